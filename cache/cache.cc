@@ -78,6 +78,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    enable_custom_split_merge),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"enable_tinylfu_admission",
+         {offsetof(struct CompressedSecondaryCacheOptions,
+                   enable_tinylfu_admission),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
 };
 
 Status SecondaryCache::CreateFromString(
@@ -11,11 +11,19 @@
 
 #include "memory/memory_allocator_impl.h"
 #include "monitoring/perf_context_imp.h"
+#include "util/cast_util.h"
 #include "util/compression.h"
+#include "util/hash.h"
 #include "util/string_util.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+// Used to size the frequency sketch. Blocks are typically a few KB before
+// compression, so this errs on the side of tracking too many keys.
+constexpr size_t kTinyLfuEstimatedEntryCharge = 1024;
+}  // namespace
+
 CompressedSecondaryCache::CompressedSecondaryCache(
     const CompressedSecondaryCacheOptions& opts)
     : cache_(opts.LRUCacheOptions::MakeSharedCache()),
@@ -23,7 +31,11 @@ CompressedSecondaryCache::CompressedSecondaryCache(
       cache_res_mgr_(std::make_shared<ConcurrentCacheReservationManager>(
           std::make_shared<CacheReservationManagerImpl<CacheEntryRole::kMisc>>(
               cache_))),
-      disable_cache_(opts.capacity == 0) {}
+      disable_cache_(opts.capacity == 0) {
+  if (opts.enable_tinylfu_admission) {
+    ResizeSketch(opts.capacity);
+  }
+}
 
 CompressedSecondaryCache::~CompressedSecondaryCache() {
   assert(cache_res_mgr_->GetTotalReservedCacheSize() == 0);
@@ -38,6 +50,11 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
     return nullptr;
   }
 
+  FrequencySketch* sketch = sketch_.load(std::memory_order_acquire);
+  if (sketch) {
+    sketch->Increment(GetSliceNPHash64(key));
+  }
+
   std::unique_ptr<SecondaryCacheResultHandle> handle;
   kept_in_sec_cache = false;
   Cache::Handle* lru_handle = cache_->Lookup(key);
@@ -98,12 +115,14 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
 
   if (advise_erase) {
     cache_->Release(lru_handle, /*erase_if_last_ref=*/true);
-    // Insert a dummy handle.
-    cache_
-        ->Insert(key, /*obj=*/nullptr,
-                 GetHelper(cache_options_.enable_custom_split_merge),
-                 /*charge=*/0)
-        .PermitUncheckedError();
+    if (!sketch) {
+      // Insert a dummy handle.
+      cache_
+          ->Insert(key, /*obj=*/nullptr,
+                   GetHelper(cache_options_.enable_custom_split_merge),
+                   /*charge=*/0)
+          .PermitUncheckedError();
+    }
   } else {
     kept_in_sec_cache = true;
     cache_->Release(lru_handle, /*erase_if_last_ref=*/false);
@@ -125,7 +144,16 @@ Status CompressedSecondaryCache::Insert(const Slice& key,
   }
 
   auto internal_helper = GetHelper(cache_options_.enable_custom_split_merge);
-  if (!force_insert) {
+  size_t size = (*helper->size_cb)(value);
+  FrequencySketch* sketch = sketch_.load(std::memory_order_acquire);
+  if (!force_insert && sketch) {
+    // The uncompressed size is an upper bound on the charge, and checking it
+    // up front avoids compressing blocks that are then rejected
+    if (!TinyLfuAdmit(sketch, key, size)) {
+      PERF_COUNTER_ADD(compressed_sec_cache_admit_reject_count, 1);
+      return Status::OK();
+    }
+  } else if (!force_insert) {
     Cache::Handle* lru_handle = cache_->Lookup(key);
     if (lru_handle == nullptr) {
       PERF_COUNTER_ADD(compressed_sec_cache_insert_dummy_count, 1);
@@ -137,7 +165,6 @@ Status CompressedSecondaryCache::Insert(const Slice& key,
     }
   }
 
-  size_t size = (*helper->size_cb)(value);
   CacheAllocationPtr ptr =
       AllocateBlock(size, cache_options_.memory_allocator.get());
 
@@ -189,12 +216,44 @@ Status CompressedSecondaryCache::Insert(const Slice& key,
   }
 }
 
+bool CompressedSecondaryCache::TinyLfuAdmit(FrequencySketch* sketch,
+                                            const Slice& key, size_t charge) {
+  const uint64_t hash = GetSliceNPHash64(key);
+  sketch->Increment(hash);
+  std::string victim_key;
+  if (!static_cast_with_check<LRUCache>(cache_.get())
+           ->GetEvictionCandidate(key, charge, &victim_key)) {
+    return true;
+  }
+  return sketch->Estimate(hash) >
+         sketch->Estimate(GetSliceNPHash64(victim_key));
+}
+
+void CompressedSecondaryCache::ResizeSketch(size_t capacity) {
+  const size_t width =
+      FrequencySketch::WidthFor(capacity / kTinyLfuEstimatedEntryCharge);
+  FrequencySketch* current = sketch_.load(std::memory_order_relaxed);
+  if (current != nullptr && current->GetWidth() == width) {
+    return;
+  }
+  // Lookups and inserts may still use the current sketch, so it is kept and
+  // reused if the capacity changes back
+  auto& sketch = sketches_[width];
+  if (!sketch) {
+    sketch.reset(new FrequencySketch(capacity / kTinyLfuEstimatedEntryCharge));
+  }
+  sketch_.store(sketch.get(), std::memory_order_release);
+}
+
 void CompressedSecondaryCache::Erase(const Slice& key) { cache_->Erase(key); }
 
 Status CompressedSecondaryCache::SetCapacity(size_t capacity) {
   MutexLock l(&capacity_mutex_);
   cache_options_.capacity = capacity;
   cache_->SetCapacity(capacity);
+  if (cache_options_.enable_tinylfu_admission) {
+    ResizeSketch(capacity);
+  }
   disable_cache_ = capacity == 0;
   return Status::OK();
 }
@@ -217,6 +276,9 @@ std::string CompressedSecondaryCache::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "    compress_format_version : %d\n",
            cache_options_.compress_format_version);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    enable_tinylfu_admission : %d\n",
+           cache_options_.enable_tinylfu_admission);
+  ret.append(buffer);
   return ret;
 }
 
@@ -6,10 +6,13 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <map>
 #include <memory>
 
 #include "cache/cache_reservation_manager.h"
+#include "cache/frequency_sketch.h"
 #include "cache/lru_cache.h"
 #include "memory/memory_allocator_impl.h"
 #include "rocksdb/secondary_cache.h"
@@ -61,6 +64,11 @@ class CompressedSecondaryCacheResultHandle : public SecondaryCacheResultHandle {
 //    CompressedSecondaryCache.
 // 2. If not, we just insert a dummy block (size 0) in CompressedSecondaryCache.
 //
+// With enable_tinylfu_admission, no dummy blocks are used. Instead, lookups
+// and insertion attempts are counted in a FrequencySketch, and an evicted
+// block is admitted only if it fits without eviction or its estimated access
+// frequency is higher than that of the LRU entry it would displace.
+//
 // Users can also cast a pointer to CompressedSecondaryCache and call methods on
 // it directly, especially custom methods that may be added
 // in the future.  For example -
@@ -103,6 +111,11 @@ class CompressedSecondaryCache : public SecondaryCache {
 
   size_t TEST_GetUsage() { return cache_->GetUsage(); }
 
+  size_t TEST_GetSketchWidth() {
+    FrequencySketch* sketch = sketch_.load(std::memory_order_acquire);
+    return sketch ? sketch->GetWidth() : 0;
+  }
+
  private:
   friend class CompressedSecondaryCacheTestBase;
   static constexpr std::array<uint16_t, 8> malloc_bin_sizes_{
@@ -130,6 +143,14 @@ class CompressedSecondaryCache : public SecondaryCache {
   CacheAllocationPtr MergeChunksIntoValue(const void* chunks_head,
                                           size_t& charge);
 
+  // Decides whether a block evicted from the primary cache is worth storing,
+  // using TinyLFU: admit if it fits, or if it is accessed more often than the
+  // entry that would be evicted to make room for it.
+  bool TinyLfuAdmit(FrequencySketch* sketch, const Slice& key, size_t charge);
+  // Switches to a sketch sized for `capacity`. REQUIRES: capacity_mutex_ held
+  // unless called from the constructor
+  void ResizeSketch(size_t capacity);
+
   // TODO: clean up to use cleaner interfaces in typed_cache.h
   const Cache::CacheItemHelper* GetHelper(bool enable_custom_split_merge) const;
   std::shared_ptr<Cache> cache_;
@@ -137,6 +158,11 @@ class CompressedSecondaryCache : public SecondaryCache {
   mutable port::Mutex capacity_mutex_;
   std::shared_ptr<ConcurrentCacheReservationManager> cache_res_mgr_;
   bool disable_cache_;
+  // Only set with enable_tinylfu_admission, to a sketch sized for the
+  // current capacity
+  std::atomic<FrequencySketch*> sketch_{nullptr};
+  // The sketches of every width used so far, by width
+  std::map<size_t, std::unique_ptr<FrequencySketch>> sketches_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -841,6 +841,99 @@ TEST_P(CompressedSecondaryCacheTestWithCompressionParam,
   BasicTestHelper(sec_cache, sec_cache_is_compressed_);
 }
 
+TEST_P(CompressedSecondaryCacheTestWithCompressionParam, TinyLfuAdmission) {
+  if (sec_cache_is_compressed_ && !LZ4_Supported()) {
+    ROCKSDB_GTEST_SKIP("This test requires LZ4 support.");
+    return;
+  }
+  std::string sec_cache_uri =
+      "compressed_secondary_cache://"
+      "capacity=2048;num_shard_bits=0;enable_tinylfu_admission=true;";
+  sec_cache_uri += sec_cache_is_compressed_
+                       ? "compression_type=kLZ4Compression"
+                       : "compression_type=kNoCompression";
+  std::shared_ptr<SecondaryCache> sec_cache;
+  ASSERT_OK(SecondaryCache::CreateFromString(ConfigOptions(), sec_cache_uri,
+                                             &sec_cache));
+  get_perf_context()->Reset();
+
+  Random rnd(301);
+  std::string str1(rnd.RandomString(1100));
+  TestItem item1(str1.data(), str1.length());
+  std::string str2(rnd.RandomString(1100));
+  TestItem item2(str2.data(), str2.length());
+  bool kept_in_sec_cache{false};
+
+  // The first item fits without eviction, so it is admitted right away
+  // rather than through a dummy entry.
+  ASSERT_OK(sec_cache->Insert(key1, &item1, GetHelper(), false));
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_insert_dummy_count, 0);
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_insert_real_count, 1);
+  for (int i = 0; i < 3; ++i) {
+    std::unique_ptr<SecondaryCacheResultHandle> handle =
+        sec_cache->Lookup(key1, GetHelper(), this, true,
+                          /*advise_erase=*/false, kept_in_sec_cache);
+    ASSERT_NE(handle, nullptr);
+    ASSERT_TRUE(kept_in_sec_cache);
+    delete static_cast<TestItem*>(handle->Value());
+  }
+
+  // The second item would evict the more frequently used first one.
+  ASSERT_OK(sec_cache->Insert(key2, &item2, GetHelper(), false));
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_admit_reject_count, 1);
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_insert_real_count, 1);
+
+  // Once the second item is requested more often, it replaces the first one.
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(sec_cache->Lookup(key2, GetHelper(), this, true,
+                                /*advise_erase=*/false, kept_in_sec_cache),
+              nullptr);
+  }
+  ASSERT_OK(sec_cache->Insert(key2, &item2, GetHelper(), false));
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_admit_reject_count, 1);
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_insert_real_count, 2);
+  ASSERT_EQ(sec_cache->Lookup(key1, GetHelper(), this, true,
+                              /*advise_erase=*/false, kept_in_sec_cache),
+            nullptr);
+  std::unique_ptr<SecondaryCacheResultHandle> handle2 =
+      sec_cache->Lookup(key2, GetHelper(), this, true, /*advise_erase=*/true,
+                        kept_in_sec_cache);
+  ASSERT_NE(handle2, nullptr);
+  ASSERT_FALSE(kept_in_sec_cache);
+  std::unique_ptr<TestItem> val2(static_cast<TestItem*>(handle2->Value()));
+  ASSERT_EQ(memcmp(val2->Buf(), item2.Buf(), item2.Size()), 0);
+
+  // Without dummy entries, forced insertions still bypass admission.
+  ASSERT_OK(sec_cache->Insert(key3, &item1, GetHelper(), true));
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_insert_real_count, 3);
+}
+
+TEST_P(CompressedSecondaryCacheTest, TinyLfuSketchFollowsCapacity) {
+  CompressedSecondaryCacheOptions opts;
+  opts.capacity = 64 << 10;
+  opts.num_shard_bits = 0;
+  opts.compression_type = kNoCompression;
+  opts.enable_tinylfu_admission = true;
+  std::shared_ptr<SecondaryCache> sec_cache =
+      NewCompressedSecondaryCache(opts);
+  auto* comp_sec_cache =
+      static_cast<CompressedSecondaryCache*>(sec_cache.get());
+  const size_t width = comp_sec_cache->TEST_GetSketchWidth();
+  ASSERT_GT(width, 0);
+
+  ASSERT_OK(sec_cache->SetCapacity(64 << 20));
+  ASSERT_GT(comp_sec_cache->TEST_GetSketchWidth(), width);
+  ASSERT_OK(sec_cache->SetCapacity(64 << 10));
+  ASSERT_EQ(comp_sec_cache->TEST_GetSketchWidth(), width);
+
+  // Admission still works once the sketch was replaced
+  Random rnd(301);
+  std::string str1(rnd.RandomString(1000));
+  TestItem item1(str1.data(), str1.length());
+  get_perf_context()->Reset();
+  ASSERT_OK(sec_cache->Insert(key1, &item1, GetHelper(), false));
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_insert_real_count, 1);
+}
 
 TEST_P(CompressedSecondaryCacheTestWithCompressionParam, FailsTest) {
   FailsTest(sec_cache_is_compressed_);
@@ -1109,6 +1202,10 @@ TEST_P(CompressedSecCacheTestWithTiered, AdmissionPolicy) {
     ROCKSDB_GTEST_BYPASS("This test requires LZ4 support\n");
     return;
   }
+  if (std::get<1>(GetParam()) == TieredAdmissionPolicy::kAdmPolicyAllowAll) {
+    ROCKSDB_GTEST_BYPASS("This test requires placeholder admission\n");
+    return;
+  }
 
   Cache* tiered_cache = GetTieredCache();
   Cache* cache = GetCache();
@@ -1165,13 +1262,66 @@ TEST_P(CompressedSecCacheTestWithTiered, AdmissionPolicy) {
   ASSERT_EQ(handle1, nullptr);
 }
 
+TEST_P(CompressedSecCacheTestWithTiered, DemoteAll) {
+  if (!LZ4_Supported()) {
+    ROCKSDB_GTEST_BYPASS("This test requires LZ4 support\n");
+    return;
+  }
+  if (std::get<1>(GetParam()) != TieredAdmissionPolicy::kAdmPolicyAllowAll) {
+    ROCKSDB_GTEST_BYPASS("This test requires kAdmPolicyAllowAll\n");
+    return;
+  }
+
+  Cache* tiered_cache = GetTieredCache();
+  Cache* cache = GetCache();
+  std::vector<CacheKey> keys;
+  std::vector<std::string> vals;
+  // 100 highly compressible 1MB items are more than twice what the primary
+  // cache can hold, but easily fit in the compressed secondary cache
+  const int kNumItems = 100;
+  const size_t kItemSize = 1 << 20;
+  int i;
+  Random rnd(301);
+  for (i = 0; i < kNumItems; ++i) {
+    keys.emplace_back(CacheKey::CreateUniqueForCacheLifetime(cache));
+    std::string val = rnd.RandomString(1000);
+    val.resize(kItemSize, 'x');
+    vals.emplace_back(std::move(val));
+  }
+
+  for (i = 0; i < kNumItems; ++i) {
+    TestItem* item = new TestItem(vals[i].data(), vals[i].length());
+    ASSERT_OK(tiered_cache->Insert(keys[i].AsSlice(), item, GetHelper(),
+                                   vals[i].length()));
+  }
+  CompressedSecondaryCache* sec_cache =
+      static_cast<CompressedSecondaryCache*>(GetSecondaryCache());
+  ASSERT_GT(sec_cache->TEST_GetUsage(), 0);
+
+  // Every item is found, either in the primary cache or (without ever having
+  // been looked up) in the secondary cache, and comes back intact
+  for (i = 0; i < kNumItems; ++i) {
+    Cache::Handle* handle =
+        tiered_cache->Lookup(keys[i].AsSlice(), GetHelper(),
+                             /*context*/ this, Cache::Priority::LOW);
+    ASSERT_NE(handle, nullptr) << "item " << i;
+    TestItem* item = static_cast<TestItem*>(tiered_cache->Value(handle));
+    ASSERT_EQ(item->ToString(), vals[i]);
+    tiered_cache->Release(handle);
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
     CompressedSecCacheTests, CompressedSecCacheTestWithTiered,
     ::testing::Values(
         std::make_tuple(PrimaryCacheType::kCacheTypeLRU,
                         TieredAdmissionPolicy::kAdmPolicyAllowCacheHits),
         std::make_tuple(PrimaryCacheType::kCacheTypeHCC,
-                        TieredAdmissionPolicy::kAdmPolicyAllowCacheHits)));
+                        TieredAdmissionPolicy::kAdmPolicyAllowCacheHits),
+        std::make_tuple(PrimaryCacheType::kCacheTypeLRU,
+                        TieredAdmissionPolicy::kAdmPolicyAllowAll),
+        std::make_tuple(PrimaryCacheType::kCacheTypeHCC,
+                        TieredAdmissionPolicy::kAdmPolicyAllowAll)));
 
 }  // namespace ROCKSDB_NAMESPACE
 
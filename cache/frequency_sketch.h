@@ -0,0 +1,125 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A count-min sketch of small saturating counters that estimates how often a
+// key was accessed recently, as used by TinyLFU cache admission. Every
+// `kSampleFactor` x width increments all counters are halved, so estimates
+// reflect recent popularity and old hot keys age out.
+//
+// Counters are read and updated with relaxed atomics and no locking. Under
+// concurrent use an increment or an aging step may occasionally be lost, which
+// only makes the (already approximate) estimates slightly less accurate.
+class FrequencySketch {
+ public:
+  static constexpr uint32_t kMaxCount = 15;
+
+  // `expected_entries` is the number of distinct keys the sketch should track
+  // with reasonable accuracy, normally the number of entries that fit in the
+  // cache.
+  explicit FrequencySketch(size_t expected_entries) {
+    size_t width = WidthFor(expected_entries);
+    width_mask_ = width - 1;
+    sample_size_ = width * kSampleFactor;
+    counters_.reset(new std::atomic<uint8_t>[width * kDepth]);
+    for (size_t i = 0; i < width * kDepth; ++i) {
+      counters_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // No copying allowed
+  FrequencySketch(const FrequencySketch&) = delete;
+  FrequencySketch& operator=(const FrequencySketch&) = delete;
+
+  // Records an access to the key with the given 64-bit hash
+  void Increment(uint64_t hash) {
+    for (size_t row = 0; row < kDepth; ++row) {
+      std::atomic<uint8_t>& counter = counters_[Index(hash, row)];
+      uint8_t count = counter.load(std::memory_order_relaxed);
+      if (count < kMaxCount) {
+        counter.store(count + 1, std::memory_order_relaxed);
+      }
+    }
+    if (additions_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+        sample_size_) {
+      Age();
+    }
+  }
+
+  // Returns the estimated recent access count of the key with the given
+  // 64-bit hash, never more than kMaxCount
+  uint32_t Estimate(uint64_t hash) const {
+    uint32_t estimate = kMaxCount;
+    for (size_t row = 0; row < kDepth; ++row) {
+      uint32_t count =
+          counters_[Index(hash, row)].load(std::memory_order_relaxed);
+      estimate = std::min(estimate, count);
+    }
+    return estimate;
+  }
+
+  size_t GetWidth() const { return width_mask_ + 1; }
+
+  // Returns the width of a sketch tracking `expected_entries` keys
+  static size_t WidthFor(size_t expected_entries) {
+    size_t width = kMinWidth;
+    while (width < expected_entries && width < kMaxWidth) {
+      width <<= 1;
+    }
+    return width;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kMinWidth = 64;
+  static constexpr size_t kMaxWidth = size_t{1} << 24;
+  static constexpr size_t kSampleFactor = 10;
+
+  size_t Index(uint64_t hash, size_t row) const {
+    // Each row uses a different 16-bit rotation of the hash, remixed so that
+    // rows are independent even for small widths
+    uint64_t h = hash;
+    if (row > 0) {
+      h = (hash >> (16 * row)) | (hash << (64 - 16 * row));
+    }
+    h *= 0x9E3779B97F4A7C15ULL;
+    return row * GetWidth() + (static_cast<size_t>(h >> 32) & width_mask_);
+  }
+
+  void Age() {
+    for (size_t i = 0; i < GetWidth() * kDepth; ++i) {
+      uint8_t count = counters_[i].load(std::memory_order_relaxed);
+      counters_[i].store(count >> 1, std::memory_order_relaxed);
+    }
+    additions_.fetch_sub(sample_size_, std::memory_order_relaxed);
+  }
+
+  size_t width_mask_;
+  size_t sample_size_;
+  std::unique_ptr<std::atomic<uint8_t>[]> counters_;
+  std::atomic<size_t> additions_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -663,6 +663,16 @@ size_t LRUCacheShard::GetTableAddressCount() const {
   return size_t{1} << table_.GetLengthBits();
 }
 
+bool LRUCacheShard::GetEvictionCandidate(size_t charge,
+                                         std::string* victim_key) const {
+  DMutexLock l(mutex_);
+  if (usage_ + charge <= capacity_ || lru_.next == &lru_) {
+    return false;
+  }
+  victim_key->assign(lru_.next->key().data(), lru_.next->key().size());
+  return true;
+}
+
 void LRUCacheShard::AppendPrintableOptions(std::string& str) const {
   const int kBufferSize = 200;
   char buffer[kBufferSize];
@@ -704,6 +714,12 @@ const Cache::CacheItemHelper* LRUCache::GetCacheItemHelper(
   return h->helper;
 }
 
+bool LRUCache::GetEvictionCandidate(const Slice& key, size_t charge,
+                                    std::string* victim_key) const {
+  return GetShard(LRUCacheShard::ComputeHash(key, hash_seed_))
+      .GetEvictionCandidate(charge, victim_key);
+}
+
 size_t LRUCache::TEST_GetLRUSize() {
   return SumOverShards([](LRUCacheShard& cs) { return cs.TEST_GetLRUSize(); });
 }
@@ -346,6 +346,11 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
   size_t GetOccupancyCount() const;
   size_t GetTableAddressCount() const;
 
+  // If inserting an entry with the given charge would evict entries, stores
+  // the key of the first entry that would be evicted in *victim_key and
+  // returns true. Returns false if nothing would be evicted.
+  bool GetEvictionCandidate(size_t charge, std::string* victim_key) const;
+
   void ApplyToSomeEntriesWithOwnerId(
       const std::function<void(const Slice& key, Cache::ObjectPtr value,
                                size_t charge,
@@ -475,6 +480,11 @@ class LRUCache
   size_t GetCharge(Handle* handle) const override;
   const CacheItemHelper* GetCacheItemHelper(Handle* handle) const override;
 
+  // See LRUCacheShard::GetEvictionCandidate. The shard is the one an entry
+  // with the given key would be inserted into.
+  bool GetEvictionCandidate(const Slice& key, size_t charge,
+                            std::string* victim_key) const;
+
   // Retrieves number of elements in LRU, for unit test purpose only.
   size_t TEST_GetLRUSize();
   // Retrieves high pri pool ratio.
@@ -126,6 +126,8 @@ bool CacheWithSecondaryAdapter::EvictionHandler(const Slice& key,
       bool hit = false;
       if (adm_policy_ == TieredAdmissionPolicy::kAdmPolicyAllowCacheHits) {
         hit = was_hit;
+      } else if (adm_policy_ == TieredAdmissionPolicy::kAdmPolicyAllowAll) {
+        hit = true;
       }
       // Spill into secondary cache.
       secondary_cache_->Insert(key, obj, helper, hit).PermitUncheckedError();
@@ -250,6 +252,8 @@ Cache::Handle* CacheWithSecondaryAdapter::Lookup(const Slice& key,
   bool secondary_compatible = helper && helper->IsSecondaryCacheCompatible();
   bool found_dummy_entry =
       ProcessDummyResult(&result, /*erase=*/secondary_compatible);
+  // Without placeholders, always promote as if this were the second hit
+  found_dummy_entry |= adm_policy_ == TieredAdmissionPolicy::kAdmPolicyAllowAll;
   if (!result && secondary_compatible) {
     // Try our secondary cache
     bool kept_in_sec_cache = false;
@@ -313,6 +317,8 @@ void CacheWithSecondaryAdapter::StartAsyncLookup(
         async_handle.helper->IsSecondaryCacheCompatible();
     async_handle.found_dummy_entry |= ProcessDummyResult(
         &async_handle.result_handle, /*erase=*/secondary_compatible);
+    async_handle.found_dummy_entry |=
+        adm_policy_ == TieredAdmissionPolicy::kAdmPolicyAllowAll;
 
     if (async_handle.Result() == nullptr && secondary_compatible) {
       // Not found and not pending on another secondary cache
@@ -0,0 +1,108 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/adaptive_compression.h"
+
+#include "util/compression.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+bool AdaptiveCompressionSelector::Pick(
+    const std::vector<AdaptiveCompressionCandidate>& candidates,
+    int output_level, double write_cost, CompressionType* type,
+    CompressionOptions* opts) {
+  MutexLock l(&mutex_);
+  ++picks_;
+
+  Stats* undersampled = nullptr;
+  Stats* oldest = nullptr;
+  Stats* cheapest = nullptr;
+  const AdaptiveCompressionCandidate* undersampled_candidate = nullptr;
+  const AdaptiveCompressionCandidate* oldest_candidate = nullptr;
+  const AdaptiveCompressionCandidate* cheapest_candidate = nullptr;
+  double cheapest_cost = 0;
+  for (const auto& candidate : candidates) {
+    if (!CompressionTypeSupported(candidate.type)) {
+      continue;
+    }
+    Stats& stats = stats_[Key(output_level, candidate.type, candidate.level)];
+    if (stats.raw_bytes < kMinSampleBytes) {
+      // Rotate among the candidates that were not measured yet, since the
+      // measurements of the files being written are not known yet
+      if (undersampled == nullptr ||
+          ((stats.raw_bytes == 0) != (undersampled->raw_bytes == 0)
+               ? stats.raw_bytes == 0
+               : stats.last_used < undersampled->last_used)) {
+        undersampled = &stats;
+        undersampled_candidate = &candidate;
+      }
+      continue;
+    }
+    if (oldest == nullptr || stats.last_used < oldest->last_used) {
+      oldest = &stats;
+      oldest_candidate = &candidate;
+    }
+    const double cost =
+        (static_cast<double>(stats.nanos) +
+         write_cost * static_cast<double>(stats.compressed_bytes)) /
+        static_cast<double>(stats.raw_bytes);
+    if (cheapest == nullptr || cost < cheapest_cost) {
+      cheapest = &stats;
+      cheapest_candidate = &candidate;
+      cheapest_cost = cost;
+    }
+  }
+
+  Stats* chosen = cheapest;
+  const AdaptiveCompressionCandidate* chosen_candidate = cheapest_candidate;
+  if (undersampled != nullptr) {
+    chosen = undersampled;
+    chosen_candidate = undersampled_candidate;
+  } else if (picks_ % kExploreOneInPicks == 0) {
+    chosen = oldest;
+    chosen_candidate = oldest_candidate;
+  }
+  if (chosen == nullptr) {
+    return false;
+  }
+  chosen->last_used = picks_;
+  *type = chosen_candidate->type;
+  opts->level = chosen_candidate->level;
+  return true;
+}
+
+void AdaptiveCompressionSelector::Record(int output_level,
+                                         CompressionType type,
+                                         int compression_level,
+                                         uint64_t raw_bytes,
+                                         uint64_t compressed_bytes,
+                                         uint64_t nanos) {
+  if (raw_bytes == 0) {
+    return;
+  }
+  MutexLock l(&mutex_);
+  Stats& stats = stats_[Key(output_level, type, compression_level)];
+  stats.raw_bytes += raw_bytes;
+  stats.compressed_bytes += compressed_bytes;
+  stats.nanos += nanos;
+  stats.last_used = picks_;
+  if (stats.raw_bytes > kWindowBytes) {
+    stats.raw_bytes /= 2;
+    stats.compressed_bytes /= 2;
+    stats.nanos /= 2;
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
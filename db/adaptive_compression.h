@@ -0,0 +1,86 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/advanced_options.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Chooses the compression of the compaction output files of a column family
+// among the adaptive_compression_candidates.
+//
+// Table builders report the time spent compressing the data blocks of each
+// finished file and their size before and after compression. The selector
+// keeps these per output level and candidate, and picks the candidate with
+// the lowest cost per raw byte, where a compressed byte costs
+// adaptive_compression_write_cost nanoseconds. Candidates that were not
+// measured enough yet are tried first, and every kExploreOneInPicks-th pick
+// measures the candidate with the oldest measurement again, so that the
+// choice follows the data and the host load. Older measurements decay once
+// a candidate compressed more than kWindowBytes.
+//
+// All methods are thread-safe.
+class AdaptiveCompressionSelector {
+ public:
+  AdaptiveCompressionSelector() = default;
+
+  // No copying allowed
+  AdaptiveCompressionSelector(const AdaptiveCompressionSelector&) = delete;
+  AdaptiveCompressionSelector& operator=(const AdaptiveCompressionSelector&) =
+      delete;
+
+  // Picks the compression of a new output file of `output_level`. Sets
+  // `*type` and the level in `*opts`, and returns true, unless none of the
+  // candidates is supported, in which case they are left unchanged.
+  bool Pick(const std::vector<AdaptiveCompressionCandidate>& candidates,
+            int output_level, double write_cost, CompressionType* type,
+            CompressionOptions* opts);
+
+  // Reports the data blocks of a finished file of `output_level` compressed
+  // with this compression type and level: their size before and after
+  // compression and the compression time
+  void Record(int output_level, CompressionType type, int compression_level,
+              uint64_t raw_bytes, uint64_t compressed_bytes, uint64_t nanos);
+
+ private:
+  // Candidates are measured over at least that many raw bytes before they
+  // are compared with the others
+  static constexpr uint64_t kMinSampleBytes = 4 << 20;
+  // Measurements are halved when they exceed that many raw bytes
+  static constexpr uint64_t kWindowBytes = 64 << 20;
+  static constexpr uint64_t kExploreOneInPicks = 16;
+
+  using Key = std::tuple<int, CompressionType, int>;
+
+  struct Stats {
+    uint64_t raw_bytes = 0;
+    uint64_t compressed_bytes = 0;
+    uint64_t nanos = 0;
+    // The value of picks_ at the last pick or measurement
+    uint64_t last_used = 0;
+  };
+
+  port::Mutex mutex_;
+  std::map<Key, Stats> stats_;
+  uint64_t picks_ = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
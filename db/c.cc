@@ -6630,6 +6630,47 @@ rocksdb_pinnableslice_t* rocksdb_get_pinned_cf(
 
 void rocksdb_pinnableslice_destroy(rocksdb_pinnableslice_t* v) { delete v; }
 
+rocksdb_pinnableslice_t* rocksdb_pinnableslice_create() {
+  return new rocksdb_pinnableslice_t;
+}
+
+void rocksdb_pinnableslice_reset(rocksdb_pinnableslice_t* v) { v->rep.Reset(); }
+
+unsigned char rocksdb_get_pinned_v2(rocksdb_t* db,
+                                    const rocksdb_readoptions_t* options,
+                                    const char* key, size_t keylen,
+                                    rocksdb_pinnableslice_t* value,
+                                    char** errptr) {
+  value->rep.Reset();
+  Status s = db->rep->Get(options->rep, db->rep->DefaultColumnFamily(),
+                          Slice(key, keylen), &value->rep);
+  if (!s.ok()) {
+    value->rep.Reset();
+    if (!s.IsNotFound()) {
+      SaveError(errptr, s);
+    }
+    return 0;
+  }
+  return 1;
+}
+
+unsigned char rocksdb_get_pinned_cf_v2(
+    rocksdb_t* db, const rocksdb_readoptions_t* options,
+    rocksdb_column_family_handle_t* column_family, const char* key,
+    size_t keylen, rocksdb_pinnableslice_t* value, char** errptr) {
+  value->rep.Reset();
+  Status s = db->rep->Get(options->rep, column_family->rep, Slice(key, keylen),
+                          &value->rep);
+  if (!s.ok()) {
+    value->rep.Reset();
+    if (!s.IsNotFound()) {
+      SaveError(errptr, s);
+    }
+    return 0;
+  }
+  return 1;
+}
+
 const char* rocksdb_pinnableslice_value(const rocksdb_pinnableslice_t* v,
                                         size_t* vlen) {
   if (!v) {
@@ -152,6 +152,22 @@ static void CheckPinGet(rocksdb_t* db, const rocksdb_readoptions_t* options,
   rocksdb_pinnableslice_destroy(p);
 }
 
+static void CheckPinGetV2(rocksdb_t* db, const rocksdb_readoptions_t* options,
+                          rocksdb_pinnableslice_t* p, const char* key,
+                          const char* expected) {
+  char* err = NULL;
+  size_t val_len;
+  const char* val;
+  unsigned char found;
+  found = rocksdb_get_pinned_v2(db, options, key, strlen(key), p, &err);
+  CheckNoError(err);
+  CheckCondition(found == (expected != NULL));
+  if (found) {
+    val = rocksdb_pinnableslice_value(p, &val_len);
+    CheckEqual(expected, val, val_len);
+  }
+}
+
 static void CheckPinGetCF(rocksdb_t* db, const rocksdb_readoptions_t* options,
                           rocksdb_column_family_handle_t* handle,
                           const char* key, const char* expected) {
@@ -1197,6 +1213,14 @@ int main(int argc, char** argv) {
     CheckPinGet(db, roptions, "box", "c");
     CheckPinGet(db, roptions, "foo", "hello");
     CheckPinGet(db, roptions, "notfound", NULL);
+
+    rocksdb_pinnableslice_t* p = rocksdb_pinnableslice_create();
+    CheckPinGetV2(db, roptions, p, "box", "c");
+    CheckPinGetV2(db, roptions, p, "foo", "hello");
+    CheckPinGetV2(db, roptions, p, "notfound", NULL);
+    CheckPinGetV2(db, roptions, p, "box", "c");
+    rocksdb_pinnableslice_reset(p);
+    rocksdb_pinnableslice_destroy(p);
   }
 
   StartPhase("approximate_sizes");
@@ -32,12 +32,14 @@
 #include <string>
 #include <vector>
 
+#include "db/adaptive_compression.h"
 #include "db/blob/blob_file_cache.h"
 #include "db/blob/blob_source.h"
 #include "db/compaction/compaction_picker.h"
 #include "db/compaction/compaction_picker_fifo.h"
 #include "db/compaction/compaction_picker_level.h"
 #include "db/compaction/compaction_picker_universal.h"
+#include "db/compression_dict_service.h"
 #include "db/db_impl/db_impl.h"
 #include "db/internal_stats.h"
 #include "db/job_context.h"
@@ -606,6 +608,9 @@ ColumnFamilyData::ColumnFamilyData(
                           internal_stats_->GetBlobFileReadHist(), io_tracer));
     blob_source_.reset(new BlobSource(ioptions(), db_id, db_session_id,
                                       blob_file_cache_.get()));
+    compression_dict_service_.reset(new CompressionDictService());
+    table_cache_->SetCompressionDictService(compression_dict_service_.get());
+    adaptive_compression_.reset(new AdaptiveCompressionSelector());
 
     if (ioptions_.compaction_style == kCompactionStyleLevel) {
       compaction_picker_.reset(
@@ -1587,6 +1592,26 @@ Status ColumnFamilyData::ValidateOptions(
         "FIFO compaction only supported with max_open_files = -1.");
   }
 
+  if (!cf_options.key_prefix_retentions.empty()) {
+    if (cf_options.compaction_style != kCompactionStyleLevel) {
+      return Status::NotSupported(
+          "Key prefix retentions are only supported with level compaction.");
+    }
+    if (ucmp->timestamp_size() > 0 ||
+        (ucmp != BytewiseComparator() &&
+         ucmp != ReverseBytewiseComparator())) {
+      return Status::NotSupported(
+          "Key prefix retentions are only supported with the bytewise "
+          "comparators.");
+    }
+    for (const auto& retention : cf_options.key_prefix_retentions) {
+      if (retention.retention_seconds == 0) {
+        return Status::InvalidArgument(
+            "The retention of a key prefix should be positive.");
+      }
+    }
+  }
+
   std::vector<uint32_t> supported{0, 1, 2, 4, 8};
   if (std::find(supported.begin(), supported.end(),
                 cf_options.memtable_protection_bytes_per_key) ==
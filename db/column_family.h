@@ -62,6 +62,8 @@ class InstrumentedMutexLock;
 struct SuperVersionContext;
 class BlobFileCache;
 class BlobSource;
+class AdaptiveCompressionSelector;
+class CompressionDictService;
 
 extern const double kIncSlowdownRatio;
 // This file contains a list of data structures for managing column family
@@ -387,6 +389,12 @@ class ColumnFamilyData {
 
   TableCache* table_cache() const { return table_cache_.get(); }
   BlobSource* blob_source() const { return blob_source_.get(); }
+  CompressionDictService* compression_dict_service() const {
+    return compression_dict_service_.get();
+  }
+  AdaptiveCompressionSelector* adaptive_compression() const {
+    return adaptive_compression_.get();
+  }
 
   // See documentation in compaction_picker.h
   // REQUIRES: DB mutex held
@@ -642,6 +650,8 @@ class ColumnFamilyData {
   std::unique_ptr<TableCache> table_cache_;
   std::unique_ptr<BlobFileCache> blob_file_cache_;
   std::unique_ptr<BlobSource> blob_source_;
+  std::unique_ptr<CompressionDictService> compression_dict_service_;
+  std::unique_ptr<AdaptiveCompressionSelector> adaptive_compression_;
 
   std::unique_ptr<InternalStats> internal_stats_;
 
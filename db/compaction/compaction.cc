@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "db/column_family.h"
+#include "db/compaction/key_prefix_retention.h"
 #include "logging/logging.h"
 #include "rocksdb/compaction_filter.h"
 #include "rocksdb/sst_partitioner.h"
@@ -499,8 +500,11 @@ bool Compaction::IsTrivialMove() const {
   }
 
   // Used in universal compaction, where trivial move can be done if the
-  // input files are non overlapping
-  if ((mutable_cf_options_.compaction_options_universal.allow_trivial_move) &&
+  // input files are non overlapping. A compaction picked as a fold of
+  // non-overlapping sorted runs is marked as a trivial move regardless of
+  // allow_trivial_move.
+  if ((mutable_cf_options_.compaction_options_universal.allow_trivial_move ||
+       is_trivial_move_) &&
       (output_level_ != 0) &&
       (cfd_->ioptions()->compaction_style == kCompactionStyleUniversal)) {
     return is_trivial_move_;
@@ -781,17 +785,24 @@ std::unique_ptr<CompactionFilter> Compaction::CreateCompactionFilter() const {
 }
 
 std::unique_ptr<SstPartitioner> Compaction::CreateSstPartitioner() const {
-  if (!immutable_options_.sst_partitioner_factory) {
-    return nullptr;
-  }
-
-  SstPartitioner::Context context;
-  context.is_full_compaction = is_full_compaction_;
-  context.is_manual_compaction = is_manual_compaction_;
-  context.output_level = output_level_;
-  context.smallest_user_key = smallest_user_key_;
-  context.largest_user_key = largest_user_key_;
-  return immutable_options_.sst_partitioner_factory->CreatePartitioner(context);
+  std::unique_ptr<SstPartitioner> partitioner;
+  if (immutable_options_.sst_partitioner_factory) {
+    SstPartitioner::Context context;
+    context.is_full_compaction = is_full_compaction_;
+    context.is_manual_compaction = is_manual_compaction_;
+    context.output_level = output_level_;
+    context.smallest_user_key = smallest_user_key_;
+    context.largest_user_key = largest_user_key_;
+    partitioner =
+        immutable_options_.sst_partitioner_factory->CreatePartitioner(context);
+  }
+  if (!immutable_options_.key_prefix_retentions.empty()) {
+    // Keep the keys of each retention in their own files, which can be
+    // deleted as a whole once the keys expire
+    partitioner.reset(new KeyPrefixRetentionPartitioner(
+        immutable_options_.key_prefix_retentions, std::move(partitioner)));
+  }
+  return partitioner;
 }
 
 bool Compaction::IsOutputLevelEmpty() const {
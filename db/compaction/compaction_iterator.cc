@@ -51,7 +51,8 @@ CompactionIterator::CompactionIterator(
     const std::shared_ptr<Logger> info_log,
     const std::string* full_history_ts_low,
     const SequenceNumber preserve_time_min_seqno,
-    const SequenceNumber preclude_last_level_min_seqno)
+    const SequenceNumber preclude_last_level_min_seqno,
+    const KeyPrefixRetentionCutoffs* key_prefix_retention_cutoffs)
     : CompactionIterator(
           input, cmp, merge_helper, last_sequence, snapshots,
           earliest_write_conflict_snapshot, job_snapshot, snapshot_checker, env,
@@ -62,7 +63,7 @@ CompactionIterator::CompactionIterator(
               compaction ? new RealCompaction(compaction) : nullptr),
           must_count_input_entries, compaction_filter, shutting_down, info_log,
           full_history_ts_low, preserve_time_min_seqno,
-          preclude_last_level_min_seqno) {}
+          preclude_last_level_min_seqno, key_prefix_retention_cutoffs) {}
 
 CompactionIterator::CompactionIterator(
     InternalIterator* input, const Comparator* cmp, MergeHelper* merge_helper,
@@ -80,7 +81,8 @@ CompactionIterator::CompactionIterator(
     const std::shared_ptr<Logger> info_log,
     const std::string* full_history_ts_low,
     const SequenceNumber preserve_time_min_seqno,
-    const SequenceNumber preclude_last_level_min_seqno)
+    const SequenceNumber preclude_last_level_min_seqno,
+    const KeyPrefixRetentionCutoffs* key_prefix_retention_cutoffs)
     : input_(input, cmp, must_count_input_entries),
       cmp_(cmp),
       merge_helper_(merge_helper),
@@ -124,7 +126,8 @@ CompactionIterator::CompactionIterator(
       cmp_with_history_ts_low_(0),
       level_(compaction_ == nullptr ? 0 : compaction_->level()),
       preserve_time_min_seqno_(preserve_time_min_seqno),
-      preclude_last_level_min_seqno_(preclude_last_level_min_seqno) {
+      preclude_last_level_min_seqno_(preclude_last_level_min_seqno),
+      key_prefix_retention_cutoffs_(key_prefix_retention_cutoffs) {
   assert(snapshots_ != nullptr);
   assert(preserve_time_min_seqno_ <= preclude_last_level_min_seqno_);
 
@@ -503,6 +506,27 @@ void CompactionIterator::NextFromInput() {
       validity_info_.SetValid(kRangeDeletion);
       break;
     }
+    // Drop the expired keys of the key prefix retentions. Reads do not check
+    // for expiry, so an older version of such a key beyond the output level
+    // would become visible instead: unless there is none, the key is turned
+    // into a tombstone, as for a compaction filter's kRemove. The put that
+    // follows a kept single delete is kept (without its value).
+    bool expired_to_deletion = false;
+    if (UNLIKELY(key_prefix_retention_cutoffs_ != nullptr) &&
+        !clear_and_output_next_key_ &&
+        key_prefix_retention_cutoffs_->IsExpired(ikey_.user_key,
+                                                 ikey_.sequence)) {
+      if (compaction_ != nullptr &&
+          compaction_->KeyNotExistsBeyondOutputLevel(ikey_.user_key,
+                                                     &level_ptrs_)) {
+        iter_stats_.num_record_drop_user++;
+        AdvanceInputIter();
+        continue;
+      }
+      expired_to_deletion = ikey_.type != kTypeDeletion &&
+                            ikey_.type != kTypeSingleDeletion &&
+                            ikey_.type != kTypeDeletionWithTimestamp;
+    }
     // Update input statistics
     if (ikey_.type == kTypeDeletion || ikey_.type == kTypeSingleDeletion ||
         ikey_.type == kTypeDeletionWithTimestamp) {
@@ -510,6 +534,12 @@ void CompactionIterator::NextFromInput() {
     }
     iter_stats_.total_input_raw_key_bytes += key_.size();
     iter_stats_.total_input_raw_value_bytes += value_.size();
+    if (UNLIKELY(expired_to_deletion)) {
+      // The internal key is updated once it is copied below
+      ikey_.type = kTypeDeletion;
+      value_.clear();
+      iter_stats_.num_record_drop_user++;
+    }
 
     // If need_skip is true, we should seek the input iterator
     // to internal key skip_until and continue from there.
@@ -539,6 +569,9 @@ void CompactionIterator::NextFromInput() {
       // First occurrence of this user key
       // Copy key for output
       key_ = current_key_.SetInternalKey(key_, &ikey_);
+      if (UNLIKELY(expired_to_deletion)) {
+        current_key_.UpdateInternalKey(ikey_.sequence, ikey_.type);
+      }
 
       int prev_cmp_with_ts_low =
           !full_history_ts_low_ ? 0
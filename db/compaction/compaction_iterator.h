@@ -27,6 +27,7 @@
 
 #include "db/compaction/compaction.h"
 #include "db/compaction/compaction_iteration_stats.h"
+#include "db/compaction/key_prefix_retention.h"
 #include "db/merge_helper.h"
 #include "db/pinned_iterators_manager.h"
 #include "db/range_del_aggregator.h"
@@ -228,7 +229,8 @@ class CompactionIterator {
       const std::shared_ptr<Logger> info_log = nullptr,
       const std::string* full_history_ts_low = nullptr,
       const SequenceNumber preserve_time_min_seqno = kMaxSequenceNumber,
-      const SequenceNumber preclude_last_level_min_seqno = kMaxSequenceNumber);
+      const SequenceNumber preclude_last_level_min_seqno = kMaxSequenceNumber,
+      const KeyPrefixRetentionCutoffs* key_prefix_retention_cutoffs = nullptr);
 
   // Constructor with custom CompactionProxy, used for tests.
   CompactionIterator(
@@ -248,7 +250,8 @@ class CompactionIterator {
       const std::shared_ptr<Logger> info_log = nullptr,
       const std::string* full_history_ts_low = nullptr,
       const SequenceNumber preserve_time_min_seqno = kMaxSequenceNumber,
-      const SequenceNumber preclude_last_level_min_seqno = kMaxSequenceNumber);
+      const SequenceNumber preclude_last_level_min_seqno = kMaxSequenceNumber,
+      const KeyPrefixRetentionCutoffs* key_prefix_retention_cutoffs = nullptr);
 
   ~CompactionIterator();
 
@@ -517,6 +520,10 @@ class CompactionIterator {
   // than this, it will be output to penultimate level
   const SequenceNumber preclude_last_level_min_seqno_ = kMaxSequenceNumber;
 
+  // If not null, the keys that expired according to these cutoffs are
+  // dropped.
+  const KeyPrefixRetentionCutoffs* key_prefix_retention_cutoffs_ = nullptr;
+
   void AdvanceInputIter() { input_.Next(); }
 
   void SkipUntil(const Slice& skip_until) { input_.Seek(skip_until); }
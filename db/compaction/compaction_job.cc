@@ -31,12 +31,14 @@
 #include <utility>
 #include <vector>
 
+#include "db/adaptive_compression.h"
 #include "db/blob/blob_counting_iterator.h"
 #include "db/blob/blob_file_addition.h"
 #include "db/blob/blob_file_builder.h"
 #include "db/builder.h"
 #include "db/compaction/clipping_iterator.h"
 #include "db/compaction/compaction_state.h"
+#include "db/compression_dict_service.h"
 #include "db/db_impl/db_impl.h"
 #include "db/dbformat.h"
 #include "db/error_handler.h"
@@ -115,6 +117,10 @@ const char* GetCompactionReasonString(CompactionReason compaction_reason) {
       return "RoundRobinTtl";
     case CompactionReason::kRefitLevel:
       return "RefitLevel";
+    case CompactionReason::kRangeTombstones:
+      return "RangeTombstones";
+    case CompactionReason::kKeyPrefixRetention:
+      return "KeyPrefixRetention";
     case CompactionReason::kNumOfReasons:
       // fall through
     default:
@@ -169,6 +175,8 @@ CompactionJob::CompactionJob(
       stats_(stats),
       bottommost_level_(false),
       last_level_with_data_(false),
+      relieves_write_stalls_(compaction->start_level() == 0 ||
+                             !compaction->bottommost_level()),
       write_hint_(Env::WLTH_NOT_SET),
       compaction_job_stats_(compaction_job_stats),
       job_id_(job_id),
@@ -301,6 +309,11 @@ void CompactionJob::Prepare() {
   uint64_t preserve_time_duration =
       std::max(c->immutable_options()->preserve_internal_time_seconds,
                c->immutable_options()->preclude_last_level_data_seconds);
+  // The keys with a retention keep their sequence number until they expire
+  preserve_time_duration = std::max(
+      preserve_time_duration,
+      MaxKeyPrefixRetentionSeconds(
+          c->immutable_options()->key_prefix_retentions));
 
   if (preserve_time_duration > 0) {
     const ReadOptions read_options(Env::IOActivity::kCompaction);
@@ -355,6 +368,15 @@ void CompactionJob::Prepare() {
         preclude_last_level_min_seqno_ =
             seqno_time_mapping_.GetOldestSequenceNum(preclude_last_level_time);
       }
+      if (!c->immutable_options()->key_prefix_retentions.empty()) {
+        key_prefix_retention_cutoffs_.Update(
+            c->immutable_options()->key_prefix_retentions, seqno_time_mapping_,
+            _current_time);
+        // Drop at least the keys that made the files be picked, which the
+        // mapping of the input files alone may miss
+        key_prefix_retention_cutoffs_.Merge(
+            c->input_version()->storage_info()->key_prefix_retention_cutoffs());
+      }
     }
   }
 }
@@ -550,15 +572,25 @@ void CompactionJob::GenSubcompactionBoundaries() {
                0;
       });
 
-  // Remove duplicated entries from boundaries.
-  all_anchors.erase(
-      std::unique(all_anchors.begin(), all_anchors.end(),
-                  [cfd_comparator](TableReader::Anchor& a,
-                                   TableReader::Anchor& b) -> bool {
-                    return cfd_comparator->CompareWithoutTimestamp(
-                               a.user_key, b.user_key) == 0;
-                  }),
-      all_anchors.end());
+  // Remove duplicated entries from boundaries, keeping the range sizes of
+  // the removed ones so that the anchors still add up to total_size
+  size_t num_unique_anchors = 0;
+  for (size_t i = 0; i < all_anchors.size(); i++) {
+    if (num_unique_anchors > 0 &&
+        cfd_comparator->CompareWithoutTimestamp(
+            all_anchors[num_unique_anchors - 1].user_key,
+            all_anchors[i].user_key) == 0) {
+      all_anchors[num_unique_anchors - 1].range_size +=
+          all_anchors[i].range_size;
+    } else {
+      if (num_unique_anchors != i) {
+        all_anchors[num_unique_anchors] = std::move(all_anchors[i]);
+      }
+      num_unique_anchors++;
+    }
+  }
+  all_anchors.erase(all_anchors.begin() + num_unique_anchors,
+                    all_anchors.end());
 
   // Get the number of planned subcompactions, may update reserve threads
   // and update extra_num_subcompaction_threads_reserved_ for round-robin
@@ -609,22 +641,114 @@ void CompactionJob::GenSubcompactionBoundaries() {
     return;
   }
 
-  uint64_t next_threshold = target_range_size;
-  uint64_t cumulative_size = 0;
+  // bytes_before[i] estimates the input bytes before the key of anchor i,
+  // the range of an anchor ending with its key
+  std::vector<uint64_t> bytes_before(all_anchors.size() + 1, 0);
+  for (size_t i = 0; i < all_anchors.size(); i++) {
+    bytes_before[i + 1] = bytes_before[i] + all_anchors[i].range_size;
+  }
+  auto estimate_bytes_before = [&](const Slice& key) -> uint64_t {
+    auto it = std::lower_bound(
+        all_anchors.begin(), all_anchors.end(), key,
+        [cfd_comparator](const TableReader::Anchor& a, const Slice& k) {
+          return cfd_comparator->CompareWithoutTimestamp(a.user_key, k) < 0;
+        });
+    return bytes_before[it - all_anchors.begin()];
+  };
+
+  // A subcompaction boundary that falls within an output partition, or
+  // within a file of the level below the output level, splits an output
+  // file that would otherwise be whole: a boundary is moved to the start of
+  // such a partition, or else of such a file, when one is close enough.
+  struct Cut {
+    uint64_t bytes_before;
+    std::string user_key;
+  };
+  std::vector<Cut> partition_cuts;
+  std::vector<Cut> file_cuts;
+  std::unique_ptr<SstPartitioner> partitioner = c->CreateSstPartitioner();
+  if (partitioner) {
+    std::string partition_start;
+    for (size_t i = 1; i < all_anchors.size(); i++) {
+      Slice prev_key(all_anchors[i - 1].user_key);
+      Slice key(all_anchors[i].user_key);
+      if (partitioner->ShouldPartition(
+              PartitionerRequest(prev_key, key, 0)) == kRequired &&
+          partitioner->GetPartitionStart(prev_key, key, &partition_start)) {
+        partition_cuts.push_back(
+            {estimate_bytes_before(partition_start), partition_start});
+      }
+    }
+  }
+  const std::vector<FileMetaData*>& grandparents = c->grandparents();
+  for (size_t i = 1; i < grandparents.size(); i++) {
+    Slice key = grandparents[i]->smallest.user_key();
+    file_cuts.push_back({estimate_bytes_before(key), key.ToString()});
+  }
+
+  const uint64_t max_shift = target_range_size / 4;
+  uint64_t prev_bytes_before = 0;
+  // Returns the cut closest to the threshold among those within max_shift
+  // bytes of it and past the previous boundary, or nullptr
+  auto closest_cut = [&](const std::vector<Cut>& cuts,
+                         uint64_t threshold) -> const Cut* {
+    const Cut* best = nullptr;
+    uint64_t best_distance = max_shift + 1;
+    for (const Cut& cut : cuts) {
+      uint64_t distance = cut.bytes_before > threshold
+                              ? cut.bytes_before - threshold
+                              : threshold - cut.bytes_before;
+      if (distance < best_distance && cut.bytes_before > prev_bytes_before &&
+          cut.bytes_before < total_size &&
+          (boundaries_.empty() ||
+           cfd_comparator->CompareWithoutTimestamp(cut.user_key,
+                                                   boundaries_.back()) > 0)) {
+        best = &cut;
+        best_distance = distance;
+      }
+    }
+    return best;
+  };
+
   uint64_t num_actual_subcompactions = 1U;
-  for (TableReader::Anchor& anchor : all_anchors) {
-    cumulative_size += anchor.range_size;
-    if (cumulative_size > next_threshold) {
-      next_threshold += target_range_size;
+  for (uint64_t threshold = target_range_size;
+       threshold < total_size &&
+       num_actual_subcompactions < num_planned_subcompactions;
+       threshold += target_range_size) {
+    const Cut* cut = closest_cut(partition_cuts, threshold);
+    if (cut == nullptr) {
+      cut = closest_cut(file_cuts, threshold);
+    }
+    if (cut != nullptr) {
+      boundaries_.push_back(cut->user_key);
+      prev_bytes_before = cut->bytes_before;
       num_actual_subcompactions++;
-      boundaries_.push_back(anchor.user_key);
+      continue;
     }
-    if (num_actual_subcompactions == num_planned_subcompactions) {
-      break;
+    // The anchor that splits the bytes closest to the threshold. The range
+    // of anchor i - 1 ends with its key, so about bytes_before[i] bytes are
+    // before a boundary at that key.
+    size_t i = std::lower_bound(bytes_before.begin() + 1, bytes_before.end(),
+                                threshold) -
+               bytes_before.begin();
+    if (i > 1 && bytes_before[i - 1] > prev_bytes_before &&
+        threshold - bytes_before[i - 1] < bytes_before[i] - threshold) {
+      i--;
+    }
+    if (bytes_before[i] <= prev_bytes_before ||
+        (!boundaries_.empty() &&
+         cfd_comparator->CompareWithoutTimestamp(all_anchors[i - 1].user_key,
+                                                 boundaries_.back()) <= 0)) {
+      continue;
     }
+    boundaries_.push_back(all_anchors[i - 1].user_key);
+    prev_bytes_before = bytes_before[i];
+    num_actual_subcompactions++;
   }
   TEST_SYNC_POINT_CALLBACK("CompactionJob::GenSubcompactionBoundaries:1",
                            &num_actual_subcompactions);
+  TEST_SYNC_POINT_CALLBACK("CompactionJob::GenSubcompactionBoundaries:2",
+                           &boundaries_);
   // Shrink extra subcompactions resources when extra resrouces are acquired
   ShrinkSubcompactionResources(
       std::min((int)(num_planned_subcompactions - num_actual_subcompactions),
@@ -854,6 +978,21 @@ Status CompactionJob::Run() {
       }
     }
   }
+  if (status.ok()) {
+    const Compaction* c = compact_->compaction;
+    ColumnFamilyData* cfd = c->column_family_data();
+    if (CompressionDictService::IsEnabled(c->output_compression(),
+                                          c->output_compression_opts()) &&
+        cfd->compression_dict_service()->MaybeTrain(
+            c->output_compression_opts(), &new_compression_dict_id_,
+            &new_compression_dict_)) {
+      ROCKS_LOG_INFO(db_options_.info_log,
+                     "[%s] [JOB %d] Trained shared compression dictionary "
+                     "%" PRIu64 " of %" ROCKSDB_PRIszt " bytes",
+                     cfd->GetName().c_str(), job_id_, new_compression_dict_id_,
+                     new_compression_dict_.size());
+    }
+  }
   RecordCompactionIOStats();
   LogFlush(db_options_.info_log);
   TEST_SYNC_POINT("CompactionJob::Run():End");
@@ -989,6 +1128,13 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
   stream << "num_single_delete_fallthrough"
          << compaction_job_stats_->num_single_del_fallthru;
 
+  if (compaction_job_stats_->readahead_bytes > 0) {
+    stream << "readahead_bytes" << compaction_job_stats_->readahead_bytes
+           << "readahead_useful_bytes"
+           << compaction_job_stats_->readahead_useful_bytes
+           << "readahead_stalls" << compaction_job_stats_->readahead_stalls;
+  }
+
   if (measure_io_stats_) {
     stream << "file_write_nanos" << compaction_job_stats_->file_write_nanos;
     stream << "file_range_sync_nanos"
@@ -1135,6 +1281,8 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   ReadOptions read_options;
   read_options.verify_checksums = true;
   read_options.fill_cache = false;
+  read_options.decompression_threads =
+      db_options_.compaction_decompression_threads;
   read_options.rate_limiter_priority = GetRateLimiterPriority();
   read_options.io_activity = Env::IOActivity::kCompaction;
   // Compaction iterators shouldn't be confined to a single prefix.
@@ -1161,6 +1309,12 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     }
   }
 
+  // The input files are read ahead from the first positioning of the input
+  const uint64_t prev_readahead_bytes = IOSTATS(compaction_readahead_bytes);
+  const uint64_t prev_readahead_useful_bytes =
+      IOSTATS(compaction_readahead_useful_bytes);
+  const uint64_t prev_readahead_stalls = IOSTATS(compaction_readahead_stalls);
+
   // Although the v2 aggregator is what the level iterator(s) know about,
   // the AddTombstones calls will be propagated down to the v1 aggregator.
   std::unique_ptr<InternalIterator> raw_input(versions_->MakeInputIterator(
@@ -1307,7 +1461,9 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
           ->DoesInputReferenceBlobFiles() /* must_count_input_entries */,
       sub_compact->compaction, compaction_filter, shutting_down_,
       db_options_.info_log, full_history_ts_low, preserve_time_min_seqno_,
-      preclude_last_level_min_seqno_);
+      preclude_last_level_min_seqno_,
+      key_prefix_retention_cutoffs_.Empty() ? nullptr
+                                            : &key_prefix_retention_cutoffs_);
   c_iter->SeekToFirst();
 
   // Assign range delete aggregator to the target output level, which makes sure
@@ -1458,6 +1614,12 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
 
   sub_compact->compaction_job_stats.cpu_micros =
       db_options_.clock->CPUMicros() - prev_cpu_micros;
+  sub_compact->compaction_job_stats.readahead_bytes +=
+      IOSTATS(compaction_readahead_bytes) - prev_readahead_bytes;
+  sub_compact->compaction_job_stats.readahead_useful_bytes +=
+      IOSTATS(compaction_readahead_useful_bytes) - prev_readahead_useful_bytes;
+  sub_compact->compaction_job_stats.readahead_stalls +=
+      IOSTATS(compaction_readahead_stalls) - prev_readahead_stalls;
 
   if (measure_io_stats_) {
     sub_compact->compaction_job_stats.file_write_nanos +=
@@ -1743,6 +1905,12 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction inputs
   compaction->AddInputDeletions(edit);
 
+  if (new_compression_dict_id_ != 0) {
+    edit->AddCompressionDict(new_compression_dict_id_,
+                             std::move(new_compression_dict_));
+    new_compression_dict_id_ = 0;
+  }
+
   std::unordered_map<uint64_t, BlobGarbageMeter::BlobStats> blob_total_garbage;
 
   for (const auto& sub_compact : compact_->sub_compact_states) {
@@ -1942,16 +2110,34 @@ Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
       db_options_.stats, listeners, db_options_.file_checksum_gen_factory.get(),
       tmp_set.Contains(FileType::kTableFile), false));
 
+  // Adaptive compression may replace the compression type and level of the
+  // compaction by the cheapest one measured for the output level
+  const MutableCFOptions& mutable_cf_options =
+      *(sub_compact->compaction->mutable_cf_options());
+  CompressionType compression_type =
+      sub_compact->compaction->output_compression();
+  CompressionOptions compression_opts =
+      sub_compact->compaction->output_compression_opts();
+  const bool adaptive_compression =
+      !mutable_cf_options.adaptive_compression_candidates.empty() &&
+      cfd->adaptive_compression()->Pick(
+          mutable_cf_options.adaptive_compression_candidates,
+          sub_compact->compaction->output_level(),
+          mutable_cf_options.adaptive_compression_write_cost,
+          &compression_type, &compression_opts);
+
   TableBuilderOptions tboptions(
-      *cfd->ioptions(), *(sub_compact->compaction->mutable_cf_options()),
-      cfd->internal_comparator(), cfd->int_tbl_prop_collector_factories(),
-      sub_compact->compaction->output_compression(),
-      sub_compact->compaction->output_compression_opts(), cfd->GetID(),
-      cfd->GetName(), sub_compact->compaction->output_level(),
-      bottommost_level_, last_level_with_data_,
-      TableFileCreationReason::kCompaction, 0 /* oldest_key_time */,
-      current_time, db_id_, db_session_id_,
+      *cfd->ioptions(), mutable_cf_options, cfd->internal_comparator(),
+      cfd->int_tbl_prop_collector_factories(), compression_type,
+      compression_opts, cfd->GetID(), cfd->GetName(),
+      sub_compact->compaction->output_level(), bottommost_level_,
+      last_level_with_data_, TableFileCreationReason::kCompaction,
+      0 /* oldest_key_time */, current_time, db_id_, db_session_id_,
       sub_compact->compaction->max_output_file_size(), file_number);
+  tboptions.compression_dict_service = cfd->compression_dict_service();
+  if (adaptive_compression) {
+    tboptions.adaptive_compression = cfd->adaptive_compression();
+  }
 
   outputs.NewBuilder(tboptions);
 
@@ -2130,8 +2316,20 @@ Env::IOPriority CompactionJob::GetRateLimiterPriority() {
       versions_->GetColumnFamilySet()->write_controller()) {
     const WriteController* write_controller =
         versions_->GetColumnFamilySet()->write_controller_ptr();
+    if (db_options_.rate_limiter == nullptr ||
+        !db_options_.rate_limiter->SchedulesByDeadline()) {
+      if (write_controller->NeedsDelay() || write_controller->IsStopped()) {
+        return Env::IO_USER;
+      }
+      return Env::IO_LOW;
+    }
+    // The bottommost compactions that do not relieve the write stalls can
+    // wait
     if (write_controller->NeedsDelay() || write_controller->IsStopped()) {
-      return Env::IO_USER;
+      return relieves_write_stalls_ ? Env::IO_USER : Env::IO_MID;
+    }
+    if (write_controller->NeedSpeedupCompaction() && relieves_write_stalls_) {
+      return Env::IO_MID;
     }
   }
 
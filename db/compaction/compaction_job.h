@@ -35,6 +35,7 @@
 #include "db/column_family.h"
 #include "db/compaction/compaction_iterator.h"
 #include "db/compaction/compaction_outputs.h"
+#include "db/compaction/key_prefix_retention.h"
 #include "db/flush_scheduler.h"
 #include "db/internal_stats.h"
 #include "db/job_context.h"
@@ -240,6 +241,9 @@ class CompactionJob {
   bool bottommost_level_;
   // Is this compaction creating a file in the last level with data?
   bool last_level_with_data_ = false;
+  // Does this compaction reduce the data that causes write stalls, i.e. is it
+  // out of L0 or not into the bottommost level?
+  const bool relieves_write_stalls_;
   Env::WriteLifeTimeHint write_hint_;
 
   IOStatus io_status_;
@@ -253,7 +257,10 @@ class CompactionJob {
   // the input. It adds the starting and/or ending keys of certain input files
   // to the working set and then finds the approximate size of data in between
   // each consecutive pair of slices. Then it divides these ranges into
-  // consecutive groups such that each group has a similar size.
+  // consecutive groups such that each group has a similar size. A boundary
+  // is moved to a nearby start of an SstPartitioner partition or of a file of
+  // the level below the output level, so that it does not split an output
+  // file.
   void GenSubcompactionBoundaries();
 
   // Get the number of planned subcompactions based on max_subcompactions and
@@ -348,6 +355,12 @@ class CompactionJob {
   std::string trim_ts_;
   BlobFileCompletionCallback* blob_callback_;
 
+  // Shared compression dictionary trained from the samples collected so far
+  // (see CompressionOptions::use_shared_dict), recorded in the MANIFEST along
+  // with the compaction results. An ID of 0 means none.
+  uint64_t new_compression_dict_id_ = 0;
+  std::string new_compression_dict_;
+
   uint64_t GetCompactionId(SubcompactionState* sub_compact) const;
   // Stores the number of reserved threads in shared env_ for the number of
   // extra subcompaction in kRoundRobin compaction priority
@@ -373,6 +386,10 @@ class CompactionJob {
   // the last level (output to penultimate level).
   SequenceNumber preclude_last_level_min_seqno_ = kMaxSequenceNumber;
 
+  // The sequence numbers below which the keys of each key prefix retention
+  // expired, and are dropped by the compaction.
+  KeyPrefixRetentionCutoffs key_prefix_retention_cutoffs_;
+
   // Get table file name in where it's outputting to, which should also be in
   // `output_directory_`.
   virtual std::string GetTableFileName(uint64_t file_number);
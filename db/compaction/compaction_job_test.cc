@@ -723,6 +723,17 @@ class CompactionJobTestBase : public testing::Test {
     WriteController* write_controller =
         compaction_job.versions_->GetColumnFamilySet()->write_controller_ptr();
 
+    {
+      // When there is compaction pressure, only a rate limiter scheduling by
+      // deadline gets a higher priority for the compactions out of L0
+      std::unique_ptr<WriteControllerToken> pressure_token =
+          write_controller->GetCompactionPressureToken();
+      const bool by_deadline = db_options_.rate_limiter != nullptr &&
+                               db_options_.rate_limiter->SchedulesByDeadline();
+      ASSERT_EQ(compaction_job.GetRateLimiterPriority(),
+                by_deadline ? Env::IO_MID : Env::IO_LOW);
+    }
+
     {
       // When the state from WriteController is Delayed.
       if (write_controller->is_dynamic_delay()) {
@@ -1696,6 +1707,7 @@ TEST_F(CompactionJobTest, ResultSerialization) {
   result.stats.num_output_files = rnd.Uniform(1000);
   result.stats.is_full_compaction = rnd.OneIn(2);
   result.stats.num_single_del_mismatch = rnd64.Uniform(UINT64_MAX);
+  result.stats.readahead_bytes = rnd64.Uniform(UINT64_MAX);
   result.stats.num_input_files = 9;
 
   std::string output;
@@ -2463,6 +2475,19 @@ TEST_F(CompactionJobIOPriorityTest, GetRateLimiterPriority) {
                 Env::IO_LOW, Env::IO_LOW);
 }
 
+TEST_F(CompactionJobIOPriorityTest, GetRateLimiterPriorityByDeadline) {
+  db_options_.rate_limiter.reset(NewDeadlineRateLimiter(100 << 20));
+  NewDB();
+  mock::KVVector expected_results = CreateTwoFiles(false);
+  auto cfd = versions_->GetColumnFamilySet()->GetDefault();
+  constexpr int input_level = 0;
+  auto files = cfd->current()->storage_info()->LevelFiles(input_level);
+  ASSERT_EQ(2U, files.size());
+  RunCompaction({files}, {input_level}, {expected_results}, {},
+                kMaxSequenceNumber, 1, false, {kInvalidBlobFileNumber}, true,
+                Env::IO_LOW, Env::IO_LOW);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -9,12 +9,14 @@
 
 #include "db/compaction/compaction_picker_level.h"
 
+#include <cinttypes>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "db/version_edit.h"
 #include "logging/log_buffer.h"
+#include "logging/logging.h"
 #include "test_util/sync_point.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -36,6 +38,13 @@ bool LevelCompactionPicker::NeedsCompaction(
   if (!vstorage->FilesMarkedForForcedBlobGC().empty()) {
     return true;
   }
+  if (!vstorage->FilesMarkedForRangeTombstoneCompaction().empty()) {
+    return true;
+  }
+  if (!vstorage->ExpiredKeyPrefixRetentionFiles().empty() ||
+      !vstorage->FilesMarkedForKeyPrefixRetention().empty()) {
+    return true;
+  }
   for (int i = 0; i <= vstorage->MaxInputLevel(); i++) {
     if (vstorage->CompactionScore(i) >= 1) {
       return true;
@@ -66,6 +75,11 @@ class LevelCompactionBuilder {
   // Pick and return a compaction.
   Compaction* PickCompaction();
 
+  // Returns a compaction that deletes the files of a level whose keys all
+  // expired according to their key prefix retention, or nullptr if there
+  // is none.
+  Compaction* PickExpiredKeyPrefixRetentionFiles();
+
   // Pick the initial files to compact to the next level. (or together
   // in Intra-L0 compactions)
   void SetupInitialFiles();
@@ -247,6 +261,13 @@ void LevelCompactionBuilder::SetupInitialFiles() {
     return;
   }
 
+  // Files whose range tombstones slow down the reads of the data they cover
+  PickFileToCompact(vstorage_->FilesMarkedForRangeTombstoneCompaction(), true);
+  if (!start_level_inputs_.empty()) {
+    compaction_reason_ = CompactionReason::kRangeTombstones;
+    return;
+  }
+
   // Bottommost Files Compaction on deleting tombstones
   PickFileToCompact(vstorage_->BottommostFilesMarkedForCompaction(), false);
   if (!start_level_inputs_.empty()) {
@@ -293,6 +314,29 @@ void LevelCompactionBuilder::SetupInitialFiles() {
     compaction_reason_ = CompactionReason::kForcedBlobGC;
     return;
   }
+
+  // Files that hold expired keys, rewritten in place without them. The
+  // expired keys that may hide older versions in older files are kept as
+  // tombstones instead, so those files are compacted to the next level,
+  // where the tombstones eventually meet the versions they hide.
+  autovector<std::pair<int, FileMetaData*>> in_place_files;
+  autovector<std::pair<int, FileMetaData*>> next_level_files;
+  for (const auto& level_file : vstorage_->FilesMarkedForKeyPrefixRetention()) {
+    if (vstorage_->OlderFilesMightOverlap(level_file.first,
+                                          level_file.second)) {
+      next_level_files.push_back(level_file);
+    } else {
+      in_place_files.push_back(level_file);
+    }
+  }
+  PickFileToCompact(in_place_files, false);
+  if (start_level_inputs_.empty()) {
+    PickFileToCompact(next_level_files, true);
+  }
+  if (!start_level_inputs_.empty()) {
+    compaction_reason_ = CompactionReason::kKeyPrefixRetention;
+    return;
+  }
 }
 
 bool LevelCompactionBuilder::SetupOtherL0FilesIfNeeded() {
@@ -474,6 +518,14 @@ bool LevelCompactionBuilder::SetupOtherInputsIfNeeded() {
 }
 
 Compaction* LevelCompactionBuilder::PickCompaction() {
+  // Deleting the files whose keys all expired costs no I/O, so it goes first
+  Compaction* deletion = PickExpiredKeyPrefixRetentionFiles();
+  if (deletion != nullptr) {
+    TEST_SYNC_POINT_CALLBACK("LevelCompactionPicker::PickCompaction:Return",
+                             deletion);
+    return deletion;
+  }
+
   // Pick up the first file to start compaction. It may have been extended
   // to a clean cut.
   SetupInitialFiles();
@@ -502,6 +554,45 @@ Compaction* LevelCompactionBuilder::PickCompaction() {
   return c;
 }
 
+Compaction* LevelCompactionBuilder::PickExpiredKeyPrefixRetentionFiles() {
+  CompactionInputFiles inputs;
+  for (const auto& level_file : vstorage_->ExpiredKeyPrefixRetentionFiles()) {
+    assert(!level_file.second->being_compacted);
+    if (!inputs.empty() && level_file.first != inputs.level) {
+      break;
+    }
+    if (level_file.first == 0 &&
+        !compaction_picker_->level0_compactions_in_progress()->empty()) {
+      continue;
+    }
+    inputs.level = level_file.first;
+    inputs.files.push_back(level_file.second);
+  }
+  if (inputs.empty()) {
+    return nullptr;
+  }
+
+  for (const auto* f : inputs.files) {
+    ROCKS_LOG_BUFFER(log_buffer_,
+                     "[%s] Key prefix retention: picking expired file %" PRIu64
+                     " of level %d for deletion",
+                     cf_name_.c_str(), f->fd.GetNumber(), inputs.level);
+  }
+  const int level = inputs.level;
+  auto c = new Compaction(
+      vstorage_, ioptions_, mutable_cf_options_, mutable_db_options_,
+      {std::move(inputs)}, level, /* output file size limit */ 0,
+      /* max compaction bytes */ 0, /* output path ID */ 0, kNoCompression,
+      mutable_cf_options_.compression_opts, Temperature::kUnknown,
+      /* max_subcompactions */ 0, {}, /* is manual */ false,
+      /* trim_ts */ "", vstorage_->CompactionScore(0),
+      /* is deletion compaction */ true, /* l0_files_might_overlap */ true,
+      CompactionReason::kKeyPrefixRetention);
+  compaction_picker_->RegisterCompaction(c);
+  vstorage_->ComputeCompactionScore(ioptions_, mutable_cf_options_);
+  return c;
+}
+
 Compaction* LevelCompactionBuilder::GetCompaction() {
   // TryPickL0TrivialMove() does not apply to the case when compacting L0 to an
   // empty output level. So L0 files is picked in PickFileToCompact() by
@@ -1412,6 +1412,45 @@ TEST_F(CompactionPickerTest, CompactionPriMinOverlapping4) {
   ASSERT_EQ(6U, compaction->input(0, 0)->fd.GetNumber());
 }
 
+TEST_F(CompactionPickerTest, CompactionPriHottestRangeFirst) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  ioptions_.compaction_pri = kHottestRangeFirst;
+  mutable_cf_options_.target_file_size_base = 100000000000;
+  mutable_cf_options_.target_file_size_multiplier = 10;
+  mutable_cf_options_.max_bytes_for_level_base = 10 * 1024 * 1024;
+  mutable_cf_options_.RefreshDerivedOptions(ioptions_);
+
+  Add(2, 6U, "150", "179", 50000000U);
+  Add(2, 7U, "180", "220", 50000000U);
+  Add(2, 8U, "321", "400", 50000000U);  // File not overlapping
+  Add(2, 9U, "721", "800", 50000000U);
+
+  Add(3, 26U, "150", "170", 260000000U);
+  Add(3, 27U, "171", "179", 260000000U);
+  Add(3, 28U, "191", "220", 260000000U);
+  Add(3, 29U, "221", "300", 260000000U);
+  Add(3, 30U, "750", "900", 260000000U);
+
+  Add(4, 40U, "100", "200", 1000U);
+
+  // Reads of file 7 also probe levels 3 and 4, reads of file 9 only level 3
+  file_map_[7U].first->stats.num_reads_sampled = 1000;
+  file_map_[9U].first->stats.num_reads_sampled = 1200;
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(7U, compaction->input(0, 0)->fd.GetNumber());
+  // Files without reads follow, in kMinOverlappingRatio order
+  const std::vector<int>& files_by_pri = vstorage_->FilesByCompactionPri(2);
+  ASSERT_EQ(4U, files_by_pri.size());
+  ASSERT_EQ(9U, vstorage_->LevelFiles(2)[files_by_pri[1]]->fd.GetNumber());
+  ASSERT_EQ(8U, vstorage_->LevelFiles(2)[files_by_pri[2]]->fd.GetNumber());
+}
+
 TEST_F(CompactionPickerTest, CompactionPriRoundRobin) {
   std::vector<InternalKey> test_cursors = {InternalKey("249", 100, kTypeValue),
                                            InternalKey("600", 100, kTypeValue),
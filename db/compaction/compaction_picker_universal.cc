@@ -114,6 +114,14 @@ class UniversalCompactionBuilder {
   // because some files are being compacted.
   Compaction* PickPeriodicCompaction();
 
+  // Used in universal compaction when the fold_non_overlapping_sorted_runs
+  // option is set. Picks the first sequence of consecutive sorted runs, not
+  // being compacted, whose key ranges do not overlap, and forms a trivial
+  // move of all their files to the level of the oldest of them. Returns null
+  // if there is no such sequence of at least two sorted runs that can be
+  // moved.
+  Compaction* PickTrivialMoveToFoldSortedRuns();
+
   // Used in universal compaction when the allow_trivial_move
   // option is set. Checks whether there are any overlapping files
   // in the input. Returns true if the input files are non
@@ -404,6 +412,22 @@ Compaction* UniversalCompactionBuilder::PickCompaction() {
     TEST_SYNC_POINT_CALLBACK("PostPickPeriodicCompaction", c);
   }
 
+  // Folding sorted runs only updates the metadata, so it is preferred to any
+  // merge of them
+  if (c == nullptr &&
+      mutable_cf_options_.compaction_options_universal
+          .fold_non_overlapping_sorted_runs &&
+      sorted_runs_.size() >=
+          static_cast<size_t>(
+              mutable_cf_options_.level0_file_num_compaction_trigger)) {
+    if ((c = PickTrivialMoveToFoldSortedRuns()) != nullptr) {
+      TEST_SYNC_POINT("PickTrivialMoveToFoldSortedRunsReturnNonnullptr");
+      ROCKS_LOG_BUFFER(log_buffer_,
+                       "[%s] Universal: folding non-overlapping sorted runs\n",
+                       cf_name_.c_str());
+    }
+  }
+
   // Check for size amplification.
   if (c == nullptr &&
       sorted_runs_.size() >=
@@ -478,6 +502,7 @@ Compaction* UniversalCompactionBuilder::PickCompaction() {
 
   if (mutable_cf_options_.compaction_options_universal.allow_trivial_move ==
           true &&
+      !c->is_trivial_move() &&
       c->compaction_reason() != CompactionReason::kPeriodicCompaction) {
     c->set_is_trivial_move(IsInputFilesNonOverlapping(c));
   }
@@ -1365,6 +1390,129 @@ Compaction* UniversalCompactionBuilder::PickCompactionWithSortedRunRange(
       /* l0_files_might_overlap */ true, compaction_reason);
 }
 
+Compaction* UniversalCompactionBuilder::PickTrivialMoveToFoldSortedRuns() {
+  const Comparator* ucmp = icmp_->user_comparator();
+  int max_output_level =
+      vstorage_->MaxOutputLevel(ioptions_.allow_ingest_behind);
+
+  // The smallest and largest user keys of each sorted run
+  std::vector<std::pair<Slice, Slice>> key_ranges;
+  key_ranges.reserve(sorted_runs_.size());
+  for (const auto& sr : sorted_runs_) {
+    if (sr.level == 0) {
+      key_ranges.emplace_back(sr.file->smallest.user_key(),
+                              sr.file->largest.user_key());
+    } else {
+      const auto& files = vstorage_->LevelFiles(sr.level);
+      key_ranges.emplace_back(files.front()->smallest.user_key(),
+                              files.back()->largest.user_key());
+    }
+  }
+  auto overlap = [&](size_t i, size_t j) {
+    return ucmp->CompareWithoutTimestamp(key_ranges[i].second,
+                                         key_ranges[j].first) >= 0 &&
+           ucmp->CompareWithoutTimestamp(key_ranges[j].second,
+                                         key_ranges[i].first) >= 0;
+  };
+
+  size_t start_index = 0;
+  while (start_index < sorted_runs_.size()) {
+    if (sorted_runs_[start_index].being_compacted) {
+      start_index++;
+      continue;
+    }
+    // Extend the sequence with the older sorted runs as long as they do not
+    // overlap with any sorted run of the sequence
+    size_t end_index = start_index + 1;
+    for (; end_index < sorted_runs_.size(); end_index++) {
+      if (sorted_runs_[end_index].being_compacted) {
+        break;
+      }
+      bool overlapping = false;
+      for (size_t i = start_index; i < end_index && !overlapping; i++) {
+        overlapping = overlap(i, end_index);
+      }
+      if (overlapping) {
+        break;
+      }
+    }
+    if (end_index - start_index < 2) {
+      start_index = end_index;
+      continue;
+    }
+
+    // The files are moved to the level of the oldest sorted run. The L0
+    // files can only be moved if the oldest one of them is moved too, to the
+    // level above the next older sorted run.
+    const SortedRun& oldest_sr = sorted_runs_[end_index - 1];
+    int output_level;
+    if (oldest_sr.level > 0) {
+      output_level = oldest_sr.level;
+    } else if (end_index == sorted_runs_.size()) {
+      output_level = max_output_level;
+    } else {
+      output_level = sorted_runs_[end_index].level - 1;
+    }
+    if (output_level <= 0) {
+      start_index = end_index;
+      continue;
+    }
+
+    int start_level = sorted_runs_[start_index].level;
+    std::vector<CompactionInputFiles> inputs(output_level - start_level + 1);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      inputs[i].level = start_level + static_cast<int>(i);
+    }
+    uint64_t estimated_total_size = 0;
+    for (size_t i = start_index; i < end_index; i++) {
+      auto& picking_sr = sorted_runs_[i];
+      estimated_total_size += picking_sr.size;
+      if (picking_sr.level == 0) {
+        inputs[0].files.push_back(picking_sr.file);
+      } else {
+        auto& files = inputs[picking_sr.level - start_level].files;
+        for (auto* f : vstorage_->LevelFiles(picking_sr.level)) {
+          files.push_back(f);
+        }
+      }
+      char file_num_buf[256];
+      picking_sr.DumpSizeInfo(file_num_buf, sizeof(file_num_buf), i);
+      ROCKS_LOG_BUFFER(log_buffer_, "[%s] Universal: folding %s",
+                       cf_name_.c_str(), file_num_buf);
+    }
+
+    if (picker_->FilesRangeOverlapWithCompaction(
+            inputs, output_level,
+            Compaction::EvaluatePenultimateLevel(vstorage_, ioptions_,
+                                                 start_level, output_level))) {
+      start_index = end_index;
+      continue;
+    }
+
+    uint32_t path_id =
+        GetPathId(ioptions_, mutable_cf_options_, estimated_total_size);
+    Compaction* c = new Compaction(
+        vstorage_, ioptions_, mutable_cf_options_, mutable_db_options_,
+        std::move(inputs), output_level,
+        MaxFileSizeForLevel(mutable_cf_options_, output_level,
+                            kCompactionStyleUniversal),
+        GetMaxOverlappingBytes(), path_id,
+        GetCompressionType(vstorage_, mutable_cf_options_, output_level, 1,
+                           true /* enable_compression */),
+        GetCompressionOptions(mutable_cf_options_, vstorage_, output_level,
+                              true /* enable_compression */),
+        Temperature::kUnknown,
+        /* max_subcompactions */ 0, /* grandparents */ {},
+        /* is manual */ false, /* trim_ts */ "", score_,
+        false /* deletion_compaction */,
+        /* l0_files_might_overlap */ false,
+        CompactionReason::kUniversalSortedRunNum);
+    c->set_is_trivial_move(true);
+    return c;
+  }
+  return nullptr;
+}
+
 Compaction* UniversalCompactionBuilder::PickPeriodicCompaction() {
   ROCKS_LOG_BUFFER(log_buffer_, "[%s] Universal: Periodic Compaction",
                    cf_name_.c_str());
@@ -640,6 +640,18 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct CompactionJobStats, num_single_del_mismatch),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"readahead_bytes",
+         {offsetof(struct CompactionJobStats, readahead_bytes),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"readahead_useful_bytes",
+         {offsetof(struct CompactionJobStats, readahead_useful_bytes),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"readahead_stalls",
+         {offsetof(struct CompactionJobStats, readahead_stalls),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
 };
 
 namespace {
@@ -18,8 +18,13 @@
 //  (found in the LICENSE.Apache file in the root directory).
 
 
+#ifndef OS_WIN
+#include <unistd.h>
+#endif  // OS_WIN
+
 #include "db/db_test_util.h"
 #include "port/stack_trace.h"
+#include "rocksdb/utilities/local_compaction_service.h"
 #include "table/unique_id_impl.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -964,10 +969,124 @@ TEST_F(CompactionServiceTest, TablePropertiesCollector) {
   ASSERT_TRUE(has_user_property);
 }
 
+#ifndef OS_WIN
+// The path of this test binary, which runs as a local compaction service
+// worker when started with kLocalCompactionWorkerFdArg (see main())
+std::string local_compaction_worker_path;
+// Makes such a worker die as it receives its first compaction
+const char* kCrashBeforeCompactionArg = "--crash_before_compaction";
+
+TEST_F(CompactionServiceTest, LocalCompactionServiceRequiresWorkerCommand) {
+  LocalCompactionServiceOptions service_options;
+  std::shared_ptr<CompactionService> service;
+  ASSERT_TRUE(
+      NewLocalCompactionService(service_options, &service).IsInvalidArgument());
+  ASSERT_EQ(service, nullptr);
+}
+
+TEST_F(CompactionServiceTest, LocalCompactionService) {
+  LocalCompactionServiceOptions service_options;
+  service_options.num_workers = 2;
+  service_options.worker_command = {local_compaction_worker_path};
+  std::shared_ptr<CompactionService> service;
+  ASSERT_OK(NewLocalCompactionService(service_options, &service));
+
+  Options options = CurrentOptions();
+  options.env = env_;
+  options.statistics = CreateDBStatistics();
+  options.compaction_service = service;
+  DestroyAndReopen(options);
+
+  GenerateTestData();
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  VerifyTestData();
+
+  // The compaction ran in a worker
+  ASSERT_GT(options.statistics->getTickerCount(REMOTE_COMPACT_WRITE_BYTES), 0);
+  ASSERT_EQ(options.statistics->getTickerCount(COMPACT_WRITE_BYTES), 0);
+
+  Reopen(options);
+  VerifyTestData();
+  Close();
+
+  // The outputs were moved into the DB
+  service.reset();
+  options.compaction_service.reset();
+  last_options_.compaction_service.reset();
+  std::vector<std::string> children;
+  ASSERT_OK(env_->GetChildren(dbname_ + "/local_compaction", &children));
+  ASSERT_TRUE(children.empty());
+}
+
+TEST_F(CompactionServiceTest, LocalCompactionServiceWorkerCrash) {
+  // The worker dies as it receives its compaction, and so does the one
+  // started in its place
+  LocalCompactionServiceOptions service_options;
+  service_options.num_workers = 1;
+  service_options.worker_command = {local_compaction_worker_path,
+                                    kCrashBeforeCompactionArg};
+  std::shared_ptr<CompactionService> service;
+  ASSERT_OK(NewLocalCompactionService(service_options, &service));
+
+  Options options = CurrentOptions();
+  options.env = env_;
+  options.statistics = CreateDBStatistics();
+  options.compaction_service = service;
+  DestroyAndReopen(options);
+
+  GenerateTestData();
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  VerifyTestData();
+
+  // The compactions ran in the DB process instead
+  ASSERT_EQ(options.statistics->getTickerCount(REMOTE_COMPACT_WRITE_BYTES), 0);
+  ASSERT_GT(options.statistics->getTickerCount(COMPACT_WRITE_BYTES), 0);
+
+  // No partial output was left behind
+  std::vector<std::string> children;
+  ASSERT_OK(env_->GetChildren(dbname_ + "/local_compaction", &children));
+  ASSERT_TRUE(children.empty());
+
+  Reopen(options);
+  VerifyTestData();
+  Close();
+  service.reset();
+  options.compaction_service.reset();
+  last_options_.compaction_service.reset();
+}
+#endif  // OS_WIN
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
   ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+#ifndef OS_WIN
+  // Started as a worker by the local compaction service tests
+  ROCKSDB_NAMESPACE::local_compaction_worker_path = argv[0];
+  int worker_fd = -1;
+  bool crash_before_compaction = false;
+  for (int i = 1; i < argc; ++i) {
+    ROCKSDB_NAMESPACE::Slice arg(argv[i]);
+    if (arg.starts_with(ROCKSDB_NAMESPACE::kLocalCompactionWorkerFdArg)) {
+      arg.remove_prefix(strlen(ROCKSDB_NAMESPACE::kLocalCompactionWorkerFdArg));
+      worker_fd = std::stoi(arg.ToString());
+    } else if (arg == ROCKSDB_NAMESPACE::kCrashBeforeCompactionArg) {
+      crash_before_compaction = true;
+    }
+  }
+  if (worker_fd >= 0) {
+    if (crash_before_compaction) {
+      ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+          "RunLocalCompactionServiceWorker:BeforeCompaction",
+          [](void* /*arg*/) { _exit(1); });
+      ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+    }
+    ROCKSDB_NAMESPACE::Status s =
+        ROCKSDB_NAMESPACE::RunLocalCompactionServiceWorker(
+            worker_fd, ROCKSDB_NAMESPACE::CompactionServiceOptionsOverride());
+    return s.ok() ? 0 : 1;
+  }
+#endif  // OS_WIN
   ::testing::InitGoogleTest(&argc, argv);
   RegisterCustomObjects(argc, argv);
   return RUN_ALL_TESTS();
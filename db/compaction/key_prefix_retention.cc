@@ -0,0 +1,135 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/compaction/key_prefix_retention.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "db/seqno_to_time_mapping.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+int FindKeyPrefixRetention(const std::vector<KeyPrefixRetention>& retentions,
+                           const Slice& user_key) {
+  int index = -1;
+  for (size_t i = 0; i < retentions.size(); ++i) {
+    const std::string& prefix = retentions[i].prefix;
+    if (user_key.starts_with(prefix) &&
+        (index < 0 || prefix.size() > retentions[index].prefix.size())) {
+      index = static_cast<int>(i);
+    }
+  }
+  return index;
+}
+
+bool FindKeyRangePrefixRetention(
+    const std::vector<KeyPrefixRetention>& retentions, const Slice& first_key,
+    const Slice& last_key, int* index) {
+  *index = FindKeyPrefixRetention(retentions, first_key);
+  if (FindKeyPrefixRetention(retentions, last_key) != *index) {
+    return false;
+  }
+  // Both keys have the longest prefix of the keys between them, which may
+  // still hold keys with another (longer) prefix. The keys with a prefix are
+  // contiguous in the bytewise order, and start with the prefix itself.
+  const Slice& low = first_key.compare(last_key) < 0 ? first_key : last_key;
+  const Slice& high = first_key.compare(last_key) < 0 ? last_key : first_key;
+  for (size_t i = 0; i < retentions.size(); ++i) {
+    const Slice prefix(retentions[i].prefix);
+    if (static_cast<int>(i) != *index && low.compare(prefix) < 0 &&
+        prefix.compare(high) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t MaxKeyPrefixRetentionSeconds(
+    const std::vector<KeyPrefixRetention>& retentions) {
+  uint64_t max_retention = 0;
+  for (const auto& retention : retentions) {
+    max_retention = std::max(max_retention, retention.retention_seconds);
+  }
+  return max_retention;
+}
+
+void KeyPrefixRetentionCutoffs::Update(
+    const std::vector<KeyPrefixRetention>& retentions,
+    SeqnoToTimeMapping& seqno_time_mapping, uint64_t now) {
+  retentions_ = &retentions;
+  cutoffs_.resize(retentions.size());
+  max_cutoff_ = 0;
+  for (size_t i = 0; i < retentions.size(); ++i) {
+    const uint64_t retention = retentions[i].retention_seconds;
+    // The keys with a smaller sequence number than the last one sampled
+    // before the retention period were written before it
+    cutoffs_[i] = now > retention
+                      ? seqno_time_mapping.GetOldestSequenceNum(now - retention)
+                      : 0;
+    max_cutoff_ = std::max(max_cutoff_, cutoffs_[i]);
+  }
+}
+
+void KeyPrefixRetentionCutoffs::Merge(const KeyPrefixRetentionCutoffs& other) {
+  if (other.Empty()) {
+    return;
+  }
+  if (Empty()) {
+    *this = other;
+    return;
+  }
+  assert(cutoffs_.size() == other.cutoffs_.size());
+  for (size_t i = 0; i < cutoffs_.size(); ++i) {
+    cutoffs_[i] = std::max(cutoffs_[i], other.cutoffs_[i]);
+    max_cutoff_ = std::max(max_cutoff_, cutoffs_[i]);
+  }
+}
+
+PartitionerResult KeyPrefixRetentionPartitioner::ShouldPartition(
+    const PartitionerRequest& request) {
+  if (FindKeyPrefixRetention(retentions_, *request.prev_user_key) !=
+      FindKeyPrefixRetention(retentions_, *request.current_user_key)) {
+    return kRequired;
+  }
+  return partitioner_ ? partitioner_->ShouldPartition(request) : kNotRequired;
+}
+
+bool KeyPrefixRetentionPartitioner::CanDoTrivialMove(
+    const Slice& smallest_user_key, const Slice& largest_user_key) {
+  int index;
+  if (!FindKeyRangePrefixRetention(retentions_, smallest_user_key,
+                                   largest_user_key, &index)) {
+    return false;
+  }
+  return !partitioner_ ||
+         partitioner_->CanDoTrivialMove(smallest_user_key, largest_user_key);
+}
+
+bool KeyPrefixRetentionPartitioner::GetPartitionStart(
+    const Slice& prev_user_key, const Slice& current_user_key,
+    std::string* partition_start) {
+  // The start of the keys of a retention is only known for the keys that
+  // follow its prefix directly, so only the partitions of the configured
+  // partitioner get a hint
+  if (!partitioner_ || FindKeyPrefixRetention(retentions_, prev_user_key) !=
+                           FindKeyPrefixRetention(retentions_,
+                                                  current_user_key)) {
+    return false;
+  }
+  return partitioner_->GetPartitionStart(prev_user_key, current_user_key,
+                                         partition_start);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
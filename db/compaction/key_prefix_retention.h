@@ -0,0 +1,113 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Helpers of the `key_prefix_retentions` option: matching the keys with
+// their retention, the sequence numbers below which they expired, and the
+// partitioning of the compaction outputs by retention.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/advanced_options.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/sst_partitioner.h"
+#include "rocksdb/types.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class SeqnoToTimeMapping;
+
+// Returns the index in `retentions` of the longest prefix of `user_key`, or
+// -1 if the key has no retention.
+extern int FindKeyPrefixRetention(
+    const std::vector<KeyPrefixRetention>& retentions, const Slice& user_key);
+
+// Sets `index` to the retention of all the keys between two user keys, in
+// either order, as FindKeyPrefixRetention(). Returns false if these keys may
+// have different retentions.
+extern bool FindKeyRangePrefixRetention(
+    const std::vector<KeyPrefixRetention>& retentions, const Slice& first_key,
+    const Slice& last_key, int* index);
+
+// Returns the longest retention period, or 0 if there is none.
+extern uint64_t MaxKeyPrefixRetentionSeconds(
+    const std::vector<KeyPrefixRetention>& retentions);
+
+// The sequence numbers below which the keys of each retention expired.
+class KeyPrefixRetentionCutoffs {
+ public:
+  // Computes the cutoffs at time `now` from the mapping of the sequence
+  // numbers to their time. The retentions must outlive this object.
+  void Update(const std::vector<KeyPrefixRetention>& retentions,
+              SeqnoToTimeMapping& seqno_time_mapping, uint64_t now);
+
+  // Raises the cutoffs to those of `other`, computed for the same
+  // retentions.
+  void Merge(const KeyPrefixRetentionCutoffs& other);
+
+  // Returns true if no key expired.
+  bool Empty() const { return max_cutoff_ == 0; }
+
+  // Returns the cutoff of the retention with this index, 0 for -1.
+  SequenceNumber GetCutoff(int index) const {
+    return index < 0 || static_cast<size_t>(index) >= cutoffs_.size()
+               ? 0
+               : cutoffs_[index];
+  }
+
+  // Returns true if the key with this user key and sequence number expired.
+  // Keys without a sequence number, like the keys of ingested files, are not
+  // known to be old and are kept.
+  bool IsExpired(const Slice& user_key, SequenceNumber seqno) const {
+    if (seqno == 0 || seqno >= max_cutoff_) {
+      return false;
+    }
+    return seqno < GetCutoff(FindKeyPrefixRetention(*retentions_, user_key));
+  }
+
+ private:
+  const std::vector<KeyPrefixRetention>* retentions_ = nullptr;
+  std::vector<SequenceNumber> cutoffs_;
+  SequenceNumber max_cutoff_ = 0;
+};
+
+// Partitions the compaction outputs where the retention of the keys changes,
+// in addition to the partitions of the configured partitioner (if any).
+class KeyPrefixRetentionPartitioner : public SstPartitioner {
+ public:
+  KeyPrefixRetentionPartitioner(
+      const std::vector<KeyPrefixRetention>& retentions,
+      std::unique_ptr<SstPartitioner>&& partitioner)
+      : retentions_(retentions), partitioner_(std::move(partitioner)) {}
+
+  const char* Name() const override { return "KeyPrefixRetentionPartitioner"; }
+
+  PartitionerResult ShouldPartition(const PartitionerRequest& request) override;
+
+  bool CanDoTrivialMove(const Slice& smallest_user_key,
+                        const Slice& largest_user_key) override;
+
+  bool GetPartitionStart(const Slice& prev_user_key,
+                         const Slice& current_user_key,
+                         std::string* partition_start) override;
+
+ private:
+  const std::vector<KeyPrefixRetention>& retentions_;
+  std::unique_ptr<SstPartitioner> partitioner_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
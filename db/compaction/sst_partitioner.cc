@@ -45,6 +45,16 @@ bool SstPartitionerFixedPrefix::CanDoTrivialMove(
                                             0)) == kNotRequired;
 }
 
+bool SstPartitionerFixedPrefix::GetPartitionStart(
+    const Slice& /*prev_user_key*/, const Slice& current_user_key,
+    std::string* partition_start) {
+  // The partition holds the keys with the prefix of current_user_key, the
+  // prefix itself being the smallest of them
+  partition_start->assign(current_user_key.data(),
+                          std::min(current_user_key.size(), len_));
+  return true;
+}
+
 std::unique_ptr<SstPartitioner>
 SstPartitionerFixedPrefixFactory::CreatePartitioner(
     const SstPartitioner::Context& /* context */) const {
@@ -0,0 +1,207 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/compression_dict_service.h"
+
+#include <algorithm>
+
+#include "util/compression.h"
+#include "util/hash.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+CompressionDictService::~CompressionDictService() = default;
+
+bool CompressionDictService::IsEnabled(CompressionType type,
+                                       const CompressionOptions& opts) {
+  return opts.use_shared_dict && opts.max_dict_bytes > 0 &&
+         (type == kZSTD || type == kZSTDNotFinalCompression) &&
+         ZSTD_Supported();
+}
+
+size_t CompressionDictService::SampleBudget(const CompressionOptions& opts) {
+  // Same semantics as for per-file dictionaries: without a trainer, the raw
+  // samples are the dictionary
+  return opts.zstd_max_train_bytes > 0 ? opts.zstd_max_train_bytes
+                                       : opts.max_dict_bytes;
+}
+
+void CompressionDictService::AddDict(uint64_t id, const Slice& dict) {
+  assert(id != 0);
+  MutexLock l(&mutex_);
+  auto it = dicts_.find(id);
+  if (it == dicts_.end()) {
+    dicts_[id].dict = dict.ToString();
+    dict_order_.push_back(id);
+  }
+  if (current_id_ != id) {
+    current_id_ = id;
+    window_raw_bytes_ = 0;
+    window_compressed_bytes_ = 0;
+    best_ratio_ = 0;
+  }
+  samples_.clear();
+  sample_lens_.clear();
+  wants_samples_.store(false, std::memory_order_relaxed);
+}
+
+std::vector<std::pair<uint64_t, std::string>> CompressionDictService::GetDicts()
+    const {
+  MutexLock l(&mutex_);
+  std::vector<std::pair<uint64_t, std::string>> result;
+  result.reserve(dict_order_.size());
+  for (uint64_t id : dict_order_) {
+    result.emplace_back(id, dicts_.at(id).dict);
+  }
+  return result;
+}
+
+void CompressionDictService::RemoveUnreferencedDicts(
+    const std::unordered_set<uint64_t>& referenced) {
+  MutexLock l(&mutex_);
+  auto keep = [&](uint64_t id) {
+    return id == current_id_ || referenced.count(id) > 0;
+  };
+  for (uint64_t id : dict_order_) {
+    if (!keep(id)) {
+      dicts_.erase(id);
+    }
+  }
+  dict_order_.erase(
+      std::remove_if(dict_order_.begin(), dict_order_.end(),
+                     [&](uint64_t id) { return !keep(id); }),
+      dict_order_.end());
+}
+
+std::shared_ptr<const CompressionDict>
+CompressionDictService::GetCurrentCompressionDict(CompressionType type,
+                                                  int level, uint64_t* id) {
+  assert(id != nullptr);
+  MutexLock l(&mutex_);
+  if (current_id_ == 0) {
+    return nullptr;
+  }
+  DictEntry& entry = dicts_.at(current_id_);
+  if (entry.compression_dict == nullptr || entry.compression_type != type ||
+      entry.compression_level != level) {
+    entry.compression_dict =
+        std::make_shared<const CompressionDict>(entry.dict, type, level);
+    entry.compression_type = type;
+    entry.compression_level = level;
+  }
+  *id = current_id_;
+  return entry.compression_dict;
+}
+
+std::shared_ptr<UncompressionDict> CompressionDictService::GetUncompressionDict(
+    uint64_t id) {
+  MutexLock l(&mutex_);
+  auto it = dicts_.find(id);
+  if (it == dicts_.end()) {
+    return nullptr;
+  }
+  DictEntry& entry = it->second;
+  if (entry.uncompression_dict == nullptr) {
+    entry.uncompression_dict =
+        std::make_shared<UncompressionDict>(entry.dict, true /* using_zstd */);
+  }
+  return entry.uncompression_dict;
+}
+
+void CompressionDictService::AddSample(const Slice& block,
+                                       const CompressionOptions& opts) {
+  if (!wants_samples_.load(std::memory_order_relaxed) ||
+      blocks_offered_.fetch_add(1, std::memory_order_relaxed) %
+              kSampleOneInBlocks !=
+          0) {
+    return;
+  }
+  const size_t budget = SampleBudget(opts);
+  MutexLock l(&mutex_);
+  if (samples_.size() >= budget) {
+    return;
+  }
+  const size_t len = std::min(block.size(), budget - samples_.size());
+  samples_.append(block.data(), len);
+  sample_lens_.push_back(len);
+}
+
+void CompressionDictService::RecordCompression(uint64_t id, uint64_t raw_bytes,
+                                               uint64_t compressed_bytes,
+                                               const CompressionOptions& opts) {
+  MutexLock l(&mutex_);
+  if (id == 0 || id != current_id_) {
+    return;
+  }
+  window_raw_bytes_ += raw_bytes;
+  window_compressed_bytes_ += compressed_bytes;
+  if (window_raw_bytes_ < kRatioWindowFactor * SampleBudget(opts) ||
+      window_compressed_bytes_ == 0) {
+    return;
+  }
+  const double ratio = static_cast<double>(window_raw_bytes_) /
+                       static_cast<double>(window_compressed_bytes_);
+  window_raw_bytes_ = 0;
+  window_compressed_bytes_ = 0;
+  if (ratio > best_ratio_) {
+    best_ratio_ = ratio;
+  } else if (ratio < best_ratio_ * (1 - kMaxRatioDrift)) {
+    wants_samples_.store(true, std::memory_order_relaxed);
+  }
+}
+
+bool CompressionDictService::MaybeTrain(const CompressionOptions& opts,
+                                        uint64_t* id, std::string* dict) {
+  assert(id != nullptr);
+  assert(dict != nullptr);
+  std::string samples;
+  std::vector<size_t> sample_lens;
+  {
+    MutexLock l(&mutex_);
+    if (!wants_samples_.load(std::memory_order_relaxed) ||
+        samples_.size() < SampleBudget(opts)) {
+      return false;
+    }
+    samples.swap(samples_);
+    sample_lens.swap(sample_lens_);
+  }
+
+  // Training can take a while, so it is done outside the lock
+  std::string trained;
+  if (opts.zstd_max_train_bytes == 0) {
+    trained = std::move(samples);
+  } else if (opts.use_zstd_dict_trainer) {
+    if (ZSTD_TrainDictionarySupported()) {
+      trained =
+          ZSTD_TrainDictionary(samples, sample_lens, opts.max_dict_bytes);
+    }
+  } else if (ZSTD_FinalizeDictionarySupported()) {
+    trained = ZSTD_FinalizeDictionary(samples, sample_lens,
+                                      opts.max_dict_bytes, opts.level);
+  }
+  if (trained.empty()) {
+    // Samples are dropped and sampling continues with fresh data
+    return false;
+  }
+
+  *id = Hash64(trained.data(), trained.size());
+  if (*id == 0) {
+    *id = 1;
+  }
+  *dict = std::move(trained);
+  return true;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
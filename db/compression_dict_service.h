@@ -0,0 +1,142 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/advanced_options.h"
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class CompressionDict;
+struct UncompressionDict;
+
+// Owns the shared compression dictionaries of a column family
+// (CompressionOptions::use_shared_dict).
+//
+// Instead of training a dictionary per SST file and storing it in the file,
+// table builders sample the data blocks they write into the service, and a
+// compaction trains a dictionary from the samples once enough were collected.
+// The dictionary is recorded in the MANIFEST (VersionEdit::AddCompressionDict)
+// before any file uses it, and is identified by an ID that files compressed
+// with it store in their table properties.
+// Readers of those files share a single digested dictionary per ID.
+//
+// The service also tracks the compression ratio achieved with the current
+// dictionary. When it drops noticeably below the best ratio observed since
+// the dictionary was installed, the data has drifted away from what the
+// dictionary was trained on, and the service starts sampling again so that
+// the next compaction retrains it.
+//
+// Files compressed with a shared dictionary also keep a copy of it, so
+// readers without access to the service (e.g. RepairDB or SstFileReader) can
+// still read them. Dictionaries that no live file refers to are dropped when
+// a new MANIFEST is written. All methods are thread-safe.
+class CompressionDictService {
+ public:
+  CompressionDictService() = default;
+  ~CompressionDictService();
+
+  // No copying allowed
+  CompressionDictService(const CompressionDictService&) = delete;
+  CompressionDictService& operator=(const CompressionDictService&) = delete;
+
+  // Whether shared dictionaries are in use for the given options
+  static bool IsEnabled(CompressionType type, const CompressionOptions& opts);
+
+  // Registers a dictionary recovered from or written to the MANIFEST. The most
+  // recently added dictionary becomes the one used for new files. Adding an
+  // already known ID only makes it current again.
+  void AddDict(uint64_t id, const Slice& dict);
+
+  // Returns all known dictionaries, in the order they were added
+  std::vector<std::pair<uint64_t, std::string>> GetDicts() const;
+
+  // Drops the dictionaries that are neither in `referenced` nor current.
+  // Readers of files that were compressed with a dropped dictionary fall back
+  // to the copy in the file.
+  void RemoveUnreferencedDicts(const std::unordered_set<uint64_t>& referenced);
+
+  // Returns the dictionary new files should be compressed with, digested for
+  // the given compression type and level, or nullptr if there is none yet.
+  // `*id` is set to its ID.
+  std::shared_ptr<const CompressionDict> GetCurrentCompressionDict(
+      CompressionType type, int level, uint64_t* id);
+
+  // Returns the digested dictionary for decompressing blocks of files that
+  // reference `id`, or nullptr if the ID is unknown
+  std::shared_ptr<UncompressionDict> GetUncompressionDict(uint64_t id);
+
+  // Offers an uncompressed data block as a training sample. Only a fraction of
+  // the blocks is kept, and only while the service wants to (re)train.
+  void AddSample(const Slice& block, const CompressionOptions& opts);
+
+  // Reports the data block bytes a finished table compressed with dictionary
+  // `id`, before and after compression
+  void RecordCompression(uint64_t id, uint64_t raw_bytes,
+                         uint64_t compressed_bytes,
+                         const CompressionOptions& opts);
+
+  // Trains a new dictionary if enough samples were collected. Returns true and
+  // sets `*id` and `*dict` on success; the caller is responsible for recording
+  // the dictionary in the MANIFEST, which in turn calls AddDict().
+  bool MaybeTrain(const CompressionOptions& opts, uint64_t* id,
+                  std::string* dict);
+
+ private:
+  // One in that many data blocks is kept as a sample
+  static constexpr uint64_t kSampleOneInBlocks = 4;
+  // The ratio is evaluated over windows of that many times the sample budget
+  static constexpr uint64_t kRatioWindowFactor = 16;
+  // Retrain when the ratio of a window falls that much below the best one
+  static constexpr double kMaxRatioDrift = 0.1;
+
+  struct DictEntry {
+    std::string dict;
+    std::shared_ptr<UncompressionDict> uncompression_dict;
+    std::shared_ptr<const CompressionDict> compression_dict;
+    CompressionType compression_type = kNoCompression;
+    int compression_level = 0;
+  };
+
+  static size_t SampleBudget(const CompressionOptions& opts);
+
+  mutable port::Mutex mutex_;
+  std::unordered_map<uint64_t, DictEntry> dicts_;
+  std::vector<uint64_t> dict_order_;
+  uint64_t current_id_ = 0;
+
+  // Sampling starts when there is no dictionary yet and after a drift
+  std::atomic<bool> wants_samples_{true};
+  std::atomic<uint64_t> blocks_offered_{0};
+  std::string samples_;
+  std::vector<size_t> sample_lens_;
+
+  // Compression ratio tracking for the current dictionary
+  uint64_t window_raw_bytes_ = 0;
+  uint64_t window_compressed_bytes_ = 0;
+  double best_ratio_ = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -54,11 +54,11 @@ Status VerifySstFileChecksum(const Options& options,
                                        file_path, largest_seqno);
 }
 
-Status VerifySstFileChecksumInternal(const Options& options,
-                                     const EnvOptions& env_options,
-                                     const ReadOptions& read_options,
-                                     const std::string& file_path,
-                                     const SequenceNumber& largest_seqno) {
+Status VerifySstFileChecksumInternal(
+    const Options& options, const EnvOptions& env_options,
+    const ReadOptions& read_options, const std::string& file_path,
+    const SequenceNumber& largest_seqno,
+    CompressionDictService* compression_dict_service) {
   std::unique_ptr<FSRandomAccessFile> file;
   uint64_t file_size;
   InternalKeyComparator internal_comparator(options.comparator);
@@ -84,6 +84,7 @@ Status VerifySstFileChecksumInternal(const Options& options,
       options.block_protection_bytes_per_key, false /* skip_filters */,
       !kImmortal, false /* force_direct_prefetch */, -1 /* level */);
   reader_options.largest_seqno = largest_seqno;
+  reader_options.compression_dict_service = compression_dict_service;
   s = ioptions.table_factory->NewTableReader(
       read_options, reader_options, std::move(file_reader), file_size,
       &table_reader, false /* prefetch_index_and_filter_in_cache */);
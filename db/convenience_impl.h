@@ -7,9 +7,13 @@
 #include "rocksdb/db.h"
 
 namespace ROCKSDB_NAMESPACE {
-Status VerifySstFileChecksumInternal(const Options& options,
-                                     const EnvOptions& env_options,
-                                     const ReadOptions& read_options,
-                                     const std::string& file_path,
-                                     const SequenceNumber& largest_seqno = 0);
+class CompressionDictService;
+
+// compression_dict_service provides the shared dictionaries of the column
+// family the file belongs to, if it was written with use_shared_dict
+Status VerifySstFileChecksumInternal(
+    const Options& options, const EnvOptions& env_options,
+    const ReadOptions& read_options, const std::string& file_path,
+    const SequenceNumber& largest_seqno = 0,
+    CompressionDictService* compression_dict_service = nullptr);
 }  // namespace ROCKSDB_NAMESPACE
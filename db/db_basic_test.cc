@@ -1079,6 +1079,220 @@ TEST_F(DBBasicTest, MultiGetEmpty) {
   } while (ChangeCompactOptions());
 }
 
+TEST_F(DBBasicTest, MultiGetAsync) {
+  Options options = CurrentOptions();
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(8 << 20);
+  table_options.block_size = 256;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  for (int i = 0; i < 200; ++i) {
+    ASSERT_OK(Put(Key(i), "val" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put(Key(1), "new_val1"));
+  ASSERT_OK(Delete(Key(2)));
+  // Start with a cold block cache
+  Reopen(options);
+  ASSERT_OK(Put(Key(3), "new_val3"));
+
+  std::atomic<int> reads{0};
+  SyncPoint::GetInstance()->SetCallBack(
+      "MultiGetAsyncLookup::IssueRead", [&](void* /*arg*/) { ++reads; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  std::unique_ptr<MultiGetAsyncQueue> queue = NewMultiGetAsyncQueue();
+  constexpr int kNumBatches = 20;
+  std::vector<std::vector<std::string>> results(kNumBatches);
+  int num_callbacks = 0;
+  for (int b = 0; b < kNumBatches; ++b) {
+    std::vector<std::string> key_strs{Key(b * 10), Key(b * 10 + 1),
+                                      Key(b * 10 + 2), Key(b * 10 + 3),
+                                      "no_key"};
+    std::vector<Slice> keys(key_strs.begin(), key_strs.end());
+    ASSERT_OK(db_->MultiGetAsync(
+        ReadOptions(), db_->DefaultColumnFamily(), keys,
+        [&, b](std::vector<Status>&& statuses,
+               std::vector<PinnableSlice>&& values) {
+          ++num_callbacks;
+          ASSERT_EQ(statuses.size(), 5U);
+          for (size_t i = 0; i < statuses.size(); ++i) {
+            if (statuses[i].IsNotFound()) {
+              results[b].push_back("NOT_FOUND");
+            } else {
+              ASSERT_OK(statuses[i]);
+              results[b].push_back(values[i].ToString());
+            }
+          }
+        },
+        queue.get()));
+  }
+  // Callbacks only run from Poll()
+  ASSERT_EQ(num_callbacks, 0);
+  ASSERT_EQ(queue->NumInFlight(), static_cast<size_t>(kNumBatches));
+  ASSERT_GT(reads.load(), 0);
+
+  // Writes after MultiGetAsync() are not visible to the lookups
+  ASSERT_OK(Put(Key(10), "too_late"));
+  ASSERT_GE(queue->Poll(1), 1);
+  while (queue->NumInFlight() > 0) {
+    queue->Poll(queue->NumInFlight());
+  }
+  ASSERT_EQ(num_callbacks, kNumBatches);
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  for (int b = 0; b < kNumBatches; ++b) {
+    ASSERT_EQ(results[b].size(), 5U);
+    for (int i = 0; i < 4; ++i) {
+      const int k = b * 10 + i;
+      if (k == 1) {
+        ASSERT_EQ(results[b][i], "new_val1");
+      } else if (k == 2) {
+        ASSERT_EQ(results[b][i], "NOT_FOUND");
+      } else if (k == 3) {
+        ASSERT_EQ(results[b][i], "new_val3");
+      } else {
+        ASSERT_EQ(results[b][i], "val" + std::to_string(k));
+      }
+    }
+    ASSERT_EQ(results[b][4], "NOT_FOUND");
+  }
+
+  // Without filling the block cache, the keys are looked up synchronously
+  ReadOptions no_fill;
+  no_fill.fill_cache = false;
+  std::vector<Slice> keys{Key(50), Key(51)};
+  std::vector<std::string> values;
+  ASSERT_OK(db_->MultiGetAsync(
+      no_fill, nullptr, keys,
+      [&](std::vector<Status>&& statuses,
+          std::vector<PinnableSlice>&& pinned) {
+        for (size_t i = 0; i < statuses.size(); ++i) {
+          ASSERT_OK(statuses[i]);
+          values.push_back(pinned[i].ToString());
+        }
+      },
+      queue.get()));
+  // Destroying the queue completes the lookups in flight
+  queue.reset();
+  ASSERT_EQ(values, std::vector<std::string>({"val50", "val51"}));
+}
+
+TEST_F(DBBasicTest, MultiGetBlockCacheTier) {
+  Options options = CurrentOptions();
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(8 << 20);
+  table_options.block_size = 256;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Put(Key(i), "val" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put(Key(100), "val100"));
+
+  ReadOptions ro;
+  ro.read_tier = kBlockCacheTier;
+  std::vector<std::string> key_strs{Key(10), Key(50), Key(100)};
+  std::vector<Slice> keys(key_strs.begin(), key_strs.end());
+  std::vector<PinnableSlice> values(keys.size());
+  std::vector<Status> statuses(keys.size());
+
+  // The data blocks are not in the block cache, and are not read
+  db_->MultiGet(ro, db_->DefaultColumnFamily(), keys.size(), keys.data(),
+                values.data(), statuses.data());
+  ASSERT_TRUE(statuses[0].IsIncomplete());
+  ASSERT_TRUE(statuses[1].IsIncomplete());
+  ASSERT_OK(statuses[2]);
+  ASSERT_EQ(values[2], "val100");
+
+  // Once the blocks are cached, the keys are found without I/O
+  ASSERT_EQ(Get(Key(10)), "val10");
+  ASSERT_EQ(Get(Key(50)), "val50");
+  for (auto& value : values) {
+    value.Reset();
+  }
+  db_->MultiGet(ro, db_->DefaultColumnFamily(), keys.size(), keys.data(),
+                values.data(), statuses.data());
+  ASSERT_OK(statuses[0]);
+  ASSERT_EQ(values[0], "val10");
+  ASSERT_OK(statuses[1]);
+  ASSERT_EQ(values[1], "val50");
+  ASSERT_OK(statuses[2]);
+  ASSERT_EQ(values[2], "val100");
+}
+
+TEST_F(DBBasicTest, MultiGetSingleRoundIO) {
+  Options options = CurrentOptions();
+  options.statistics = CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(8 << 20);
+  table_options.block_size = 256;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // Keys in three levels, with newer versions of some of them above
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Put(Key(i), "L2_" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+  for (int i = 0; i < 100; i += 2) {
+    ASSERT_OK(Put(Key(i), "L1_" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+  for (int i = 0; i < 100; i += 4) {
+    ASSERT_OK(Put(Key(i), "L0_" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+  // Start with a cold block cache
+  Reopen(options);
+
+  size_t num_reads = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "MultiGetIOPlanner::Execute:NumReads",
+      [&](void* arg) { num_reads = *static_cast<size_t*>(arg); });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  std::vector<std::string> key_strs;
+  for (int i = 20; i < 40; ++i) {
+    key_strs.push_back(Key(i));
+  }
+  std::vector<Slice> keys(key_strs.begin(), key_strs.end());
+  std::vector<PinnableSlice> values(keys.size());
+  std::vector<Status> statuses(keys.size());
+  ReadOptions ro;
+  ro.multiget_single_round_io = true;
+  SetPerfLevel(kEnableCount);
+  get_perf_context()->Reset();
+  db_->MultiGet(ro, db_->DefaultColumnFamily(), keys.size(), keys.data(),
+                values.data(), statuses.data());
+  // All blocks were read ahead, so the lookups did not read any
+  ASSERT_EQ(get_perf_context()->block_read_count, 0);
+  SetPerfLevel(kDisable);
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  const uint64_t num_blocks =
+      options.statistics->getTickerCount(MULTIGET_SINGLE_ROUND_IO_BLOCKS);
+  ASSERT_GT(num_blocks, 0);
+  // Adjacent blocks are merged
+  ASSERT_GT(num_reads, 0);
+  ASSERT_LT(num_reads, num_blocks);
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_OK(statuses[i]);
+    const int k = 20 + static_cast<int>(i);
+    const std::string level = k % 4 == 0 ? "L0_" : k % 2 == 0 ? "L1_" : "L2_";
+    ASSERT_EQ(values[i].ToString(), level + std::to_string(k));
+  }
+}
+
 class DBBlockChecksumTest : public DBBasicTest,
                             public testing::WithParamInterface<uint32_t> {};
 
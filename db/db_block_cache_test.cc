@@ -729,6 +729,7 @@ class MockCache : public LRUCache {
  public:
   static uint32_t high_pri_insert_count;
   static uint32_t low_pri_insert_count;
+  static uint32_t bottom_pri_insert_count;
 
   MockCache()
       : LRUCache(LRUCacheOptions(
@@ -750,6 +751,8 @@ class MockCache : public LRUCache {
                            Priority priority) override {
     if (priority == Priority::LOW) {
       low_pri_insert_count++;
+    } else if (priority == Priority::BOTTOM) {
+      bottom_pri_insert_count++;
     } else {
       high_pri_insert_count++;
     }
@@ -760,6 +763,7 @@ class MockCache : public LRUCache {
 
 uint32_t MockCache::high_pri_insert_count = 0;
 uint32_t MockCache::low_pri_insert_count = 0;
+uint32_t MockCache::bottom_pri_insert_count = 0;
 
 }  // anonymous namespace
 
@@ -820,6 +824,154 @@ TEST_F(DBBlockCacheTest, IndexAndFilterBlocksCachePriority) {
   }
 }
 
+TEST_F(DBBlockCacheTest, LongScanCachePriority) {
+  for (uint64_t threshold : {uint64_t{0}, uint64_t{4}}) {
+    Options options = CurrentOptions();
+    options.create_if_missing = true;
+    options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+    options.compression = kNoCompression;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 100;
+    table_options.block_cache.reset(new MockCache());
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    DestroyAndReopen(options);
+
+    Random rnd(301);
+    for (int i = 0; i < 20; i++) {
+      ASSERT_OK(Put(Key(i), rnd.RandomString(100)));
+    }
+    ASSERT_OK(Flush());
+    ASSERT_EQ(1, NumTableFilesAtLevel(0));
+
+    MockCache::high_pri_insert_count = 0;
+    MockCache::low_pri_insert_count = 0;
+    MockCache::bottom_pri_insert_count = 0;
+    ASSERT_OK(options.statistics->Reset());
+
+    ReadOptions read_options;
+    read_options.scan_probation_threshold = threshold;
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    int keys = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      keys++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(20, keys);
+
+    uint64_t data_adds = TestGetTickerCount(options, BLOCK_CACHE_DATA_ADD);
+    ASSERT_GT(data_adds, 4);
+    ASSERT_EQ(0u, MockCache::high_pri_insert_count);
+    if (threshold == 0) {
+      ASSERT_EQ(data_adds, MockCache::low_pri_insert_count);
+      ASSERT_EQ(0u, MockCache::bottom_pri_insert_count);
+    } else {
+      // Only the first blocks of the scan get the normal priority
+      ASSERT_EQ(threshold, MockCache::low_pri_insert_count);
+      ASSERT_EQ(data_adds - threshold, MockCache::bottom_pri_insert_count);
+    }
+  }
+}
+
+TEST_F(DBBlockCacheTest, HotBlocksWarmUp) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.compression = kNoCompression;
+  // Only persisted on demand in this test
+  options.hot_blocks_persist_period_sec = 24 * 60 * 60;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 100;
+  table_options.block_cache = NewLRUCache(1 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  for (int i = 0; i < 20; i++) {
+    ASSERT_OK(Put(Key(i), rnd.RandomString(100)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ(1, NumTableFilesAtLevel(0));
+
+  // Make the first five data blocks hot. Hits are sampled, so read them often
+  // enough for all of them to be counted.
+  for (int round = 0; round < 200; round++) {
+    for (int i = 0; i < 5; i++) {
+      ASSERT_NE("NOT_FOUND", Get(Key(i)));
+    }
+  }
+  ASSERT_OK(dbfull()->TEST_PersistHotBlocks());
+  ASSERT_OK(env_->FileExists(HotBlocksFileName(dbname_)));
+
+  // Restart with an empty block cache
+  table_options.block_cache = NewLRUCache(1 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_OK(dbfull()->TEST_WaitForHotBlocksWarmUp());
+
+  ASSERT_OK(options.statistics->Reset());
+  for (int i = 0; i < 5; i++) {
+    ASSERT_NE("NOT_FOUND", Get(Key(i)));
+  }
+  ASSERT_EQ(0, TestGetTickerCount(options, BLOCK_CACHE_DATA_MISS));
+  ASSERT_EQ(5, TestGetTickerCount(options, BLOCK_CACHE_DATA_HIT));
+
+  // Cold blocks were not read back
+  ASSERT_NE("NOT_FOUND", Get(Key(10)));
+  ASSERT_EQ(1, TestGetTickerCount(options, BLOCK_CACHE_DATA_MISS));
+
+  // Without the option, the list is ignored
+  table_options.block_cache = NewLRUCache(1 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options.hot_blocks_persist_period_sec = 0;
+  Reopen(options);
+  ASSERT_OK(dbfull()->TEST_WaitForHotBlocksWarmUp());
+  ASSERT_OK(options.statistics->Reset());
+  ASSERT_NE("NOT_FOUND", Get(Key(0)));
+  ASSERT_EQ(1, TestGetTickerCount(options, BLOCK_CACHE_DATA_MISS));
+}
+
+TEST_F(DBBlockCacheTest, HotBlocksAgeOut) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.compression = kNoCompression;
+  // Only persisted on demand in this test
+  options.hot_blocks_persist_period_sec = 24 * 60 * 60;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 100;
+  table_options.block_cache = NewLRUCache(1 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  for (int i = 0; i < 20; i++) {
+    ASSERT_OK(Put(Key(i), rnd.RandomString(100)));
+  }
+  ASSERT_OK(Flush());
+  for (int round = 0; round < 200; round++) {
+    ASSERT_NE("NOT_FOUND", Get(Key(0)));
+  }
+
+  // The hits are halved on each persist, so a block that is no longer read
+  // drops out of the list
+  for (int i = 0; i < 16; i++) {
+    ASSERT_OK(dbfull()->TEST_PersistHotBlocks());
+  }
+
+  // A temp file left by a crash while persisting is purged on open
+  ASSERT_OK(WriteStringToFile(env_, "garbage", HotBlocksTempFileName(dbname_)));
+  table_options.block_cache = NewLRUCache(1 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_OK(dbfull()->TEST_WaitForHotBlocksWarmUp());
+  ASSERT_TRUE(env_->FileExists(HotBlocksTempFileName(dbname_)).IsNotFound());
+  ASSERT_OK(env_->FileExists(HotBlocksFileName(dbname_)));
+
+  ASSERT_OK(options.statistics->Reset());
+  ASSERT_NE("NOT_FOUND", Get(Key(0)));
+  ASSERT_EQ(1, TestGetTickerCount(options, BLOCK_CACHE_DATA_MISS));
+}
+
 namespace {
 
 // An LRUCache wrapper that can falsely report "not found" on Lookup.
@@ -3193,6 +3193,156 @@ TEST_F(DBBloomFilterTest, DynamicBloomFilterOptions) {
   }
 }
 
+namespace {
+std::shared_ptr<const FilterPolicy> CreateSpeedbRangeFilter(int suffix_bytes) {
+  ConfigOptions config_options;
+  config_options.ignore_unsupported_options = false;
+  std::shared_ptr<const FilterPolicy> filter_policy;
+  EXPECT_OK(FilterPolicy::CreateFromString(
+      config_options, "speedb.RangeFilter:" + std::to_string(suffix_bytes),
+      &filter_policy));
+  EXPECT_NE(filter_policy, nullptr);
+  return filter_policy;
+}
+}  // anonymous namespace
+
+TEST_F(DBBloomFilterTest, SpeedbRangeFilterNoFalseNegatives) {
+  Random rnd(301);
+  for (int suffix_bytes : {0, 1, 4}) {
+    auto policy = CreateSpeedbRangeFilter(suffix_bytes);
+    ASSERT_TRUE(policy->SupportsRangeQueries());
+
+    BlockBasedTableOptions table_options;
+    FilterBuildingContext context(table_options);
+    std::unique_ptr<FilterBitsBuilder> builder(
+        policy->GetBuilderWithContext(context));
+    ASSERT_NE(builder, nullptr);
+
+    // Keys over a small alphabet so that prefixes are shared a lot
+    std::set<std::string> keys;
+    while (keys.size() < 1000) {
+      std::string key;
+      const int len = 1 + rnd.Uniform(8);
+      for (int i = 0; i < len; ++i) {
+        key.push_back(static_cast<char>('a' + rnd.Uniform(4)));
+      }
+      keys.insert(key);
+    }
+    for (const auto& key : keys) {
+      builder->AddKey(key);
+    }
+    std::unique_ptr<const char[]> buf;
+    Slice filter = builder->Finish(&buf);
+    std::unique_ptr<FilterBitsReader> reader(
+        policy->GetFilterBitsReader(filter));
+
+    for (const auto& key : keys) {
+      ASSERT_TRUE(reader->MayMatch(key));
+      ASSERT_TRUE(reader->RangeMayMatch(key, key + '\0'));
+    }
+
+    int empty_ranges = 0;
+    int filtered_ranges = 0;
+    for (int i = 0; i < 10000; ++i) {
+      std::string lower;
+      std::string upper;
+      for (int j = 1 + rnd.Uniform(8); j > 0; --j) {
+        lower.push_back(static_cast<char>('a' + rnd.Uniform(5)));
+      }
+      for (int j = 1 + rnd.Uniform(8); j > 0; --j) {
+        upper.push_back(static_cast<char>('a' + rnd.Uniform(5)));
+      }
+      if (lower > upper) {
+        std::swap(lower, upper);
+      }
+      auto it = keys.lower_bound(lower);
+      const bool any_key = it != keys.end() && *it < upper;
+      const bool may_match = reader->RangeMayMatch(lower, upper);
+      if (any_key) {
+        ASSERT_TRUE(may_match) << "[" << lower << ", " << upper << ")";
+      } else {
+        ++empty_ranges;
+        filtered_ranges += may_match ? 0 : 1;
+      }
+      if (keys.count(lower) > 0) {
+        ASSERT_TRUE(reader->MayMatch(lower));
+      }
+    }
+    // Some of the empty ranges must be ruled out
+    ASSERT_GT(empty_ranges, 0);
+    ASSERT_GT(filtered_ranges, 0);
+  }
+}
+
+TEST_F(DBBloomFilterTest, SpeedbRangeFilterSeekWithUpperBound) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.filter_policy = CreateSpeedbRangeFilter(1);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // Keys "k000", "k002", ... "k198" leave a gap between every two keys
+  for (int i = 0; i < 200; i += 2) {
+    char key[8];
+    snprintf(key, sizeof(key), "k%03d", i);
+    ASSERT_OK(Put(key, "v"));
+  }
+  ASSERT_OK(Put("z", "v"));
+  ASSERT_OK(Flush());
+
+  ReadOptions read_options;
+  Slice upper_bound;
+  read_options.iterate_upper_bound = &upper_bound;
+
+  // Empty range: filtered without reading any data block
+  upper_bound = "k0015";
+  get_perf_context()->Reset();
+  SetPerfLevel(kEnableCount);
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->Seek("k001");
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+  }
+  EXPECT_EQ(get_perf_context()->block_read_count, 0);
+  EXPECT_EQ(PopTicker(options, NON_LAST_LEVEL_SEEK_FILTERED), 1);
+
+  // Non-empty range
+  upper_bound = "k010";
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    ASSERT_EQ(CountIter(iter, "k001"), 4);
+  }
+  EXPECT_EQ(PopTicker(options, NON_LAST_LEVEL_SEEK_FILTERED), 0);
+
+  // Range past the end of the bounded keys still finds nothing
+  upper_bound = "y";
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->Seek("k199");
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+  }
+  EXPECT_EQ(PopTicker(options, NON_LAST_LEVEL_SEEK_FILTERED), 1);
+
+  // Without an upper bound the range filter is not consulted
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    iter->Seek("k199");
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), "z");
+  }
+  EXPECT_EQ(PopTicker(options, NON_LAST_LEVEL_SEEK_FILTERED), 0);
+
+  // Point lookups use the same filter
+  ASSERT_EQ(Get("k100"), "v");
+  ASSERT_EQ(Get("k101"), "NOT_FOUND");
+  SetPerfLevel(kDisable);
+}
+
 TEST_P(DBBloomFilterTestWithPairedBloomOnOff,
        SeekForPrevWithPartitionedFilters) {
   Options options = CurrentOptions();
@@ -1027,6 +1027,143 @@ TEST_P(DBCompactionTestWithMCC, CompactRangeBottomPri) {
   SyncPoint::GetInstance()->DisableProcessing();
 }
 
+TEST_F(DBCompactionTest, NonBlockingCompactRangeQueue) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.max_non_blocking_compact_range_jobs = 1;
+  options.statistics = CreateDBStatistics();
+  Reopen(options);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Put(Key(i), "v"));
+    if (i % 10 == 9) {
+      ASSERT_OK(Flush());
+    }
+  }
+
+  std::mutex order_mutex;
+  std::vector<std::string> order;
+  std::atomic<uint64_t> num_times_cb_called{0};
+  auto NonBlockingCompactRange = [&](const std::string& name, int begin,
+                                     int end, int priority) {
+    auto cb = std::make_shared<CompactRangeCompleteCb>(
+        [&order_mutex, &order, name](Status completion_status) {
+          std::lock_guard<std::mutex> lock(order_mutex);
+          order.push_back(name + ":" + completion_status.ToString());
+        },
+        &num_times_cb_called);
+    CompactRangeOptions cro;
+    cro.async_completion_cb = cb;
+    cro.async_priority = priority;
+    std::string begin_key = Key(begin);
+    std::string end_key = Key(end);
+    Slice begin_slice(begin_key);
+    Slice end_slice(end_key);
+    EXPECT_OK(db_->CompactRange(cro, &begin_slice, &end_slice));
+    return cb;
+  };
+
+  // Keep the only worker thread busy while the other requests are queued
+  SyncPoint::GetInstance()->LoadDependency(
+      {{"CompactRangeJobQueue::RunJob:Start",
+        "DBCompactionTest::NonBlockingCompactRangeQueue:Running"},
+       {"DBCompactionTest::NonBlockingCompactRangeQueue:Queued",
+        "CompactRangeJobQueue::RunJob:Run"}});
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  auto a = NonBlockingCompactRange("a", 0, 9, 0);
+  TEST_SYNC_POINT("DBCompactionTest::NonBlockingCompactRangeQueue:Running");
+  auto b = NonBlockingCompactRange("b", 10, 29, 0);
+  // Overlaps b, and is coalesced into it
+  auto c = NonBlockingCompactRange("c", 20, 49, 0);
+  auto d = NonBlockingCompactRange("d", 80, 89, 1);
+  auto e = NonBlockingCompactRange("e", 60, 69, 0);
+  e->Cancel();
+  ASSERT_EQ(1,
+            options.statistics->getTickerCount(COMPACT_RANGE_JOBS_COALESCED));
+  TEST_SYNC_POINT("DBCompactionTest::NonBlockingCompactRangeQueue:Queued");
+
+  for (const auto& cb : {a, b, c, d, e}) {
+    auto future = static_cast<CompactRangeCompleteCb*>(cb.get())->GetFuture();
+    ASSERT_EQ(std::future_status::ready,
+              future.wait_for(std::chrono::seconds(10)));
+  }
+  SyncPoint::GetInstance()->DisableProcessing();
+
+  // e was dropped before d, which was picked before b and c for its priority
+  const std::string paused =
+      Status::Incomplete(Status::SubCode::kManualCompactionPaused).ToString();
+  ASSERT_EQ(std::vector<std::string>(
+                {"a:OK", "e:" + paused, "d:OK", "b:OK", "c:OK"}),
+            order);
+  ASSERT_EQ(5U, num_times_cb_called.load());
+
+  // One job for a, d and the coalesced b and c
+  HistogramData wait;
+  options.statistics->histogramData(COMPACT_RANGE_QUEUE_WAIT_MICROS, &wait);
+  ASSERT_EQ(3U, wait.count);
+  HistogramData depth;
+  options.statistics->histogramData(COMPACT_RANGE_QUEUE_DEPTH, &depth);
+  ASSERT_EQ(5U, depth.count);
+  ASSERT_EQ(2.0, depth.max);
+}
+
+TEST_F(DBCompactionTest, NonBlockingCompactRangeDroppedColumnFamily) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.max_non_blocking_compact_range_jobs = 1;
+  CreateAndReopenWithCF({"pikachu"}, options);
+  for (int cf = 0; cf < 2; ++cf) {
+    for (int i = 0; i < 20; ++i) {
+      ASSERT_OK(Put(cf, Key(i), "v"));
+      if (i % 10 == 9) {
+        ASSERT_OK(Flush(cf));
+      }
+    }
+  }
+
+  std::atomic<uint64_t> num_times_cb_called{0};
+  auto NonBlockingCompactRange = [&](int cf, Status* status) {
+    auto cb = std::make_shared<CompactRangeCompleteCb>(
+        [status](Status completion_status) { *status = completion_status; },
+        &num_times_cb_called);
+    CompactRangeOptions cro;
+    cro.async_completion_cb = cb;
+    EXPECT_OK(db_->CompactRange(cro, handles_[cf], nullptr, nullptr));
+    return cb;
+  };
+
+  // The job of the dropped column family is queued behind a running one
+  SyncPoint::GetInstance()->LoadDependency(
+      {{"CompactRangeJobQueue::RunJob:Start",
+        "DBCompactionTest::NonBlockingCompactRangeDroppedColumnFamily:Running"},
+       {"DBCompactionTest::NonBlockingCompactRangeDroppedColumnFamily:Dropped",
+        "CompactRangeJobQueue::RunJob:Run"}});
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  Status s0;
+  Status s1;
+  auto a = NonBlockingCompactRange(0, &s0);
+  TEST_SYNC_POINT(
+      "DBCompactionTest::NonBlockingCompactRangeDroppedColumnFamily:Running");
+  auto b = NonBlockingCompactRange(1, &s1);
+  // The queued job keeps the column family alive once its handle is gone
+  ASSERT_OK(db_->DropColumnFamily(handles_[1]));
+  ASSERT_OK(db_->DestroyColumnFamilyHandle(handles_[1]));
+  handles_.resize(1);
+  TEST_SYNC_POINT(
+      "DBCompactionTest::NonBlockingCompactRangeDroppedColumnFamily:Dropped");
+
+  for (const auto& cb : {a, b}) {
+    auto future = static_cast<CompactRangeCompleteCb*>(cb.get())->GetFuture();
+    ASSERT_EQ(std::future_status::ready,
+              future.wait_for(std::chrono::seconds(10)));
+  }
+  SyncPoint::GetInstance()->DisableProcessing();
+  ASSERT_OK(s0);
+  ASSERT_TRUE(s1.ok() || s1.IsColumnFamilyDropped()) << s1.ToString();
+  ASSERT_EQ(2U, num_times_cb_called.load());
+}
+
 TEST_F(DBCompactionTest, DisableStatsUpdateReopen) {
   uint64_t db_size[3];
   for (int test = 0; test < 2; ++test) {
@@ -1477,6 +1614,53 @@ TEST_F(DBCompactionTest, CompactionSstPartitionerNonTrivial) {
   ASSERT_EQ("B", Get("bbbb1"));
 }
 
+TEST_F(DBCompactionTest, SubcompactionBoundariesAlignedWithPartitions) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.max_subcompactions = 4;
+  options.target_file_size_base = 64 << 10;
+  options.sst_partitioner_factory = NewSstPartitionerFixedPrefixFactory(3);
+  DestroyAndReopen(options);
+
+  // Overlapping L0 files covering 10 partitions of the same size
+  Random rnd(301);
+  for (int f = 0; f < 4; f++) {
+    for (int p = 0; p < 10; p++) {
+      for (int k = 0; k < 200; k++) {
+        char key[16];
+        snprintf(key, sizeof(key), "p%02d_%04d", p, k);
+        ASSERT_OK(Put(key, rnd.RandomString(100)));
+      }
+    }
+    ASSERT_OK(Flush());
+  }
+
+  std::vector<std::string> boundaries;
+  SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::GenSubcompactionBoundaries:2", [&](void* arg) {
+        boundaries = *static_cast<std::vector<std::string>*>(arg);
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // Every subcompaction starts a partition, so no output file is split
+  ASSERT_EQ(boundaries.size(), 3);
+  for (const auto& boundary : boundaries) {
+    ASSERT_EQ(boundary.size(), 3);
+  }
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(files.size(), 10);
+  std::set<std::string> partitions;
+  for (const auto& file : files) {
+    ASSERT_EQ(file.smallestkey.substr(0, 3), file.largestkey.substr(0, 3));
+    partitions.insert(file.smallestkey.substr(0, 3));
+  }
+  ASSERT_EQ(partitions.size(), 10);
+}
+
 TEST_F(DBCompactionTest, ZeroSeqIdCompaction) {
   Options options = CurrentOptions();
   options.compaction_style = kCompactionStyleLevel;
@@ -0,0 +1,272 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/db_impl/compact_range_job_queue.h"
+
+#include <algorithm>
+
+#include "db/column_family.h"
+#include "monitoring/instrumented_mutex.h"
+#include "monitoring/statistics_impl.h"
+#include "rocksdb/system_clock.h"
+#include "test_util/sync_point.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+CompactRangeJobQueue::CompactRangeJobQueue(RunFunc run, int max_jobs,
+                                           InstrumentedMutex* db_mutex,
+                                           SystemClock* clock,
+                                           Statistics* stats)
+    : run_(std::move(run)),
+      max_threads_(static_cast<size_t>(std::max(max_jobs, 1))),
+      db_mutex_(db_mutex),
+      clock_(clock),
+      stats_(stats),
+      cv_(&mutex_) {}
+
+CompactRangeJobQueue::~CompactRangeJobQueue() { Shutdown(); }
+
+void CompactRangeJobQueue::Enqueue(const CompactRangeOptions& options,
+                                   ColumnFamilyData* cfd, const Slice* begin,
+                                   const Slice* end,
+                                   const std::string& trim_ts) {
+  assert(options.async_completion_cb);
+  std::unique_ptr<Job> job(new Job);
+  job->options = options;
+  job->options.async_completion_cb.reset();
+  job->cfd = cfd;
+  cfd->Ref();
+  if (begin != nullptr) {
+    job->has_begin = true;
+    job->begin.assign(begin->data(), begin->size());
+  }
+  if (end != nullptr) {
+    job->has_end = true;
+    job->end.assign(end->data(), end->size());
+  }
+  job->trim_ts = trim_ts;
+  job->cbs.push_back(options.async_completion_cb);
+  job->priority = options.async_priority;
+  job->enqueue_micros = clock_->NowMicros();
+
+  std::vector<CbPtr> canceled;
+  std::vector<ColumnFamilyData*> unref_cfds;
+  bool shutting_down;
+  {
+    MutexLock l(&mutex_);
+    shutting_down = shutting_down_;
+    if (!shutting_down) {
+      RemoveCanceled(&canceled, &unref_cfds);
+      RecordInHistogram(stats_, COMPACT_RANGE_QUEUE_DEPTH, queue_.size());
+      bool coalesced = false;
+      for (auto& queued : queue_) {
+        if (Coalesce(queued.get(), *job)) {
+          RecordTick(stats_, COMPACT_RANGE_JOBS_COALESCED);
+          coalesced = true;
+          break;
+        }
+      }
+      if (coalesced) {
+        unref_cfds.push_back(cfd);
+      } else {
+        job->seqno = next_seqno_++;
+        queue_.push_back(std::move(job));
+        if (num_idle_threads_ == 0 && threads_.size() < max_threads_) {
+          threads_.emplace_back(&CompactRangeJobQueue::WorkerThread, this);
+        } else {
+          cv_.Signal();
+        }
+      }
+    } else {
+      unref_cfds.push_back(cfd);
+    }
+  }
+  UnrefCfds(unref_cfds);
+  for (const auto& cb : canceled) {
+    cb->InternalCompletedCb(
+        Status::Incomplete(Status::SubCode::kManualCompactionPaused));
+  }
+  if (shutting_down) {
+    options.async_completion_cb->InternalCompletedCb(
+        Status::ShutdownInProgress());
+  }
+}
+
+void CompactRangeJobQueue::Shutdown() {
+  std::list<std::unique_ptr<Job>> queued;
+  std::vector<port::Thread> threads;
+  {
+    MutexLock l(&mutex_);
+    shutting_down_ = true;
+    queued.swap(queue_);
+    threads.swap(threads_);
+    cv_.SignalAll();
+  }
+  std::vector<ColumnFamilyData*> unref_cfds;
+  for (const auto& job : queued) {
+    unref_cfds.push_back(job->cfd);
+  }
+  UnrefCfds(unref_cfds);
+  for (const auto& job : queued) {
+    for (const auto& cb : job->cbs) {
+      cb->InternalCompletedCb(Status::ShutdownInProgress());
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+bool CompactRangeJobQueue::Coalesce(Job* queued, const Job& job) {
+  mutex_.AssertHeld();
+  const CompactRangeOptions& a = queued->options;
+  const CompactRangeOptions& b = job.options;
+  // Jobs canceled through a flag of their own are kept apart, as are jobs
+  // that change the history of the column family
+  if (queued->cfd != job.cfd || queued->trim_ts != job.trim_ts ||
+      a.canceled != nullptr || b.canceled != nullptr ||
+      a.full_history_ts_low != nullptr || b.full_history_ts_low != nullptr ||
+      a.exclusive_manual_compaction != b.exclusive_manual_compaction ||
+      a.change_level != b.change_level || a.target_level != b.target_level ||
+      a.target_path_id != b.target_path_id ||
+      a.bottommost_level_compaction != b.bottommost_level_compaction ||
+      a.allow_write_stall != b.allow_write_stall ||
+      a.max_subcompactions != b.max_subcompactions ||
+      a.blob_garbage_collection_policy != b.blob_garbage_collection_policy ||
+      a.blob_garbage_collection_age_cutoff !=
+          b.blob_garbage_collection_age_cutoff) {
+    return false;
+  }
+
+  // Both ranges are inclusive
+  const Comparator* ucmp = job.cfd->user_comparator();
+  if ((queued->has_end && job.has_begin &&
+       ucmp->Compare(queued->end, job.begin) < 0) ||
+      (job.has_end && queued->has_begin &&
+       ucmp->Compare(job.end, queued->begin) < 0)) {
+    return false;
+  }
+  if (!job.has_begin) {
+    queued->has_begin = false;
+    queued->begin.clear();
+  } else if (queued->has_begin && ucmp->Compare(job.begin, queued->begin) < 0) {
+    queued->begin = job.begin;
+  }
+  if (!job.has_end) {
+    queued->has_end = false;
+    queued->end.clear();
+  } else if (queued->has_end && ucmp->Compare(job.end, queued->end) > 0) {
+    queued->end = job.end;
+  }
+  queued->cbs.insert(queued->cbs.end(), job.cbs.begin(), job.cbs.end());
+  queued->priority = std::max(queued->priority, job.priority);
+  return true;
+}
+
+void CompactRangeJobQueue::RemoveCanceled(
+    std::vector<CbPtr>* canceled, std::vector<ColumnFamilyData*>* unref_cfds) {
+  mutex_.AssertHeld();
+  for (auto it = queue_.begin(); it != queue_.end();) {
+    auto& cbs = (*it)->cbs;
+    for (auto cb_it = cbs.begin(); cb_it != cbs.end();) {
+      if ((*cb_it)->IsCanceled()) {
+        canceled->push_back(std::move(*cb_it));
+        cb_it = cbs.erase(cb_it);
+      } else {
+        ++cb_it;
+      }
+    }
+    if (cbs.empty()) {
+      unref_cfds->push_back((*it)->cfd);
+      it = queue_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void CompactRangeJobQueue::UnrefCfds(
+    const std::vector<ColumnFamilyData*>& cfds) {
+  if (cfds.empty()) {
+    return;
+  }
+  InstrumentedMutexLock l(db_mutex_);
+  for (auto* cfd : cfds) {
+    cfd->UnrefAndTryDelete();
+  }
+}
+
+void CompactRangeJobQueue::WorkerThread() {
+  mutex_.Lock();
+  while (true) {
+    std::vector<CbPtr> canceled;
+    std::vector<ColumnFamilyData*> unref_cfds;
+    RemoveCanceled(&canceled, &unref_cfds);
+    if (!canceled.empty()) {
+      mutex_.Unlock();
+      UnrefCfds(unref_cfds);
+      for (const auto& cb : canceled) {
+        cb->InternalCompletedCb(
+            Status::Incomplete(Status::SubCode::kManualCompactionPaused));
+      }
+      mutex_.Lock();
+      continue;
+    }
+    if (queue_.empty()) {
+      if (shutting_down_) {
+        break;
+      }
+      ++num_idle_threads_;
+      cv_.Wait();
+      --num_idle_threads_;
+      continue;
+    }
+    auto next = std::min_element(
+        queue_.begin(), queue_.end(),
+        [](const std::unique_ptr<Job>& a, const std::unique_ptr<Job>& b) {
+          return a->priority != b->priority ? a->priority > b->priority
+                                            : a->seqno < b->seqno;
+        });
+    std::unique_ptr<Job> job = std::move(*next);
+    queue_.erase(next);
+    mutex_.Unlock();
+    RunJob(job.get());
+    UnrefCfds({job->cfd});
+    mutex_.Lock();
+  }
+  mutex_.Unlock();
+}
+
+void CompactRangeJobQueue::RunJob(Job* job) {
+  TEST_SYNC_POINT("CompactRangeJobQueue::RunJob:Start");
+  TEST_SYNC_POINT("CompactRangeJobQueue::RunJob:Run");
+  const uint64_t now = clock_->NowMicros();
+  RecordInHistogram(stats_, COMPACT_RANGE_QUEUE_WAIT_MICROS,
+                    now > job->enqueue_micros ? now - job->enqueue_micros : 0);
+
+  CompactRangeOptions options = job->options;
+  if (options.canceled == nullptr && job->cbs.size() == 1) {
+    // A compaction serving a single request is canceled with it
+    options.canceled = &job->cbs.front()->canceled_;
+  }
+  Slice begin(job->begin);
+  Slice end(job->end);
+  Status s = run_(options, job->cfd, job->has_begin ? &begin : nullptr,
+                  job->has_end ? &end : nullptr, job->trim_ts);
+  for (const auto& cb : job->cbs) {
+    cb->InternalCompletedCb(s);
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
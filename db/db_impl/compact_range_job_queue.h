@@ -0,0 +1,119 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Runs the non-blocking CompactRange() requests of a DB (those with
+// CompactRangeOptions::async_completion_cb set) as queued jobs.
+//
+// Up to DBOptions::max_non_blocking_compact_range_jobs worker threads are
+// created on demand and pick the queued jobs by priority
+// (CompactRangeOptions::async_priority), and in the order of the requests
+// within a priority. A request whose range overlaps the range of a job that
+// is still queued, for the same column family and with the same options, is
+// coalesced into that job: the job's range is extended to cover both ranges
+// and the callbacks of both requests are called once it completes.
+//
+// Each job holds a reference to its column family, which is released under
+// the DB mutex once the job ran, was canceled or was discarded.
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/options.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class ColumnFamilyData;
+class InstrumentedMutex;
+class Statistics;
+class SystemClock;
+
+class CompactRangeJobQueue {
+ public:
+  // Runs a manual compaction to completion. Called from the worker threads.
+  using RunFunc = std::function<Status(
+      const CompactRangeOptions& options, ColumnFamilyData* cfd,
+      const Slice* begin, const Slice* end, const std::string& trim_ts)>;
+
+  // db_mutex is the DB mutex, under which the column families are unref'ed
+  CompactRangeJobQueue(RunFunc run, int max_jobs, InstrumentedMutex* db_mutex,
+                       SystemClock* clock, Statistics* stats);
+  ~CompactRangeJobQueue();
+
+  // No copying allowed
+  CompactRangeJobQueue(const CompactRangeJobQueue&) = delete;
+  CompactRangeJobQueue& operator=(const CompactRangeJobQueue&) = delete;
+
+  // Queues a manual compaction of [begin, end] (nullptr meaning unbounded).
+  // options.async_completion_cb is called once it completes.
+  void Enqueue(const CompactRangeOptions& options, ColumnFamilyData* cfd,
+               const Slice* begin, const Slice* end,
+               const std::string& trim_ts);
+
+  // Completes the queued jobs with Status::ShutdownInProgress() and waits for
+  // the running ones. Jobs enqueued afterwards are completed right away.
+  void Shutdown();
+
+ private:
+  using CbPtr = std::shared_ptr<CompactRangeCompletedCbIf>;
+
+  struct Job {
+    CompactRangeOptions options;
+    ColumnFamilyData* cfd = nullptr;
+    bool has_begin = false;
+    bool has_end = false;
+    std::string begin;
+    std::string end;
+    std::string trim_ts;
+    // More than one once requests were coalesced into the job
+    std::vector<CbPtr> cbs;
+    int priority = 0;
+    uint64_t seqno = 0;
+    uint64_t enqueue_micros = 0;
+  };
+
+  // Extends `queued` to cover `job` when possible. REQUIRES: mutex_ held
+  bool Coalesce(Job* queued, const Job& job);
+  // Removes the callbacks that were canceled from the queued jobs, and the
+  // jobs left without callbacks, whose column families are added to
+  // `unref_cfds`. REQUIRES: mutex_ held
+  void RemoveCanceled(std::vector<CbPtr>* canceled,
+                      std::vector<ColumnFamilyData*>* unref_cfds);
+  // Releases the references of the jobs to `cfds`. REQUIRES: mutex_ not held
+  void UnrefCfds(const std::vector<ColumnFamilyData*>& cfds);
+  void WorkerThread();
+  void RunJob(Job* job);
+
+  const RunFunc run_;
+  const size_t max_threads_;
+  InstrumentedMutex* const db_mutex_;
+  SystemClock* const clock_;
+  Statistics* const stats_;
+
+  port::Mutex mutex_;
+  port::CondVar cv_;
+  std::list<std::unique_ptr<Job>> queue_;
+  std::vector<port::Thread> threads_;
+  size_t num_idle_threads_ = 0;
+  uint64_t next_seqno_ = 0;
+  bool shutting_down_ = false;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
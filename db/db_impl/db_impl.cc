@@ -42,6 +42,7 @@
 #include "db/arena_wrapped_db_iter.h"
 #include "db/builder.h"
 #include "db/compaction/compaction_job.h"
+#include "db/compaction/key_prefix_retention.h"
 #include "db/convenience_impl.h"
 #include "db/db_info_dumper.h"
 #include "db/db_iter.h"
@@ -60,6 +61,7 @@
 #include "db/memtable_list.h"
 #include "db/merge_context.h"
 #include "db/merge_helper.h"
+#include "db/multi_get_async.h"
 #include "db/periodic_task_scheduler.h"
 #include "db/range_tombstone_fragmenter.h"
 #include "db/table_cache.h"
@@ -242,6 +244,7 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       bg_flush_scheduled_(0),
       num_running_flushes_(0),
       bg_purge_scheduled_(0),
+      bg_hot_blocks_warmup_scheduled_(false),
       disable_delete_obsolete_files_(0),
       pending_purge_obsolete_files_(0),
       delete_obsolete_files_last_run_(immutable_db_options_.clock->NowMicros()),
@@ -280,7 +283,16 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       blob_callback_(immutable_db_options_.sst_file_manager.get(), &mutex_,
                      &error_handler_, &event_logger_,
                      immutable_db_options_.listeners, dbname_),
-      lock_wal_count_(0) {
+      lock_wal_count_(0),
+      compact_range_job_queue_(
+          [this](const CompactRangeOptions& cr_options, ColumnFamilyData* cfd,
+                 const Slice* begin, const Slice* end,
+                 const std::string& trim_ts) {
+            return CompactRangeNonBlockingJob(cr_options, cfd, begin, end,
+                                              trim_ts);
+          },
+          immutable_db_options_.max_non_blocking_compact_range_jobs,
+          &mutex_, immutable_db_options_.clock, immutable_db_options_.stats) {
   // !batch_per_trx_ implies seq_per_batch_ because it is only unset for
   // WriteUnprepared, which should use seq_per_batch_.
   assert(batch_per_txn_ || seq_per_batch_);
@@ -312,6 +324,9 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       [this]() { this->RecordSeqnoToTimeMapping(); });
   periodic_task_functions_.emplace(PeriodicTaskType::kRefreshOptions,
                                    [this]() { this->RefreshOptions(); });
+  periodic_task_functions_.emplace(
+      PeriodicTaskType::kPersistHotBlocks,
+      [this]() { this->PersistHotBlocks().PermitUncheckedError(); });
 
   versions_.reset(new VersionSet(dbname_, &immutable_db_options_, file_options_,
                                  table_cache_.get(), write_buffer_manager_,
@@ -612,6 +627,10 @@ Status DBImpl::CloseHelper() {
   if (HasPendingManualCompaction()) {
     DisableManualCompaction();
   }
+  // Complete the queued non-blocking manual compactions and wait for the
+  // running ones
+  compact_range_job_queue_.Shutdown();
+
   mutex_.Lock();
   // Unschedule all tasks for this DB
   for (uint8_t i = 0; i < static_cast<uint8_t>(TaskType::kCount); i++) {
@@ -625,7 +644,7 @@ Status DBImpl::CloseHelper() {
   // Wait for background work to finish
   while (bg_bottom_compaction_scheduled_ || bg_compaction_scheduled_ ||
          bg_flush_scheduled_ || bg_purge_scheduled_ ||
-         pending_purge_obsolete_files_ ||
+         bg_hot_blocks_warmup_scheduled_ || pending_purge_obsolete_files_ ||
          error_handler_.IsRecoveryInProgress()) {
     TEST_SYNC_POINT("DBImpl::~DBImpl:WaitJob");
     bg_cv_.Wait();
@@ -648,10 +667,6 @@ Status DBImpl::CloseHelper() {
     cfd->UnrefAndTryDelete();
   }
 
-  // Wait for all non-blocking manual compactions that may still be in progress.
-  // Do it only after cleaning up all compaction-related activity above.
-  compact_range_threads_mngr_.Shutdown();
-
   if (default_cf_handle_ != nullptr || persist_stats_cf_handle_ != nullptr) {
     // we need to delete handle outside of lock because it does its own locking
     mutex_.Unlock();
@@ -872,6 +887,15 @@ Status DBImpl::StartPeriodicTaskScheduler() {
       return s;
     }
   }
+  if (immutable_db_options_.hot_blocks_persist_period_sec > 0) {
+    Status s = periodic_task_scheduler_.Register(
+        PeriodicTaskType::kPersistHotBlocks,
+        periodic_task_functions_.at(PeriodicTaskType::kPersistHotBlocks),
+        immutable_db_options_.hot_blocks_persist_period_sec);
+    if (!s.ok()) {
+      return s;
+    }
+  }
 
   Status s = periodic_task_scheduler_.Register(
       PeriodicTaskType::kFlushInfoLog,
@@ -887,13 +911,19 @@ Status DBImpl::RegisterRecordSeqnoTimeWorker() {
     InstrumentedMutexLock l(&mutex_);
 
     for (auto cfd : *versions_->GetColumnFamilySet()) {
-      // preserve time is the max of 2 options.
+      // preserve time is the max of 2 options and the key prefix retentions.
+      const uint64_t max_retention =
+          MaxKeyPrefixRetentionSeconds(cfd->ioptions()->key_prefix_retentions);
       uint64_t preserve_time_duration =
-          std::max(cfd->ioptions()->preserve_internal_time_seconds,
-                   cfd->ioptions()->preclude_last_level_data_seconds);
+          std::max({cfd->ioptions()->preserve_internal_time_seconds,
+                    cfd->ioptions()->preclude_last_level_data_seconds,
+                    max_retention});
       if (!cfd->IsDropped() && preserve_time_duration > 0) {
         min_time_duration = std::min(preserve_time_duration, min_time_duration);
-        max_time_duration = std::max(preserve_time_duration, max_time_duration);
+        // The expiry of the keys looks up the time before their retention,
+        // which a mapping full at exactly the retention has dropped already
+        max_time_duration = std::max(
+            {preserve_time_duration, 2 * max_retention, max_time_duration});
       }
     }
     if (min_time_duration == std::numeric_limits<uint64_t>::max()) {
@@ -3378,6 +3408,21 @@ void DBImpl::MultiGetEntity(const ReadOptions& options,
                  results, /* timestamps */ nullptr, statuses, sorted_input);
 }
 
+Status DBImpl::MultiGetAsync(const ReadOptions& options,
+                             ColumnFamilyHandle* column_family,
+                             const std::vector<Slice>& keys,
+                             MultiGetAsyncCallback callback,
+                             MultiGetAsyncQueue* queue) {
+  if (queue == nullptr || !callback) {
+    return Status::InvalidArgument(
+        "MultiGetAsync() requires a queue and a callback");
+  }
+  static_cast_with_check<MultiGetAsyncQueueImpl>(queue)->Add(
+      std::unique_ptr<MultiGetAsyncLookup>(new MultiGetAsyncLookup(
+          this, options, column_family, keys, std::move(callback))));
+  return Status::OK();
+}
+
 Status DBImpl::CreateColumnFamily(const ColumnFamilyOptions& cf_options,
                                   const std::string& column_family,
                                   ColumnFamilyHandle** handle) {
@@ -3530,7 +3575,8 @@ Status DBImpl::CreateColumnFamilyImpl(const ColumnFamilyOptions& cf_options,
   }  // InstrumentedMutexLock l(&mutex_)
 
   if (cf_options.preserve_internal_time_seconds > 0 ||
-      cf_options.preclude_last_level_data_seconds > 0) {
+      cf_options.preclude_last_level_data_seconds > 0 ||
+      !cf_options.key_prefix_retentions.empty()) {
     s = RegisterRecordSeqnoTimeWorker();
   }
   sv_context.Clean();
@@ -3625,7 +3671,8 @@ Status DBImpl::DropColumnFamilyImpl(ColumnFamilyHandle* column_family) {
   }
 
   if (cfd->ioptions()->preserve_internal_time_seconds > 0 ||
-      cfd->ioptions()->preclude_last_level_data_seconds > 0) {
+      cfd->ioptions()->preclude_last_level_data_seconds > 0 ||
+      !cfd->ioptions()->key_prefix_retentions.empty()) {
     s = RegisterRecordSeqnoTimeWorker();
   }
 
@@ -6177,7 +6224,8 @@ Status DBImpl::VerifyChecksumInternal(const ReadOptions& read_options,
                                      read_options);
         } else {
           s = ROCKSDB_NAMESPACE::VerifySstFileChecksumInternal(
-              opts, file_options_, read_options, fname, fd.largest_seqno);
+              opts, file_options_, read_options, fname, fd.largest_seqno,
+              cfd->compression_dict_service());
         }
         RecordTick(stats_, VERIFY_CHECKSUM_READ_BYTES,
                    IOSTATS(bytes_read) - prev_bytes_read);
@@ -6438,6 +6486,23 @@ void DBImpl::RecordSeqnoToTimeMapping() {
   {
     InstrumentedMutexLock l(&mutex_);
     appended = seqno_time_mapping_.Append(seqno, unix_time);
+    // Keys expire as time passes, so the files to delete or compact for the
+    // key prefix retentions are updated here
+    for (auto* cfd : *versions_->GetColumnFamilySet()) {
+      if (cfd->IsDropped() || cfd->ioptions()->key_prefix_retentions.empty()) {
+        continue;
+      }
+      KeyPrefixRetentionCutoffs cutoffs;
+      cutoffs.Update(cfd->ioptions()->key_prefix_retentions,
+                     seqno_time_mapping_, static_cast<uint64_t>(unix_time));
+      VersionStorageInfo* vstorage = cfd->current()->storage_info();
+      vstorage->UpdateKeyPrefixRetentionCutoffs(cutoffs, *cfd->ioptions());
+      if (!vstorage->ExpiredKeyPrefixRetentionFiles().empty() ||
+          !vstorage->FilesMarkedForKeyPrefixRetention().empty()) {
+        SchedulePendingCompaction(cfd);
+        MaybeScheduleFlushOrCompaction();
+      }
+    }
   }
   if (!appended) {
     ROCKS_LOG_WARN(immutable_db_options_.info_log,
@@ -37,7 +37,7 @@
 #include "db/column_family.h"
 #include "db/compaction/compaction_iterator.h"
 #include "db/compaction/compaction_job.h"
-#include "db/db_impl/compact_range_threads_mngr.h"
+#include "db/db_impl/compact_range_job_queue.h"
 #include "db/db_impl/db_spdb_impl_write.h"
 #include "db/error_handler.h"
 #include "db/event_helpers.h"
@@ -316,6 +316,12 @@ class DBImpl : public DB {
       ReadCallback* callback,
       autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys);
 
+  Status MultiGetAsync(const ReadOptions& options,
+                       ColumnFamilyHandle* column_family,
+                       const std::vector<Slice>& keys,
+                       MultiGetAsyncCallback callback,
+                       MultiGetAsyncQueue* queue) override;
+
   using DB::MultiGetEntity;
 
   void MultiGetEntity(const ReadOptions& options,
@@ -870,6 +876,10 @@ class DBImpl : public DB {
   // Schedule a background job to actually delete obsolete files.
   void SchedulePurge();
 
+  // Schedules reading the blocks listed in the HOTBLOCKS file, if any, into
+  // the block cache
+  void MaybeScheduleHotBlocksWarmUp();
+
   const SnapshotList& snapshots() const { return snapshots_; }
 
   // load list of snapshots to `snap_vector` that is no newer than `max_seq`
@@ -1154,6 +1164,10 @@ class DBImpl : public DB {
   // Wait for any background purge
   Status TEST_WaitForPurge();
 
+  // Write the hot block list now and wait for the hot block warm-up
+  Status TEST_PersistHotBlocks();
+  Status TEST_WaitForHotBlocksWarmUp();
+
   // Get the background error status
   Status TEST_GetBGError();
 
@@ -1250,6 +1264,10 @@ class DBImpl : public DB {
   // Checks if the options should be updated
   void RefreshOptions();
 
+  // Writes the hottest data blocks of the live table files to the HOTBLOCKS
+  // file
+  Status PersistHotBlocks();
+
   // Interface to block and signal the DB in case of stalling writes by
   // WriteBufferManager. Each DBImpl object contains ptr to WBMStallInterface.
   // When DB needs to be blocked or signalled by WriteBufferManager,
@@ -2169,12 +2187,15 @@ class DBImpl : public DB {
   static void BGWorkBottomCompaction(void* arg);
   static void BGWorkFlush(void* arg);
   static void BGWorkPurge(void* arg);
+  static void BGWorkHotBlocksWarmUp(void* arg);
   static void UnscheduleCompactionCallback(void* arg);
   static void UnscheduleFlushCallback(void* arg);
   void BackgroundCallCompaction(PrepickedCompaction* prepicked_compaction,
                                 Env::Priority thread_pri);
   void BackgroundCallFlush(Env::Priority thread_pri);
   void BackgroundCallPurge();
+  // Reads the blocks listed in the HOTBLOCKS file into the block cache
+  void BackgroundCallHotBlocksWarmUp();
   Status BackgroundCompaction(bool* madeProgress, JobContext* job_context,
                               LogBuffer* log_buffer,
                               PrepickedCompaction* prepicked_compaction,
@@ -2408,10 +2429,12 @@ class DBImpl : public DB {
 
   bool ShouldReferenceSuperVersion(const MergeContext& merge_context);
 
-  void CompactRangeNonBlockingThread(const CompactRangeOptions options,
-                                     ColumnFamilyData* cfd, std::string begin,
-                                     std::string end,
-                                     const std::string trim_ts);
+  // Runs a non-blocking manual compaction on a thread of
+  // compact_range_job_queue_
+  Status CompactRangeNonBlockingJob(const CompactRangeOptions& options,
+                                    ColumnFamilyData* cfd, const Slice* begin,
+                                    const Slice* end,
+                                    const std::string& trim_ts);
 
   Status CompactRangeInternalBlocking(const CompactRangeOptions& options,
                                       ColumnFamilyData* cfd, const Slice* begin,
@@ -2683,6 +2706,14 @@ class DBImpl : public DB {
   // number of background obsolete file purge jobs, submitted to the HIGH pool
   int bg_purge_scheduled_;
 
+  // whether the block cache warm-up from the HOTBLOCKS file, submitted to the
+  // LOW pool, is still running
+  bool bg_hot_blocks_warmup_scheduled_;
+
+  // whether PersistHotBlocks() may be writing the HOTBLOCKS temp file, which
+  // is otherwise left by a crash and purged as obsolete
+  std::atomic<bool> persisting_hot_blocks_{false};
+
   std::deque<ManualCompactionState*> manual_compaction_dequeue_;
 
   // shall we disable deletion of obsolete files
@@ -2832,9 +2863,8 @@ class DBImpl : public DB {
   // See also lock_wal_write_token_
   uint32_t lock_wal_count_;
 
-  // Tracks threads created internally to handle non-blocking
-  // CompactRange() requests.
-  CompactRangeThreadsMngr compact_range_threads_mngr_;
+  // Queues and runs the non-blocking CompactRange() requests
+  CompactRangeJobQueue compact_range_job_queue_;
 };
 
 class GetWithTimestampReadCallback : public ReadCallback {
@@ -1118,28 +1118,14 @@ Status DBImpl::IncreaseFullHistoryTsLowImpl(ColumnFamilyData* cfd,
   return Status::OK();
 }
 
-void DBImpl::CompactRangeNonBlockingThread(const CompactRangeOptions options,
-                                           ColumnFamilyData* cfd,
-                                           std::string begin_str,
-                                           std::string end_str,
-                                           const std::string trim_ts) {
-  assert(options.async_completion_cb);
-
+Status DBImpl::CompactRangeNonBlockingJob(const CompactRangeOptions& options,
+                                          ColumnFamilyData* cfd,
+                                          const Slice* begin, const Slice* end,
+                                          const std::string& trim_ts) {
   if (shutdown_initiated_) {
-    options.async_completion_cb->InternalCompletedCb(
-        Status::ShutdownInProgress());
-    return;
+    return Status::ShutdownInProgress();
   }
-
-  Slice begin{begin_str};
-  Slice* begin_to_use = begin.empty() ? nullptr : &begin;
-  Slice end{end_str};
-  Slice* end_to_use = end.empty() ? nullptr : &end;
-
-  auto status = CompactRangeInternalBlocking(options, cfd, begin_to_use,
-                                             end_to_use, trim_ts);
-
-  options.async_completion_cb->InternalCompletedCb(status);
+  return CompactRangeInternalBlocking(options, cfd, begin, end, trim_ts);
 }
 
 Status DBImpl::CompactRangeInternal(const CompactRangeOptions& options,
@@ -1179,19 +1165,7 @@ Status DBImpl::CompactRangeInternal(const CompactRangeOptions& options,
   }
 
   if (options.async_completion_cb) {
-    std::string begin_str;
-    if (begin != nullptr) {
-      begin_str.assign(begin->data(), begin->size());
-    }
-    std::string end_str;
-    if (end != nullptr) {
-      end_str.assign(end->data(), end->size());
-    }
-    port::Thread compact_range_thread(&DBImpl::CompactRangeNonBlockingThread,
-                                      this, options, cfd, begin_str, end_str,
-                                      trim_ts);
-    compact_range_threads_mngr_.AddThread(std::move(compact_range_thread),
-                                          options.async_completion_cb);
+    compact_range_job_queue_.Enqueue(options, cfd, begin, end, trim_ts);
     return Status::OK();
   } else {
     return CompactRangeInternalBlocking(options, cfd, begin, end, trim_ts);
@@ -1953,7 +1927,7 @@ Status DBImpl::ReFitLevel(ColumnFamilyData* cfd, int level, int target_level) {
           f->oldest_ancester_time, f->file_creation_time, f->epoch_number,
           f->file_checksum, f->file_checksum_func_name, f->unique_id,
           f->compensated_range_deletion_size, f->tail_size,
-          f->user_defined_timestamps_persisted);
+          f->user_defined_timestamps_persisted, f->compression_dict_id);
     }
     ROCKS_LOG_DEBUG(immutable_db_options_.info_log,
                     "[%s] Apply version edit:\n%s", cfd->GetName().c_str(),
@@ -3763,7 +3737,8 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
                              c->column_family_data());
     assert(c->num_input_files(1) == 0);
     assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+               kCompactionStyleFIFO ||
+           c->compaction_reason() == CompactionReason::kKeyPrefixRetention);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
@@ -3818,7 +3793,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
             f->file_creation_time, f->epoch_number, f->file_checksum,
             f->file_checksum_func_name, f->unique_id,
             f->compensated_range_deletion_size, f->tail_size,
-            f->user_defined_timestamps_persisted);
+            f->user_defined_timestamps_persisted, f->compression_dict_id);
 
         ROCKS_LOG_BUFFER(
             log_buffer,
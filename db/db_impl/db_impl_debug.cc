@@ -194,6 +194,16 @@ Status DBImpl::TEST_WaitForPurge() {
   return error_handler_.GetBGError();
 }
 
+Status DBImpl::TEST_PersistHotBlocks() { return PersistHotBlocks(); }
+
+Status DBImpl::TEST_WaitForHotBlocksWarmUp() {
+  InstrumentedMutexLock l(&mutex_);
+  while (bg_hot_blocks_warmup_scheduled_) {
+    bg_cv_.Wait();
+  }
+  return Status::OK();
+}
+
 Status DBImpl::TEST_GetBGError() {
   InstrumentedMutexLock l(&mutex_);
   return error_handler_.GetBGError();
@@ -552,6 +552,12 @@ void DBImpl::PurgeObsoleteFiles(JobContext& state, bool schedule_only) {
         }
         break;
       case kTempFile:
+        if (candidate_file.file_path + to_delete ==
+            HotBlocksTempFileName(dbname_)) {
+          // Left by a crash unless the hot blocks are being persisted
+          keep = persisting_hot_blocks_.load(std::memory_order_acquire);
+          break;
+        }
         // Any temp files that are currently being written to must
         // be recorded in pending_outputs_, which is inserted into "live".
         // Also, SetCurrentFile creates a temp file when writing out new
@@ -578,6 +584,7 @@ void DBImpl::PurgeObsoleteFiles(JobContext& state, bool schedule_only) {
       case kDBLockFile:
       case kIdentityFile:
       case kMetaDatabase:
+      case kHotBlocksFile:
         keep = true;
         break;
     }
@@ -0,0 +1,314 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cinttypes>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "db/column_family.h"
+#include "db/db_impl/db_impl.h"
+#include "db/table_cache.h"
+#include "db/version_set.h"
+#include "file/filename.h"
+#include "logging/logging.h"
+#include "monitoring/iostats_context_imp.h"
+#include "rocksdb/file_system.h"
+#include "test_util/sync_point.h"
+#include "util/autovector.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// HOTBLOCKS file layout:
+//
+//   format version (fixed32) | num entries (varint64) |
+//   num entries x [file number | offset | size | hits] (varint64 each) |
+//   masked crc32c of everything before (fixed32)
+//
+// Entries are in hotness order, hottest first.
+constexpr uint32_t kHotBlocksFormatVersion = 1;
+
+struct HotBlockEntry {
+  uint64_t file_number;
+  TableReader::HotBlock block;
+};
+
+void EncodeHotBlocks(const std::vector<HotBlockEntry>& entries,
+                     std::string* dst) {
+  PutFixed32(dst, kHotBlocksFormatVersion);
+  PutVarint64(dst, entries.size());
+  for (const auto& entry : entries) {
+    PutVarint64Varint64(dst, entry.file_number, entry.block.offset);
+    PutVarint64Varint64(dst, entry.block.size, entry.block.hits);
+  }
+  PutFixed32(dst, crc32c::Mask(crc32c::Value(dst->data(), dst->size())));
+}
+
+Status DecodeHotBlocks(Slice input, std::vector<HotBlockEntry>* entries) {
+  if (input.size() < 2 * sizeof(uint32_t)) {
+    return Status::Corruption("HOTBLOCKS file too short");
+  }
+  const size_t body_size = input.size() - sizeof(uint32_t);
+  const uint32_t expected_crc =
+      crc32c::Unmask(DecodeFixed32(input.data() + body_size));
+  if (crc32c::Value(input.data(), body_size) != expected_crc) {
+    return Status::Corruption("HOTBLOCKS checksum mismatch");
+  }
+  input.remove_suffix(sizeof(uint32_t));
+  const uint32_t format_version = DecodeFixed32(input.data());
+  input.remove_prefix(sizeof(uint32_t));
+  if (format_version != kHotBlocksFormatVersion) {
+    return Status::NotSupported("Unknown HOTBLOCKS format version");
+  }
+  uint64_t num_entries = 0;
+  if (!GetVarint64(&input, &num_entries)) {
+    return Status::Corruption("Bad HOTBLOCKS entry count");
+  }
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    HotBlockEntry entry;
+    if (!GetVarint64(&input, &entry.file_number) ||
+        !GetVarint64(&input, &entry.block.offset) ||
+        !GetVarint64(&input, &entry.block.size) ||
+        !GetVarint64(&input, &entry.block.hits)) {
+      return Status::Corruption("Bad HOTBLOCKS entry");
+    }
+    entries->push_back(entry);
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status DBImpl::PersistHotBlocks() {
+  if (shutdown_initiated_) {
+    return Status::OK();
+  }
+  TEST_SYNC_POINT("DBImpl::PersistHotBlocks:Start");
+
+  // Pin the current version of every column family so that its files stay
+  // valid while the mutex is released
+  autovector<Version*> versions;
+  {
+    InstrumentedMutexLock l(&mutex_);
+    for (auto cfd : *versions_->GetColumnFamilySet()) {
+      if (cfd->IsDropped() || !cfd->initialized()) {
+        continue;
+      }
+      cfd->Ref();
+      cfd->current()->Ref();
+      versions.push_back(cfd->current());
+    }
+  }
+
+  ReadOptions read_options;
+  std::vector<HotBlockEntry> entries;
+  std::vector<TableReader::HotBlock> blocks;
+  for (Version* version : versions) {
+    ColumnFamilyData* cfd = version->cfd();
+    const MutableCFOptions& cf_options = version->GetMutableCFOptions();
+    const VersionStorageInfo* vstorage = version->storage_info();
+    for (int level = 0; level < vstorage->num_levels(); ++level) {
+      for (FileMetaData* file_meta : vstorage->LevelFiles(level)) {
+        blocks.clear();
+        cfd->table_cache()->GetHotBlocks(
+            file_options_, read_options, cfd->internal_comparator(),
+            *file_meta, cf_options.block_protection_bytes_per_key,
+            cf_options.prefix_extractor, &blocks);
+        for (const auto& block : blocks) {
+          entries.push_back({file_meta->fd.GetNumber(), block});
+        }
+      }
+    }
+  }
+
+  {
+    InstrumentedMutexLock l(&mutex_);
+    for (Version* version : versions) {
+      ColumnFamilyData* cfd = version->cfd();
+      version->Unref();
+      cfd->UnrefAndTryDelete();
+    }
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const HotBlockEntry& a, const HotBlockEntry& b) {
+              return a.block.hits > b.block.hits;
+            });
+  const uint64_t budget = immutable_db_options_.hot_blocks_warmup_bytes;
+  if (budget > 0) {
+    uint64_t total_bytes = 0;
+    size_t num_entries = 0;
+    while (num_entries < entries.size() && total_bytes < budget) {
+      total_bytes += entries[num_entries++].block.size;
+    }
+    entries.resize(num_entries);
+  }
+
+  std::string data;
+  EncodeHotBlocks(entries, &data);
+  const std::string fname = HotBlocksFileName(dbname_);
+  const std::string tmp_fname = HotBlocksTempFileName(dbname_);
+  persisting_hot_blocks_.store(true, std::memory_order_release);
+  IOStatus io_s = WriteStringToFile(fs_.get(), data, tmp_fname,
+                                    /*should_sync=*/true);
+  if (io_s.ok()) {
+    io_s = fs_->RenameFile(tmp_fname, fname, IOOptions(), nullptr);
+  }
+  if (io_s.ok()) {
+    ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                   "Persisted %" ROCKSDB_PRIszt " hot blocks to %s",
+                   entries.size(), fname.c_str());
+  } else {
+    ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                   "Failed to persist hot blocks to %s: %s", fname.c_str(),
+                   io_s.ToString().c_str());
+    fs_->DeleteFile(tmp_fname, IOOptions(), nullptr).PermitUncheckedError();
+  }
+  persisting_hot_blocks_.store(false, std::memory_order_release);
+  return io_s;
+}
+
+void DBImpl::MaybeScheduleHotBlocksWarmUp() {
+  mutex_.AssertHeld();
+  if (immutable_db_options_.hot_blocks_persist_period_sec == 0 ||
+      bg_hot_blocks_warmup_scheduled_) {
+    return;
+  }
+  bg_hot_blocks_warmup_scheduled_ = true;
+  env_->Schedule(&DBImpl::BGWorkHotBlocksWarmUp, this, Env::Priority::LOW,
+                 nullptr);
+}
+
+void DBImpl::BGWorkHotBlocksWarmUp(void* db) {
+  IOSTATS_SET_THREAD_POOL_ID(Env::Priority::LOW);
+  TEST_SYNC_POINT("DBImpl::BGWorkHotBlocksWarmUp:start");
+  reinterpret_cast<DBImpl*>(db)->BackgroundCallHotBlocksWarmUp();
+  TEST_SYNC_POINT("DBImpl::BGWorkHotBlocksWarmUp:end");
+}
+
+void DBImpl::BackgroundCallHotBlocksWarmUp() {
+  const std::string fname = HotBlocksFileName(dbname_);
+  std::string data;
+  std::vector<HotBlockEntry> entries;
+  Status s = ReadFileToString(fs_.get(), fname, &data);
+  if (s.ok()) {
+    s = DecodeHotBlocks(data, &entries);
+  }
+  if (!s.ok() && !s.IsNotFound()) {
+    ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                   "Skipping block cache warm-up from %s: %s", fname.c_str(),
+                   s.ToString().c_str());
+  }
+
+  // Take the hottest blocks within the budget, then group them by file,
+  // hottest file first, so that each file's blocks can be read in offset
+  // order with coalesced I/O
+  const uint64_t budget = immutable_db_options_.hot_blocks_warmup_bytes;
+  uint64_t selected_bytes = 0;
+  std::vector<uint64_t> file_order;
+  std::unordered_map<uint64_t, std::vector<TableReader::HotBlock>>
+      blocks_by_file;
+  for (const auto& entry : entries) {
+    if (budget > 0 && selected_bytes >= budget) {
+      break;
+    }
+    selected_bytes += entry.block.size;
+    auto& file_blocks = blocks_by_file[entry.file_number];
+    if (file_blocks.empty()) {
+      file_order.push_back(entry.file_number);
+    }
+    file_blocks.push_back(entry.block);
+  }
+
+  // Pin the current version of every column family and locate the files
+  autovector<Version*> versions;
+  std::unordered_map<uint64_t, std::pair<Version*, FileMetaData*>> live_files;
+  if (!file_order.empty()) {
+    InstrumentedMutexLock l(&mutex_);
+    for (auto cfd : *versions_->GetColumnFamilySet()) {
+      if (cfd->IsDropped() || !cfd->initialized()) {
+        continue;
+      }
+      Version* version = cfd->current();
+      cfd->Ref();
+      version->Ref();
+      versions.push_back(version);
+      const VersionStorageInfo* vstorage = version->storage_info();
+      for (int level = 0; level < vstorage->num_levels(); ++level) {
+        for (FileMetaData* file_meta : vstorage->LevelFiles(level)) {
+          if (blocks_by_file.count(file_meta->fd.GetNumber()) > 0) {
+            live_files.emplace(file_meta->fd.GetNumber(),
+                               std::make_pair(version, file_meta));
+          }
+        }
+      }
+    }
+  }
+
+  ReadOptions read_options;
+  read_options.rate_limiter_priority = Env::IO_LOW;
+  uint64_t num_files = 0;
+  uint64_t num_blocks = 0;
+  for (uint64_t file_number : file_order) {
+    if (shutting_down_.load(std::memory_order_acquire)) {
+      break;
+    }
+    auto it = live_files.find(file_number);
+    if (it == live_files.end()) {
+      // Compacted away since the list was written
+      continue;
+    }
+    Version* version = it->second.first;
+    ColumnFamilyData* cfd = version->cfd();
+    const MutableCFOptions& cf_options = version->GetMutableCFOptions();
+    const auto& file_blocks = blocks_by_file[file_number];
+    s = cfd->table_cache()->WarmUpBlocks(
+        read_options, cfd->internal_comparator(), *it->second.second,
+        cf_options.block_protection_bytes_per_key, cf_options.prefix_extractor,
+        file_blocks);
+    if (s.ok()) {
+      ++num_files;
+      num_blocks += file_blocks.size();
+    } else {
+      ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                     "Block cache warm-up of file %" PRIu64 " failed: %s",
+                     file_number, s.ToString().c_str());
+    }
+  }
+  if (!file_order.empty()) {
+    ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                   "Block cache warm-up read %" PRIu64 " hot blocks of %" PRIu64
+                   " files",
+                   num_blocks, num_files);
+  }
+
+  mutex_.Lock();
+  for (Version* version : versions) {
+    ColumnFamilyData* cfd = version->cfd();
+    version->Unref();
+    cfd->UnrefAndTryDelete();
+  }
+  bg_hot_blocks_warmup_scheduled_ = false;
+  bg_cv_.SignalAll();
+  // IMPORTANT: there should be no code after calling SignalAll, see
+  // BackgroundCallPurge()
+  mutex_.Unlock();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
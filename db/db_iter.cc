@@ -9,6 +9,7 @@
 
 #include "db/db_iter.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <string>
@@ -60,6 +61,7 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
       num_internal_keys_skipped_(0),
       iterate_lower_bound_(read_options.iterate_lower_bound),
       iterate_upper_bound_(read_options.iterate_upper_bound),
+      column_projection_(read_options.column_projection),
       direction_(kForward),
       valid_(false),
       current_entry_is_merged_(false),
@@ -230,6 +232,8 @@ bool DBIter::SetValueAndColumnsFromEntity(Slice slice) {
     return false;
   }
 
+  ApplyColumnProjection();
+
   if (!wide_columns_.empty() &&
       wide_columns_[0].name() == kDefaultWideColumnName) {
     value_ = wide_columns_[0].value();
@@ -238,6 +242,20 @@ bool DBIter::SetValueAndColumnsFromEntity(Slice slice) {
   return true;
 }
 
+void DBIter::ApplyColumnProjection() {
+  if (column_projection_ == nullptr) {
+    return;
+  }
+  const auto& projection = *column_projection_;
+  wide_columns_.erase(
+      std::remove_if(wide_columns_.begin(), wide_columns_.end(),
+                     [&projection](const WideColumn& column) {
+                       return std::find(projection.begin(), projection.end(),
+                                        column.name()) == projection.end();
+                     }),
+      wide_columns_.end());
+}
+
 // PRE: saved_key_ has the current user key if skipping_saved_key
 // POST: saved_key_ should have the next user key if valid_,
 //       if the current entry is a result of merge
@@ -900,6 +918,8 @@ bool DBIter::FindValueForCurrentKey() {
       case kTypeWideColumnEntity:
         if (iter_.iter()->IsValuePinned()) {
           pinned_value_ = iter_.value();
+        } else if (last_key_entry_type == kTypeWideColumnEntity) {
+          SaveUnpinnedEntity();
         } else {
           valid_ = false;
           status_ = Status::NotSupported(
@@ -1123,8 +1143,12 @@ bool DBIter::FindValueForCurrentKeyUsingSeek() {
   }
   if (ikey.type == kTypeValue || ikey.type == kTypeBlobIndex ||
       ikey.type == kTypeWideColumnEntity) {
-    assert(iter_.iter()->IsValuePinned());
-    pinned_value_ = iter_.value();
+    if (iter_.iter()->IsValuePinned()) {
+      pinned_value_ = iter_.value();
+    } else {
+      assert(ikey.type == kTypeWideColumnEntity);
+      SaveUnpinnedEntity();
+    }
     if (ikey.type == kTypeBlobIndex) {
       if (!SetBlobValueIfNeeded(ikey.user_key, pinned_value_)) {
         return false;
@@ -306,12 +306,26 @@ class DBIter final : public Iterator {
     assert(value_.empty());
     assert(wide_columns_.empty());
 
-    value_ = slice;
     wide_columns_.emplace_back(kDefaultWideColumnName, slice);
+    ApplyColumnProjection();
+    if (!wide_columns_.empty()) {
+      value_ = slice;
+    }
   }
 
   bool SetValueAndColumnsFromEntity(Slice slice);
 
+  // Drops the columns not in ReadOptions::column_projection, if set
+  void ApplyColumnProjection();
+
+  // Entities rebuilt from the column streams of a data block (see
+  // BlockBasedTableOptions::data_block_columnar_entities) cannot be pinned,
+  // so they are copied to survive moving iter_
+  void SaveUnpinnedEntity() {
+    unpinned_entity_.assign(iter_.value().data(), iter_.value().size());
+    pinned_value_ = unpinned_entity_;
+  }
+
   void ResetValueAndColumns() {
     value_.clear();
     wide_columns_.clear();
@@ -341,6 +355,7 @@ class DBIter final : public Iterator {
   ParsedInternalKey ikey_;
   std::string saved_value_;
   Slice pinned_value_;
+  std::string unpinned_entity_;
   // for prefix seek mode to support prev()
   PinnableSlice blob_value_;
   // Value of the default column
@@ -353,6 +368,7 @@ class DBIter final : public Iterator {
   uint64_t num_internal_keys_skipped_;
   const Slice* iterate_lower_bound_;
   const Slice* iterate_upper_bound_;
+  const std::vector<Slice>* column_projection_;
 
   // The prefix of the seek key. It is only used when prefix_same_as_start_
   // is true and prefix extractor is not null. In Next() or Prev(), current keys
@@ -24,8 +24,11 @@
 #include <atomic>
 #include <cstdlib>
 #include <functional>
+#include <map>
 #include <memory>
+#include <set>
 
+#include "db/compression_dict_service.h"
 #include "db/db_test_util.h"
 #include "db/read_callback.h"
 #include "db/version_edit.h"
@@ -35,6 +38,7 @@
 #include "rocksdb/experimental.h"
 #include "rocksdb/iostats_context.h"
 #include "rocksdb/persistent_cache.h"
+#include "rocksdb/sst_file_reader.h"
 #include "rocksdb/trace_record.h"
 #include "rocksdb/trace_record_result.h"
 #include "rocksdb/utilities/replayer.h"
@@ -1443,6 +1447,219 @@ TEST_F(DBTest2, PresetCompressionDictLocality) {
   }
 }
 
+TEST_F(DBTest2, SharedCompressionDict) {
+  if (!ZSTD_Supported()) {
+    return;
+  }
+  // Verifies that a compaction trains a shared dictionary from the data blocks
+  // written so far, that later files are compressed with it and keep a copy of
+  // it for SstFileReader, that it survives reopening the DB, and that
+  // dictionaries no file refers to are dropped from the MANIFEST.
+  const int kNumKeysPerFile = 512;
+  const int kValueLen = 1 << 10;  // 1KB
+  Options options = CurrentOptions();
+  options.compression = kZSTD;
+  options.compression_opts.max_dict_bytes = 8 << 10;  // 8KB
+  options.compression_opts.use_shared_dict = true;
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 4 << 10;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  std::vector<std::string> dict_blocks;
+  SyncPoint::GetInstance()->SetCallBack(
+      "BlockBasedTableBuilder::WriteCompressionDictBlock:RawDict",
+      [&](void* arg) {
+        dict_blocks.push_back(static_cast<Slice*>(arg)->ToString());
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  auto write_file = [&](int file) {
+    for (int i = 0; i < kNumKeysPerFile; ++i) {
+      std::string key = Key(file * kNumKeysPerFile + i);
+      std::string value;
+      test::CompressibleString(&rnd, 0.5, kValueLen, &value);
+      ASSERT_OK(Put(key, value));
+      expected[key] = value;
+    }
+    ASSERT_OK(Flush());
+  };
+  auto get_dict_ids = [&]() {
+    TablePropertiesCollection props;
+    EXPECT_OK(db_->GetPropertiesOfAllTables(&props));
+    std::set<uint64_t> dict_ids;
+    for (const auto& prop : props) {
+      dict_ids.insert(prop.second->compression_dict_id);
+    }
+    return dict_ids;
+  };
+
+  // Rewrite the files, which would otherwise only be moved
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  // Without a shared dictionary yet, files get their own
+  write_file(0);
+  write_file(1);
+  ASSERT_EQ(std::set<uint64_t>{0}, get_dict_ids());
+  ASSERT_FALSE(dict_blocks.empty());
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+
+  // The compaction trained a dictionary, which the next flush uses
+  dict_blocks.clear();
+  write_file(2);
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  std::set<uint64_t> dict_ids = get_dict_ids();
+  ASSERT_EQ(1U, dict_ids.size());
+  const uint64_t dict_id = *dict_ids.begin();
+  ASSERT_NE(uint64_t{0}, dict_id);
+  // The files using the shared dictionary are read with it when verified
+  ASSERT_OK(db_->VerifyChecksum());
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // Every file stores a copy of the shared dictionary
+  CompressionDictService* dict_service =
+      static_cast<ColumnFamilyHandleImpl*>(db_->DefaultColumnFamily())
+          ->cfd()
+          ->compression_dict_service();
+  auto dicts = dict_service->GetDicts();
+  ASSERT_EQ(1U, dicts.size());
+  ASSERT_EQ(dict_id, dicts[0].first);
+  const std::string shared_dict = dicts[0].second;
+  ASSERT_FALSE(dict_blocks.empty());
+  for (const auto& dict_block : dict_blocks) {
+    ASSERT_EQ(shared_dict, dict_block);
+  }
+
+  // Which readers without access to the shared dictionary use
+  std::vector<LiveFileMetaData> live_files;
+  db_->GetLiveFilesMetaData(&live_files);
+  ASSERT_FALSE(live_files.empty());
+  size_t num_keys_read = 0;
+  for (const auto& file : live_files) {
+    SstFileReader reader(options);
+    ASSERT_OK(reader.Open(file.directory + "/" + file.relative_filename));
+    ASSERT_OK(reader.VerifyChecksum());
+    std::unique_ptr<Iterator> iter(reader.NewIterator(ReadOptions()));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(expected[iter->key().ToString()], iter->value().ToString());
+      ++num_keys_read;
+    }
+    ASSERT_OK(iter->status());
+  }
+  ASSERT_EQ(expected.size(), num_keys_read);
+
+  // Record a dictionary that no file refers to, then make the one in use
+  // current again
+  {
+    const uint64_t unused_dict_id = dict_id + 1;
+    VersionEdit unused_edit;
+    unused_edit.AddCompressionDict(unused_dict_id, shared_dict);
+    VersionEdit current_edit;
+    current_edit.AddCompressionDict(dict_id, shared_dict);
+    InstrumentedMutexLock l(dbfull()->mutex());
+    VersionSet* versions = dbfull()->GetVersionSet();
+    ASSERT_OK(versions->LogAndApplyToDefaultColumnFamily(
+        ReadOptions(), &unused_edit, dbfull()->mutex(), nullptr));
+    ASSERT_OK(versions->LogAndApplyToDefaultColumnFamily(
+        ReadOptions(), &current_edit, dbfull()->mutex(), nullptr));
+  }
+  ASSERT_EQ(2U, dict_service->GetDicts().size());
+
+  // The dictionary is recovered from the MANIFEST, and the unused one is
+  // dropped when the new MANIFEST is written
+  Reopen(options);
+  ASSERT_EQ(std::set<uint64_t>{dict_id}, get_dict_ids());
+  dicts = static_cast<ColumnFamilyHandleImpl*>(db_->DefaultColumnFamily())
+              ->cfd()
+              ->compression_dict_service()
+              ->GetDicts();
+  ASSERT_EQ(1U, dicts.size());
+  ASSERT_EQ(dict_id, dicts[0].first);
+  for (const auto& kv : expected) {
+    ASSERT_EQ(kv.second, Get(kv.first));
+  }
+  write_file(3);
+  ASSERT_EQ(std::set<uint64_t>{dict_id}, get_dict_ids());
+  for (const auto& kv : expected) {
+    ASSERT_EQ(kv.second, Get(kv.first));
+  }
+  ASSERT_OK(db_->VerifyChecksum());
+}
+
+TEST_F(DBTest2, AdaptiveCompression) {
+  CompressionType codec = kNoCompression;
+  for (CompressionType type : GetSupportedCompressions()) {
+    if (type != kNoCompression) {
+      codec = type;
+      break;
+    }
+  }
+  if (codec == kNoCompression) {
+    ROCKSDB_GTEST_SKIP("Test requires a compression library");
+    return;
+  }
+  // Verifies that the compaction outputs try all the adaptive compression
+  // candidates, and that only the compaction outputs are affected
+  const int kNumKeys = 512;
+  const int kValueLen = 1 << 10;  // 1KB
+  Options options = CurrentOptions();
+  options.compression = kNoCompression;
+  options.disable_auto_compactions = true;
+  options.target_file_size_base = 64 << 10;  // 64KB
+  options.adaptive_compression_candidates = {{kNoCompression, 0},
+                                             {codec, 1}};
+  Reopen(options);
+
+  Random rnd(301);
+  auto write_files = [&](int num_files) {
+    for (int file = 0; file < num_files; ++file) {
+      for (int i = 0; i < kNumKeys; ++i) {
+        std::string value;
+        test::CompressibleString(&rnd, 0.5, kValueLen, &value);
+        ASSERT_OK(Put(Key(i), value));
+      }
+      ASSERT_OK(Flush());
+    }
+  };
+  auto get_compression_names = [&]() {
+    TablePropertiesCollection props;
+    EXPECT_OK(db_->GetPropertiesOfAllTables(&props));
+    std::set<std::string> names;
+    for (const auto& prop : props) {
+      names.insert(prop.second->compression_name);
+    }
+    return names;
+  };
+
+  write_files(2);
+  ASSERT_EQ(std::set<std::string>{CompressionTypeToString(kNoCompression)},
+            get_compression_names());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_GT(NumTableFilesAtLevel(1), 1);
+  ASSERT_EQ((std::set<std::string>{CompressionTypeToString(kNoCompression),
+                                   CompressionTypeToString(codec)}),
+            get_compression_names());
+
+  // With a single candidate, all the compaction outputs use it
+  std::string codec_name;
+  ASSERT_OK(GetStringFromCompressionType(&codec_name, codec));
+  ASSERT_OK(dbfull()->SetOptions(
+      {{"adaptive_compression_candidates",
+        "{{type=" + codec_name + ";level=1}}"}}));
+  write_files(1);
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(std::set<std::string>{CompressionTypeToString(codec)},
+            get_compression_names());
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_EQ(static_cast<size_t>(kValueLen), Get(Key(i)).size());
+  }
+}
+
 class PresetCompressionDictTest
     : public DBTestBase,
       public testing::WithParamInterface<std::tuple<CompressionType, bool>> {
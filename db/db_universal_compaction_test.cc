@@ -2096,6 +2096,97 @@ TEST_F(DBTestUniversalCompaction2, OverlappingL0) {
   ASSERT_GT(NumTableFilesAtLevel(6), 0);
 }
 
+TEST_F(DBTestUniversalCompaction2, FoldNonOverlappingSortedRuns) {
+  int trivial_move = 0;
+  int non_trivial_move = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:TrivialMove",
+      [&](void* /*arg*/) { trivial_move++; });
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:NonTrivial",
+      [&](void* /*arg*/) { non_trivial_move++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  Options opts = CurrentOptions();
+  opts.compaction_style = kCompactionStyleUniversal;
+  opts.level0_file_num_compaction_trigger = 4;
+  opts.compression = kNoCompression;
+  opts.statistics = CreateDBStatistics();
+  opts.compaction_options_universal.fold_non_overlapping_sorted_runs = true;
+  Reopen(opts);
+
+  // Keys written in order only fold the new sorted runs into the last level
+  const int kNumFlushes = 12;
+  const int kKeysPerFlush = 100;
+  for (int i = 0; i < kNumFlushes; ++i) {
+    for (int j = 0; j < kKeysPerFlush; ++j) {
+      ASSERT_OK(Put(Key(i * kKeysPerFlush + j), "val"));
+    }
+    ASSERT_OK(Flush());
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+    ASSERT_LT(NumSortedRuns(), opts.level0_file_num_compaction_trigger);
+  }
+  ASSERT_GT(trivial_move, 0);
+  ASSERT_EQ(0, non_trivial_move);
+  ASSERT_EQ(0, TestGetTickerCount(opts, COMPACT_WRITE_BYTES));
+  ASSERT_GT(NumTableFilesAtLevel(opts.num_levels - 1), 0);
+  for (int i = 0; i < kNumFlushes * kKeysPerFlush; ++i) {
+    ASSERT_EQ("val", Get(Key(i)));
+  }
+
+  // Overlapping sorted runs are still merged
+  for (int i = 0; i < opts.level0_file_num_compaction_trigger; ++i) {
+    ASSERT_OK(Put(Key(0), "new_val"));
+    ASSERT_OK(Put(Key(kKeysPerFlush), "new_val"));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_GT(non_trivial_move, 0);
+  ASSERT_LT(NumSortedRuns(), opts.level0_file_num_compaction_trigger);
+  ASSERT_EQ("new_val", Get(Key(0)));
+  ASSERT_EQ("val", Get(Key(kNumFlushes * kKeysPerFlush - 1)));
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+TEST_F(DBTestUniversalCompaction2, FoldKeepsSingleLevelTrivialMoves) {
+  int trivial_move = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:TrivialMove",
+      [&](void* /*arg*/) { trivial_move++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  // A deletion triggered compaction of a single file into an empty last level
+  // is a trivial move without allow_trivial_move, with or without folding
+  for (bool fold : {false, true}) {
+    Options opts = CurrentOptions();
+    opts.table_properties_collector_factories.emplace_back(
+        NewCompactOnDeletionCollectorFactory(100 /* window_size */,
+                                             90 /* num_dels_trigger */));
+    opts.compaction_style = kCompactionStyleUniversal;
+    opts.num_levels = 7;
+    opts.level0_file_num_compaction_trigger = 10;
+    opts.compression = kNoCompression;
+    opts.compaction_options_universal.allow_trivial_move = false;
+    opts.compaction_options_universal.fold_non_overlapping_sorted_runs = fold;
+    DestroyAndReopen(opts);
+
+    trivial_move = 0;
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_OK(Delete(Key(i)));
+    }
+    ASSERT_OK(Flush());
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+    ASSERT_EQ(1, trivial_move) << "fold=" << fold;
+    ASSERT_EQ(0, NumTableFilesAtLevel(0));
+    ASSERT_EQ(1, NumTableFilesAtLevel(opts.num_levels - 1));
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBTestUniversalCompaction2, IngestBehind) {
   const int kNumKeys = 3000;
   const int kWindowSize = 100;
@@ -500,7 +500,8 @@ Status ExternalSstFileIngestionJob::Run() {
             : cfd_->NewEpochNumber(),
         f.file_checksum, f.file_checksum_func_name, f.unique_id, 0, tail_size,
         static_cast<bool>(
-            f.table_properties.user_defined_timestamps_persisted));
+            f.table_properties.user_defined_timestamps_persisted),
+        f.table_properties.compression_dict_id);
     f_metadata.temperature = f.file_temperature;
     edit_.AddFile(f.picked_level, f_metadata);
   }
@@ -981,6 +981,7 @@ Status FlushJob::WriteLevel0Table() {
           false /* is_last_level_with_data */, TableFileCreationReason::kFlush,
           oldest_key_time, current_time, db_id_, db_session_id_,
           0 /* target_file_size */, meta_.fd.GetNumber());
+      tboptions.compression_dict_service = cfd_->compression_dict_service();
       const SequenceNumber job_snapshot_seq =
           job_context_->GetJobSnapshotSequence();
       const ReadOptions read_options(Env::IOActivity::kFlush);
@@ -1058,7 +1059,8 @@ Status FlushJob::WriteLevel0Table() {
                    meta_.file_creation_time, meta_.epoch_number,
                    meta_.file_checksum, meta_.file_checksum_func_name,
                    meta_.unique_id, meta_.compensated_range_deletion_size,
-                   meta_.tail_size, meta_.user_defined_timestamps_persisted);
+                   meta_.tail_size, meta_.user_defined_timestamps_persisted,
+                   meta_.compression_dict_id);
     edit_->SetBlobFileAdditions(std::move(blob_file_additions));
   }
   // Piggyback FlushJobInfo on the first first flushed memtable.
@@ -0,0 +1,296 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/multi_get_async.h"
+
+#include "db/column_family.h"
+#include "db/db_impl/db_impl.h"
+#include "db/dbformat.h"
+#include "db/version_set.h"
+#include "file/random_access_file_reader.h"
+#include "test_util/sync_point.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+MultiGetAsyncLookup::BlockRead::~BlockRead() {
+  if (io_handle != nullptr && del_fn != nullptr) {
+    del_fn(io_handle);
+  }
+}
+
+MultiGetAsyncLookup::MultiGetAsyncLookup(DBImpl* db,
+                                         const ReadOptions& read_options,
+                                         ColumnFamilyHandle* column_family,
+                                         const std::vector<Slice>& keys,
+                                         MultiGetAsyncCallback callback)
+    : db_(db),
+      column_family_(column_family != nullptr ? column_family
+                                              : db->DefaultColumnFamily()),
+      read_options_(read_options),
+      callback_(std::move(callback)),
+      statuses_(keys.size()),
+      values_(keys.size()),
+      resolved_(keys.size(), false),
+      waiting_(keys.size(), false),
+      last_read_(keys.size(), {nullptr, 0}),
+      num_unresolved_(keys.size()) {
+  keys_.reserve(keys.size());
+  for (const Slice& key : keys) {
+    keys_.emplace_back(key.ToString());
+  }
+  // The keys are looked up several times, and must see the same data each time
+  if (read_options_.snapshot == nullptr) {
+    snapshot_ = db_->GetSnapshot();
+    read_options_.snapshot = snapshot_;
+  }
+  if (read_options_.timestamp != nullptr) {
+    timestamp_ = read_options_.timestamp->ToString();
+    timestamp_slice_ = timestamp_;
+    read_options_.timestamp = &timestamp_slice_;
+  }
+}
+
+MultiGetAsyncLookup::~MultiGetAsyncLookup() {
+  assert(reads_.empty());
+  if (snapshot_ != nullptr) {
+    db_->ReleaseSnapshot(snapshot_);
+  }
+}
+
+bool MultiGetAsyncLookup::Advance() {
+  bool has_completed_reads;
+  do {
+    for (auto it = reads_.begin(); it != reads_.end();) {
+      if ((*it)->completed) {
+        CompleteRead(it->get());
+        it = reads_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    LookUpKeys();
+    // Reads may complete synchronously, e.g. when the file system does not
+    // support asynchronous reads
+    has_completed_reads = false;
+    for (const auto& read : reads_) {
+      has_completed_reads |= read->completed;
+    }
+  } while (has_completed_reads);
+  return num_unresolved_ == 0;
+}
+
+void MultiGetAsyncLookup::WaitForRead() {
+  BlockRead* wait_for = nullptr;
+  for (const auto& read : reads_) {
+    if (read->completed) {
+      return;
+    }
+    if (wait_for == nullptr && read->io_handle != nullptr) {
+      wait_for = read.get();
+    }
+  }
+  if (wait_for == nullptr) {
+    return;
+  }
+  FileSystem* fs = db_->GetFileSystem();
+  std::vector<void*> handles{wait_for->io_handle};
+  IOStatus s = fs->Poll(handles, 1);
+  if (!s.ok() && !wait_for->completed) {
+    fs->AbortIO(handles).PermitUncheckedError();
+    wait_for->status = s;
+    wait_for->completed = true;
+  }
+}
+
+void MultiGetAsyncLookup::Finish() {
+  assert(num_unresolved_ == 0);
+  callback_(std::move(statuses_), std::move(values_));
+}
+
+void MultiGetAsyncLookup::LookUpKeys() {
+  std::vector<size_t> indexes;
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    if (!resolved_[i] && !waiting_[i]) {
+      indexes.push_back(i);
+    }
+  }
+  if (indexes.empty()) {
+    return;
+  }
+
+  // Without filling the block cache, the reads would not help the next lookup
+  const bool async = read_options_.read_tier == kReadAllTier &&
+                     read_options_.fill_cache;
+  ReadOptions ro = read_options_;
+  if (async) {
+    ro.read_tier = kBlockCacheTier;
+  }
+  std::vector<Slice> keys;
+  keys.reserve(indexes.size());
+  for (size_t i : indexes) {
+    keys.emplace_back(keys_[i]);
+  }
+  std::vector<PinnableSlice> values(indexes.size());
+  std::vector<Status> statuses(indexes.size());
+  db_->MultiGet(ro, column_family_, keys.size(), keys.data(), values.data(),
+                statuses.data());
+
+  SuperVersion* sv = nullptr;
+  for (size_t j = 0; j < indexes.size(); ++j) {
+    const size_t i = indexes[j];
+    if (async && statuses[j].IsIncomplete()) {
+      if (sv == nullptr) {
+        auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(
+            column_family_);
+        sv = cfh->cfd()->GetReferencedSuperVersion(db_);
+      }
+      IssueRead(i, sv);
+    } else {
+      statuses_[i] = statuses[j];
+      values_[i] = std::move(values[j]);
+      resolved_[i] = true;
+      --num_unresolved_;
+    }
+  }
+  if (sv != nullptr) {
+    db_->CleanupSuperVersion(sv);
+  }
+}
+
+void MultiGetAsyncLookup::IssueRead(size_t key_index, SuperVersion* sv) {
+  std::unique_ptr<BlockRead> read(new BlockRead);
+  TableReader::AsyncBlockRead* block = &read->block;
+  LookupKey lkey(keys_[key_index],
+                 read_options_.snapshot != nullptr
+                     ? read_options_.snapshot->GetSequenceNumber()
+                     : kMaxSequenceNumber,
+                 read_options_.timestamp);
+  Status s = sv->current->PrepareAsyncGet(read_options_, lkey, block);
+  if (!s.ok() && !s.IsNotSupported()) {
+    statuses_[key_index] = s;
+    resolved_[key_index] = true;
+    --num_unresolved_;
+    return;
+  }
+  const std::pair<const void*, uint64_t> block_id(block->file, block->offset);
+  if (!s.ok() || block->len == 0 || block_id == last_read_[key_index]) {
+    // Either the missing data is not in a data block, or the block was
+    // evicted before the key could be looked up again
+    LookUpSync(key_index);
+    return;
+  }
+  last_read_[key_index] = block_id;
+  waiting_[key_index] = true;
+  for (const auto& other : reads_) {
+    if (other->block.file == block->file &&
+        other->block.offset == block->offset) {
+      other->keys.push_back(key_index);
+      return;
+    }
+  }
+  read->keys.push_back(key_index);
+
+  TEST_SYNC_POINT("MultiGetAsyncLookup::IssueRead");
+  block->buf.reset(new char[block->len]);
+  IOOptions opts;
+  IOStatus io_s = block->file->PrepareIOOptions(read_options_, opts);
+  if (io_s.ok()) {
+    FSReadRequest req;
+    req.offset = block->offset;
+    req.len = block->len;
+    req.scratch = block->buf.get();
+    auto cb = [](const FSReadRequest& done_req, void* cb_arg) {
+      auto* done = static_cast<BlockRead*>(cb_arg);
+      done->block.result = done_req.result;
+      done->status = done_req.status;
+      done->completed = true;
+    };
+    io_s = block->file->ReadAsync(req, opts, cb, read.get(), &read->io_handle,
+                                  &read->del_fn, /*aligned_buf=*/nullptr);
+    if (io_s.IsNotSupported()) {
+      io_s = block->file->Read(opts, block->offset, block->len,
+                               &block->result, block->buf.get(),
+                               /*aligned_buf=*/nullptr);
+      read->status = io_s;
+      read->completed = true;
+    }
+  }
+  if (!io_s.ok()) {
+    read->status = io_s;
+    read->completed = true;
+  }
+  reads_.push_back(std::move(read));
+}
+
+void MultiGetAsyncLookup::CompleteRead(BlockRead* read) {
+  Status s = read->status;
+  if (s.ok()) {
+    s = read->block.table->CompleteAsyncGet(read_options_, &read->block);
+  }
+  for (size_t i : read->keys) {
+    waiting_[i] = false;
+    if (!s.ok()) {
+      statuses_[i] = s;
+      resolved_[i] = true;
+      --num_unresolved_;
+    }
+  }
+}
+
+void MultiGetAsyncLookup::LookUpSync(size_t key_index) {
+  statuses_[key_index] = db_->Get(read_options_, column_family_,
+                                  keys_[key_index], &values_[key_index]);
+  resolved_[key_index] = true;
+  --num_unresolved_;
+}
+
+MultiGetAsyncQueueImpl::~MultiGetAsyncQueueImpl() {
+  while (!lookups_.empty()) {
+    Poll(lookups_.size());
+  }
+}
+
+size_t MultiGetAsyncQueueImpl::Poll(size_t min_completions) {
+  size_t completed = 0;
+  while (!lookups_.empty()) {
+    for (auto it = lookups_.begin(); it != lookups_.end();) {
+      if ((*it)->Advance()) {
+        // The callback may start new lookups
+        std::unique_ptr<MultiGetAsyncLookup> lookup = std::move(*it);
+        it = lookups_.erase(it);
+        lookup->Finish();
+        ++completed;
+      } else {
+        ++it;
+      }
+    }
+    if (completed >= min_completions || lookups_.empty()) {
+      break;
+    }
+    lookups_.front()->WaitForRead();
+  }
+  return completed;
+}
+
+void MultiGetAsyncQueueImpl::Add(std::unique_ptr<MultiGetAsyncLookup>&& lookup) {
+  // Issue the reads right away, the callback is invoked from Poll()
+  lookup->Advance();
+  lookups_.push_back(std::move(lookup));
+}
+
+std::unique_ptr<MultiGetAsyncQueue> NewMultiGetAsyncQueue() {
+  return std::unique_ptr<MultiGetAsyncQueue>(new MultiGetAsyncQueueImpl());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
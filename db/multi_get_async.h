@@ -0,0 +1,119 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rocksdb/db.h"
+#include "rocksdb/file_system.h"
+#include "table/table_reader.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class DBImpl;
+struct SuperVersion;
+
+// The keys of a single DB::MultiGetAsync() call.
+//
+// Keys are first looked up with a block cache only MultiGet(). For each key
+// that needs I/O, the current version locates the first data block that is
+// not in the block cache (reading filters and indexes synchronously) and the
+// block is read through FileSystem::ReadAsync(). Once the read completes, the
+// block is inserted into the block cache and the key is looked up from memory
+// again, until it is resolved. Keys that cannot make progress this way, like
+// keys with blob values, are looked up synchronously.
+class MultiGetAsyncLookup {
+ public:
+  MultiGetAsyncLookup(DBImpl* db, const ReadOptions& read_options,
+                      ColumnFamilyHandle* column_family,
+                      const std::vector<Slice>& keys,
+                      MultiGetAsyncCallback callback);
+  ~MultiGetAsyncLookup();
+
+  // No copying allowed
+  MultiGetAsyncLookup(const MultiGetAsyncLookup&) = delete;
+  MultiGetAsyncLookup& operator=(const MultiGetAsyncLookup&) = delete;
+
+  // Processes the reads that completed and issues reads for the keys that
+  // need them, without waiting. Returns true once all keys are resolved.
+  bool Advance();
+
+  // Waits for at least one of the reads in flight to complete
+  void WaitForRead();
+
+  // Invokes the callback with the results. REQUIRES: Advance() returned true
+  void Finish();
+
+ private:
+  // A block read in flight, shared by all the keys waiting for it
+  struct BlockRead {
+    ~BlockRead();
+
+    TableReader::AsyncBlockRead block;
+    std::vector<size_t> keys;
+    void* io_handle = nullptr;
+    IOHandleDeleter del_fn;
+    IOStatus status;
+    bool completed = false;
+  };
+
+  // Looks up the keys that are neither resolved nor waiting for a read
+  void LookUpKeys();
+  void IssueRead(size_t key_index, SuperVersion* sv);
+  void CompleteRead(BlockRead* read);
+  void LookUpSync(size_t key_index);
+
+  DBImpl* const db_;
+  ColumnFamilyHandle* const column_family_;
+  ReadOptions read_options_;
+  const Snapshot* snapshot_ = nullptr;
+  std::string timestamp_;
+  Slice timestamp_slice_;
+  MultiGetAsyncCallback callback_;
+
+  std::vector<std::string> keys_;
+  std::vector<Status> statuses_;
+  std::vector<PinnableSlice> values_;
+  // Whether a key is resolved, or else waiting for a read
+  std::vector<bool> resolved_;
+  std::vector<bool> waiting_;
+  // The last block read for a key, to detect blocks that get evicted from
+  // the block cache before the key could be looked up again
+  std::vector<std::pair<const void*, uint64_t>> last_read_;
+  size_t num_unresolved_;
+
+  std::list<std::unique_ptr<BlockRead>> reads_;
+};
+
+class MultiGetAsyncQueueImpl : public MultiGetAsyncQueue {
+ public:
+  MultiGetAsyncQueueImpl() = default;
+  ~MultiGetAsyncQueueImpl() override;
+
+  size_t NumInFlight() const override { return lookups_.size(); }
+
+  size_t Poll(size_t min_completions) override;
+
+  void Add(std::unique_ptr<MultiGetAsyncLookup>&& lookup);
+
+ private:
+  std::list<std::unique_ptr<MultiGetAsyncLookup>> lookups_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
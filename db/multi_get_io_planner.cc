@@ -0,0 +1,191 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/multi_get_io_planner.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "file/random_access_file_reader.h"
+#include "rocksdb/file_system.h"
+#include "test_util/sync_point.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+MultiGetIOPlanner::Read::~Read() {
+  if (io_handle != nullptr && del_fn != nullptr) {
+    del_fn(io_handle);
+  }
+}
+
+void MultiGetIOPlanner::Add(
+    std::unique_ptr<TableReader::AsyncBlockRead>&& block) {
+  assert(block->len > 0);
+  blocks_.push_back(std::move(block));
+}
+
+void MultiGetIOPlanner::Execute(FileSystem* fs, bool use_async_io) {
+  if (blocks_.empty()) {
+    return;
+  }
+  std::sort(blocks_.begin(), blocks_.end(),
+            [](const std::unique_ptr<TableReader::AsyncBlockRead>& a,
+               const std::unique_ptr<TableReader::AsyncBlockRead>& b) {
+              return a->file != b->file ? a->file < b->file
+                                        : a->offset < b->offset;
+            });
+
+  // Merge the blocks into reads of contiguous ranges. Several keys may need
+  // the same block, which is then only read and inserted once.
+  std::vector<std::unique_ptr<Read>> reads;
+  const TableReader::AsyncBlockRead* prev = nullptr;
+  for (const auto& block : blocks_) {
+    if (prev != nullptr && prev->file == block->file &&
+        prev->offset == block->offset) {
+      continue;
+    }
+    prev = block.get();
+    Read* last = reads.empty() ? nullptr : reads.back().get();
+    if (last != nullptr && last->file == block->file &&
+        last->offset + last->len == block->offset) {
+      last->len += block->len;
+    } else {
+      reads.emplace_back(new Read);
+      last = reads.back().get();
+      last->file = block->file;
+      last->offset = block->offset;
+      last->len = block->len;
+    }
+    last->blocks.push_back(block.get());
+  }
+#ifndef NDEBUG
+  size_t num_reads = reads.size();
+  TEST_SYNC_POINT_CALLBACK("MultiGetIOPlanner::Execute:NumReads", &num_reads);
+#endif  // NDEBUG
+
+  // Submit all reads before waiting for any of them
+  std::vector<Read*> sync_reads;
+  std::vector<void*> io_handles;
+  for (const auto& read : reads) {
+    IOOptions opts;
+    read->status = read->file->PrepareIOOptions(read_options_, opts);
+    if (!read->status.ok()) {
+      continue;
+    }
+    if (!use_async_io) {
+      sync_reads.push_back(read.get());
+      continue;
+    }
+    read->buf.reset(new char[read->len]);
+    FSReadRequest req;
+    req.offset = read->offset;
+    req.len = read->len;
+    req.scratch = read->buf.get();
+    auto cb = [](const FSReadRequest& done_req, void* cb_arg) {
+      auto* done = static_cast<Read*>(cb_arg);
+      done->result = done_req.result;
+      done->status = done_req.status;
+    };
+    IOStatus s =
+        read->file->ReadAsync(req, opts, cb, read.get(), &read->io_handle,
+                              &read->del_fn, /*aligned_buf=*/nullptr);
+    if (s.IsNotSupported()) {
+      sync_reads.push_back(read.get());
+    } else if (!s.ok()) {
+      read->status = s;
+    } else if (read->io_handle != nullptr) {
+      io_handles.push_back(read->io_handle);
+    }
+  }
+  ReadSync(sync_reads);
+  if (!io_handles.empty()) {
+    IOStatus s = fs->Poll(io_handles, io_handles.size());
+    if (!s.ok()) {
+      // The blocks are read again by the lookup
+      fs->AbortIO(io_handles).PermitUncheckedError();
+      for (const auto& read : reads) {
+        if (read->io_handle != nullptr) {
+          read->status = s;
+        }
+      }
+    }
+  }
+
+  for (const auto& read : reads) {
+    CompleteRead(read.get());
+  }
+  blocks_.clear();
+}
+
+void MultiGetIOPlanner::ReadSync(std::vector<Read*>& reads) {
+  // The reads are sorted by file, so a MultiRead() is issued per file
+  size_t start = 0;
+  while (start < reads.size()) {
+    RandomAccessFileReader* file = reads[start]->file;
+    size_t end = start + 1;
+    while (end < reads.size() && reads[end]->file == file) {
+      ++end;
+    }
+    std::vector<FSReadRequest> reqs(end - start);
+    for (size_t i = start; i < end; ++i) {
+      Read* read = reads[i];
+      FSReadRequest& req = reqs[i - start];
+      req.offset = read->offset;
+      req.len = read->len;
+      if (!file->use_direct_io()) {
+        read->buf.reset(new char[read->len]);
+        req.scratch = read->buf.get();
+      }
+    }
+    IOOptions opts;
+    AlignedBuf direct_io_buf;
+    IOStatus s = file->PrepareIOOptions(read_options_, opts);
+    if (s.ok()) {
+      s = file->MultiRead(opts, reqs.data(), reqs.size(), &direct_io_buf);
+    }
+    for (size_t i = start; i < end; ++i) {
+      Read* read = reads[i];
+      const FSReadRequest& req = reqs[i - start];
+      read->status = s.ok() ? req.status : s;
+      if (read->status.ok() && file->use_direct_io()) {
+        // The results point into the shared aligned buffer
+        read->buf.reset(new char[req.result.size()]);
+        memcpy(read->buf.get(), req.result.data(), req.result.size());
+        read->result = Slice(read->buf.get(), req.result.size());
+      } else {
+        read->result = req.result;
+      }
+    }
+    start = end;
+  }
+}
+
+void MultiGetIOPlanner::CompleteRead(Read* read) {
+  if (!read->status.ok()) {
+    read->status.PermitUncheckedError();
+    return;
+  }
+  for (TableReader::AsyncBlockRead* block : read->blocks) {
+    const uint64_t pos = block->offset - read->offset;
+    if (pos + block->len > read->result.size()) {
+      break;
+    }
+    block->buf.reset(new char[block->len]);
+    memcpy(block->buf.get(), read->result.data() + pos, block->len);
+    block->result = Slice(block->buf.get(), block->len);
+    block->table->CompleteAsyncGet(read_options_, block).PermitUncheckedError();
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,78 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "rocksdb/options.h"
+#include "table/table_reader.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class FileSystem;
+
+// Reads the data blocks a MultiGet() batch needs from table files of all
+// levels into the block cache in a single round of I/O (see
+// ReadOptions::multiget_single_round_io).
+//
+// The blocks are located up front with TableReader::PrepareAsyncGet() and
+// added to the planner. Execute() then sorts the blocks of each file, merges
+// adjacent ones into single reads, and submits the reads of all files before
+// waiting for any of them: with FileSystem::ReadAsync() when the file system
+// supports it, and otherwise with one MultiRead() per file. Failed reads are
+// ignored, as the lookup that follows reads the blocks again and reports
+// the error.
+class MultiGetIOPlanner {
+ public:
+  explicit MultiGetIOPlanner(const ReadOptions& read_options)
+      : read_options_(read_options) {}
+
+  // No copying allowed
+  MultiGetIOPlanner(const MultiGetIOPlanner&) = delete;
+  MultiGetIOPlanner& operator=(const MultiGetIOPlanner&) = delete;
+
+  void Add(std::unique_ptr<TableReader::AsyncBlockRead>&& block);
+
+  size_t NumBlocks() const { return blocks_.size(); }
+
+  // Reads the blocks added so far and inserts them into the block cache
+  void Execute(FileSystem* fs, bool use_async_io);
+
+ private:
+  // A contiguous range of a file covering one or more blocks
+  struct Read {
+    ~Read();
+
+    RandomAccessFileReader* file = nullptr;
+    uint64_t offset = 0;
+    size_t len = 0;
+    std::vector<TableReader::AsyncBlockRead*> blocks;
+    std::unique_ptr<char[]> buf;
+    Slice result;
+    IOStatus status;
+    void* io_handle = nullptr;
+    IOHandleDeleter del_fn;
+    bool submitted = false;
+  };
+
+  void ReadSync(std::vector<Read*>& reads);
+  void CompleteRead(Read* read);
+
+  const ReadOptions& read_options_;
+  std::vector<std::unique_ptr<TableReader::AsyncBlockRead>> blocks_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -41,6 +41,7 @@ static const std::map<PeriodicTaskType, uint64_t> kDefaultPeriodSeconds = {
     {PeriodicTaskType::kFlushInfoLog, 10},
     {PeriodicTaskType::kRecordSeqnoTime, kInvalidPeriodSec},
     {PeriodicTaskType::kRefreshOptions, kInvalidPeriodSec},
+    {PeriodicTaskType::kPersistHotBlocks, kInvalidPeriodSec},
 };
 
 static const std::map<PeriodicTaskType, std::string> kPeriodicTaskTypeNames = {
@@ -49,6 +50,7 @@ static const std::map<PeriodicTaskType, std::string> kPeriodicTaskTypeNames = {
     {PeriodicTaskType::kFlushInfoLog, "flush_info_log"},
     {PeriodicTaskType::kRecordSeqnoTime, "record_seq_time"},
     {PeriodicTaskType::kRefreshOptions, "refresh_options"},
+    {PeriodicTaskType::kPersistHotBlocks, "persist_hot_blocks"},
 };
 
 Status PeriodicTaskScheduler::Register(PeriodicTaskType task_type,
@@ -37,6 +37,7 @@ enum class PeriodicTaskType : uint8_t {
   kFlushInfoLog,
   kRecordSeqnoTime,
   kRefreshOptions,
+  kPersistHotBlocks,
   kMax,
 };
 
@@ -579,6 +579,7 @@ class Repairer {
       t->meta.oldest_ancester_time = props->creation_time;
       t->meta.user_defined_timestamps_persisted =
           static_cast<bool>(props->user_defined_timestamps_persisted);
+      t->meta.compression_dict_id = props->compression_dict_id;
     }
     if (status.ok()) {
       uint64_t tail_size = 0;
@@ -724,7 +725,8 @@ class Repairer {
             table->meta.epoch_number, table->meta.file_checksum,
             table->meta.file_checksum_func_name, table->meta.unique_id,
             table->meta.compensated_range_deletion_size, table->meta.tail_size,
-            table->meta.user_defined_timestamps_persisted);
+            table->meta.user_defined_timestamps_persisted,
+            table->meta.compression_dict_id);
       }
       s = dummy_version_builder.Apply(&dummy_edit);
       if (s.ok()) {
@@ -4,6 +4,7 @@
 //  (found in the LICENSE.Apache file in the root directory).
 
 #include <algorithm>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -169,6 +170,74 @@ TEST_F(RepairTest, LostManifestMoreDbFeatures) {
   ASSERT_EQ(Get("key4"), "val4");
 }
 
+TEST_F(RepairTest, LostManifestSharedCompressionDict) {
+  if (!ZSTD_Supported()) {
+    ROCKSDB_GTEST_SKIP("Test requires ZSTD support");
+    return;
+  }
+  // Files compressed with a shared dictionary keep a copy of it, so they are
+  // still readable after RepairDB() rebuilt a MANIFEST without the dictionary.
+  Options options = CurrentOptions();
+  options.compression = kZSTD;
+  options.compression_opts.max_dict_bytes = 8 << 10;  // 8KB
+  options.compression_opts.use_shared_dict = true;
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 4 << 10;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  auto write_file = [&](int file) {
+    for (int i = 0; i < 512; ++i) {
+      std::string key = Key(file * 512 + i);
+      std::string value;
+      test::CompressibleString(&rnd, 0.5, 1 << 10, &value);
+      ASSERT_OK(Put(key, value));
+      expected[key] = value;
+    }
+    ASSERT_OK(Flush());
+  };
+  // The first compaction trains the shared dictionary, the second one
+  // rewrites all the data with it. The files would otherwise only be moved.
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  write_file(0);
+  write_file(1);
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  write_file(2);
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  TablePropertiesCollection props;
+  ASSERT_OK(db_->GetPropertiesOfAllTables(&props));
+  ASSERT_FALSE(props.empty());
+  for (const auto& prop : props) {
+    ASSERT_NE(uint64_t{0}, prop.second->compression_dict_id);
+  }
+  std::string manifest_path =
+      DescriptorFileName(dbname_, dbfull()->TEST_Current_Manifest_FileNo());
+
+  Close();
+  ASSERT_OK(env_->DeleteFile(manifest_path));
+  ASSERT_OK(RepairDB(dbname_, options));
+  // No file was given up on
+  std::vector<std::string> lost_files;
+  if (env_->GetChildren(dbname_ + "/lost", &lost_files).ok()) {
+    for (const auto& file : lost_files) {
+      uint64_t number;
+      FileType type;
+      ASSERT_FALSE(ParseFileName(file, &number, &type) && type == kTableFile)
+          << file;
+    }
+  }
+  Reopen(options);
+
+  for (const auto& kv : expected) {
+    ASSERT_EQ(kv.second, Get(kv.first));
+  }
+  ASSERT_OK(db_->VerifyChecksum());
+}
+
 TEST_F(RepairTest, CorruptManifest) {
   // Manifest is in an invalid format. Expect a full recovery.
   ASSERT_OK(Put("key", "val"));
@@ -840,6 +840,174 @@ TEST_P(SeqnoTimeTablePropTest, DISABLED_SeqnoToTimeMappingUniversal) {
   Close();
 }
 
+TEST_F(SeqnoTimeTest, KeyPrefixRetention) {
+  const int kNumKeys = 10;
+  const int kStepSeconds = 30;
+
+  Options options = CurrentOptions();
+  options.env = mock_env_.get();
+  options.key_prefix_retentions = {{"a", 1000}, {"b", 3000}};
+  DestroyAndReopen(options);
+
+  int num_deletions = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "LevelCompactionPicker::PickCompaction:Return", [&](void* arg) {
+        auto* c = static_cast<Compaction*>(arg);
+        if (c != nullptr && c->deletion_compaction()) {
+          ASSERT_EQ(c->compaction_reason(),
+                    CompactionReason::kKeyPrefixRetention);
+          num_deletions++;
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  // Writes a key without retention per step, so that the time of the
+  // sequence numbers keeps being sampled
+  int num_steps = 0;
+  auto pass_time = [&](int steps) {
+    for (int i = 0; i < steps; i++) {
+      ASSERT_OK(Put("c" + Key(num_steps++), "value"));
+      dbfull()->TEST_WaitForPeriodicTaskRun(
+          [&] { mock_clock_->MockSleepForSeconds(kStepSeconds); });
+    }
+  };
+  auto get_file_number = [&](char prefix) -> uint64_t {
+    std::vector<LiveFileMetaData> files;
+    db_->GetLiveFilesMetaData(&files);
+    for (const auto& file : files) {
+      if (file.smallestkey[0] == prefix) {
+        EXPECT_EQ(file.largestkey[0], prefix);
+        return file.file_number;
+      }
+    }
+    return 0;
+  };
+
+  pass_time(1);
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put("a" + Key(i), "value"));
+    ASSERT_OK(Put("b" + Key(i), "value"));
+  }
+  ASSERT_OK(Flush());
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+
+  // The outputs are partitioned by retention
+  ASSERT_NE(get_file_number('a'), 0);
+  const uint64_t b_file_number = get_file_number('b');
+  ASSERT_NE(b_file_number, 0);
+
+  // The file of the "a" keys is deleted once they expire, and the other
+  // files are kept as is
+  pass_time(40);
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(get_file_number('a'), 0);
+  ASSERT_EQ(get_file_number('b'), b_file_number);
+  ASSERT_GT(num_deletions, 0);
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_EQ("NOT_FOUND", Get("a" + Key(i)));
+    ASSERT_EQ("value", Get("b" + Key(i)));
+  }
+
+  // A file that holds both expired and live keys is compacted to drop the
+  // expired ones
+  for (int i = kNumKeys; i < 2 * kNumKeys; i++) {
+    ASSERT_OK(Put("b" + Key(i), "value"));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  for (int i = 0; i < 2 * kNumKeys; i++) {
+    ASSERT_EQ("value", Get("b" + Key(i)));
+  }
+
+  pass_time(65);
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_EQ("NOT_FOUND", Get("b" + Key(i)));
+  }
+  for (int i = kNumKeys; i < 2 * kNumKeys; i++) {
+    ASSERT_EQ("value", Get("b" + Key(i)));
+  }
+  for (int i = 0; i < num_steps; i++) {
+    ASSERT_EQ("value", Get("c" + Key(i)));
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  Close();
+}
+
+TEST_F(SeqnoTimeTest, KeyPrefixRetentionAboveOlderVersions) {
+  const int kStepSeconds = 30;
+
+  Options options = CurrentOptions();
+  options.env = mock_env_.get();
+  options.disable_auto_compactions = true;
+  options.key_prefix_retentions = {{"a", 1000}};
+  DestroyAndReopen(options);
+
+  std::vector<int> deletion_levels;
+  SyncPoint::GetInstance()->SetCallBack(
+      "LevelCompactionPicker::PickCompaction:Return", [&](void* arg) {
+        auto* c = static_cast<Compaction*>(arg);
+        if (c != nullptr && c->deletion_compaction()) {
+          deletion_levels.push_back(c->start_level());
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  int num_steps = 0;
+  auto pass_time = [&](int steps) {
+    for (int i = 0; i < steps; i++) {
+      ASSERT_OK(Put("c" + Key(num_steps++), "value"));
+      dbfull()->TEST_WaitForPeriodicTaskRun(
+          [&] { mock_clock_->MockSleepForSeconds(kStepSeconds); });
+    }
+  };
+
+  // Older versions in the last level and in L2
+  pass_time(1);
+  ASSERT_OK(Put("a1", "old"));
+  ASSERT_OK(Put("a2", "old"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(6);
+  ASSERT_OK(Put("a1", "mid"));
+  ASSERT_OK(Put("a2", "mid"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+  // Newer versions in L1
+  ASSERT_OK(Delete("a1"));
+  ASSERT_OK(Put("a2", "new"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+
+  // Once all of them expired, a compaction of L1 into L2 keeps tombstones for
+  // the keys that still are in the last level
+  pass_time(40);
+  ASSERT_OK(dbfull()->TEST_CompactRange(1, nullptr, nullptr));
+  ASSERT_EQ(NumTableFilesAtLevel(1), 0);
+  ASSERT_EQ(NumTableFilesAtLevel(2), 1);
+  ASSERT_EQ("NOT_FOUND", Get("a1"));
+  ASSERT_EQ("NOT_FOUND", Get("a2"));
+
+  // The file of the tombstones is only deleted once the file of the older
+  // versions below it is
+  ASSERT_OK(db_->SetOptions({{"disable_auto_compactions", "false"}}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(deletion_levels, std::vector<int>({6, 2}));
+  ASSERT_EQ(NumTableFilesAtLevel(2), 0);
+  ASSERT_EQ("NOT_FOUND", Get("a1"));
+  ASSERT_EQ("NOT_FOUND", Get("a2"));
+  for (int i = 0; i < num_steps; i++) {
+    ASSERT_EQ("value", Get("c" + Key(i)));
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  Close();
+}
+
 TEST_F(SeqnoTimeTest, MappingAppend) {
   SeqnoToTimeMapping test(/*max_time_duration=*/100, /*max_capacity=*/10);
 
@@ -179,6 +179,7 @@ Status TableCache::GetTableReader(
         file_meta.user_defined_timestamps_persisted);
 
     table_reader_options.cache_owner_id = cache_owner_id_;
+    table_reader_options.compression_dict_service = compression_dict_service_;
 
     s = ioptions_.table_factory->NewTableReader(
         ro, table_reader_options, std::move(file_reader),
@@ -681,6 +682,89 @@ size_t TableCache::GetMemoryUsageByTableReader(
   return ret;
 }
 
+void TableCache::GetHotBlocks(
+    const FileOptions& file_options, const ReadOptions& read_options,
+    const InternalKeyComparator& internal_comparator,
+    const FileMetaData& file_meta, uint8_t block_protection_bytes_per_key,
+    const std::shared_ptr<const SliceTransform>& prefix_extractor,
+    std::vector<TableReader::HotBlock>* blocks) {
+  auto table_reader = file_meta.fd.table_reader;
+  if (table_reader) {
+    table_reader->GetHotBlocks(blocks);
+    return;
+  }
+
+  TypedHandle* table_handle = nullptr;
+  Status s = FindTable(read_options, file_options, internal_comparator,
+                       file_meta, &table_handle, block_protection_bytes_per_key,
+                       prefix_extractor, true /* no_io */);
+  if (!s.ok()) {
+    return;
+  }
+  assert(table_handle);
+  cache_.Value(table_handle)->GetHotBlocks(blocks);
+  cache_.Release(table_handle);
+}
+
+Status TableCache::WarmUpBlocks(
+    const ReadOptions& read_options,
+    const InternalKeyComparator& internal_comparator,
+    const FileMetaData& file_meta, uint8_t block_protection_bytes_per_key,
+    const std::shared_ptr<const SliceTransform>& prefix_extractor,
+    const std::vector<TableReader::HotBlock>& blocks) {
+  Status s;
+  TableReader* table_reader = file_meta.fd.table_reader;
+  TypedHandle* table_handle = nullptr;
+  if (table_reader == nullptr) {
+    s = FindTable(read_options, file_options_, internal_comparator, file_meta,
+                  &table_handle, block_protection_bytes_per_key,
+                  prefix_extractor, false /* no_io */);
+    if (s.ok()) {
+      table_reader = cache_.Value(table_handle);
+    }
+  }
+  if (s.ok()) {
+    s = table_reader->WarmUpBlocks(read_options, blocks);
+  }
+  if (table_handle != nullptr) {
+    cache_.Release(table_handle);
+  }
+  return s;
+}
+
+Status TableCache::PrepareAsyncGet(
+    const ReadOptions& read_options,
+    const InternalKeyComparator& internal_comparator,
+    const FileMetaData& file_meta, const Slice& k,
+    uint8_t block_protection_bytes_per_key,
+    const std::shared_ptr<const SliceTransform>& prefix_extractor,
+    bool skip_filters, int level, TableReader::AsyncBlockRead* block) {
+  Status s;
+  TableReader* table_reader = file_meta.fd.table_reader;
+  TypedHandle* table_handle = nullptr;
+  if (table_reader == nullptr) {
+    s = FindTable(read_options, file_options_, internal_comparator, file_meta,
+                  &table_handle, block_protection_bytes_per_key,
+                  prefix_extractor, false /* no_io */,
+                  nullptr /* file_read_hist */, skip_filters, level);
+    if (s.ok()) {
+      table_reader = cache_.Value(table_handle);
+    }
+  }
+  if (s.ok()) {
+    s = table_reader->PrepareAsyncGet(read_options, k, prefix_extractor.get(),
+                                      skip_filters, block);
+  }
+  if (table_handle != nullptr) {
+    if (s.ok() && block->len > 0) {
+      cache_.RegisterReleaseAsCleanup(table_handle, *block);
+    } else {
+      cache_.Release(table_handle);
+    }
+  }
+  return s;
+}
+
 void TableCache::Evict(Cache* cache, uint64_t file_number) {
   cache->Erase(GetSliceForFileNumber(&file_number));
 }
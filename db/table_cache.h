@@ -44,6 +44,7 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+class CompressionDictService;
 class Env;
 class Arena;
 struct FileDescriptor;
@@ -225,6 +226,36 @@ class TableCache {
       const FileMetaData& file_meta, uint8_t block_protection_bytes_per_key,
       const std::shared_ptr<const SliceTransform>& prefix_extractor = nullptr);
 
+  // Appends the hot data blocks of the file to `blocks`, see
+  // TableReader::GetHotBlocks(). Nothing if the table reader of the file is not
+  // loaded.
+  void GetHotBlocks(
+      const FileOptions& toptions, const ReadOptions& read_options,
+      const InternalKeyComparator& internal_comparator,
+      const FileMetaData& file_meta, uint8_t block_protection_bytes_per_key,
+      const std::shared_ptr<const SliceTransform>& prefix_extractor,
+      std::vector<TableReader::HotBlock>* blocks);
+
+  // Reads the given data blocks of the file into the block cache, loading
+  // the table reader if needed
+  Status WarmUpBlocks(
+      const ReadOptions& read_options,
+      const InternalKeyComparator& internal_comparator,
+      const FileMetaData& file_meta, uint8_t block_protection_bytes_per_key,
+      const std::shared_ptr<const SliceTransform>& prefix_extractor,
+      const std::vector<TableReader::HotBlock>& blocks);
+
+  // Finds the first data block of the file a lookup of `k` has to read, see
+  // TableReader::PrepareAsyncGet(). Loads the table reader if needed, and
+  // keeps it alive until `block` is reset or destroyed.
+  Status PrepareAsyncGet(
+      const ReadOptions& read_options,
+      const InternalKeyComparator& internal_comparator,
+      const FileMetaData& file_meta, const Slice& k,
+      uint8_t block_protection_bytes_per_key,
+      const std::shared_ptr<const SliceTransform>& prefix_extractor,
+      bool skip_filters, int level, TableReader::AsyncBlockRead* block);
+
   // Returns approximated offset of a key in a file represented by fd.
   uint64_t ApproximateOffsetOf(
       const ReadOptions& read_options, const Slice& key,
@@ -260,6 +291,10 @@ class TableCache {
     cache_owner_id_ = cache_owner_id;
   }
 
+  void SetCompressionDictService(CompressionDictService* service) {
+    compression_dict_service_ = service;
+  }
+
  private:
   // Build a table reader
   Status GetTableReader(
@@ -302,6 +337,7 @@ class TableCache {
   std::shared_ptr<IOTracer> io_tracer_;
   std::string db_session_id_;
   Cache::ItemOwnerId cache_owner_id_ = Cache::kUnknownItemOwnerId;
+  CompressionDictService* compression_dict_service_ = nullptr;
   IsLastLevelWithDataFunc is_last_level_with_data_func_;
 };
 
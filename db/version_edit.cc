@@ -91,6 +91,7 @@ void VersionEdit::Clear() {
   is_in_atomic_group_ = false;
   remaining_entries_ = 0;
   full_history_ts_low_.clear();
+  compression_dicts_.clear();
 }
 
 bool VersionEdit::EncodeTo(std::string* dst,
@@ -247,6 +248,12 @@ bool VersionEdit::EncodeTo(std::string* dst,
       PutVarint64(&varint_tail_size, f.tail_size);
       PutLengthPrefixedSlice(dst, Slice(varint_tail_size));
     }
+    if (f.compression_dict_id) {
+      PutVarint32(dst, NewFileCustomTag::kCompressionDictId);
+      std::string varint_compression_dict_id;
+      PutVarint64(&varint_compression_dict_id, f.compression_dict_id);
+      PutLengthPrefixedSlice(dst, Slice(varint_compression_dict_id));
+    }
     if (!f.user_defined_timestamps_persisted) {
       // The default value for the flag is true, it's only explicitly persisted
       // when it's false. We are putting 0 as the value here to signal false
@@ -318,6 +325,14 @@ bool VersionEdit::EncodeTo(std::string* dst,
     char p = static_cast<char>(persist_user_defined_timestamps_);
     PutLengthPrefixedSlice(dst, Slice(&p, 1));
   }
+
+  for (const auto& dict : compression_dicts_) {
+    PutVarint32(dst, kCompressionDict);
+    std::string encoded;
+    PutVarint64(&encoded, dict.first);
+    encoded.append(dict.second);
+    PutLengthPrefixedSlice(dst, encoded);
+  }
   return true;
 }
 
@@ -453,6 +468,11 @@ const char* VersionEdit::DecodeNewFile4From(Slice* input) {
           }
           f.user_defined_timestamps_persisted = (field[0] == 1);
           break;
+        case kCompressionDictId:
+          if (!GetVarint64(&field, &f.compression_dict_id)) {
+            return "invalid compression dictionary id";
+          }
+          break;
         default:
           if ((custom_tag & kCustomTagNonSafeIgnoreMask) != 0) {
             // Should not proceed if cannot understand it
@@ -798,6 +818,19 @@ Status VersionEdit::DecodeFrom(const Slice& src) {
         }
         break;
 
+      case kCompressionDict: {
+        uint64_t dict_id = 0;
+        if (!GetLengthPrefixedSlice(&input, &str) ||
+            !GetVarint64(&str, &dict_id)) {
+          msg = "compression dictionary";
+        } else if (dict_id == 0 || str.empty()) {
+          msg = "compression dictionary: empty";
+        } else {
+          compression_dicts_.emplace_back(dict_id, str.ToString());
+        }
+        break;
+      }
+
       default:
         if (tag & kTagSafeIgnoreMask) {
           // Tag from future which can be safely ignored.
@@ -924,6 +957,10 @@ std::string VersionEdit::DebugString(bool hex_key) const {
     AppendNumberTo(&r, f.tail_size);
     r.append(" User-defined timestamps persisted: ");
     r.append(f.user_defined_timestamps_persisted ? "true" : "false");
+    if (f.compression_dict_id) {
+      r.append(" compression dict id: ");
+      AppendNumberTo(&r, f.compression_dict_id);
+    }
   }
 
   for (const auto& blob_file_addition : blob_file_additions_) {
@@ -964,6 +1001,12 @@ std::string VersionEdit::DebugString(bool hex_key) const {
     r.append("\n FullHistoryTsLow: ");
     r.append(Slice(full_history_ts_low_).ToString(hex_key));
   }
+  for (const auto& dict : compression_dicts_) {
+    r.append("\n  CompressionDict: ");
+    AppendNumberTo(&r, dict.first);
+    r.append(" size: ");
+    AppendNumberTo(&r, dict.second.size());
+  }
   r.append("\n}\n");
   return r;
 }
@@ -1042,6 +1085,9 @@ std::string VersionEdit::DebugJSON(int edit_num, bool hex_key) const {
       jw << "TailSize" << f.tail_size;
       jw << "UserDefinedTimestampsPersisted"
          << f.user_defined_timestamps_persisted;
+      if (f.compression_dict_id) {
+        jw << "CompressionDictId" << f.compression_dict_id;
+      }
       jw.EndArrayedObject();
     }
 
@@ -1113,6 +1159,17 @@ std::string VersionEdit::DebugJSON(int edit_num, bool hex_key) const {
     jw << "FullHistoryTsLow" << Slice(full_history_ts_low_).ToString(hex_key);
   }
 
+  if (!compression_dicts_.empty()) {
+    jw << "CompressionDicts";
+    jw.StartArray();
+    for (const auto& dict : compression_dicts_) {
+      jw.StartArrayedObject();
+      jw << "ID" << dict.first << "Size" << dict.second.size();
+      jw.EndArrayedObject();
+    }
+    jw.EndArray();
+  }
+
   jw.EndObject();
 
   return jw.Get();
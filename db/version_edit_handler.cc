@@ -14,6 +14,7 @@
 
 #include "db/blob/blob_file_reader.h"
 #include "db/blob/blob_source.h"
+#include "db/compression_dict_service.h"
 #include "db/version_edit.h"
 #include "logging/logging.h"
 #include "monitoring/persistent_stats_history.h"
@@ -634,6 +635,9 @@ Status VersionEditHandler::ExtractInfoFromVersionEdit(ColumnFamilyData* cfd,
       const std::string& new_ts = edit.GetFullHistoryTsLow();
       cfd->SetFullHistoryTsLow(new_ts);
     }
+    for (const auto& dict : edit.GetCompressionDicts()) {
+      cfd->compression_dict_service()->AddDict(dict.first, dict.second);
+    }
   }
 
   if (s.ok()) {
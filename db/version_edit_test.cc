@@ -670,6 +670,46 @@ TEST_F(VersionEditTest, IgnorableTags) {
   SyncPoint::GetInstance()->DisableProcessing();
 }
 
+// Shared compression dictionaries and the references to them must not be
+// dropped by versions that ignore the ignorable tags.
+TEST_F(VersionEditTest, CompressionDictsAreNotIgnorable) {
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  SyncPoint::GetInstance()->SetCallBack(
+      "VersionEdit::EncodeTo:IgnoreIgnorableTags", [&](void* arg) {
+        bool* ignore = static_cast<bool*>(arg);
+        *ignore = true;
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  constexpr uint64_t kDictId = 7;
+
+  VersionEdit edit;
+  edit.AddCompressionDict(kDictId, "dict");
+  edit.AddFile(3, 300, 3, 100, InternalKey("foo", 500, kTypeValue),
+               InternalKey("zoo", 600, kTypeDeletion), 500, 600, false,
+               Temperature::kUnknown, kInvalidBlobFileNumber,
+               kUnknownOldestAncesterTime, kUnknownFileCreationTime,
+               300 /* epoch_number */, kUnknownFileChecksum,
+               kUnknownFileChecksumFuncName, kNullUniqueId64x2, 0, 0, true,
+               kDictId);
+
+  std::string encoded;
+  ASSERT_TRUE(edit.EncodeTo(&encoded, 0 /* ts_sz */));
+
+  VersionEdit decoded;
+  ASSERT_OK(decoded.DecodeFrom(encoded));
+  ASSERT_EQ(1U, decoded.GetCompressionDicts().size());
+  ASSERT_EQ(kDictId, decoded.GetCompressionDicts()[0].first);
+  ASSERT_EQ("dict", decoded.GetCompressionDicts()[0].second);
+  ASSERT_EQ(1U, decoded.GetNewFiles().size());
+  ASSERT_EQ(kDictId, decoded.GetNewFiles()[0].second.compression_dict_id);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  TestEncodeDecode(edit);
+}
+
 TEST(FileMetaDataTest, UpdateBoundariesBlobIndex) {
   FileMetaData meta;
 
@@ -32,6 +32,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "db/blob/blob_fetcher.h"
@@ -41,6 +42,7 @@
 #include "db/blob/blob_source.h"
 #include "db/compaction/compaction.h"
 #include "db/compaction/file_pri.h"
+#include "db/compression_dict_service.h"
 #include "db/dbformat.h"
 #include "db/internal_stats.h"
 #include "db/log_reader.h"
@@ -48,6 +50,7 @@
 #include "db/memtable.h"
 #include "db/merge_context.h"
 #include "db/merge_helper.h"
+#include "db/multi_get_io_planner.h"
 #include "db/pinned_iterators_manager.h"
 #include "db/table_cache.h"
 #include "db/version_builder.h"
@@ -2182,6 +2185,7 @@ VersionStorageInfo::VersionStorageInfo(
     current_num_deletions_ = ref_vstorage->current_num_deletions_;
     current_num_samples_ = ref_vstorage->current_num_samples_;
     oldest_snapshot_seqnum_ = ref_vstorage->oldest_snapshot_seqnum_;
+    key_prefix_retention_cutoffs_ = ref_vstorage->key_prefix_retention_cutoffs_;
     compact_cursor_ = ref_vstorage->compact_cursor_;
     compact_cursor_.resize(num_levels_);
   }
@@ -2363,6 +2367,32 @@ void Version::MultiGetBlob(
   }
 }
 
+Status Version::PrepareAsyncGet(const ReadOptions& read_options,
+                                const LookupKey& k,
+                                TableReader::AsyncBlockRead* block) {
+  Slice ikey = k.internal_key();
+  Slice user_key = k.user_key();
+  FilePicker fp(user_key, ikey, &storage_info_.level_files_brief_,
+                storage_info_.num_non_empty_levels_,
+                &storage_info_.file_indexer_, user_comparator(),
+                internal_comparator());
+  Status s;
+  for (FdWithKeyRange* f = fp.GetNextFile(); f != nullptr && s.ok();
+       f = fp.GetNextFile()) {
+    s = table_cache_->PrepareAsyncGet(
+        read_options, *internal_comparator(), *f->file_metadata, ikey,
+        mutable_cf_options_.block_protection_bytes_per_key,
+        mutable_cf_options_.prefix_extractor,
+        IsFilterSkipped(static_cast<int>(fp.GetHitFileLevel()),
+                        fp.IsHitFileLastInLevel()),
+        static_cast<int>(fp.GetHitFileLevel()), block);
+    if (block->len > 0) {
+      break;
+    }
+  }
+  return s;
+}
+
 void Version::Get(const ReadOptions& read_options, const LookupKey& k,
                   PinnableSlice* value, PinnableWideColumns* columns,
                   std::string* timestamp, Status* status,
@@ -2570,6 +2600,41 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
   }
 }
 
+void Version::ReadMultiGetBlocks(const ReadOptions& read_options,
+                                 MultiGetRange* range) {
+  MultiGetIOPlanner planner(read_options);
+  for (auto iter = range->begin(); iter != range->end(); ++iter) {
+    FilePicker fp(iter->ukey_with_ts, iter->ikey,
+                  &storage_info_.level_files_brief_,
+                  storage_info_.num_non_empty_levels_,
+                  &storage_info_.file_indexer_, user_comparator(),
+                  internal_comparator());
+    for (FdWithKeyRange* f = fp.GetNextFile(); f != nullptr;
+         f = fp.GetNextFile()) {
+      std::unique_ptr<TableReader::AsyncBlockRead> block(
+          new TableReader::AsyncBlockRead);
+      Status s = table_cache_->PrepareAsyncGet(
+          read_options, *internal_comparator(), *f->file_metadata,
+          iter->ikey, mutable_cf_options_.block_protection_bytes_per_key,
+          mutable_cf_options_.prefix_extractor,
+          IsFilterSkipped(static_cast<int>(fp.GetHitFileLevel()),
+                          fp.IsHitFileLastInLevel()),
+          static_cast<int>(fp.GetHitFileLevel()), block.get());
+      if (!s.ok()) {
+        // Left to the lookup to read and report
+        s.PermitUncheckedError();
+        continue;
+      }
+      if (block->len > 0) {
+        planner.Add(std::move(block));
+      }
+    }
+  }
+  RecordTick(db_statistics_, MULTIGET_SINGLE_ROUND_IO_BLOCKS,
+             planner.NumBlocks());
+  planner.Execute(env_->GetFileSystem().get(), use_async_io_);
+}
+
 void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
                        ReadCallback* callback) {
   PinnedIteratorsManager pinned_iters_mgr;
@@ -2615,6 +2680,10 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
   // blob_file => [[blob_idx, it], ...]
   std::unordered_map<uint64_t, BlobReadContexts> blob_ctxs;
   MultiGetRange keys_with_blobs_range(*range, range->begin(), range->end());
+  if (read_options.multiget_single_round_io && read_options.fill_cache &&
+      read_options.read_tier == kReadAllTier) {
+    ReadMultiGetBlocks(read_options, range);
+  }
 #if USE_COROUTINES
   if (read_options.async_io && read_options.optimize_multiget_for_io &&
       using_coroutines() && use_async_io_) {
@@ -3628,6 +3697,17 @@ void VersionStorageInfo::ComputeCompactionScore(
         mutable_cf_options.blob_garbage_collection_force_threshold);
   }
 
+  if (mutable_cf_options.range_tombstone_compaction_budget > 0 &&
+      compaction_style_ == kCompactionStyleLevel) {
+    ComputeFilesMarkedForRangeTombstoneCompaction(
+        mutable_cf_options.range_tombstone_compaction_budget, max_output_level);
+  }
+
+  if (!immutable_options.key_prefix_retentions.empty() &&
+      compaction_style_ == kCompactionStyleLevel) {
+    ComputeKeyPrefixRetentionFiles(immutable_options);
+  }
+
   EstimateCompactionBytesNeeded(mutable_cf_options);
 }
 
@@ -3843,6 +3923,118 @@ void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
   }
 }
 
+void VersionStorageInfo::ComputeFilesMarkedForRangeTombstoneCompaction(
+    uint64_t budget, int last_level) {
+  files_marked_for_range_tombstone_compaction_.clear();
+
+  // The range tombstones of the last level with data cover nothing
+  int last_qualify_level = -1;
+  for (int level = last_level; level >= 1; level--) {
+    if (!files_[level].empty()) {
+      last_qualify_level = level - 1;
+      break;
+    }
+  }
+
+  struct Candidate {
+    int level;
+    FileMetaData* file;
+    // Bytes of the lower levels covered by the range tombstones of the file
+    uint64_t covered_bytes;
+    double read_cost_reduction;
+  };
+  std::vector<Candidate> candidates;
+  uint64_t in_progress_bytes = 0;
+  for (int level = 0; level <= last_qualify_level; level++) {
+    for (auto* f : files_[level]) {
+      const uint64_t covered_bytes = f->compensated_range_deletion_size;
+      // Rewriting the file must cost less than the covered data
+      if (covered_bytes <= f->fd.GetFileSize()) {
+        continue;
+      }
+      if (f->being_compacted) {
+        in_progress_bytes += covered_bytes;
+        continue;
+      }
+      // Every read of a covered key searches the range tombstones and the
+      // covered data below them, a cost that is roughly proportional to the
+      // covered bytes
+      const uint64_t reads =
+          f->stats.num_reads_sampled.load(std::memory_order_relaxed);
+      candidates.push_back(
+          {level, f, covered_bytes,
+           static_cast<double>(covered_bytes) * static_cast<double>(1 + reads)});
+    }
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate& a, const Candidate& b) {
+                     return a.read_cost_reduction > b.read_cost_reduction;
+                   });
+
+  uint64_t marked_bytes = in_progress_bytes;
+  for (const auto& candidate : candidates) {
+    if (marked_bytes > 0 && marked_bytes + candidate.covered_bytes > budget) {
+      break;
+    }
+    marked_bytes += candidate.covered_bytes;
+    files_marked_for_range_tombstone_compaction_.emplace_back(candidate.level,
+                                                              candidate.file);
+  }
+}
+
+void VersionStorageInfo::ComputeKeyPrefixRetentionFiles(
+    const ImmutableOptions& ioptions) {
+  expired_key_prefix_retention_files_.clear();
+  files_marked_for_key_prefix_retention_.clear();
+
+  int64_t _current_time = 0;
+  // If GetCurrentTime() fails, only the sequence numbers are used
+  ioptions.clock->GetCurrentTime(&_current_time).PermitUncheckedError();
+  const uint64_t current_time = static_cast<uint64_t>(_current_time);
+
+  for (int level = 0; level < num_levels(); level++) {
+    for (FileMetaData* f : files_[level]) {
+      int index;
+      // The files of several retentions are split by the compactions first
+      if (f->being_compacted ||
+          !FindKeyRangePrefixRetention(ioptions.key_prefix_retentions,
+                                       f->smallest.user_key(),
+                                       f->largest.user_key(), &index) ||
+          index < 0) {
+        continue;
+      }
+      const SequenceNumber cutoff =
+          key_prefix_retention_cutoffs_.GetCutoff(index);
+      const uint64_t retention =
+          ioptions.key_prefix_retentions[index].retention_seconds;
+      // All the keys of a file were written before it was created
+      const uint64_t creation_time = f->TryGetFileCreationTime();
+      if ((f->fd.smallest_seqno > 0 && f->fd.largest_seqno < cutoff) ||
+          (creation_time != kUnknownFileCreationTime &&
+           creation_time + retention <= current_time)) {
+        // Deleting the file would make visible the older versions of its
+        // keys (reads do not check for expiry), so it is compacted instead
+        if (OlderFilesMightOverlap(level, f)) {
+          files_marked_for_key_prefix_retention_.emplace_back(level, f);
+        } else {
+          expired_key_prefix_retention_files_.emplace_back(level, f);
+        }
+      } else if (f->fd.smallest_seqno > 0 && f->fd.smallest_seqno < cutoff) {
+        files_marked_for_key_prefix_retention_.emplace_back(level, f);
+      }
+    }
+  }
+}
+
+void VersionStorageInfo::UpdateKeyPrefixRetentionCutoffs(
+    const KeyPrefixRetentionCutoffs& cutoffs,
+    const ImmutableOptions& ioptions) {
+  key_prefix_retention_cutoffs_.Merge(cutoffs);
+  if (compaction_style_ == kCompactionStyleLevel) {
+    ComputeKeyPrefixRetentionFiles(ioptions);
+  }
+}
+
 namespace {
 
 // used to sort files by size
@@ -3999,6 +4191,77 @@ void SortFileByOverlappingRatio(
                     });
 }
 
+// Returns whether a file of `level_files`, which are sorted and do not
+// overlap, overlaps the key range of `file`
+bool LevelOverlapsFile(const Comparator* ucmp,
+                       const std::vector<FileMetaData*>& level_files,
+                       const FileMetaData* file) {
+  const Slice smallest = file->smallest.user_key();
+  auto it = std::lower_bound(
+      level_files.begin(), level_files.end(), smallest,
+      [ucmp](const FileMetaData* f, const Slice& key) -> bool {
+        return ucmp->Compare(f->largest.user_key(), key) < 0;
+      });
+  return it != level_files.end() &&
+         ucmp->Compare((*it)->smallest.user_key(), file->largest.user_key()) <=
+             0;
+}
+
+// Sort `temp` by the read heat of the files' key ranges, hottest first: the
+// rate of sampled reads of a file since its creation, times the number of
+// levels a read of its range probes. Files without sampled reads keep the
+// kMinOverlappingRatio order.
+void SortFileByReadHeat(const InternalKeyComparator& icmp,
+                        const std::vector<FileMetaData*>* files,
+                        SystemClock* clock, int level,
+                        int num_non_empty_levels, uint64_t ttl,
+                        std::vector<Fsize>* temp) {
+  SortFileByOverlappingRatio(icmp, files[level], files[level + 1], clock,
+                             level, num_non_empty_levels, ttl, temp);
+
+  int64_t curr_time = 0;
+  if (!clock->GetCurrentTime(&curr_time).ok()) {
+    curr_time = 0;
+  }
+  const Comparator* ucmp = icmp.user_comparator();
+  std::unordered_map<uint64_t, double> file_to_heat;
+  for (const auto& f : *temp) {
+    FileMetaData* file = f.file;
+    const uint64_t reads =
+        file->stats.num_reads_sampled.load(std::memory_order_relaxed);
+    if (reads == 0) {
+      continue;
+    }
+    uint64_t age_secs = 1;
+    const uint64_t creation_time = file->TryGetFileCreationTime();
+    if (creation_time != kUnknownFileCreationTime &&
+        static_cast<uint64_t>(curr_time) > creation_time) {
+      age_secs = static_cast<uint64_t>(curr_time) - creation_time;
+    }
+    int levels_probed = 1;
+    for (int l = level + 1; l < num_non_empty_levels; l++) {
+      if (LevelOverlapsFile(ucmp, files[l], file)) {
+        levels_probed++;
+      }
+    }
+    file_to_heat[file->fd.GetNumber()] =
+        static_cast<double>(reads) * levels_probed / age_secs;
+  }
+  if (file_to_heat.empty()) {
+    return;
+  }
+  std::stable_sort(temp->begin(), temp->end(),
+                   [&](const Fsize& f1, const Fsize& f2) -> bool {
+                     auto it1 = file_to_heat.find(f1.file->fd.GetNumber());
+                     auto it2 = file_to_heat.find(f2.file->fd.GetNumber());
+                     const double heat1 =
+                         it1 == file_to_heat.end() ? 0 : it1->second;
+                     const double heat2 =
+                         it2 == file_to_heat.end() ? 0 : it2->second;
+                     return heat1 > heat2;
+                   });
+}
+
 void SortFileByRoundRobin(const InternalKeyComparator& icmp,
                           std::vector<InternalKey>* compact_cursor,
                           bool level0_non_overlapping, int level,
@@ -4109,6 +4372,10 @@ void VersionStorageInfo::UpdateFilesByCompactionPri(
         SortFileByRoundRobin(*internal_comparator_, &compact_cursor_,
                              level0_non_overlapping_, level, &temp);
         break;
+      case kHottestRangeFirst:
+        SortFileByReadHeat(*internal_comparator_, files_, ioptions.clock,
+                           level, num_non_empty_levels_, options.ttl, &temp);
+        break;
       default:
         assert(false);
     }
@@ -4879,6 +5146,19 @@ bool VersionStorageInfo::RangeMightExistAfterSortedRun(
   return false;
 }
 
+bool VersionStorageInfo::OlderFilesMightOverlap(int level,
+                                                const FileMetaData* file) {
+  int l0_idx = -1;
+  if (level == 0) {
+    const auto& l0_files = LevelFiles(0);
+    l0_idx = static_cast<int>(
+        std::find(l0_files.begin(), l0_files.end(), file) - l0_files.begin());
+    assert(l0_idx < static_cast<int>(l0_files.size()));
+  }
+  return RangeMightExistAfterSortedRun(file->smallest.user_key(),
+                                       file->largest.user_key(), level, l0_idx);
+}
+
 void Version::AddLiveFiles(std::vector<uint64_t>* live_table_files,
                            std::vector<uint64_t>* live_blob_files) const {
   assert(live_table_files);
@@ -5608,6 +5888,9 @@ Status VersionSet::ProcessManifestWrites(
           if (e->HasFullHistoryTsLow()) {
             cfd->SetFullHistoryTsLow(e->GetFullHistoryTsLow());
           }
+          for (const auto& dict : e->GetCompressionDicts()) {
+            cfd->compression_dict_service()->AddDict(dict.first, dict.second);
+          }
         }
         if (e->has_min_log_number_to_keep_) {
           last_min_log_number_to_keep =
@@ -6521,6 +6804,23 @@ Status VersionSet::WriteCurrentStateToManifest(
           cfd->internal_comparator().user_comparator()->Name());
       edit.SetPersistUserDefinedTimestamps(
           cfd->ioptions()->persist_user_defined_timestamps);
+      // Shared compression dictionaries must be known before the files that
+      // reference them are opened. Those no live file refers to anymore are
+      // dropped.
+      std::unordered_set<uint64_t> referenced_dict_ids;
+      const auto* vstorage = cfd->current()->storage_info();
+      for (int level = 0; level < cfd->NumberLevels(); level++) {
+        for (const auto& f : vstorage->LevelFiles(level)) {
+          if (f->compression_dict_id != 0) {
+            referenced_dict_ids.insert(f->compression_dict_id);
+          }
+        }
+      }
+      cfd->compression_dict_service()->RemoveUnreferencedDicts(
+          referenced_dict_ids);
+      for (auto& dict : cfd->compression_dict_service()->GetDicts()) {
+        edit.AddCompressionDict(dict.first, std::move(dict.second));
+      }
       std::string record;
       if (!edit.EncodeTo(&record)) {
         return Status::Corruption("Unable to Encode VersionEdit:" +
@@ -6557,7 +6857,8 @@ Status VersionSet::WriteCurrentStateToManifest(
                        f->file_creation_time, f->epoch_number, f->file_checksum,
                        f->file_checksum_func_name, f->unique_id,
                        f->compensated_range_deletion_size, f->tail_size,
-                       f->user_defined_timestamps_persisted);
+                       f->user_defined_timestamps_persisted,
+                       f->compression_dict_id);
         }
       }
 
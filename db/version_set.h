@@ -51,6 +51,7 @@
 #include "db/column_family.h"
 #include "db/compaction/compaction.h"
 #include "db/compaction/compaction_picker.h"
+#include "db/compaction/key_prefix_retention.h"
 #include "db/dbformat.h"
 #include "db/file_indexer.h"
 #include "db/log_reader.h"
@@ -252,6 +253,32 @@ class VersionStorageInfo {
       double blob_garbage_collection_age_cutoff,
       double blob_garbage_collection_force_threshold);
 
+  // This computes files_marked_for_range_tombstone_compaction_ and is called
+  // by ComputeCompactionScore()
+  //
+  // REQUIRES: DB mutex held
+  void ComputeFilesMarkedForRangeTombstoneCompaction(uint64_t budget,
+                                                     int last_level);
+
+  // This computes expired_key_prefix_retention_files_ and
+  // files_marked_for_key_prefix_retention_ and is called by
+  // ComputeCompactionScore() and UpdateKeyPrefixRetentionCutoffs()
+  //
+  // REQUIRES: DB mutex held
+  void ComputeKeyPrefixRetentionFiles(const ImmutableOptions& ioptions);
+
+  // Raises the cutoffs of the key prefix retentions to `cutoffs` and updates
+  // the files that hold expired keys. Must be called when the cutoffs
+  // advance, as keys expire without any change of the version.
+  //
+  // REQUIRES: DB mutex held
+  void UpdateKeyPrefixRetentionCutoffs(const KeyPrefixRetentionCutoffs& cutoffs,
+                                       const ImmutableOptions& ioptions);
+
+  const KeyPrefixRetentionCutoffs& key_prefix_retention_cutoffs() const {
+    return key_prefix_retention_cutoffs_;
+  }
+
   bool level0_non_overlapping() const { return level0_non_overlapping_; }
 
   // Updates the oldest snapshot and related internal state, like the bottommost
@@ -515,6 +542,32 @@ class VersionStorageInfo {
     return files_marked_for_forced_blob_gc_;
   }
 
+  // REQUIRES: ComputeCompactionScore has been called
+  // REQUIRES: DB mutex held during access
+  const autovector<std::pair<int, FileMetaData*>>&
+  FilesMarkedForRangeTombstoneCompaction() const {
+    assert(finalized_);
+    return files_marked_for_range_tombstone_compaction_;
+  }
+
+  // REQUIRES: ComputeCompactionScore has been called
+  // REQUIRES: DB mutex held during access
+  // Used by Leveled Compaction only.
+  const autovector<std::pair<int, FileMetaData*>>&
+  ExpiredKeyPrefixRetentionFiles() const {
+    assert(finalized_);
+    return expired_key_prefix_retention_files_;
+  }
+
+  // REQUIRES: ComputeCompactionScore has been called
+  // REQUIRES: DB mutex held during access
+  // Used by Leveled Compaction only.
+  const autovector<std::pair<int, FileMetaData*>>&
+  FilesMarkedForKeyPrefixRetention() const {
+    assert(finalized_);
+    return files_marked_for_key_prefix_retention_;
+  }
+
   int base_level() const { return base_level_; }
   double level_multiplier() const { return level_multiplier_; }
 
@@ -619,6 +672,10 @@ class VersionStorageInfo {
                                      const Slice& largest_user_key,
                                      int last_level, int last_l0_idx);
 
+  // Returns whether any key of `file`, which is in `level`, could appear in an
+  // older file, see RangeMightExistAfterSortedRun()
+  bool OlderFilesMightOverlap(int level, const FileMetaData* file);
+
  private:
   void ComputeCompensatedSizes();
   void UpdateNumNonEmptyLevels();
@@ -717,6 +774,23 @@ class VersionStorageInfo {
 
   autovector<std::pair<int, FileMetaData*>> files_marked_for_forced_blob_gc_;
 
+  // Sorted by the expected reduction of read cost, highest first
+  autovector<std::pair<int, FileMetaData*>>
+      files_marked_for_range_tombstone_compaction_;
+
+  // The sequence numbers below which the keys of each key prefix retention
+  // expired, as of the last update
+  KeyPrefixRetentionCutoffs key_prefix_retention_cutoffs_;
+
+  // Files whose keys all expired and that no older file overlaps, sorted by
+  // level
+  autovector<std::pair<int, FileMetaData*>> expired_key_prefix_retention_files_;
+
+  // Files that hold both expired and live keys, or only expired keys that
+  // may hide older versions in older files
+  autovector<std::pair<int, FileMetaData*>>
+      files_marked_for_key_prefix_retention_;
+
   // Threshold for needing to mark another bottommost file. Maintain it so we
   // can quickly check when releasing a snapshot whether more bottommost files
   // became eligible for compaction. It's defined as the min of the max nonzero
@@ -901,6 +975,13 @@ class Version {
   void MultiGet(const ReadOptions&, MultiGetRange* range,
                 ReadCallback* callback = nullptr);
 
+  // Finds the first data block, in the order Get() visits the files, that a
+  // lookup of `key` cannot find in the block cache, see
+  // TableReader::PrepareAsyncGet(). Leaves `block->len` at 0 if there is none.
+  // REQUIRES: lock is not held
+  Status PrepareAsyncGet(const ReadOptions& read_options, const LookupKey& key,
+                         TableReader::AsyncBlockRead* block);
+
   // Interprets blob_index_slice as a blob reference, and (assuming the
   // corresponding blob file is part of this Version) retrieves the blob and
   // saves it in *value.
@@ -1069,6 +1150,11 @@ class Version {
       TableCache::TypedHandle* table_handle, uint64_t& num_filter_read,
       uint64_t& num_index_read, uint64_t& num_sst_read);
 
+  // Reads the data blocks that the keys of `range` may need from all levels
+  // into the block cache, see ReadOptions::multiget_single_round_io
+  void ReadMultiGetBlocks(const ReadOptions& read_options,
+                          MultiGetRange* range);
+
 #ifdef USE_COROUTINES
   // MultiGet using async IO to read data blocks from SST files in parallel
   // within and across levels
@@ -210,6 +210,136 @@ TEST_F(DBWideBasicTest, PutEntity) {
   verify();
 }
 
+TEST_F(DBWideBasicTest, ColumnarEntities) {
+  constexpr int kNumKeys = 64;
+
+  // Every fifth key is a plain key-value, with a value that looks like a
+  // columnar entry. Every third entity has no default column, and every other
+  // one has an extra column.
+  std::vector<std::string> keys;
+  std::vector<std::vector<std::pair<std::string, std::string>>> values;
+  for (int i = 0; i < kNumKeys; ++i) {
+    keys.push_back("key" + std::to_string(1000 + i));
+    values.emplace_back();
+    auto& value = values.back();
+    if (i % 5 == 4) {
+      value.emplace_back(kDefaultWideColumnName.ToString(),
+                         std::string(1, '\0') + "plain" + std::to_string(i));
+      continue;
+    }
+    if (i % 3 != 0) {
+      value.emplace_back(kDefaultWideColumnName.ToString(),
+                         "default" + std::to_string(i));
+    }
+    value.emplace_back("attr_a", "a" + std::to_string(i));
+    if (i % 2 == 0) {
+      value.emplace_back("attr_b", std::string(i, 'b'));
+    }
+    value.emplace_back("attr_c", "c" + std::to_string(i));
+  }
+  auto is_plain = [](int i) { return i % 5 == 4; };
+
+  const std::vector<Slice> projection{kDefaultWideColumnName, "attr_b"};
+
+  std::vector<WideColumns> expected(kNumKeys);
+  std::vector<WideColumns> expected_projected(kNumKeys);
+  for (int i = 0; i < kNumKeys; ++i) {
+    for (const auto& column : values[i]) {
+      expected[i].emplace_back(column.first, column.second);
+      if (std::find(projection.begin(), projection.end(),
+                    Slice(column.first)) != projection.end()) {
+        expected_projected[i].emplace_back(column.first, column.second);
+      }
+    }
+  }
+
+  auto verify = [&]() {
+    for (int i = 0; i < kNumKeys; ++i) {
+      PinnableWideColumns result;
+      ASSERT_OK(db_->GetEntity(ReadOptions(), db_->DefaultColumnFamily(),
+                               keys[i], &result));
+      ASSERT_EQ(result.columns(), expected[i]);
+    }
+
+    {
+      std::vector<Slice> key_slices(keys.begin(), keys.end());
+      std::vector<PinnableWideColumns> results(kNumKeys);
+      std::vector<Status> statuses(kNumKeys);
+      db_->MultiGetEntity(ReadOptions(), db_->DefaultColumnFamily(), kNumKeys,
+                          key_slices.data(), results.data(), statuses.data());
+      for (int i = 0; i < kNumKeys; ++i) {
+        ASSERT_OK(statuses[i]);
+        ASSERT_EQ(results[i].columns(), expected[i]);
+      }
+    }
+
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+      int i = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++i) {
+        ASSERT_EQ(iter->key(), keys[i]);
+        ASSERT_EQ(iter->columns(), expected[i]);
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(i, kNumKeys);
+    }
+
+    ReadOptions read_options;
+    read_options.column_projection = &projection;
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    int i = kNumKeys - 1;
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev(), --i) {
+      ASSERT_EQ(iter->key(), keys[i]);
+      ASSERT_EQ(iter->columns(), expected_projected[i]);
+      if (!expected_projected[i].empty() &&
+          expected_projected[i][0].name() == kDefaultWideColumnName) {
+        ASSERT_EQ(iter->value(), expected_projected[i][0].value());
+      } else {
+        ASSERT_TRUE(iter->value().empty());
+      }
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, -1);
+
+    iter->Seek(keys[kNumKeys / 2]);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->columns(), expected_projected[kNumKeys / 2]);
+  };
+
+  for (auto index_type : {BlockBasedTableOptions::kDataBlockBinarySearch,
+                          BlockBasedTableOptions::kDataBlockBinaryAndHash}) {
+    Options options = GetDefaultOptions();
+    options.create_if_missing = true;
+    BlockBasedTableOptions table_options;
+    table_options.data_block_columnar_entities = true;
+    table_options.data_block_index_type = index_type;
+    table_options.block_restart_interval = 4;
+    table_options.block_size = 512;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    DestroyAndReopen(options);
+
+    for (int i = 0; i < kNumKeys; ++i) {
+      if (is_plain(i)) {
+        ASSERT_OK(db_->Put(WriteOptions(), keys[i], values[i][0].second));
+      } else {
+        ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                                 keys[i], expected[i]));
+      }
+    }
+
+    // Try reading from memtable
+    verify();
+
+    // Try reading from storage
+    ASSERT_OK(Flush());
+    verify();
+
+    // And after compaction
+    ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+    verify();
+  }
+}
+
 TEST_F(DBWideBasicTest, PutEntityColumnFamily) {
   Options options = GetDefaultOptions();
   CreateAndReopenWithCF({"corinthian"}, options);
@@ -2683,6 +2683,9 @@ void StressTest::PrintEnv() const {
     case kRoundRobin:
       compaction_pri = "kRoundRobin";
       break;
+    case kHottestRangeFirst:
+      compaction_pri = "kHottestRangeFirst";
+      break;
   }
   fprintf(stdout, "Compaction Pri            : %s\n", compaction_pri);
   fprintf(stdout, "Background Purge          : %d\n",
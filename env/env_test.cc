@@ -54,6 +54,9 @@
 #include "env/env_chroot.h"
 #include "env/env_encryption_ctr.h"
 #include "env/fs_readonly.h"
+#if defined(ROCKSDB_IOURING_PRESENT)
+#include "env/io_posix.h"
+#endif
 #include "env/mock_env.h"
 #include "env/unique_id_gen.h"
 #include "logging/log_buffer.h"
@@ -66,6 +69,8 @@
 #include "rocksdb/env.h"
 #include "rocksdb/env_encryption.h"
 #include "rocksdb/file_system.h"
+#include "rocksdb/iostats_context.h"
+#include "rocksdb/perf_level.h"
 #include "rocksdb/system_clock.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "test_util/mock_time_env.h"
@@ -1747,6 +1752,132 @@ TEST_F(EnvPosixTest, MultiReadIOUringError2) {
   SyncPoint::GetInstance()->DisableProcessing();
   SyncPoint::GetInstance()->ClearAllCallBacks();
 }
+
+TEST_F(EnvPosixTest, IOUringFileWriterSyncAfterQueuedWrites) {
+  std::string fname = test::PerThreadDBPath(env_, "testfile");
+  int fd = open(fname.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+  ASSERT_GE(fd, 0);
+  std::unique_ptr<IOUringFileWriter> writer =
+      IOUringFileWriter::Create(fname, fd, kPageSize);
+  if (writer == nullptr) {
+    close(fd);
+    ROCKSDB_GTEST_SKIP("io_uring writes are not usable here");
+    return;
+  }
+
+  unsigned int num_linked_writes = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "IOUringFileWriter::Sync:LinkedWrites", [&](void* arg) {
+        num_linked_writes = *static_cast<unsigned int*>(arg);
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  // Each write takes a buffer of its own and stays queued until Sync(),
+  // which has to link all of them ahead of the fdatasync
+  const size_t kWriteSize = 100 << 10;
+  const int kNumWrites = 3;
+  Random rnd(301);
+  std::string data = rnd.RandomString(kNumWrites * kWriteSize);
+  for (int i = 0; i < kNumWrites; ++i) {
+    ASSERT_OK(writer->Write(data.data() + i * kWriteSize, kWriteSize,
+                            i * kWriteSize));
+  }
+  ASSERT_OK(writer->Sync(/*full_sync=*/false));
+  ASSERT_EQ(num_linked_writes, static_cast<unsigned int>(kNumWrites));
+
+  // A sync with nothing queued only syncs
+  ASSERT_OK(writer->Sync(/*full_sync=*/true));
+  ASSERT_EQ(num_linked_writes, 0U);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  writer.reset();
+
+  std::string read_back(data.size(), '\0');
+  ASSERT_EQ(pread(fd, &read_back[0], read_back.size(), 0),
+            static_cast<ssize_t>(read_back.size()));
+  close(fd);
+  ASSERT_EQ(read_back, data);
+}
+
+TEST_F(EnvPosixTest, IOUringFileWriterFailsAfterSubmitError) {
+  std::string fname = test::PerThreadDBPath(env_, "testfile");
+  int fd = open(fname.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+  ASSERT_GE(fd, 0);
+  std::unique_ptr<IOUringFileWriter> writer =
+      IOUringFileWriter::Create(fname, fd, kPageSize);
+  if (writer == nullptr) {
+    close(fd);
+    ROCKSDB_GTEST_SKIP("io_uring writes are not usable here");
+    return;
+  }
+
+  SyncPoint::GetInstance()->SetCallBack(
+      "IOUringFileWriter::SubmitLocked:io_uring_submit",
+      [&](void* arg) { *static_cast<int*>(arg) = -EBUSY; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  std::string data(4096, 'x');
+  ASSERT_OK(writer->Write(data.data(), data.size(), 0));
+  // The queued write may be lost, so the writer fails from now on
+  ASSERT_TRUE(writer->Submit().IsIOError());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  ASSERT_TRUE(writer->Write(data.data(), data.size(), data.size()).IsIOError());
+  ASSERT_TRUE(writer->Sync(/*full_sync=*/false).IsIOError());
+  ASSERT_TRUE(writer->WaitAll().IsIOError());
+
+  writer.reset();
+  close(fd);
+}
+
+TEST_F(EnvPosixTest, IOUringWriteFileSystemOption) {
+  std::shared_ptr<FileSystem> fs;
+  ASSERT_OK(FileSystem::CreateFromString(
+      ConfigOptions(), "id=posix; io_uring_write=true", &fs));
+  std::string fname = test::PerThreadDBPath(env_, "testfile");
+  std::unique_ptr<FSWritableFile> file;
+  ASSERT_OK(fs->NewWritableFile(fname, FileOptions(), &file, nullptr));
+
+  int num_syncs = 0;
+  unsigned int num_linked_writes = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "IOUringFileWriter::Sync:LinkedWrites", [&](void* arg) {
+        ++num_syncs;
+        num_linked_writes = *static_cast<unsigned int*>(arg);
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  Random rnd(301);
+  std::string data = rnd.RandomString(8192);
+  ASSERT_OK(file->Append(Slice(data.data(), 4096), IOOptions(), nullptr));
+  ASSERT_OK(file->Sync(IOOptions(), nullptr));
+  if (num_syncs == 0) {
+    SyncPoint::GetInstance()->DisableProcessing();
+    SyncPoint::GetInstance()->ClearAllCallBacks();
+    ASSERT_OK(file->Close(IOOptions(), nullptr));
+    ROCKSDB_GTEST_SKIP("io_uring writes are not usable here");
+    return;
+  }
+  // The write was queued until the sync
+  ASSERT_EQ(num_linked_writes, 1U);
+
+  // Flush() submits the queued write without waiting for it, so there is
+  // nothing left to link ahead of the sync
+  ASSERT_OK(file->Append(Slice(data.data() + 4096, 4096), IOOptions(),
+                         nullptr));
+  ASSERT_OK(file->Flush(IOOptions(), nullptr));
+  ASSERT_OK(file->Sync(IOOptions(), nullptr));
+  ASSERT_EQ(num_linked_writes, 0U);
+  ASSERT_OK(file->Close(IOOptions(), nullptr));
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  std::string read_back;
+  ASSERT_OK(ReadFileToString(fs.get(), fname, &read_back));
+  ASSERT_EQ(read_back, data);
+}
 #endif  // ROCKSDB_IOURING_PRESENT
 
 // Only works in linux platforms
@@ -2913,6 +3044,102 @@ TEST_F(CreateEnvTest, CreateChrootFileSystem) {
   ASSERT_OK(FileSystem::CreateFromString(config_options_, opts_str, &copy));
   ASSERT_TRUE(fs->AreEquivalent(config_options_, copy.get(), &mismatch));
 }
+
+TEST_F(CreateEnvTest, CreatePosixFileSystemWithIOUringPolling) {
+  std::shared_ptr<FileSystem> fs;
+  ASSERT_OK(FileSystem::CreateFromString(
+      config_options_, "id=posix; io_uring_sqpoll=true; io_uring_iopoll=true",
+      &fs));
+  ASSERT_NE(fs, nullptr);
+  ASSERT_NE(fs, FileSystem::Default());
+  ASSERT_TRUE(fs->IsInstanceOf("posix"));
+  ASSERT_NOK(FileSystem::CreateFromString(
+      config_options_, "id=posix; io_uring_no_such_option=true", &fs));
+  ASSERT_OK(FileSystem::CreateFromString(
+      config_options_, "id=posix; io_uring_sqpoll=true; io_uring_iopoll=true",
+      &fs));
+
+  std::string fname = test::PerThreadDBPath("polled_multi_read");
+  std::string data(4096 * 4, 'a');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>('a' + i % 26);
+  }
+  ASSERT_OK(WriteStringToFile(fs.get(), data, fname));
+  // Polled completions need O_DIRECT
+  std::unique_ptr<FSRandomAccessFile> file;
+  IOStatus s = fs->NewRandomAccessFile(fname, FileOptions(), &file, nullptr);
+  ASSERT_TRUE(s.IsInvalidArgument()) << s.ToString();
+  ASSERT_EQ(file, nullptr);
+
+  // MultiRead works whether or not polled io_uring is available
+  ASSERT_OK(FileSystem::CreateFromString(config_options_,
+                                         "id=posix; io_uring_sqpoll=true", &fs));
+  ASSERT_OK(fs->NewRandomAccessFile(fname, FileOptions(), &file, nullptr));
+  std::vector<FSReadRequest> reqs(3);
+  std::vector<std::string> scratches(reqs.size(), std::string(100, '\0'));
+  for (size_t i = 0; i < reqs.size(); ++i) {
+    reqs[i].offset = i * 4096 + 7;
+    reqs[i].len = 100;
+    reqs[i].scratch = &scratches[i][0];
+  }
+  ASSERT_OK(file->MultiRead(reqs.data(), reqs.size(), IOOptions(), nullptr));
+  for (size_t i = 0; i < reqs.size(); ++i) {
+    ASSERT_OK(reqs[i].status);
+    ASSERT_EQ(reqs[i].result.ToString(), data.substr(i * 4096 + 7, 100));
+  }
+  ASSERT_OK(fs->DeleteFile(fname, IOOptions(), nullptr));
+}
+
+TEST_F(CreateEnvTest, MultiReadThroughPolledIOUring) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  // SQPOLL may need privileges, in which case the reads would not be polled
+  struct io_uring* iu = CreateIOUring(IORING_SETUP_SQPOLL);
+  const bool sq_polled =
+      iu != nullptr && (iu->flags & IORING_SETUP_SQPOLL) != 0;
+  if (iu != nullptr) {
+    DeleteIOUring(iu);
+  }
+  if (!sq_polled) {
+    ROCKSDB_GTEST_BYPASS("io_uring with IORING_SETUP_SQPOLL is not available");
+    return;
+  }
+
+  std::shared_ptr<FileSystem> fs;
+  ASSERT_OK(FileSystem::CreateFromString(config_options_,
+                                         "id=posix; io_uring_sqpoll=true", &fs));
+  std::string fname = test::PerThreadDBPath("polled_io_uring_read");
+  Random rnd(301);
+  std::string data = rnd.RandomString(64 << 10);
+  ASSERT_OK(WriteStringToFile(fs.get(), data, fname));
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_OK(fs->NewRandomAccessFile(fname, FileOptions(), &file, nullptr));
+
+  SetPerfLevel(PerfLevel::kEnableTimeExceptForMutex);
+  // More requests than fit into one submission, read in several rounds
+  const size_t kNumReads = kIoUringDepth + 10;
+  const size_t kReadSize = 100;
+  std::vector<FSReadRequest> reqs(kNumReads);
+  std::vector<std::string> scratches(kNumReads, std::string(kReadSize, '\0'));
+  for (size_t i = 0; i < kNumReads; ++i) {
+    reqs[i].offset = (i * 211) % (data.size() - kReadSize);
+    reqs[i].len = kReadSize;
+    reqs[i].scratch = &scratches[i][0];
+  }
+  get_iostats_context()->Reset();
+  ASSERT_OK(file->MultiRead(reqs.data(), reqs.size(), IOOptions(), nullptr));
+  for (size_t i = 0; i < kNumReads; ++i) {
+    ASSERT_OK(reqs[i].status);
+    ASSERT_EQ(reqs[i].result.ToString(),
+              data.substr(reqs[i].offset, kReadSize));
+  }
+  // The completions were polled rather than waited for
+  ASSERT_GT(get_iostats_context()->io_uring_poll_nanos, 0U);
+  SetPerfLevel(PerfLevel::kDisable);
+  ASSERT_OK(fs->DeleteFile(fname, IOOptions(), nullptr));
+#else
+  ROCKSDB_GTEST_BYPASS("io_uring is not available");
+#endif  // ROCKSDB_IOURING_PRESENT
+}
 #endif  // OS_WIN
 
 TEST_F(CreateEnvTest, CreateEncryptedFileSystem) {
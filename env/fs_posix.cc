@@ -55,6 +55,7 @@
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/utilities/object_registry.h"
+#include "rocksdb/utilities/options_type.h"
 #include "test_util/sync_point.h"
 #include "util/coding.h"
 #include "util/compression_context_cache.h"
@@ -79,6 +80,44 @@ namespace ROCKSDB_NAMESPACE {
 
 namespace {
 
+// Options of the posix FileSystem, set through
+// FileSystem::CreateFromString(), e.g. "id=posix;io_uring_sqpoll=true"
+struct PosixFileSystemOptions {
+  // MultiRead() uses io_urings whose submission queue is polled by a kernel
+  // thread (IORING_SETUP_SQPOLL) and busy-polls their completion queue. This
+  // saves the system calls of submitting and reaping reads at the cost of a
+  // polling kernel thread per reading thread and of CPU time spent polling
+  // (see IOStatsContext::io_uring_poll_nanos).
+  bool io_uring_sqpoll = false;
+  // MultiRead() uses io_urings whose reads complete by polling the device
+  // (IORING_SETUP_IOPOLL) instead of by interrupts. The device driver must
+  // support polled I/O, and it requires O_DIRECT, so opening a file for
+  // random reads without use_direct_reads fails with InvalidArgument.
+  bool io_uring_iopoll = false;
+  // Files opened for writing from offset 0 (not reopened for appending) are
+  // written through an io_uring, with the writes submitted in batches on
+  // Flush() and linked ahead of the sync on Sync(), if io_uring is
+  // available. Saves system calls for small, frequent appends such as WAL
+  // writes.
+  bool io_uring_write = false;
+};
+
+static std::unordered_map<std::string, OptionTypeInfo>
+    posix_fs_options_type_info = {
+        {"io_uring_sqpoll",
+         {offsetof(struct PosixFileSystemOptions, io_uring_sqpoll),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kDontSerialize | OptionTypeFlags::kCompareNever}},
+        {"io_uring_iopoll",
+         {offsetof(struct PosixFileSystemOptions, io_uring_iopoll),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kDontSerialize | OptionTypeFlags::kCompareNever}},
+        {"io_uring_write",
+         {offsetof(struct PosixFileSystemOptions, io_uring_write),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kDontSerialize | OptionTypeFlags::kCompareNever}},
+};
+
 inline mode_t GetDBFileMode(bool allow_non_owner_access) {
   return allow_non_owner_access ? 0644 : 0600;
 }
@@ -214,6 +253,11 @@ class PosixFileSystem : public FileSystem {
                                std::unique_ptr<FSRandomAccessFile>* result,
                                IODebugContext* /*dbg*/) override {
     result->reset();
+    if (options_.io_uring_iopoll &&
+        (!options.use_direct_reads || options.use_mmap_reads)) {
+      return IOStatus::InvalidArgument(
+          "io_uring_iopoll requires use_direct_reads", fname);
+    }
     IOStatus s = IOStatus::OK();
     int fd;
     int flags = cloexec_flags(O_RDONLY, &options);
@@ -268,7 +312,9 @@ class PosixFileSystem : public FileSystem {
           options
 #if defined(ROCKSDB_IOURING_PRESENT)
           ,
-          !IsIOUringEnabled() ? nullptr : thread_local_io_urings_.get()
+          !IsIOUringEnabled() ? nullptr : thread_local_io_urings_.get(),
+          GetPolledIOUrings(GetPolledIOUringFlags(options)),
+          GetPolledIOUringFlags(options)
 #endif
               ));
     }
@@ -341,16 +387,16 @@ class PosixFileSystem : public FileSystem {
 #endif
       result->reset(new PosixWritableFile(
           fname, fd, GetLogicalBlockSizeForWriteIfNeeded(options, fname, fd),
-          options));
+          options, !reopen && IsIOUringWriteEnabled()));
     } else {
       // disable mmap writes
       EnvOptions no_mmap_writes_options = options;
       no_mmap_writes_options.use_mmap_writes = false;
-      result->reset(
-          new PosixWritableFile(fname, fd,
-                                GetLogicalBlockSizeForWriteIfNeeded(
-                                    no_mmap_writes_options, fname, fd),
-                                no_mmap_writes_options));
+      result->reset(new PosixWritableFile(
+          fname, fd,
+          GetLogicalBlockSizeForWriteIfNeeded(no_mmap_writes_options, fname,
+                                              fd),
+          no_mmap_writes_options, !reopen && IsIOUringWriteEnabled()));
     }
     return s;
   }
@@ -436,16 +482,16 @@ class PosixFileSystem : public FileSystem {
 #endif
       result->reset(new PosixWritableFile(
           fname, fd, GetLogicalBlockSizeForWriteIfNeeded(options, fname, fd),
-          options));
+          options, IsIOUringWriteEnabled()));
     } else {
       // disable mmap writes
       FileOptions no_mmap_writes_options = options;
       no_mmap_writes_options.use_mmap_writes = false;
-      result->reset(
-          new PosixWritableFile(fname, fd,
-                                GetLogicalBlockSizeForWriteIfNeeded(
-                                    no_mmap_writes_options, fname, fd),
-                                no_mmap_writes_options));
+      result->reset(new PosixWritableFile(
+          fname, fd,
+          GetLogicalBlockSizeForWriteIfNeeded(no_mmap_writes_options, fname,
+                                              fd),
+          no_mmap_writes_options, IsIOUringWriteEnabled()));
     }
     return s;
   }
@@ -997,6 +1043,14 @@ class PosixFileSystem : public FileSystem {
   }
 #endif  // ROCKSDB_IOURING_PRESENT
 
+  bool IsIOUringWriteEnabled() const {
+#ifdef ROCKSDB_IOURING_PRESENT
+    return options_.io_uring_write;
+#else
+    return false;
+#endif  // ROCKSDB_IOURING_PRESENT
+  }
+
   // EXPERIMENTAL
   //
   // TODO akankshamahajan:
@@ -1194,10 +1248,40 @@ class PosixFileSystem : public FileSystem {
   }
 
 #if defined(ROCKSDB_IOURING_PRESENT)
+  // Returns the IORING_SETUP_* flags for the io_urings of MultiRead() on a
+  // file opened with `options`, or 0 if polling is not enabled
+  unsigned int GetPolledIOUringFlags(const EnvOptions& options) const {
+    unsigned int flags = 0;
+    if (options_.io_uring_sqpoll) {
+      flags |= IORING_SETUP_SQPOLL;
+    }
+    // Polled completions are only supported for O_DIRECT I/O, which
+    // NewRandomAccessFile() checks
+    if (options_.io_uring_iopoll && options.use_direct_reads) {
+      flags |= IORING_SETUP_IOPOLL;
+    }
+    return flags;
+  }
+
+  // Every thread-local io_uring in a set has to be created with the same
+  // flags, so there is one set per combination of flags
+  ThreadLocalPtr* GetPolledIOUrings(unsigned int flags) const {
+    if (flags == 0) {
+      return nullptr;
+    }
+    const size_t index = ((flags & IORING_SETUP_SQPOLL) ? 1 : 0) |
+                         ((flags & IORING_SETUP_IOPOLL) ? 2 : 0);
+    return thread_local_polled_io_urings_[index - 1].get();
+  }
+
   // io_uring instance
   std::unique_ptr<ThreadLocalPtr> thread_local_io_urings_;
+  // Polled io_uring instances, indexed as in GetPolledIOUrings()
+  std::unique_ptr<ThreadLocalPtr> thread_local_polled_io_urings_[3];
 #endif
 
+  PosixFileSystemOptions options_;
+
   size_t page_size_;
 
   // If true, allow non owner read access for db files. Otherwise, non-owner
@@ -1249,6 +1333,8 @@ PosixFileSystem::PosixFileSystem()
     : forceMmapOff_(false),
       page_size_(getpagesize()),
       allow_non_owner_access_(true) {
+  RegisterOptions("PosixFileSystemOptions", &options_,
+                  &posix_fs_options_type_info);
 #if defined(ROCKSDB_IOURING_PRESENT)
   // Test whether IOUring is supported, and if it does, create a managing
   // object for thread local point so that in the future thread-local
@@ -1256,7 +1342,10 @@ PosixFileSystem::PosixFileSystem()
   struct io_uring* new_io_uring = CreateIOUring();
   if (new_io_uring != nullptr) {
     thread_local_io_urings_.reset(new ThreadLocalPtr(DeleteIOUring));
-    delete new_io_uring;
+    for (auto& polled_io_urings : thread_local_polled_io_urings_) {
+      polled_io_urings.reset(new ThreadLocalPtr(DeleteIOUring));
+    }
+    DeleteIOUring(new_io_uring);
   }
 #endif
 }
@@ -599,7 +599,9 @@ PosixRandomAccessFile::PosixRandomAccessFile(
     const EnvOptions& options
 #if defined(ROCKSDB_IOURING_PRESENT)
     ,
-    ThreadLocalPtr* thread_local_io_urings
+    ThreadLocalPtr* thread_local_io_urings,
+    ThreadLocalPtr* thread_local_polled_io_urings,
+    unsigned int polled_io_uring_flags
 #endif
     )
     : filename_(fname),
@@ -608,7 +610,9 @@ PosixRandomAccessFile::PosixRandomAccessFile(
       logical_sector_size_(logical_block_size)
 #if defined(ROCKSDB_IOURING_PRESENT)
       ,
-      thread_local_io_urings_(thread_local_io_urings)
+      thread_local_io_urings_(thread_local_io_urings),
+      thread_local_polled_io_urings_(thread_local_polled_io_urings),
+      polled_io_uring_flags_(polled_io_uring_flags)
 #endif
 {
   assert(!options.use_direct_reads || !options.use_mmap_reads);
@@ -671,12 +675,17 @@ IOStatus PosixRandomAccessFile::MultiRead(FSReadRequest* reqs, size_t num_reqs,
 
 #if defined(ROCKSDB_IOURING_PRESENT)
   struct io_uring* iu = nullptr;
-  if (thread_local_io_urings_) {
-    iu = static_cast<struct io_uring*>(thread_local_io_urings_->Get());
+  ThreadLocalPtr* io_urings = thread_local_polled_io_urings_ != nullptr
+                                  ? thread_local_polled_io_urings_
+                                  : thread_local_io_urings_;
+  if (io_urings) {
+    iu = static_cast<struct io_uring*>(io_urings->Get());
     if (iu == nullptr) {
-      iu = CreateIOUring();
+      iu = CreateIOUring(io_urings == thread_local_polled_io_urings_
+                             ? polled_io_uring_flags_
+                             : 0);
       if (iu != nullptr) {
-        thread_local_io_urings_->Reset(iu);
+        io_urings->Reset(iu);
       }
     }
   }
@@ -687,6 +696,14 @@ IOStatus PosixRandomAccessFile::MultiRead(FSReadRequest* reqs, size_t num_reqs,
     return FSRandomAccessFile::MultiRead(reqs, num_reqs, options, dbg);
   }
 
+  // With a polled submission queue, submitting needs no system call as long
+  // as the kernel thread is awake, and completions are busy-polled from the
+  // completion queue (which the kernel thread also fills for IOPOLL) instead
+  // of waiting in io_uring_enter().
+  const bool sq_polled = (iu->flags & IORING_SETUP_SQPOLL) != 0;
+  const bool polled =
+      (iu->flags & (IORING_SETUP_SQPOLL | IORING_SETUP_IOPOLL)) != 0;
+
   IOStatus ios = IOStatus::OK();
 
   struct WrappedReadRequest {
@@ -736,7 +753,9 @@ IOStatus PosixRandomAccessFile::MultiRead(FSReadRequest* reqs, size_t num_reqs,
     incomplete_rq_list.clear();
 
     ssize_t ret =
-        io_uring_submit_and_wait(iu, static_cast<unsigned int>(this_reqs));
+        sq_polled
+            ? io_uring_submit(iu)
+            : io_uring_submit_and_wait(iu, static_cast<unsigned int>(this_reqs));
     TEST_SYNC_POINT_CALLBACK(
         "PosixRandomAccessFile::MultiRead:io_uring_submit_and_wait:return1",
         &ret);
@@ -767,7 +786,19 @@ IOStatus PosixRandomAccessFile::MultiRead(FSReadRequest* reqs, size_t num_reqs,
 
       // We could use the peek variant here, but this seems safer in terms
       // of our initial wait not reaping all completions
-      ret = io_uring_wait_cqe(iu, &cqe);
+      if (polled) {
+        IOSTATS_TIMER_GUARD(io_uring_poll_nanos);
+        if (sq_polled) {
+          while ((ret = io_uring_peek_cqe(iu, &cqe)) == -EAGAIN) {
+            port::AsmVolatilePause();
+          }
+        } else {
+          // io_uring_enter() polls the device for IOPOLL rings
+          ret = io_uring_wait_cqe(iu, &cqe);
+        }
+      } else {
+        ret = io_uring_wait_cqe(iu, &cqe);
+      }
       TEST_SYNC_POINT_CALLBACK(
           "PosixRandomAccessFile::MultiRead:io_uring_wait_cqe:return", &ret);
       if (ret) {
@@ -1308,6 +1339,283 @@ IOStatus PosixMmapFile::Allocate(uint64_t offset, uint64_t len,
 }
 #endif
 
+#if defined(ROCKSDB_IOURING_PRESENT)
+/*
+ * IOUringFileWriter
+ */
+IOUringFileWriter::IOUringFileWriter(const std::string& fname, int fd)
+    : filename_(fname), fd_(fd) {}
+
+std::unique_ptr<IOUringFileWriter> IOUringFileWriter::Create(
+    const std::string& fname, int fd, size_t alignment) {
+  std::unique_ptr<IOUringFileWriter> writer(new IOUringFileWriter(fname, fd));
+  // Room for every buffer's write plus the linked sync
+  if (io_uring_queue_init(2 * kNumBuffers, &writer->ring_, 0) != 0) {
+    return nullptr;
+  }
+  writer->ring_initialized_ = true;
+
+  struct iovec iovs[kNumBuffers];
+  alignment = std::max(alignment, static_cast<size_t>(kDefaultPageSize));
+  for (unsigned int i = 0; i < kNumBuffers; ++i) {
+    void* buf = nullptr;
+    if (posix_memalign(&buf, alignment, kBufferSize) != 0) {
+      return nullptr;
+    }
+    writer->buffers_[i].data = static_cast<char*>(buf);
+    iovs[i].iov_base = buf;
+    iovs[i].iov_len = kBufferSize;
+  }
+  if (io_uring_register_buffers(&writer->ring_, iovs, kNumBuffers) != 0) {
+    return nullptr;
+  }
+  writer->buffers_registered_ = true;
+  return writer;
+}
+
+IOUringFileWriter::~IOUringFileWriter() {
+  if (ring_initialized_) {
+    IOStatus s = WaitAll();
+    s.PermitUncheckedError();
+    if (buffers_registered_) {
+      io_uring_unregister_buffers(&ring_);
+    }
+    io_uring_queue_exit(&ring_);
+  }
+  for (auto& buffer : buffers_) {
+    free(buffer.data);
+  }
+}
+
+IOStatus IOUringFileWriter::SubmitLocked() {
+  mutex_.AssertHeld();
+  if (!status_.ok() || io_uring_sq_ready(&ring_) == 0) {
+    return status_;
+  }
+  int ret;
+  do {
+    ret = io_uring_submit(&ring_);
+  } while (ret == -EINTR);
+  TEST_SYNC_POINT_CALLBACK("IOUringFileWriter::SubmitLocked:io_uring_submit",
+                           &ret);
+  const unsigned int not_submitted = io_uring_sq_ready(&ring_);
+  if (ret < 0 || not_submitted > 0) {
+    // The requests that were not submitted never complete and the data of
+    // their writes is lost, so the writer fails from now on
+    assert(in_flight_ >= not_submitted);
+    in_flight_ -= not_submitted;
+    status_ = IOError("While io_uring_submit", filename_,
+                      ret < 0 ? -ret : EAGAIN);
+    return status_;
+  }
+  num_queued_writes_ = 0;
+  return IOStatus::OK();
+}
+
+IOStatus IOUringFileWriter::ReapOneLocked() {
+  mutex_.AssertHeld();
+  assert(in_flight_ > 0);
+  struct io_uring_cqe* cqe = nullptr;
+  int ret;
+  do {
+    ret = io_uring_wait_cqe(&ring_, &cqe);
+  } while (ret == -EINTR);
+  if (ret < 0) {
+    // Nothing can be reaped anymore, so the writer fails
+    in_flight_ = 0;
+    status_ = IOError("While waiting for io_uring write", filename_, -ret);
+    return status_;
+  }
+  return CompleteLocked(cqe);
+}
+
+IOStatus IOUringFileWriter::CompleteLocked(struct io_uring_cqe* cqe) {
+  mutex_.AssertHeld();
+  Buffer* buffer = static_cast<Buffer*>(io_uring_cqe_get_data(cqe));
+  const int res = cqe->res;
+  io_uring_cqe_seen(&ring_, cqe);
+  --in_flight_;
+
+  if (buffer == nullptr) {
+    sync_res_ = res;
+    return IOStatus::OK();
+  }
+  IOStatus s;
+  // A short write of a linked chain cancels the writes after it, which are
+  // then written synchronously like the rest of the short write
+  const size_t written = res == -ECANCELED ? 0 : static_cast<size_t>(res);
+  if (res < 0 && res != -ECANCELED) {
+    s = IOError("While io_uring write to file at offset " +
+                    std::to_string(buffer->offset),
+                filename_, -res);
+  } else if (written < buffer->len) {
+    if (!PosixPositionedWrite(fd_, buffer->data + written,
+                              buffer->len - written,
+                              static_cast<off_t>(buffer->offset + written))) {
+      s = IOError("While pwrite to file at offset " +
+                      std::to_string(buffer->offset + written),
+                  filename_, errno);
+    }
+  }
+  buffer->busy = false;
+  return s;
+}
+
+IOStatus IOUringFileWriter::ReapAllLocked() {
+  mutex_.AssertHeld();
+  IOStatus s;
+  while (in_flight_ > 0) {
+    IOStatus r = ReapOneLocked();
+    if (s.ok()) {
+      s = r;
+    } else {
+      r.PermitUncheckedError();
+    }
+  }
+  return s;
+}
+
+IOUringFileWriter::Buffer* IOUringFileWriter::GetFreeBufferLocked(
+    IOStatus* s) {
+  mutex_.AssertHeld();
+  while (true) {
+    for (auto& buffer : buffers_) {
+      if (!buffer.busy) {
+        return &buffer;
+      }
+    }
+    *s = SubmitLocked();
+    if (s->ok()) {
+      *s = ReapOneLocked();
+    }
+    if (!s->ok()) {
+      return nullptr;
+    }
+  }
+}
+
+IOStatus IOUringFileWriter::Write(const char* data, size_t n,
+                                  uint64_t offset) {
+  MutexLock lock(&mutex_);
+  IOStatus s = status_;
+  while (s.ok() && n > 0) {
+    Buffer* buffer = GetFreeBufferLocked(&s);
+    if (buffer == nullptr) {
+      return s;
+    }
+    const size_t len = std::min(n, kBufferSize);
+    memcpy(buffer->data, data, len);
+    buffer->len = len;
+    buffer->offset = offset;
+    buffer->busy = true;
+
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+    assert(sqe != nullptr);
+    io_uring_prep_write_fixed(sqe, fd_, buffer->data,
+                              static_cast<unsigned>(len), offset,
+                              static_cast<int>(buffer - buffers_));
+    io_uring_sqe_set_data(sqe, buffer);
+    assert(num_queued_writes_ < kNumBuffers);
+    queued_writes_[num_queued_writes_++] = sqe;
+    ++in_flight_;
+
+    data += len;
+    offset += len;
+    n -= len;
+  }
+  return s;
+}
+
+IOStatus IOUringFileWriter::Submit() {
+  MutexLock lock(&mutex_);
+  IOStatus s = SubmitLocked();
+  // Only the requests that were submitted can have completed
+  struct io_uring_cqe* cqe = nullptr;
+  while (in_flight_ > io_uring_sq_ready(&ring_) &&
+         io_uring_peek_cqe(&ring_, &cqe) == 0) {
+    IOStatus r = CompleteLocked(cqe);
+    if (s.ok()) {
+      s = r;
+    } else {
+      r.PermitUncheckedError();
+    }
+  }
+  return s;
+}
+
+IOStatus IOUringFileWriter::WaitAll() {
+  MutexLock lock(&mutex_);
+  IOStatus s = SubmitLocked();
+  IOStatus r = ReapAllLocked();
+  if (s.ok()) {
+    s = r;
+  } else {
+    r.PermitUncheckedError();
+  }
+  return s;
+}
+
+IOStatus IOUringFileWriter::Sync(bool full_sync) {
+  MutexLock lock(&mutex_);
+  if (!status_.ok()) {
+    return status_;
+  }
+  IOStatus s;
+  // Writes submitted earlier are not part of the linked chain, so they have
+  // to complete before the sync is issued
+  while (in_flight_ > io_uring_sq_ready(&ring_)) {
+    IOStatus r = ReapOneLocked();
+    if (s.ok()) {
+      s = r;
+    } else {
+      r.PermitUncheckedError();
+    }
+  }
+  // io_uring may run requests that are not linked in any order, so every
+  // queued write is linked ahead of the sync, not only the last one
+  for (unsigned int i = 0; i < num_queued_writes_; ++i) {
+    io_uring_sqe_set_flags(queued_writes_[i], IOSQE_IO_LINK);
+  }
+  TEST_SYNC_POINT_CALLBACK("IOUringFileWriter::Sync:LinkedWrites",
+                           &num_queued_writes_);
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  assert(sqe != nullptr);
+  io_uring_prep_fsync(sqe, fd_, full_sync ? 0 : IORING_FSYNC_DATASYNC);
+  io_uring_sqe_set_data(sqe, nullptr);
+  ++in_flight_;
+  sync_res_ = 0;
+
+  IOStatus r = SubmitLocked();
+  if (s.ok()) {
+    s = r;
+  } else {
+    r.PermitUncheckedError();
+  }
+  r = ReapAllLocked();
+  if (s.ok()) {
+    s = r;
+  } else {
+    r.PermitUncheckedError();
+  }
+  if (!s.ok()) {
+    return s;
+  }
+  if (sync_res_ == -ECANCELED) {
+    // A short write broke the chain; the writes were completed, so sync the
+    // usual way
+    if ((full_sync ? fsync(fd_) : fdatasync(fd_)) < 0) {
+      return IOError(full_sync ? "While fsync" : "While fdatasync", filename_,
+                     errno);
+    }
+  } else if (sync_res_ < 0) {
+    return IOError(
+        full_sync ? "While io_uring fsync" : "While io_uring fdatasync",
+        filename_, -sync_res_);
+  }
+  return IOStatus::OK();
+}
+#endif  // ROCKSDB_IOURING_PRESENT
+
 /*
  * PosixWritableFile
  *
@@ -1315,13 +1623,22 @@ IOStatus PosixMmapFile::Allocate(uint64_t offset, uint64_t len,
  */
 PosixWritableFile::PosixWritableFile(const std::string& fname, int fd,
                                      size_t logical_block_size,
-                                     const EnvOptions& options)
+                                     const EnvOptions& options,
+                                     bool use_io_uring)
     : FSWritableFile(options),
       filename_(fname),
       use_direct_io_(options.use_direct_writes),
       fd_(fd),
       filesize_(0),
       logical_sector_size_(logical_block_size) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (use_io_uring) {
+    uring_writer_ = IOUringFileWriter::Create(filename_, fd_,
+                                              logical_sector_size_);
+  }
+#else
+  (void)use_io_uring;
+#endif
 #ifdef ROCKSDB_FALLOCATE_PRESENT
   allow_fallocate_ = options.allow_fallocate;
   fallocate_with_keep_size_ = options.fallocate_with_keep_size;
@@ -1348,6 +1665,15 @@ IOStatus PosixWritableFile::Append(const Slice& data, const IOOptions& /*opts*/,
   const char* src = data.data();
   size_t nbytes = data.size();
 
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (uring_writer_) {
+    IOStatus s = uring_writer_->Write(src, nbytes, filesize_);
+    if (s.ok()) {
+      filesize_ += nbytes;
+    }
+    return s;
+  }
+#endif
   if (!PosixWrite(fd_, src, nbytes)) {
     return IOError("While appending to file", filename_, errno);
   }
@@ -1367,6 +1693,15 @@ IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
   assert(offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
   const char* src = data.data();
   size_t nbytes = data.size();
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (uring_writer_) {
+    IOStatus s = uring_writer_->Write(src, nbytes, offset);
+    if (s.ok()) {
+      filesize_ = offset + nbytes;
+    }
+    return s;
+  }
+#endif
   if (!PosixPositionedWrite(fd_, src, nbytes, static_cast<off_t>(offset))) {
     return IOError("While pwrite to file at offset " + std::to_string(offset),
                    filename_, errno);
@@ -1378,6 +1713,14 @@ IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
 IOStatus PosixWritableFile::Truncate(uint64_t size, const IOOptions& /*opts*/,
                                      IODebugContext* /*dbg*/) {
   IOStatus s;
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (uring_writer_) {
+    s = uring_writer_->WaitAll();
+    if (!s.ok()) {
+      return s;
+    }
+  }
+#endif
   int r = ftruncate(fd_, size);
   if (r < 0) {
     s = IOError("While ftruncate file to size " + std::to_string(size),
@@ -1391,6 +1734,12 @@ IOStatus PosixWritableFile::Truncate(uint64_t size, const IOOptions& /*opts*/,
 IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
   IOStatus s;
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (uring_writer_) {
+    s = uring_writer_->WaitAll();
+    uring_writer_.reset();
+  }
+#endif
 
   size_t block_size;
   size_t last_allocated_block;
@@ -1431,7 +1780,7 @@ IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
 #endif
   }
 
-  if (close(fd_) < 0) {
+  if (close(fd_) < 0 && s.ok()) {
     s = IOError("While closing file after writing", filename_, errno);
   }
   fd_ = -1;
@@ -1441,16 +1790,31 @@ IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
 // write out the cached data to the OS cache
 IOStatus PosixWritableFile::Flush(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (uring_writer_) {
+    return uring_writer_->Submit();
+  }
+#endif
   return IOStatus::OK();
 }
 
 IOStatus PosixWritableFile::Sync(const IOOptions& /*opts*/,
                                  IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (uring_writer_) {
+    return uring_writer_->Sync(false /* full_sync */);
+  }
+#endif
   return PosixSync(fd_, filename_, "");
 }
 
 IOStatus PosixWritableFile::Fsync(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (uring_writer_) {
+    return uring_writer_->Sync(true /* full_sync */);
+  }
+#endif
   return PosixFSync(fd_, filename_, "");
 }
 
@@ -1524,6 +1888,15 @@ IOStatus PosixWritableFile::Allocate(uint64_t offset, uint64_t len,
 IOStatus PosixWritableFile::RangeSync(uint64_t offset, uint64_t nbytes,
                                       const IOOptions& opts,
                                       IODebugContext* dbg) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (uring_writer_) {
+    // sync_file_range() only starts writeback of data already written
+    IOStatus s = uring_writer_->WaitAll();
+    if (!s.ok()) {
+      return s;
+    }
+  }
+#endif
 #ifdef ROCKSDB_RANGESYNC_PRESENT
   assert(offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
   assert(nbytes <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
@@ -97,6 +97,9 @@ Status FilePrefetchBuffer::Read(const IOOptions& opts,
   if (!s.ok()) {
     return s;
   }
+  if (IsAdaptiveReadahead()) {
+    IOSTATS_ADD(compaction_readahead_bytes, result.size());
+  }
 
   // Update the buffer offset and size.
   bufs_[index].offset_ = rounddown_start;
@@ -628,7 +631,18 @@ bool FilePrefetchBuffer::TryReadFromCacheUntracked(
   if (track_min_offset_ && offset < min_offset_read_) {
     min_offset_read_ = static_cast<size_t>(offset);
   }
-  if (!enable_ || (offset < bufs_[curr_].offset_)) {
+  if (!enable_) {
+    return false;
+  }
+  // Without asynchronous reads, every sequential read that needs more data
+  // waits for it
+  const bool sequential =
+      IsAdaptiveReadahead() && ShrinkReadaheadIfSkipping(offset);
+  if (offset < bufs_[curr_].offset_) {
+    if (IsAdaptiveReadahead()) {
+      // Shrink only once for this jump
+      UpdateReadPattern(offset, n, false /*decrease_readaheadsize*/);
+    }
     return false;
   }
 
@@ -643,7 +657,9 @@ bool FilePrefetchBuffer::TryReadFromCacheUntracked(
       Status s;
       assert(reader != nullptr);
       assert(max_readahead_size_ >= readahead_size_);
-      if (for_compaction) {
+      if (IsAdaptiveReadahead()) {
+        s = Prefetch(opts, reader, offset, n + readahead_size_);
+      } else if (for_compaction) {
         s = Prefetch(opts, reader, offset, std::max(n, readahead_size_));
       } else {
         if (implicit_auto_readahead_) {
@@ -665,18 +681,40 @@ bool FilePrefetchBuffer::TryReadFromCacheUntracked(
 #endif
         return false;
       }
-      readahead_size_ = std::min(max_readahead_size_, readahead_size_ * 2);
+      if (!IsAdaptiveReadahead()) {
+        readahead_size_ = std::min(max_readahead_size_, readahead_size_ * 2);
+      } else if (sequential && prev_len_ > 0) {
+        GrowReadaheadOnStall();
+      }
     } else {
       return false;
     }
   }
   UpdateReadPattern(offset, n, false /*decrease_readaheadsize*/);
+  if (IsAdaptiveReadahead()) {
+    IOSTATS_ADD(compaction_readahead_useful_bytes, n);
+  }
 
   uint64_t offset_in_buffer = offset - bufs_[curr_].offset_;
   *result = Slice(bufs_[curr_].buffer_.BufferStart() + offset_in_buffer, n);
   return true;
 }
 
+bool FilePrefetchBuffer::ShrinkReadaheadIfSkipping(uint64_t offset) {
+  if (IsBlockSequential(offset)) {
+    return true;
+  }
+  if (HasUnconsumedData()) {
+    readahead_size_ = std::max(kMinAdaptiveReadaheadSize, readahead_size_ / 2);
+  }
+  return false;
+}
+
+void FilePrefetchBuffer::GrowReadaheadOnStall() {
+  IOSTATS_ADD(compaction_readahead_stalls, 1);
+  readahead_size_ = std::min(max_readahead_size_, readahead_size_ * 2);
+}
+
 bool FilePrefetchBuffer::TryReadFromCacheAsync(const IOOptions& opts,
                                                RandomAccessFileReader* reader,
                                                uint64_t offset, size_t n,
@@ -718,7 +756,18 @@ bool FilePrefetchBuffer::TryReadFromCacheAsyncUntracked(
     }
   }
 
+  // A sequential read stalls if it has to wait for the data being read ahead
+  bool stalled = false;
+  if (IsAdaptiveReadahead() && ShrinkReadaheadIfSkipping(offset) &&
+      prev_len_ > 0) {
+    stalled = !IsDataBlockReady(offset, n);
+  }
+
   if (!explicit_prefetch_submitted_ && offset < bufs_[curr_].offset_) {
+    if (IsAdaptiveReadahead()) {
+      // Shrink only once for this jump
+      UpdateReadPattern(offset, n, false /*decrease_readaheadsize*/);
+    }
     return false;
   }
 
@@ -757,6 +806,15 @@ bool FilePrefetchBuffer::TryReadFromCacheAsyncUntracked(
       s = PrefetchAsyncInternal(opts, reader, offset, n, readahead_size_ / 2,
                                 copy_to_third_buffer);
       explicit_prefetch_submitted_ = false;
+      if (s.IsNotSupported() && async_reads_) {
+        // The file system cannot read this file asynchronously after all,
+        // continue with synchronous reads
+        async_reads_ = false;
+        AbortAllIOs();
+        bufs_[curr_ ^ 1].buffer_.Clear();
+        return TryReadFromCacheUntracked(opts, reader, offset, n, result,
+                                         status, true /* for_compaction */);
+      }
       if (!s.ok()) {
         if (status) {
           *status = s;
@@ -780,7 +838,12 @@ bool FilePrefetchBuffer::TryReadFromCacheAsyncUntracked(
   }
   uint64_t offset_in_buffer = offset - bufs_[index].offset_;
   *result = Slice(bufs_[index].buffer_.BufferStart() + offset_in_buffer, n);
-  if (prefetched) {
+  if (IsAdaptiveReadahead()) {
+    IOSTATS_ADD(compaction_readahead_useful_bytes, n);
+    if (stalled) {
+      GrowReadaheadOnStall();
+    }
+  } else if (prefetched) {
     readahead_size_ = std::min(max_readahead_size_, readahead_size_ * 2);
   }
   return true;
@@ -799,6 +862,9 @@ void FilePrefetchBuffer::PrefetchAsyncCallback(const FSReadRequest& req,
 #endif
 
   if (req.status.ok()) {
+    if (IsAdaptiveReadahead()) {
+      IOSTATS_ADD(compaction_readahead_bytes, req.result.size());
+    }
     if (req.offset + req.result.size() <=
         bufs_[index].offset_ + bufs_[index].buffer_.CurrentSize()) {
       // All requested bytes are already in the buffer or no data is read
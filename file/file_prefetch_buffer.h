@@ -56,12 +56,19 @@ struct BufferInfo {
 
 enum class FilePrefetchBufferUsage {
   kTableOpenPrefetchTail,
+  // Compaction input read ahead asynchronously, with a readahead size that
+  // adapts to the stalls and the unused read-ahead data (see
+  // DBOptions::max_compaction_readahead_size)
+  kCompactionAdaptiveReadahead,
   kUnknown,
 };
 
 // FilePrefetchBuffer is a smart buffer to store and read data from a file.
 class FilePrefetchBuffer {
  public:
+  // The smallest readahead size of kCompactionAdaptiveReadahead
+  static constexpr size_t kMinAdaptiveReadaheadSize = 8 * 1024;
+
   // Constructor.
   //
   // All arguments are optional.
@@ -118,6 +125,13 @@ class FilePrefetchBuffer {
     for (uint32_t i = 0; i < 2; i++) {
       bufs_[i].pos_ = i;
     }
+    // The adaptive readahead double-buffers with asynchronous reads when the
+    // file system supports them
+    if (IsAdaptiveReadahead() && fs_ != nullptr) {
+      int64_t supported_ops = 0;
+      fs_->SupportedOps(supported_ops);
+      async_reads_ = (supported_ops & (1ULL << FSSupportedOps::kAsyncIO)) != 0;
+    }
   }
 
   ~FilePrefetchBuffer() {
@@ -184,6 +198,14 @@ class FilePrefetchBuffer {
 
   bool Enabled() const { return enable_; }
 
+  bool IsAdaptiveReadahead() const {
+    return usage_ == FilePrefetchBufferUsage::kCompactionAdaptiveReadahead;
+  }
+
+  // Whether the reads from this buffer should go through
+  // TryReadFromCacheAsync(), even if ReadOptions::async_io is not set
+  bool UsesAsyncReads() const { return async_reads_; }
+
   // Load data into the buffer from a file.
   // opts                  : the IO options to use.
   // reader                : the file reader.
@@ -222,6 +244,23 @@ class FilePrefetchBuffer {
                         uint64_t offset, size_t n, Slice* result, Status* s,
                         bool for_compaction = false);
 
+  // Returns the data for a file read from this buffer if it is already in the
+  // current buffer. Unlike TryReadFromCache(), it never reads or prefetches
+  // and does not update the read pattern, so data can be looked at ahead of
+  // its actual read. `result` is only valid until the next read.
+  bool TryPeekFromBuffer(uint64_t offset, size_t n, Slice* result) const {
+    if (!enable_ || bufs_[curr_].async_read_in_progress_ ||
+        offset < bufs_[curr_].offset_ ||
+        offset + n >
+            bufs_[curr_].offset_ + bufs_[curr_].buffer_.CurrentSize()) {
+      return false;
+    }
+    *result = Slice(
+        bufs_[curr_].buffer_.BufferStart() + (offset - bufs_[curr_].offset_),
+        n);
+    return true;
+  }
+
   bool TryReadFromCacheAsync(const IOOptions& opts,
                              RandomAccessFileReader* reader, uint64_t offset,
                              size_t n, Slice* result, Status* status);
@@ -317,6 +356,34 @@ class FilePrefetchBuffer {
     return (prev_len_ == 0 || (prev_offset_ + prev_len_ == offset));
   }
 
+  // Whether all the bytes of [offset, offset + length) are in buffers that
+  // can be read without waiting for I/O
+  bool IsDataBlockReady(uint64_t offset, size_t length) {
+    uint64_t ready_end = offset;
+    for (uint32_t index : {curr_, curr_ ^ 1}) {
+      // Reads completed within ReadAsync() leave no I/O handle behind
+      if ((!bufs_[index].async_read_in_progress_ ||
+           bufs_[index].io_handle_ == nullptr) &&
+          DoesBufferContainData(index) && IsOffsetInBuffer(ready_end, index)) {
+        ready_end = bufs_[index].offset_ + bufs_[index].buffer_.CurrentSize();
+      }
+    }
+    return ready_end >= offset + length;
+  }
+
+  // Whether read-ahead data after the previous read is still in the buffers
+  bool HasUnconsumedData() {
+    for (uint32_t index : {curr_, curr_ ^ 1}) {
+      if (bufs_[index].async_read_in_progress_ ||
+          (DoesBufferContainData(index) &&
+           bufs_[index].offset_ + bufs_[index].buffer_.CurrentSize() >
+               prev_offset_ + prev_len_)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   // Called in case of implicit auto prefetching.
   void ResetValues() {
     num_file_reads_ = 1;
@@ -414,6 +481,15 @@ class FilePrefetchBuffer {
                                bool& copy_to_third_buffer, uint64_t& tmp_offset,
                                size_t& tmp_length);
 
+  // Halves the readahead size of the adaptive readahead if a read at `offset`
+  // skips data that was read ahead. Returns whether the read follows the
+  // previous one.
+  bool ShrinkReadaheadIfSkipping(uint64_t offset);
+
+  // Doubles the readahead size of the adaptive readahead after a read waited
+  // for data it was reading ahead
+  void GrowReadaheadOnStall();
+
   bool TryReadFromCacheUntracked(const IOOptions& opts,
                                  RandomAccessFileReader* reader,
                                  uint64_t offset, size_t n, Slice* result,
@@ -478,6 +554,9 @@ class FilePrefetchBuffer {
   Statistics* stats_;
 
   FilePrefetchBufferUsage usage_;
+  // Set for the adaptive readahead when the file system supports
+  // asynchronous reads
+  bool async_reads_ = false;
 
   // upper_bound_offset_ is set when ReadOptions.iterate_upper_bound and
   // ReadOptions.auto_readahead_size are set to trim readahead_size upto
@@ -252,8 +252,18 @@ std::string IdentityFileName(const std::string& dbname) {
   return dbname + "/IDENTITY";
 }
 
+std::string HotBlocksFileName(const std::string& dbname) {
+  return dbname + "/HOTBLOCKS";
+}
+
+std::string HotBlocksTempFileName(const std::string& dbname) {
+  return HotBlocksFileName(dbname) + "." + kTempFileNameSuffix;
+}
+
 // Owned filenames have the form:
 //    dbname/IDENTITY
+//    dbname/HOTBLOCKS
+//    dbname/HOTBLOCKS.dbtmp
 //    dbname/CURRENT
 //    dbname/LOCK
 //    dbname/<info_log_name_prefix>
@@ -279,6 +289,12 @@ bool ParseFileName(const std::string& fname, uint64_t* number,
   if (rest == "IDENTITY") {
     *number = 0;
     *type = kIdentityFile;
+  } else if (rest == "HOTBLOCKS") {
+    *number = 0;
+    *type = kHotBlocksFile;
+  } else if (rest == "HOTBLOCKS." + kTempFileNameSuffix) {
+    *number = 0;
+    *type = kTempFile;
   } else if (rest == "CURRENT") {
     *number = 0;
     *type = kCurrentFile;
@@ -147,6 +147,14 @@ extern std::string MetaDatabaseName(const std::string& dbname, uint64_t number);
 // either from a backup-image or empty
 extern std::string IdentityFileName(const std::string& dbname);
 
+// Return the name of the file that lists the hottest block cache entries of
+// the db, used to warm up the block cache when the db is opened
+extern std::string HotBlocksFileName(const std::string& dbname);
+
+// Return the name of the temporary file the hot block list is written to
+// before it is renamed to HotBlocksFileName(dbname)
+extern std::string HotBlocksTempFileName(const std::string& dbname);
+
 // If filename is a rocksdb file, store the type of the file in *type.
 // The number encoded in the filename is stored in *number.  If the
 // filename was successfully parsed, returns true.  Else return false.
@@ -21,6 +21,7 @@
 #include "file/file_prefetch_buffer.h"
 #include "file/file_util.h"
 #include "rocksdb/file_system.h"
+#include "rocksdb/iostats_context.h"
 #include "test_util/sync_point.h"
 #ifdef GFLAGS
 #include "tools/io_tracer_parser_tool.h"
@@ -289,6 +290,76 @@ TEST_P(PrefetchTest, Basic) {
   Close();
 }
 
+class CompactionStatsListener : public EventListener {
+ public:
+  void OnCompactionCompleted(DB* /*db*/, const CompactionJobInfo& ci) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.Add(ci.stats);
+  }
+
+  CompactionJobStats stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+ private:
+  std::mutex mutex_;
+  CompactionJobStats stats_;
+};
+
+// This test verifies that with DBOptions.max_compaction_readahead_size, the
+// compaction inputs are read through the adaptive prefetch buffer and the
+// efficiency of the readahead is reported in CompactionJobStats.
+TEST_P(PrefetchTest, CompactionAdaptiveReadahead) {
+  bool support_prefetch =
+      std::get<0>(GetParam()) &&
+      test::IsPrefetchSupported(env_->GetFileSystem(), dbname_);
+  std::shared_ptr<MockFS> fs =
+      std::make_shared<MockFS>(env_->GetFileSystem(), support_prefetch);
+  bool use_direct_io = std::get<1>(GetParam());
+
+  std::unique_ptr<Env> env(new CompositeEnvWrapper(env_, fs));
+  Options options;
+  SetGenericOptions(env.get(), use_direct_io, options);
+  options.write_buffer_size = 1024 * 1024;
+  options.max_compaction_readahead_size = 256 * 1024;
+  auto listener = std::make_shared<CompactionStatsListener>();
+  options.listeners.emplace_back(listener);
+
+  Status s = TryReopen(options);
+  if (use_direct_io && (s.IsNotSupported() || s.IsInvalidArgument())) {
+    // If direct IO is not supported, skip the test
+    return;
+  } else {
+    ASSERT_OK(s);
+  }
+
+  const int kNumKeys = 2000;
+  Random rnd(301);
+  for (int file = 0; file < 2; file++) {
+    for (int i = 0; i < kNumKeys; i++) {
+      ASSERT_OK(Put(BuildKey(i), rnd.RandomString(100)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  CompactionJobStats stats = listener->stats();
+  ASSERT_GT(stats.readahead_bytes, 0);
+  ASSERT_GT(stats.readahead_useful_bytes, 0);
+  ASSERT_LE(stats.readahead_useful_bytes, stats.readahead_bytes);
+
+  int num_keys = 0;
+  auto iter = std::unique_ptr<Iterator>(db_->NewIterator(ReadOptions()));
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    num_keys++;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(num_keys, kNumKeys);
+  iter.reset();
+  Close();
+}
+
 class PrefetchTailTest : public PrefetchTest {
  public:
   bool SupportPrefetch() const {
@@ -2032,6 +2103,111 @@ TEST_P(PrefetchTest1, SeekParallelizationTest) {
   Close();
 }
 
+TEST_P(PrefetchTest1, ParallelDecompression) {
+  const int kNumKeys = 2000;
+  for (CompressionType compression : GetSupportedCompressions()) {
+    Options options;
+    SetGenericOptions(env_, GetParam(), options);
+    options.compression = compression;
+    options.compaction_readahead_size = 64 * 1024;
+    options.compaction_decompression_threads = 2;
+    BlockBasedTableOptions table_options;
+    SetBlockBasedTableOptions(table_options);
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+    Destroy(options);
+    Status s = TryReopen(options);
+    if (GetParam() && (s.IsNotSupported() || s.IsInvalidArgument())) {
+      // If direct IO is not supported, skip the test
+      return;
+    } else {
+      ASSERT_OK(s);
+    }
+
+    auto value_of = [this](int i) {
+      return std::string(500, static_cast<char>('a' + i % 26)) + Key(i);
+    };
+    for (int j = 0; j < 2; j++) {
+      WriteBatch batch;
+      for (int i = j; i < kNumKeys; i += 2) {
+        ASSERT_OK(batch.Put(Key(i), value_of(i)));
+      }
+      ASSERT_OK(db_->Write(WriteOptions(), &batch));
+      ASSERT_OK(Flush());
+    }
+
+    std::atomic<int> decompressed_ahead{0};
+    SyncPoint::GetInstance()->SetCallBack(
+        "BlockBasedTableIterator::InitDataBlock:DecompressedAhead",
+        [&](void*) { decompressed_ahead++; });
+    SyncPoint::GetInstance()->EnableProcessing();
+
+    // Compaction inputs are read with readahead and decompressed ahead
+    ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+    if (compression != kNoCompression) {
+      ASSERT_GT(decompressed_ahead.load(), 0);
+    }
+
+    ReadOptions ro;
+    ro.fill_cache = false;
+    ro.readahead_size = 64 * 1024;
+    ro.decompression_threads = 2;
+    decompressed_ahead = 0;
+    {
+      auto iter = std::unique_ptr<Iterator>(db_->NewIterator(ro));
+      int i = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next(), i++) {
+        ASSERT_EQ(iter->key().ToString(), Key(i));
+        ASSERT_EQ(iter->value().ToString(), value_of(i));
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(i, kNumKeys);
+
+      // Seeking and changing direction drops the blocks decompressed ahead
+      iter->Seek(Key(kNumKeys / 2));
+      for (i = kNumKeys / 2; i < kNumKeys / 2 + 100; i++) {
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(iter->key().ToString(), Key(i));
+        iter->Next();
+      }
+      for (; i > kNumKeys / 2; i--) {
+        iter->Prev();
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(iter->key().ToString(), Key(i - 1));
+        ASSERT_EQ(iter->value().ToString(), value_of(i - 1));
+      }
+      for (; i < kNumKeys; i++) {
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(iter->key().ToString(), Key(i));
+        iter->Next();
+      }
+      ASSERT_FALSE(iter->Valid());
+      ASSERT_OK(iter->status());
+    }
+    if (compression != kNoCompression) {
+      ASSERT_GT(decompressed_ahead.load(), 0);
+    }
+
+    // Blocks past the upper bound are not decompressed ahead
+    std::string upper_bound = Key(kNumKeys / 4);
+    Slice upper_bound_slice(upper_bound);
+    ro.iterate_upper_bound = &upper_bound_slice;
+    {
+      auto iter = std::unique_ptr<Iterator>(db_->NewIterator(ro));
+      int i = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next(), i++) {
+        ASSERT_EQ(iter->key().ToString(), Key(i));
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(i, kNumKeys / 4);
+    }
+
+    SyncPoint::GetInstance()->DisableProcessing();
+    SyncPoint::GetInstance()->ClearAllCallBacks();
+  }
+  Close();
+}
+
 // This test checks if readahead_size is trimmed when upper_bound is reached.
 // It tests with different combinations of async_io disabled/enabled,
 // readahead_size (implicit and explicit), and num_file_reads_for_auto_readahead
@@ -2827,10 +3003,12 @@ class FilePrefetchBufferTest : public testing::Test {
   }
 
   void Read(const std::string& fname, const FileOptions& opts,
-            std::unique_ptr<RandomAccessFileReader>* reader) {
+            std::unique_ptr<RandomAccessFileReader>* reader,
+            FileSystem* fs = nullptr) {
     std::string fpath = Path(fname);
     std::unique_ptr<FSRandomAccessFile> f;
-    ASSERT_OK(fs_->NewRandomAccessFile(fpath, opts, &f, nullptr));
+    ASSERT_OK((fs != nullptr ? fs : fs_.get())
+                  ->NewRandomAccessFile(fpath, opts, &f, nullptr));
     reader->reset(new RandomAccessFileReader(
         std::move(f), fpath, env_->GetSystemClock().get(),
         /*io_tracer=*/nullptr, stats_.get()));
@@ -3024,6 +3202,116 @@ TEST_F(FilePrefetchBufferTest, NoSyncWithAsyncIO) {
   ASSERT_EQ(result, async_result);
 }
 
+// Completes the asynchronous reads within ReadAsync()
+class InlineAsyncReadFile : public FSRandomAccessFileOwnerWrapper {
+ public:
+  explicit InlineAsyncReadFile(std::unique_ptr<FSRandomAccessFile>&& file)
+      : FSRandomAccessFileOwnerWrapper(std::move(file)) {}
+
+  IOStatus ReadAsync(FSReadRequest& req, const IOOptions& opts,
+                     std::function<void(const FSReadRequest&, void*)> cb,
+                     void* cb_arg, void** io_handle, IOHandleDeleter* del_fn,
+                     IODebugContext* dbg) override {
+    return FSRandomAccessFile::ReadAsync(req, opts, cb, cb_arg, io_handle,
+                                         del_fn, dbg);
+  }
+};
+
+class InlineAsyncReadFS : public FileSystemWrapper {
+ public:
+  explicit InlineAsyncReadFS(const std::shared_ptr<FileSystem>& wrapped)
+      : FileSystemWrapper(wrapped) {}
+
+  static const char* kClassName() { return "InlineAsyncReadFS"; }
+  const char* Name() const override { return kClassName(); }
+
+  IOStatus NewRandomAccessFile(const std::string& fname,
+                               const FileOptions& opts,
+                               std::unique_ptr<FSRandomAccessFile>* result,
+                               IODebugContext* dbg) override {
+    std::unique_ptr<FSRandomAccessFile> file;
+    IOStatus s = target()->NewRandomAccessFile(fname, opts, &file, dbg);
+    if (s.ok()) {
+      result->reset(new InlineAsyncReadFile(std::move(file)));
+    }
+    return s;
+  }
+
+  void SupportedOps(int64_t& supported_ops) override {
+    supported_ops = 1 << FSSupportedOps::kAsyncIO;
+  }
+};
+
+// Test that the adaptive readahead of the compaction inputs grows while the
+// reads wait for it and shrinks when read-ahead data is skipped, with
+// synchronous and asynchronous reads.
+TEST_F(FilePrefetchBufferTest, AdaptiveReadahead) {
+  std::string fname = "adaptive-readahead";
+  Random rand(0);
+  std::string content = rand.RandomString(256 * 1024);
+  Write(fname, content);
+
+  const size_t kBlockSize = 16 * 1024;
+  const size_t kMaxReadaheadSize = 64 * 1024;
+  auto async_fs = std::make_shared<InlineAsyncReadFS>(FileSystem::Default());
+  for (bool async_reads : {false, true}) {
+    FileSystem* fs = async_reads ? async_fs.get() : this->fs();
+    std::unique_ptr<RandomAccessFileReader> r;
+    Read(fname, FileOptions(), &r, fs);
+
+    FilePrefetchBuffer fpb(
+        /*readahead_size=*/kBlockSize, kMaxReadaheadSize, /*enable=*/true,
+        /*track_min_offset=*/false, /*implicit_auto_readahead=*/false,
+        /*num_file_reads=*/0, /*num_file_reads_for_auto_readahead=*/0,
+        /*upper_bound_offset=*/0, fs, /*clock=*/nullptr, /*stats=*/nullptr,
+        FilePrefetchBufferUsage::kCompactionAdaptiveReadahead);
+    ASSERT_EQ(fpb.UsesAsyncReads(), async_reads);
+    get_iostats_context()->Reset();
+
+    auto read_block = [&](uint64_t offset) {
+      Slice result;
+      Status s;
+      bool found =
+          fpb.UsesAsyncReads()
+              ? fpb.TryReadFromCacheAsync(IOOptions(), r.get(), offset,
+                                          kBlockSize, &result, &s)
+              : fpb.TryReadFromCache(IOOptions(), r.get(), offset, kBlockSize,
+                                     &result, &s, /*for_compaction=*/true);
+      ASSERT_OK(s);
+      ASSERT_TRUE(found);
+      ASSERT_EQ(Slice(content.data() + offset, kBlockSize), result);
+    };
+
+    // Sequential reads of blocks as large as the initial readahead size
+    // outrun it
+    const uint64_t kNumBlocks = 11;
+    for (uint64_t i = 0; i < kNumBlocks; i++) {
+      read_block(i * kBlockSize);
+    }
+    ReadaheadFileInfo::ReadaheadInfo readahead_info;
+    fpb.GetReadaheadState(&readahead_info);
+    const size_t readahead_size = readahead_info.readahead_size;
+    if (async_reads) {
+      // The reads complete within ReadAsync(), so they stop stalling once
+      // the asynchronous readahead got ahead of them
+      ASSERT_GT(readahead_size, kBlockSize);
+      ASSERT_LE(readahead_size, kMaxReadaheadSize);
+    } else {
+      ASSERT_EQ(readahead_size, kMaxReadaheadSize);
+    }
+    ASSERT_GT(get_iostats_context()->compaction_readahead_stalls, 0);
+    ASSERT_EQ(get_iostats_context()->compaction_readahead_useful_bytes,
+              kNumBlocks * kBlockSize);
+    ASSERT_GE(get_iostats_context()->compaction_readahead_bytes,
+              kNumBlocks * kBlockSize);
+
+    // Skipping data that was read ahead halves the readahead size
+    read_block((kNumBlocks + 3) * kBlockSize);
+    fpb.GetReadaheadState(&readahead_info);
+    ASSERT_EQ(readahead_info.readahead_size, readahead_size / 2);
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
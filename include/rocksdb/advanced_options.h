@@ -71,6 +71,15 @@ enum CompactionPri : char {
   // level. The file picking process will cycle through all the files in a
   // round-robin manner.
   kRoundRobin = 0x4,
+  // First compact files whose key ranges are read the most, weighted by the
+  // number of lower levels that overlap the range. The read heat of a file is
+  // the rate of sampled reads (the file read counts also exposed in
+  // SstFileMetaData::num_reads_sampled) since the file was created, so new
+  // and old files compare fairly. Compacting such a file removes a level
+  // from the path of the hottest Get()s. Files without sampled reads are
+  // ordered as with kMinOverlappingRatio. Try this for skewed read
+  // workloads where a small key range gets most of the reads.
+  kHottestRangeFirst = 0x5,
 };
 
 // Compression options for different compression algorithms like Zlib
@@ -203,6 +212,24 @@ struct CompressionOptions {
   // decompression.
   bool checksum = false;
 
+  // ZSTD only, and only effective when max_dict_bytes is nonzero.
+  // Use one dictionary for the whole column family instead of one per SST
+  // file. Table builders sample the data blocks they write, and a compaction
+  // trains a dictionary from the samples (using zstd_max_train_bytes and
+  // use_zstd_dict_trainer like per-file dictionaries do). The dictionary is
+  // recorded in the MANIFEST and referenced by ID from the files compressed
+  // with it, so that readers share one digested dictionary. The dictionary is
+  // retrained when the compression ratio achieved with it drops noticeably,
+  // and dropped from the MANIFEST once no live file refers to it. Until the
+  // first dictionary is trained, files use their own dictionary as usual.
+  //
+  // Files still store a copy of the dictionary, so that RepairDB(),
+  // SstFileReader and external tools can read them. A MANIFEST with shared
+  // dictionaries cannot be opened by older versions.
+  //
+  // Default: false.
+  bool use_shared_dict = false;
+
   // A convenience function for setting max_compressed_bytes_per_kb based on a
   // minimum acceptable compression ratio (uncompressed size over compressed
   // size).
@@ -211,6 +238,13 @@ struct CompressionOptions {
   }
 };
 
+// A compression type and level that adaptive compression may choose (see
+// adaptive_compression_candidates)
+struct AdaptiveCompressionCandidate {
+  CompressionType type = kNoCompression;
+  int level = CompressionOptions::kDefaultCompressionLevel;
+};
+
 // Temperature of a file. Used to pass to FileSystem for a different
 // placement and/or coding.
 // Reserve some numbers in the middle, in case we need to insert new tier
@@ -228,6 +262,11 @@ struct FileTemperatureAge {
   uint64_t age = 0;
 };
 
+struct KeyPrefixRetention {
+  std::string prefix;
+  uint64_t retention_seconds = 0;
+};
+
 struct CompactionOptionsFIFO {
   // once the total sum of table files reaches this, we will delete the oldest
   // table file
@@ -1245,6 +1284,76 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API.
   uint32_t bottommost_file_compaction_delay = 0;
 
+  // If positive, leveled compaction also picks files whose range tombstones
+  // cover data in the lower levels, which reads of the deleted keys still
+  // have to search past. Files are picked by the expected reduction of read
+  // cost, estimated as the bytes their range tombstones cover in the lower
+  // levels weighted by their sampled reads, highest first. Only files that
+  // cover more bytes than their own size qualify, and the covered bytes of
+  // the qualifying files being compacted at a time are limited to this
+  // budget (a single file may exceed it).
+  //
+  // Default: 0 (disabled)
+  // Dynamically changeable through the SetOptions() API.
+  uint64_t range_tombstone_compaction_budget = 0;
+
+  // EXPERIMENTAL
+  // Retention periods (in seconds) of the keys that start with a prefix. A
+  // key that matches several prefixes uses the longest one, and keys that
+  // match none are kept forever. The age of the keys is estimated with the
+  // sequence number to time mapping, which is sampled as with
+  // `preserve_internal_time_seconds` for the longest retention period.
+  //
+  // Compaction outputs are partitioned at the boundaries of the prefixes, so
+  // SST files hold the keys of a single prefix. Files whose keys all expired
+  // are deleted without being rewritten, and files that hold both expired and
+  // live keys are compacted to drop the expired ones. Expired keys are dropped
+  // regardless of snapshots, as by a compaction filter, and may be returned by
+  // reads until they are dropped. The keys of ingested files, whose time is
+  // unknown, only expire with their file.
+  //
+  // Only supported with leveled compaction and the bytewise comparators.
+  // Example:
+  //   "key_prefix_retentions={{prefix=session_;retention_seconds=3600}:
+  //    {prefix=log_;retention_seconds=86400}}"
+  //
+  // Default: empty (disabled)
+  //
+  // Not dynamically changeable, change it requires db restart.
+  std::vector<KeyPrefixRetention> key_prefix_retentions{};
+
+  // EXPERIMENTAL
+  // If not empty, the output files of compactions are compressed with one of
+  // these compression types and levels instead of the static choice of
+  // `compression`, `compression_per_level` and `bottommost_compression`.
+  // For every output level, the compression time and the compressed size of
+  // the data blocks are measured for each candidate, and each output file
+  // uses the candidate with the lowest cost per input byte:
+  //   compression nanoseconds + adaptive_compression_write_cost *
+  //                             compressed bytes
+  // A small share of the files keeps measuring the other candidates, so that
+  // the choice follows changes of the data and of the host load. The choice
+  // is recorded in the compression name and options table properties of each
+  // file. Candidates that are not supported by the build are ignored, and
+  // flushes keep using the static choice.
+  //
+  // Example:
+  //   "adaptive_compression_candidates={{type=kLZ4Compression;level=0}:
+  //    {type=kZSTD;level=3}}"
+  //
+  // Default: empty (disabled)
+  // Dynamically changeable through the SetOptions() API.
+  std::vector<AdaptiveCompressionCandidate> adaptive_compression_candidates{};
+
+  // The cost of writing one byte, in nanoseconds of compression CPU time,
+  // used by adaptive compression. Hosts bound by I/O should use larger
+  // values, so that stronger compression is chosen, and hosts bound by CPU
+  // smaller ones.
+  //
+  // Default: 4.0
+  // Dynamically changeable through the SetOptions() API.
+  double adaptive_compression_write_cost = 4.0;
+
   // Create ColumnFamilyOptions with default values for all fields
   AdvancedColumnFamilyOptions();
   // Create ColumnFamilyOptions from Options
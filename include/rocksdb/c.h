@@ -2915,6 +2915,23 @@ extern ROCKSDB_LIBRARY_API void rocksdb_pinnableslice_destroy(
 extern ROCKSDB_LIBRARY_API const char* rocksdb_pinnableslice_value(
     const rocksdb_pinnableslice_t* t, size_t* vlen);
 
+/* Reusable pinned reads. The value handle is created once, and each
+   rocksdb_get_pinned_v2() call fills it without copying the value when it is
+   in the block cache, and without allocating. The value stays valid, and the
+   memory holding it pinned, until the handle is reset, reused or destroyed.
+   Returns 1 if the key was found, 0 otherwise (including on error). */
+extern ROCKSDB_LIBRARY_API rocksdb_pinnableslice_t*
+rocksdb_pinnableslice_create(void);
+extern ROCKSDB_LIBRARY_API void rocksdb_pinnableslice_reset(
+    rocksdb_pinnableslice_t* v);
+extern ROCKSDB_LIBRARY_API unsigned char rocksdb_get_pinned_v2(
+    rocksdb_t* db, const rocksdb_readoptions_t* options, const char* key,
+    size_t keylen, rocksdb_pinnableslice_t* value, char** errptr);
+extern ROCKSDB_LIBRARY_API unsigned char rocksdb_get_pinned_cf_v2(
+    rocksdb_t* db, const rocksdb_readoptions_t* options,
+    rocksdb_column_family_handle_t* column_family, const char* key,
+    size_t keylen, rocksdb_pinnableslice_t* value, char** errptr);
+
 extern ROCKSDB_LIBRARY_API rocksdb_memory_consumers_t*
 rocksdb_memory_consumers_create(void);
 extern ROCKSDB_LIBRARY_API void rocksdb_memory_consumers_add_db(
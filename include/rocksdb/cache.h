@@ -333,6 +333,17 @@ struct CompressedSecondaryCacheOptions : LRUCacheOptions {
   // (Filter blocks are essentially non-compressible but others usually are.)
   CacheEntryRoleSet do_not_compress_roles = {CacheEntryRole::kFilterBlock};
 
+  // Use TinyLFU admission instead of the default "admit on second eviction"
+  // scheme. A compact frequency sketch records recent lookups and insertion
+  // attempts, and a block evicted from the primary cache is only admitted if
+  // it fits without eviction or is estimated to be accessed more often than
+  // the entry it would evict. This keeps one-off blocks (e.g. from scans)
+  // from flushing frequently used blocks out of the secondary cache. Has no
+  // effect on insertions with force_insert. The sketch is resized with
+  // SetCapacity, but the option itself cannot be changed once the cache is
+  // created.
+  bool enable_tinylfu_admission = false;
+
   CompressedSecondaryCacheOptions() {}
   CompressedSecondaryCacheOptions(
       size_t _capacity, int _num_shard_bits, bool _strict_capacity_limit,
@@ -484,6 +495,12 @@ enum TieredAdmissionPolicy {
   // Same as kAdmPolicyPlaceholder, but also if an entry in the primary cache
   // was a hit, then force insert it into the compressed secondary cache
   kAdmPolicyAllowCacheHits,
+  // No placeholders. Every entry evicted from the primary cache is force
+  // inserted into the compressed secondary cache, rather than only on its
+  // second eviction. A hit in the secondary cache decompresses the entry,
+  // erases the compressed copy and inserts the entry back into the primary
+  // cache, as with the other policies.
+  kAdmPolicyAllowAll,
   kAdmPolicyMax,
 };
 
@@ -94,6 +94,17 @@ struct CompactionJobStats {
   // Time spent on preparing file write (fallocate, etc)
   uint64_t file_prepare_write_nanos;
 
+  // Following counters are only populated if
+  // DBOptions::max_compaction_readahead_size is set.
+
+  // the number of bytes read ahead of the compaction from its input files.
+  uint64_t readahead_bytes;
+  // the number of the read-ahead bytes that the compaction used. The
+  // prefetch efficiency of the compaction is the ratio of both.
+  uint64_t readahead_useful_bytes;
+  // the number of times the compaction waited for data it was reading ahead.
+  uint64_t readahead_stalls;
+
   // 0-terminated strings storing the first 8 bytes of the smallest and
   // largest key in the output.
   static const size_t kMaxPrefixLength = 8;
@@ -25,6 +25,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -153,6 +154,33 @@ struct GetMergeOperandsOptions {
   int expected_max_number_of_operands = 0;
 };
 
+// Invoked once all the keys of a DB::MultiGetAsync() call are resolved, with
+// the status and value of each key, in the order of the keys
+using MultiGetAsyncCallback = std::function<void(
+    std::vector<Status>&& statuses, std::vector<PinnableSlice>&& values)>;
+
+// Tracks the lookups started by DB::MultiGetAsync(). The application makes
+// them progress by calling Poll(), and their callbacks are invoked from Poll()
+// on the calling thread, never from MultiGetAsync() itself.
+//
+// A queue is not thread-safe, but each thread may use its own. It must be
+// destroyed before the DBs it has lookups of are closed; destroying it
+// completes the lookups still in flight.
+class MultiGetAsyncQueue {
+ public:
+  virtual ~MultiGetAsyncQueue() {}
+
+  // Number of lookups whose callback has not been invoked yet
+  virtual size_t NumInFlight() const = 0;
+
+  // Advances the lookups in flight, waiting for I/O until at least
+  // `min_completions` of them have completed (or all of them, if fewer are
+  // in flight). Returns the number of callbacks invoked.
+  virtual size_t Poll(size_t min_completions) = 0;
+};
+
+std::unique_ptr<MultiGetAsyncQueue> NewMultiGetAsyncQueue();
+
 // A collections of table properties objects, where
 //  key: is the table's file name.
 //  value: the table properties object of the given table.
@@ -806,6 +834,29 @@ class DB {
     }
   }
 
+  // Asynchronous version of MultiGet() for keys of a single column family.
+  // Memtables, filters and indexes are searched synchronously, while data
+  // blocks that are not in the block cache are read through
+  // FileSystem::ReadAsync() (with io_uring on Posix), so a single thread can
+  // keep many lookups in flight. The lookups advance when `queue->Poll()` is
+  // called, and `callback` is invoked from there once all keys are resolved.
+  //
+  // The lookups see the DB as of this call: an implicit snapshot is taken if
+  // `options.snapshot` is not set. The keys are copied. Data blocks read on
+  // behalf of the lookups are inserted into the block cache, so without a
+  // block cache or with `options.fill_cache` unset, the keys are looked up
+  // synchronously.
+  //
+  // Returns a non-OK status, without ever invoking `callback`, if the lookups
+  // could not be started.
+  virtual Status MultiGetAsync(const ReadOptions& /*options*/,
+                               ColumnFamilyHandle* /*column_family*/,
+                               const std::vector<Slice>& /*keys*/,
+                               MultiGetAsyncCallback /*callback*/,
+                               MultiGetAsyncQueue* /*queue*/) {
+    return Status::NotSupported("MultiGetAsync() not supported");
+  }
+
   // Batched MultiGet-like API that returns wide-column entities from a single
   // column family. For any given "key[i]" in "keys" (where 0 <= "i" <
   // "num_keys"), if the column family specified by "column_family" contains an
@@ -149,6 +149,15 @@ class FilterPolicy : public Customizable {
   // built-in FilterPolicy.
   virtual FilterBitsReader* GetFilterBitsReader(
       const Slice& /*contents*/) const = 0;
+
+  // Returns true if the filters generated by this policy can also answer
+  // whether any key in a key range may be present, and not only point (and
+  // prefix) queries. Such filters are consulted by bounded iterator seeks
+  // (ReadOptions::iterate_upper_bound set) before reading index and data
+  // blocks. Range queries are only used for full (non-partitioned) filters
+  // with whole_key_filtering, a bytewise comparator and no user-defined
+  // timestamps.
+  virtual bool SupportsRangeQueries() const { return false; }
 };
 
 // Return a new filter policy that uses a bloom filter with approximately
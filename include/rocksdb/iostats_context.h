@@ -75,6 +75,17 @@ struct IOStatsContext {
   uint64_t cpu_write_nanos;
   // CPU time spent in read() and pread()
   uint64_t cpu_read_nanos;
+  // time spent waiting for io_uring read completions in polled mode
+  // (io_uring_sqpoll or io_uring_iopoll options of the posix FileSystem),
+  // i.e. the CPU cost of polling
+  uint64_t io_uring_poll_nanos;
+  // number of bytes read ahead of compactions, when
+  // DBOptions::max_compaction_readahead_size is set
+  uint64_t compaction_readahead_bytes;
+  // number of the read-ahead bytes that compactions then used
+  uint64_t compaction_readahead_useful_bytes;
+  // number of times compactions waited for data they were reading ahead
+  uint64_t compaction_readahead_stalls;
 
   FileIOByTemperature file_io_stats_by_temperature;
 
@@ -171,6 +171,12 @@ enum class CompactionReason : int {
   // [InternalOnly] DBImpl::ReFitLevel treated as a compaction,
   // Used only for internal conflict checking with other compactions
   kRefitLevel,
+  // Compaction of files whose range tombstones cover data in lower levels
+  // (see range_tombstone_compaction_budget)
+  kRangeTombstones,
+  // Deletion or compaction of files that hold expired keys (see
+  // key_prefix_retentions)
+  kKeyPrefixRetention,
   // total number of compaction reasons, new reasons must be added above this.
   kNumOfReasons,
 };
@@ -1504,6 +1504,55 @@ struct DBOptions {
   // Defaults to check once per hour.  Set to 0 to disable the task.
   unsigned int refresh_options_sec = 60 * 60;
   std::string refresh_options_file;
+
+  // If non-zero, block-based tables sample how often each of their data blocks
+  // is found in the block cache, and every this many seconds the DB writes the
+  // handles of the hottest blocks (file number, offset, size and hit count) to
+  // a HOTBLOCKS file in the DB directory. On the next DB::Open with this
+  // option set, those blocks are read back into the block cache in the
+  // background, hottest first, so read latency recovers quickly after a
+  // restart. Blocks of files that no longer exist are skipped.
+  //
+  // Default: 0 (disabled)
+  unsigned int hot_blocks_persist_period_sec = 0;
+
+  // The maximum number of bytes of hot blocks that are persisted, and read
+  // back into the block cache when the DB is opened. The warm-up reads are
+  // issued at Env::IO_LOW priority, so they are also subject to the
+  // rate_limiter if one is set. 0 means no limit.
+  //
+  // Default: 256MB
+  uint64_t hot_blocks_warmup_bytes = 256 << 20;
+
+  // If non-zero, compactions verify and decompress the data blocks of their
+  // input files on up to that many threads, ahead of merging them (see
+  // ReadOptions::decompression_threads). Only useful together with
+  // compaction_readahead_size and compressed files, when compactions are
+  // bound by decompression CPU.
+  //
+  // Default: 0 (disabled)
+  size_t compaction_decompression_threads = 0;
+
+  // If non-zero, compactions read their input files ahead asynchronously
+  // into two alternating buffers, and adapt the readahead size of each input
+  // file to the storage: it starts at compaction_readahead_size (or 64KB if
+  // that is 0), doubles every time the compaction has to wait for data that
+  // was read ahead, and halves when read-ahead data is left unused, between
+  // 8KB and this size. The file system prefetching and the readahead of
+  // compaction_readahead_size are then not used for compaction inputs.
+  // The efficiency of the readahead is reported in CompactionJobStats.
+  //
+  // Default: 0 (disabled)
+  uint64_t max_compaction_readahead_size = 0;
+
+  // The maximum number of non-blocking manual compactions (CompactRange()
+  // with CompactRangeOptions::async_completion_cb set) that run at the same
+  // time. Each runs on a thread of its own, and further requests wait in a
+  // queue (see CompactRangeOptions::async_priority). Values below 1 are
+  // treated as 1.
+  //
+  // Default: 4
+  int max_non_blocking_compact_range_jobs = 4;
   std::shared_ptr<std::function<void(std::thread::native_handle_type)>>
       on_thread_start_callback = nullptr;
 };
@@ -1675,6 +1724,22 @@ struct ReadOptions {
   // comes at the expense of slightly higher CPU overhead.
   bool optimize_multiget_for_io = true;
 
+  // Experimental
+  //
+  // If true, MultiGet() first probes the filters and indexes of every table
+  // file, in every level, that may contain keys of the batch, and reads all
+  // the data blocks they need that are missing from the block cache in a
+  // single round of I/O, without coroutines. Adjacent blocks of a file are
+  // merged into single reads, and the reads of all files are submitted
+  // before waiting for any of them (with FileSystem::ReadAsync() when
+  // supported, and MultiRead() otherwise). The keys are then resolved level
+  // by level from the block cache.
+  //
+  // This saves a round trip per level when keys are looked up in several
+  // levels, at the cost of possibly reading blocks of lower levels that turn
+  // out not to be needed. It requires a block cache and fill_cache = true.
+  bool multiget_single_round_io = false;
+
   // *** END options relevant to point lookups (as well as scans) ***
   // *** BEGIN options only relevant to iterators or scans ***
 
@@ -1726,6 +1791,17 @@ struct ReadOptions {
   // point to key without timestamp part.
   const Slice* iterate_upper_bound = nullptr;
 
+  // If not null, iterators only return the wide columns named here (see
+  // Iterator::columns()). The default column is named kDefaultWideColumnName,
+  // and value() is empty for entities that do not have it or when it is not
+  // projected. Plain key-values are treated as entities with a default column
+  // only.
+  // With BlockBasedTableOptions::data_block_columnar_entities, only the
+  // projected columns are read from the data blocks, unless the column family
+  // has a merge operator.
+  // The vector and the names must outlive the iterators.
+  const std::vector<Slice>* column_projection = nullptr;
+
   // Specify to create a tailing iterator -- a special iterator that has a
   // view of the complete database (i.e. it can also be used to read newly
   // added data) and is optimized for sequential reads. It will return records
@@ -1806,6 +1882,33 @@ struct ReadOptions {
   // Default: false
   bool auto_readahead_size = false;
 
+  // If non-zero, once an iterator has loaded this many data blocks of a table
+  // file without seeking, the data blocks it loads after that are inserted
+  // into the block cache with the lowest priority (Cache::Priority::BOTTOM).
+  // Blocks brought in by long scans are then evicted first unless they are
+  // accessed again, instead of pushing out the working set of point lookups,
+  // while the scan still gets to reuse the blocks it reads. Unlike
+  // fill_cache=false, short scans are not affected. LRUCache only keeps bottom
+  // priority blocks apart if low_pri_pool_ratio > 0.
+  // Block cache traces record these accesses with caller
+  // kUserIteratorLongScan.
+  //
+  // Default: 0 (disabled)
+  uint64_t scan_probation_threshold = 0;
+
+  // If non-zero, iterators verify and decompress the data blocks that follow
+  // the current one on up to that many background threads, as soon as those
+  // blocks are in the readahead buffer, so that long scans do not wait for
+  // decompression. Only applies to forward scans with fill_cache false and
+  // async_io false, once readahead has kicked in.
+  //
+  // The blocks are decompressed on the Env::Priority::USER thread pool of the
+  // Env, which is shared by all iterators and grown to the largest value
+  // used, rather than on threads of each iterator.
+  //
+  // Default: 0 (disabled)
+  size_t decompression_threads = 0;
+
   // *** END options only relevant to iterators or scans ***
 
   // ** For RocksDB internal use only **
@@ -1992,6 +2095,18 @@ class CompactRangeCompletedCbIf {
 
   bool WasCbCalled() const { return was_cb_called_; }
 
+  // Cancels the non-blocking manual compaction this callback was passed to.
+  // A compaction that has not started yet is dropped from the queue (and
+  // from the compaction other requests were coalesced with) once a worker
+  // thread picks the next job. A running compaction is stopped as if
+  // CompactRangeOptions::canceled was set, unless that option is set or
+  // other requests were coalesced into the compaction. Either way the
+  // callback is still called, with Status::Incomplete(kManualCompactionPaused)
+  // if the compaction did not complete.
+  void Cancel() { canceled_.store(true, std::memory_order_release); }
+
+  bool IsCanceled() const { return canceled_.load(std::memory_order_acquire); }
+
  private:
   // This is the actual callback called from the internal manual compaction
   // thread when manual compaction completes.
@@ -2006,10 +2121,13 @@ class CompactRangeCompletedCbIf {
   // and may safely be joined
   std::atomic<bool> was_cb_called_ = false;
 
+  std::atomic<bool> canceled_ = false;
+
  private:
-  // Needed to allow the internal thread (a member of DBImpl) to call
-  // the private InternalCompletedCb().
+  // Needed to allow the internal threads to call the private
+  // InternalCompletedCb().
   friend class DBImpl;
+  friend class CompactRangeJobQueue;
 };
 
 // CompactRangeOptions is used by CompactRange() call.
@@ -2069,8 +2187,20 @@ struct CompactRangeOptions {
   double blob_garbage_collection_age_cutoff = -1;
 
   // An optional completion callback to allow for non-blocking (async) operation
+  // Non-blocking manual compactions are queued and run by up to
+  // DBOptions::max_non_blocking_compact_range_jobs threads. A request whose
+  // range overlaps the range of a queued compaction of the same column family
+  // with the same options is coalesced into it: the compaction covers both
+  // ranges and both callbacks are called once it completes. Requests that set
+  // `canceled` or `full_history_ts_low` are never coalesced.
   // Default: Empty (Blocking)
   std::shared_ptr<CompactRangeCompletedCbIf> async_completion_cb;
+
+  // The priority of a non-blocking manual compaction in the queue. Queued
+  // compactions run highest priority first, and in the order of the
+  // CompactRange() calls within a priority.
+  // Default: 0
+  int async_priority = 0;
 };
 
 // IngestExternalFileOptions is used by IngestExternalFile()
@@ -93,6 +93,8 @@ struct PerfContextBase {
   uint64_t compressed_sec_cache_uncompressed_bytes;
   // bytes for vals after compression in secondary cache
   uint64_t compressed_sec_cache_compressed_bytes;
+  // total number of insertions rejected by TinyLFU admission
+  uint64_t compressed_sec_cache_admit_reject_count;
 
   uint64_t block_checksum_time;    // total nanos spent on block checksum
   uint64_t block_decompress_time;  // total nanos spent on block decompression
@@ -111,6 +111,11 @@ class RateLimiter {
 
   virtual int64_t GetBytesPerSecond() const = 0;
 
+  // Whether requests are scheduled by a deadline derived from their priority
+  // rather than by strict priority. Compactions then raise their priority
+  // with the state of the write controller (see NewDeadlineRateLimiter()).
+  virtual bool SchedulesByDeadline() const { return false; }
+
   virtual bool IsRateLimited(OpType op_type) {
     if ((mode_ == RateLimiter::Mode::kWritesOnly &&
          op_type == RateLimiter::OpType::kRead) ||
@@ -156,4 +161,31 @@ extern RateLimiter* NewGenericRateLimiter(
     RateLimiter::Mode mode = RateLimiter::Mode::kWritesOnly,
     bool auto_tuned = false);
 
+// Create a RateLimiter that schedules the I/O of flushes and compactions by
+// deadline instead of by strict priority. Each request gets a deadline from
+// its priority: Env::IO_USER requests are due immediately, Env::IO_HIGH
+// (flushes) after one refill period, Env::IO_MID after 4 and Env::IO_LOW
+// after 16. Pending requests are granted in the order of their deadlines, so
+// that lower priorities are delayed but never starved.
+//
+// Compactions raise their priority with the state of the write controller:
+// the compactions that can relieve stopped or delayed writes use
+// Env::IO_USER, and use Env::IO_MID while there is compaction pressure, while
+// the other compactions use Env::IO_LOW.
+//
+// @rate_bytes_per_sec, @refill_period_us and @mode: as for
+// NewGenericRateLimiter().
+// @urgent_reserve_pct: the percentage of each refill that only Env::IO_USER
+// and Env::IO_HIGH requests may use while there are such requests, i.e.
+// within a refill period of one. Otherwise it is granted to Env::IO_MID and
+// Env::IO_LOW requests.
+// @low_pri_pct_during_reads: the percentage of each refill that Env::IO_LOW
+// requests may use while there are foreground reads, i.e. within a refill
+// period of a read with ReadOptions::rate_limiter_priority = Env::IO_USER.
+// These reads are seen even when the mode does not limit reads.
+extern RateLimiter* NewDeadlineRateLimiter(
+    int64_t rate_bytes_per_sec, int64_t refill_period_us = 100 * 1000,
+    int32_t urgent_reserve_pct = 20, int32_t low_pri_pct_during_reads = 25,
+    RateLimiter::Mode mode = RateLimiter::Mode::kWritesOnly);
+
 }  // namespace ROCKSDB_NAMESPACE
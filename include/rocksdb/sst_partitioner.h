@@ -62,6 +62,17 @@ class SstPartitioner {
   virtual bool CanDoTrivialMove(const Slice& smallest_user_key,
                                 const Slice& largest_user_key) = 0;
 
+  // Optional hint used to align the key ranges of subcompactions with the
+  // partitions. Called with two keys that ShouldPartition() separates. Sets
+  // "partition_start" to the smallest user key of the partition that
+  // contains "current_user_key" (and not "prev_user_key") and returns true,
+  // or returns false if that key is unknown.
+  virtual bool GetPartitionStart(const Slice& /*prev_user_key*/,
+                                 const Slice& /*current_user_key*/,
+                                 std::string* /*partition_start*/) {
+    return false;
+  }
+
   // Context information of a compaction run
   struct Context {
     // Does this compaction run include all data files
@@ -113,6 +124,10 @@ class SstPartitionerFixedPrefix : public SstPartitioner {
   bool CanDoTrivialMove(const Slice& smallest_user_key,
                         const Slice& largest_user_key) override;
 
+  bool GetPartitionStart(const Slice& prev_user_key,
+                         const Slice& current_user_key,
+                         std::string* partition_start) override;
+
  private:
   size_t len_;
 };
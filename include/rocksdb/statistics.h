@@ -529,6 +529,14 @@ enum Tickers : uint32_t {
   // ReadOptions.auto_readahead_size is set.
   READAHEAD_TRIMMED,
 
+  // Number of data blocks MultiGet() read ahead of the lookups, with
+  // ReadOptions.multiget_single_round_io set.
+  MULTIGET_SINGLE_ROUND_IO_BLOCKS,
+
+  // Number of non-blocking CompactRange() requests coalesced into a queued
+  // manual compaction with an overlapping range.
+  COMPACT_RANGE_JOBS_COALESCED,
+
   TICKER_ENUM_MAX
 };
 
@@ -663,6 +671,12 @@ enum Histograms : uint32_t {
   // system's prefetch) from the end of SST table during block based table open
   TABLE_OPEN_PREFETCH_TAIL_READ_BYTES,
 
+  // Time non-blocking manual compactions wait in the queue before they start
+  COMPACT_RANGE_QUEUE_WAIT_MICROS,
+  // Number of queued non-blocking manual compactions, sampled on every
+  // non-blocking CompactRange() call
+  COMPACT_RANGE_QUEUE_DEPTH,
+
   HISTOGRAM_ENUM_MAX
 };
 
@@ -247,6 +247,17 @@ struct BlockBasedTableOptions {
     // Makes the index significantly bigger (2x or more), especially when keys
     // are long.
     kBinarySearchWithFirstKey = 0x03,
+
+    // Like kBinarySearch, but the table also stores a piecewise-linear model
+    // that predicts the position of a key in the index block within a small
+    // error window, so a lookup only binary searches that window. The model
+    // is built from the first 8 bytes of the keys and is only useful for
+    // keys like fixed-width big-endian integers. It requires
+    // BytewiseComparator and no user-defined timestamps; when the keys are
+    // not suitable, the table is written without a model and the index is
+    // searched like kBinarySearch. Table files written with this index type
+    // cannot be read by older versions.
+    kLearnedSearch = 0x04,
   };
 
   IndexType index_type = kBinarySearch;
@@ -263,6 +274,28 @@ struct BlockBasedTableOptions {
   // kDataBlockBinaryAndHash.
   double data_block_hash_table_util_ratio = 0.75;
 
+  // If true, data blocks store the first 8 bytes of the key at each restart
+  // point in a fixed-width array after the restart offsets. Seeks within a
+  // block then narrow the binary search over restart points by comparing
+  // these prefixes as integers (with SIMD where available) before decoding
+  // any key, which saves cache misses on blocks with many restart points.
+  //
+  // Only used with BytewiseComparator and no user-defined timestamps, and
+  // only helps when keys differ within their first 8 bytes. Table files
+  // written with this option cannot be read by older versions.
+  bool data_block_restart_key_prefixes = false;
+
+  // If true, the columns of wide-column entities (see PutEntity()) are stored
+  // column-wise in each data block: the values of every column are kept
+  // together in a per-column stream, and the block entry of an entity only
+  // refers to them. The column names are stored once per block. Iterators
+  // with ReadOptions::column_projection then only decode the projected
+  // columns, while reading whole entities costs rebuilding them.
+  //
+  // Plain values are stored as usual. Table files written with this option
+  // cannot be read by older versions.
+  bool data_block_columnar_entities = false;
+
   // Option hash_index_allow_collision is now deleted.
   // It will behave as if hash_index_allow_collision=true.
 
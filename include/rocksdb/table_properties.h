@@ -72,6 +72,7 @@ struct TablePropertiesNames {
   static const std::string kSequenceNumberTimeMapping;
   static const std::string kTailStartOffset;
   static const std::string kUserDefinedTimestampsPersisted;
+  static const std::string kCompressionDictId;
 };
 
 // `TablePropertiesCollector` provides the mechanism for users to collect
@@ -250,6 +251,12 @@ struct TableProperties {
   // it's explicitly written to meta properties block.
   uint64_t user_defined_timestamps_persisted = 1;
 
+  // ID of the column family's shared compression dictionary the data blocks
+  // are compressed with (see `CompressionOptions::use_shared_dict`), in which
+  // case the file has no compression dictionary block of its own.
+  // 0 means none.
+  uint64_t compression_dict_id = 0;
+
   // DB identity
   // db_id is an identifier generated the first time the DB is created
   // If DB identity is unset or unassigned, `db_id` will be an empty string.
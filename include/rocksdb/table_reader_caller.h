@@ -35,6 +35,9 @@ enum TableReaderCaller : char {
   // A list of callers that are either not interesting for analysis or are
   // calling from a test environment, e.g., unit test, benchmark, etc.
   kUncategorized = 14,
+  // A user iterator that loaded more than ReadOptions::scan_probation_threshold
+  // data blocks of a table file since its last seek.
+  kUserIteratorLongScan = 15,
   // All callers should be added before kMaxBlockCacheLookupCaller.
   kMaxBlockCacheLookupCaller
 };
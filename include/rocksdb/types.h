@@ -46,7 +46,8 @@ enum FileType {
   kMetaDatabase,
   kIdentityFile,
   kOptionsFile,
-  kBlobFile
+  kBlobFile,
+  kHotBlocksFile
 };
 
 // User-oriented representation of internal key types.
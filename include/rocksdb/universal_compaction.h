@@ -81,6 +81,15 @@ class CompactionOptionsUniversal {
   // Default: false
   bool incremental;
 
+  // If true, consecutive sorted runs whose key ranges do not overlap, as with
+  // append-only or time-ordered keys, are folded into a single level by
+  // trivially moving their files, before any merge is considered. The folded
+  // runs then count as one sorted run for level0_file_num_compaction_trigger,
+  // so that data written in key order is not rewritten to reduce the number
+  // of sorted runs. This does not require allow_trivial_move.
+  // Default: false
+  bool fold_non_overlapping_sorted_runs;
+
   // Default set of parameters
   CompactionOptionsUniversal()
       : size_ratio(1),
@@ -90,7 +99,8 @@ class CompactionOptionsUniversal {
         compression_size_percent(-1),
         stop_style(kCompactionStopStyleTotalSize),
         allow_trivial_move(false),
-        incremental(false) {}
+        incremental(false),
+        fold_non_overlapping_sorted_runs(false) {}
 };
 
 }  // namespace ROCKSDB_NAMESPACE
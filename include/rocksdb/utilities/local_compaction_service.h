@@ -0,0 +1,64 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// A CompactionService that runs the compactions of a DB in a pool of worker
+// processes on the same host, so that the CPU and memory spikes of
+// compactions are isolated from the serving process (and the workers may be
+// placed in their own cgroup).
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/options.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct LocalCompactionServiceOptions {
+  // The number of worker processes. Each runs one compaction at a time.
+  int num_workers = 2;
+
+  // The command (program path and arguments) executed for every worker, with
+  // "--local_compaction_worker_fd=<fd>" appended. The program must call
+  // RunLocalCompactionServiceWorker() with that fd. Required: the workers are
+  // spawned with a fresh process image, so that the service may be created
+  // while the process runs other threads. Workers that die are started again,
+  // and their compactions run in the DB process. A wrapper, like cgexec, may
+  // be used to limit the resources of the workers.
+  std::vector<std::string> worker_command;
+
+  // The directory under which the workers write the compaction outputs,
+  // before the DB moves them in. Must be on the file system of the DB.
+  // Default: a "local_compaction" directory in the DB directory.
+  std::string output_root;
+};
+
+// The argument passed to the workers started with worker_command
+extern const char* kLocalCompactionWorkerFdArg;
+
+// Creates the service and starts its workers. The service may be shared by
+// several DBs. Returns InvalidArgument if worker_command is empty.
+extern Status NewLocalCompactionService(
+    const LocalCompactionServiceOptions& options,
+    std::shared_ptr<CompactionService>* service);
+
+// Runs the compactions received on `fd` until the service closes it. For
+// programs started with LocalCompactionServiceOptions::worker_command.
+extern Status RunLocalCompactionServiceWorker(
+    int fd, const CompactionServiceOptionsOverride& options_override);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -136,6 +136,15 @@ class StackableDB : public DB {
                          statuses, sorted_input);
   }
 
+  Status MultiGetAsync(const ReadOptions& options,
+                       ColumnFamilyHandle* column_family,
+                       const std::vector<Slice>& keys,
+                       MultiGetAsyncCallback callback,
+                       MultiGetAsyncQueue* queue) override {
+    return db_->MultiGetAsync(options, column_family, keys,
+                              std::move(callback), queue);
+  }
+
   using DB::MultiGetEntity;
 
   void MultiGetEntity(const ReadOptions& options,
@@ -0,0 +1,80 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file implements the "bridge" between Java and C++ for
+// ROCKSDB_NAMESPACE::PinnableSlice.
+
+#include <jni.h>
+
+#include "include/org_rocksdb_PinnedValue.h"
+#include "rocksdb/slice.h"
+#include "rocksjni/cplusplus_to_java_convert.h"
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    newPinnedValue
+ * Signature: ()J
+ */
+jlong Java_org_rocksdb_PinnedValue_newPinnedValue(JNIEnv* /*env*/,
+                                                  jclass /*jcls*/) {
+  auto* pinned_value = new ROCKSDB_NAMESPACE::PinnableSlice();
+  return GET_CPLUSPLUS_POINTER(pinned_value);
+}
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    data
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+jobject Java_org_rocksdb_PinnedValue_data(JNIEnv* env, jclass /*jcls*/,
+                                          jlong jhandle) {
+  auto* pinned_value =
+      reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jhandle);
+  // The buffer is exposed read-only on the Java side
+  return env->NewDirectByteBuffer(const_cast<char*>(pinned_value->data()),
+                                  static_cast<jlong>(pinned_value->size()));
+}
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    size
+ * Signature: (J)I
+ */
+jint Java_org_rocksdb_PinnedValue_size(JNIEnv* /*env*/, jclass /*jcls*/,
+                                       jlong jhandle) {
+  auto* pinned_value =
+      reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jhandle);
+  return static_cast<jint>(pinned_value->size());
+}
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    reset
+ * Signature: (J)V
+ */
+void Java_org_rocksdb_PinnedValue_reset(JNIEnv* /*env*/, jclass /*jcls*/,
+                                        jlong jhandle) {
+  reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jhandle)->Reset();
+}
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    disposeInternal
+ * Signature: (J)V
+ */
+void Java_org_rocksdb_PinnedValue_disposeInternal(JNIEnv* /*env*/,
+                                                  jobject /*jobj*/,
+                                                  jlong jhandle) {
+  delete reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jhandle);
+}
@@ -4686,6 +4686,8 @@ class CompactionPriorityJni {
         return 0x3;
       case ROCKSDB_NAMESPACE::CompactionPri::kRoundRobin:
         return 0x4;
+      case ROCKSDB_NAMESPACE::CompactionPri::kHottestRangeFirst:
+        return 0x5;
       default:
         return 0x0;  // undefined
     }
@@ -4706,6 +4708,8 @@ class CompactionPriorityJni {
         return ROCKSDB_NAMESPACE::CompactionPri::kMinOverlappingRatio;
       case 0x4:
         return ROCKSDB_NAMESPACE::CompactionPri::kRoundRobin;
+      case 0x5:
+        return ROCKSDB_NAMESPACE::CompactionPri::kHottestRangeFirst;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::CompactionPri::kByCompensatedSize;
@@ -5148,6 +5152,10 @@ class TickerTypeJni {
         return -0x3C;
       case ROCKSDB_NAMESPACE::Tickers::READAHEAD_TRIMMED:
         return -0x3D;
+      case ROCKSDB_NAMESPACE::Tickers::MULTIGET_SINGLE_ROUND_IO_BLOCKS:
+        return -0x3E;
+      case ROCKSDB_NAMESPACE::Tickers::COMPACT_RANGE_JOBS_COALESCED:
+        return -0x3F;
       case ROCKSDB_NAMESPACE::Tickers::TICKER_ENUM_MAX:
         // 0x5F was the max value in the initial copy of tickers to Java.
         // Since these values are exposed directly to Java clients, we keep
@@ -5511,6 +5519,10 @@ class TickerTypeJni {
         return ROCKSDB_NAMESPACE::Tickers::TABLE_OPEN_PREFETCH_TAIL_HIT;
       case -0x3C:
         return ROCKSDB_NAMESPACE::Tickers::BLOCK_CHECKSUM_MISMATCH_COUNT;
+      case -0x3E:
+        return ROCKSDB_NAMESPACE::Tickers::MULTIGET_SINGLE_ROUND_IO_BLOCKS;
+      case -0x3F:
+        return ROCKSDB_NAMESPACE::Tickers::COMPACT_RANGE_JOBS_COALESCED;
       case 0x5F:
         // 0x5F was the max value in the initial copy of tickers to Java.
         // Since these values are exposed directly to Java clients, we keep
@@ -5657,6 +5669,10 @@ class HistogramTypeJni {
       case ROCKSDB_NAMESPACE::Histograms::
           FILE_READ_VERIFY_FILE_CHECKSUMS_MICROS:
         return 0x41;
+      case ROCKSDB_NAMESPACE::Histograms::COMPACT_RANGE_QUEUE_WAIT_MICROS:
+        return 0x42;
+      case ROCKSDB_NAMESPACE::Histograms::COMPACT_RANGE_QUEUE_DEPTH:
+        return 0x43;
       case ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX:
         // 0x1F for backwards compatibility on current minor version.
         return 0x1F;
@@ -5794,6 +5810,10 @@ class HistogramTypeJni {
       case 0x41:
         return ROCKSDB_NAMESPACE::Histograms::
             FILE_READ_VERIFY_FILE_CHECKSUMS_MICROS;
+      case 0x42:
+        return ROCKSDB_NAMESPACE::Histograms::COMPACT_RANGE_QUEUE_WAIT_MICROS;
+      case 0x43:
+        return ROCKSDB_NAMESPACE::Histograms::COMPACT_RANGE_QUEUE_DEPTH;
       case 0x1F:
         // 0x1F for backwards compatibility on current minor version.
         return ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX;
@@ -7176,6 +7196,10 @@ class CompactionReasonJni {
         return 0x12;
       case ROCKSDB_NAMESPACE::CompactionReason::kRefitLevel:
         return 0x13;
+      case ROCKSDB_NAMESPACE::CompactionReason::kRangeTombstones:
+        return 0x14;
+      case ROCKSDB_NAMESPACE::CompactionReason::kKeyPrefixRetention:
+        return 0x15;
       default:
         return 0x7F;  // undefined
     }
@@ -7226,6 +7250,10 @@ class CompactionReasonJni {
         return ROCKSDB_NAMESPACE::CompactionReason::kRoundRobinTtl;
       case 0x13:
         return ROCKSDB_NAMESPACE::CompactionReason::kRefitLevel;
+      case 0x14:
+        return ROCKSDB_NAMESPACE::CompactionReason::kRangeTombstones;
+      case 0x15:
+        return ROCKSDB_NAMESPACE::CompactionReason::kKeyPrefixRetention;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::CompactionReason::kUnknown;
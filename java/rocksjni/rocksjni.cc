@@ -1188,6 +1188,55 @@ jint Java_org_rocksdb_RocksDB_getDirect(JNIEnv* env, jobject /*jdb*/,
       jkey, jkey_off, jkey_len, jval, jval_off, jval_len, &has_exception);
 }
 
+/*
+ * Class:     org_rocksdb_RocksDB
+ * Method:    getPinned
+ * Signature: (JJ[BIIJJ)Z
+ */
+jboolean Java_org_rocksdb_RocksDB_getPinned(JNIEnv* env, jobject /*jdb*/,
+                                            jlong jdb_handle,
+                                            jlong jropt_handle, jbyteArray jkey,
+                                            jint jkey_off, jint jkey_len,
+                                            jlong jcf_handle,
+                                            jlong jpinned_value_handle) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
+  auto* ro_opt =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ReadOptions*>(jropt_handle);
+  auto* cf_handle =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyHandle*>(jcf_handle);
+  auto* pinned_value =
+      reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jpinned_value_handle);
+  pinned_value->Reset();
+
+  // Keys are usually small enough to avoid allocating
+  char stack_key[256];
+  std::unique_ptr<char[]> heap_key;
+  char* key = stack_key;
+  if (static_cast<size_t>(jkey_len) > sizeof(stack_key)) {
+    heap_key.reset(new char[jkey_len]);
+    key = heap_key.get();
+  }
+  env->GetByteArrayRegion(jkey, jkey_off, jkey_len,
+                          reinterpret_cast<jbyte*>(key));
+  if (env->ExceptionCheck()) {
+    // exception thrown: ArrayIndexOutOfBoundsException
+    return JNI_FALSE;
+  }
+
+  ROCKSDB_NAMESPACE::Status s = db->Get(
+      ro_opt == nullptr ? ROCKSDB_NAMESPACE::ReadOptions() : *ro_opt,
+      cf_handle == nullptr ? db->DefaultColumnFamily() : cf_handle,
+      ROCKSDB_NAMESPACE::Slice(key, jkey_len), pinned_value);
+  if (s.ok()) {
+    return JNI_TRUE;
+  }
+  pinned_value->Reset();
+  if (!s.IsNotFound()) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, s);
+  }
+  return JNI_FALSE;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // ROCKSDB_NAMESPACE::DB::Merge
 
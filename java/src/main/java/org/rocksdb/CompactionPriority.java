@@ -41,7 +41,14 @@ public enum CompactionPriority {
    * level. The file picking process will cycle through all the files in a
    * round-robin manner.
    */
-  RoundRobin((byte)0x4);
+  RoundRobin((byte)0x4),
+
+  /**
+   * First compact files whose key ranges are read the most, weighted by the
+   * number of lower levels that overlap the range. Try this for skewed read
+   * workloads where a small key range gets most of the reads.
+   */
+  HottestRangeFirst((byte)0x5);
 
 
   private final byte value;
@@ -104,7 +104,17 @@ public enum CompactionReason {
   /**
    * Compaction by calling DBImpl::ReFitLevel
    */
-  kRefitLevel((byte) 0x13);
+  kRefitLevel((byte) 0x13),
+
+  /**
+   * Compaction of files whose range tombstones cover data in lower levels
+   */
+  kRangeTombstones((byte) 0x14),
+
+  /**
+   * Deletion or compaction of files that hold expired keys
+   */
+  kKeyPrefixRetention((byte) 0x15);
 
   private final byte value;
 
@@ -185,6 +185,17 @@ public enum HistogramType {
 
   FILE_READ_VERIFY_FILE_CHECKSUMS_MICROS((byte) 0x41),
 
+  /**
+   * Time non-blocking manual compactions wait in the queue before they start.
+   */
+  COMPACT_RANGE_QUEUE_WAIT_MICROS((byte) 0x42),
+
+  /**
+   * Number of queued non-blocking manual compactions, sampled on every
+   * non-blocking CompactRange() call.
+   */
+  COMPACT_RANGE_QUEUE_DEPTH((byte) 0x43),
+
   // 0x1F for backwards compatibility on current minor version.
   HISTOGRAM_ENUM_MAX((byte) 0x1F);
 
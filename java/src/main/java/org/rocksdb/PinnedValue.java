@@ -0,0 +1,68 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package org.rocksdb;
+
+import java.nio.ByteBuffer;
+
+/**
+ * A value read by {@link RocksDB#getPinned(ColumnFamilyHandle, ReadOptions, byte[], PinnedValue)}
+ * without copying it out of native memory.
+ * <p>
+ * When the value is found in the block cache, the block holding it stays pinned in the cache
+ * for as long as this object holds the value, and {@link #data()} is a view over the cached
+ * block. The value is released by {@link #reset()}, by the next get into this object, or by
+ * {@link #close()}; buffers returned by {@link #data()} must not be accessed after that.
+ * <p>
+ * A single instance is meant to be reused across gets, which then neither copy the value nor
+ * allocate native memory. Instances are not thread-safe.
+ */
+public class PinnedValue extends RocksObject {
+  public PinnedValue() {
+    super(newPinnedValue());
+  }
+
+  /**
+   * Returns a read-only direct buffer over the value, which is empty if this object does not
+   * hold a value.
+   *
+   * @return the value, valid until this object is reset, reused or closed.
+   */
+  public ByteBuffer data() {
+    assert (isOwningHandle());
+    return data(nativeHandle_).asReadOnlyBuffer();
+  }
+
+  /**
+   * @return the size of the value in bytes, or 0 if this object does not hold a value.
+   */
+  public int size() {
+    assert (isOwningHandle());
+    return size(nativeHandle_);
+  }
+
+  /**
+   * Releases the value, unpinning the memory that holds it.
+   */
+  public void reset() {
+    assert (isOwningHandle());
+    reset(nativeHandle_);
+  }
+
+  private static native long newPinnedValue();
+  private static native ByteBuffer data(final long handle);
+  private static native int size(final long handle);
+  private static native void reset(final long handle);
+  @Override protected final native void disposeInternal(final long handle);
+}
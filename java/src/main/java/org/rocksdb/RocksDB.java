@@ -1268,6 +1268,46 @@ public class RocksDB extends RocksObject {
     return result;
   }
 
+  /**
+   * Get the value associated with the specified key in the default column
+   * family, without copying it.
+   *
+   * @param opt {@link org.rocksdb.ReadOptions} instance.
+   * @param key the key to retrieve the value.
+   * @param value receives the value, see {@link PinnedValue}. Any value it
+   *     held before is released.
+   * @return true if the key was found.
+   *
+   * @throws RocksDBException thrown if error happens in underlying
+   *    native library.
+   */
+  public boolean getPinned(final ReadOptions opt, final byte[] key, final PinnedValue value)
+      throws RocksDBException {
+    return getPinned(nativeHandle_, opt.nativeHandle_, key, 0, key.length, 0,
+        value.nativeHandle_);
+  }
+
+  /**
+   * Get the value associated with the specified key within column family,
+   * without copying it.
+   *
+   * @param columnFamilyHandle {@link org.rocksdb.ColumnFamilyHandle}
+   *     instance
+   * @param opt {@link org.rocksdb.ReadOptions} instance.
+   * @param key the key to retrieve the value.
+   * @param value receives the value, see {@link PinnedValue}. Any value it
+   *     held before is released.
+   * @return true if the key was found.
+   *
+   * @throws RocksDBException thrown if error happens in underlying
+   *    native library.
+   */
+  public boolean getPinned(final ColumnFamilyHandle columnFamilyHandle, final ReadOptions opt,
+      final byte[] key, final PinnedValue value) throws RocksDBException {
+    return getPinned(nativeHandle_, opt.nativeHandle_, key, 0, key.length,
+        columnFamilyHandle.nativeHandle_, value.nativeHandle_);
+  }
+
   /**
    * Remove the database entry for {@code key}. Requires that the key exists
    * and was not overwritten. It is not an error if the key did not exist
@@ -4555,6 +4595,8 @@ public class RocksDB extends RocksObject {
   private native int getDirect(long handle, long readOptHandle, ByteBuffer key, int keyOffset,
       int keyLength, ByteBuffer value, int valueOffset, int valueLength, long cfHandle)
       throws RocksDBException;
+  private native boolean getPinned(long handle, long readOptHandle, byte[] key, int keyOffset,
+      int keyLength, long cfHandle, long pinnedValueHandle) throws RocksDBException;
   private native boolean keyMayExistDirect(final long handle, final long cfHhandle,
       final long readOptHandle, final ByteBuffer key, final int keyOffset, final int keyLength);
   private native int[] keyMayExistDirectFoundValue(final long handle, final long cfHhandle,
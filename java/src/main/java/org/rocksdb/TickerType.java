@@ -766,6 +766,18 @@ public enum TickerType {
 
     READAHEAD_TRIMMED((byte) -0x3D),
 
+    /**
+     * Number of data blocks MultiGet() read ahead of the lookups, with
+     * ReadOptions.multiget_single_round_io set.
+     */
+    MULTIGET_SINGLE_ROUND_IO_BLOCKS((byte) -0x3E),
+
+    /**
+     * Number of non-blocking CompactRange() requests coalesced into a queued
+     * manual compaction with an overlapping range.
+     */
+    COMPACT_RANGE_JOBS_COALESCED((byte) -0x3F),
+
     TICKER_ENUM_MAX((byte) 0x5F);
 
     private final byte value;
@@ -369,6 +369,41 @@ public class RocksDBTest {
     }
   }
 
+  @Test
+  public void getPinned() throws RocksDBException {
+    try (final RocksDB db = RocksDB.open(dbFolder.getRoot().getAbsolutePath());
+         final ReadOptions rOpt = new ReadOptions();
+         final FlushOptions flushOptions = new FlushOptions().setWaitForFlush(true);
+         final PinnedValue value = new PinnedValue()) {
+      db.put("key1".getBytes(), "value".getBytes());
+      db.put("key2".getBytes(), "12345678".getBytes());
+      db.flush(flushOptions);
+      // found values, read from the block cache and from the memtable
+      db.put("key3".getBytes(), "memtable".getBytes());
+      assertThat(db.getPinned(rOpt, "key1".getBytes(), value)).isTrue();
+      assertThat(value.size()).isEqualTo(5);
+      ByteBuffer data = value.data();
+      assertThat(data.isDirect()).isTrue();
+      assertThat(data.isReadOnly()).isTrue();
+      final byte[] bytes = new byte[data.remaining()];
+      data.get(bytes);
+      assertThat(bytes).isEqualTo("value".getBytes());
+      assertThat(db.getPinned(db.getDefaultColumnFamily(), rOpt, "key2".getBytes(), value))
+          .isTrue();
+      assertThat(UTF_8.decode(value.data()).toString()).isEqualTo("12345678");
+      assertThat(db.getPinned(rOpt, "key3".getBytes(), value)).isTrue();
+      assertThat(UTF_8.decode(value.data()).toString()).isEqualTo("memtable");
+      // not found value
+      assertThat(db.getPinned(rOpt, "keyNotFound".getBytes(), value)).isFalse();
+      assertThat(value.size()).isEqualTo(0);
+      // explicit release
+      assertThat(db.getPinned(rOpt, "key1".getBytes(), value)).isTrue();
+      value.reset();
+      assertThat(value.size()).isEqualTo(0);
+      assertThat(value.data().remaining()).isEqualTo(0);
+    }
+  }
+
   @Rule
   public ExpectedException thrown = ExpectedException.none();
 
@@ -35,6 +35,10 @@ void IOStatsContext::Reset() {
   logger_nanos = 0;
   cpu_write_nanos = 0;
   cpu_read_nanos = 0;
+  io_uring_poll_nanos = 0;
+  compaction_readahead_bytes = 0;
+  compaction_readahead_useful_bytes = 0;
+  compaction_readahead_stalls = 0;
   file_io_stats_by_temperature.Reset();
 #endif  //! NIOSTATS_CONTEXT
 }
@@ -63,6 +67,10 @@ std::string IOStatsContext::ToString(bool exclude_zero_counters) const {
   IOSTATS_CONTEXT_OUTPUT(logger_nanos);
   IOSTATS_CONTEXT_OUTPUT(cpu_write_nanos);
   IOSTATS_CONTEXT_OUTPUT(cpu_read_nanos);
+  IOSTATS_CONTEXT_OUTPUT(io_uring_poll_nanos);
+  IOSTATS_CONTEXT_OUTPUT(compaction_readahead_bytes);
+  IOSTATS_CONTEXT_OUTPUT(compaction_readahead_useful_bytes);
+  IOSTATS_CONTEXT_OUTPUT(compaction_readahead_stalls);
   IOSTATS_CONTEXT_OUTPUT(file_io_stats_by_temperature.hot_file_bytes_read);
   IOSTATS_CONTEXT_OUTPUT(file_io_stats_by_temperature.warm_file_bytes_read);
   IOSTATS_CONTEXT_OUTPUT(file_io_stats_by_temperature.cold_file_bytes_read);
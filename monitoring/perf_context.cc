@@ -67,6 +67,7 @@ struct PerfContextByLevelInt {
   defCmd(compressed_sec_cache_insert_dummy_count)  \
   defCmd(compressed_sec_cache_uncompressed_bytes)  \
   defCmd(compressed_sec_cache_compressed_bytes)    \
+  defCmd(compressed_sec_cache_admit_reject_count)  \
   defCmd(block_checksum_time)                      \
   defCmd(block_decompress_time)                    \
   defCmd(get_read_bytes)                           \
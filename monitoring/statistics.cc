@@ -272,6 +272,9 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {BYTES_DECOMPRESSED_FROM, "rocksdb.bytes.decompressed.from"},
     {BYTES_DECOMPRESSED_TO, "rocksdb.bytes.decompressed.to"},
     {READAHEAD_TRIMMED, "rocksdb.readahead.trimmed"},
+    {MULTIGET_SINGLE_ROUND_IO_BLOCKS,
+     "rocksdb.multiget.single.round.io.blocks"},
+    {COMPACT_RANGE_JOBS_COALESCED, "rocksdb.compact.range.jobs.coalesced"},
 };
 
 const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
@@ -344,6 +347,9 @@ const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
     {DB_WRITE_WAIT_FOR_WAL_WITH_MUTEX, "rocksdb.db.write_wait_mutex.micros"},
     {TABLE_OPEN_PREFETCH_TAIL_READ_BYTES,
      "rocksdb.table.open.prefetch.tail.read.bytes"},
+    {COMPACT_RANGE_QUEUE_WAIT_MICROS,
+     "rocksdb.compact.range.queue.wait.micros"},
+    {COMPACT_RANGE_QUEUE_DEPTH, "rocksdb.compact.range.queue.depth"},
 };
 
 std::shared_ptr<Statistics> CreateDBStatistics() {
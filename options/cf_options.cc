@@ -43,6 +43,7 @@
 #include "rocksdb/utilities/object_registry.h"
 #include "rocksdb/utilities/options_type.h"
 #include "util/cast_util.h"
+#include "util/string_util.h"
 
 // NOTE: in this file, many option flags that were deprecated
 // and removed from the rest of the code have to be kept here
@@ -146,6 +147,39 @@ static Status ParseCompressionOptions(const std::string& value,
   return Status::OK();
 }
 
+// Returns the OptionTypeInfo of a vector of structs. Unlike the option
+// strings, the OPTIONS file keeps the brackets enclosing the whole value, e.g.
+// "{{a=1}:{a=2}}", which are stripped off for the value to be split into its
+// elements rather than parsed as a single one.
+template <typename T>
+static OptionTypeInfo StructVector(int offset, OptionTypeFlags flags,
+                                   const OptionTypeInfo& elem_info) {
+  OptionTypeInfo info = OptionTypeInfo::Vector<T>(
+      offset, OptionVerificationType::kNormal, flags, elem_info);
+  info.SetParseFunc([elem_info](const ConfigOptions& opts,
+                                const std::string& name,
+                                const std::string& value, void* addr) {
+    std::string elems = value;
+    if (elems.size() >= 2 && elems.front() == '{' && elems.back() == '}') {
+      int depth = 0;
+      size_t pos = 0;
+      for (; pos < elems.size(); ++pos) {
+        if (elems[pos] == '{') {
+          ++depth;
+        } else if (elems[pos] == '}' && --depth == 0) {
+          break;
+        }
+      }
+      if (pos == elems.size() - 1) {
+        elems = trim(elems.substr(1, elems.size() - 2));
+      }
+    }
+    auto result = static_cast<std::vector<T>*>(addr);
+    return ParseVector<T>(opts, elem_info, ':', name, elems, result);
+  });
+  return info;
+}
+
 const std::string kOptNameBMCompOpts = "bottommost_compression_opts";
 const std::string kOptNameCompOpts = "compression_opts";
 
@@ -190,6 +224,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
         {"checksum",
          {offsetof(struct CompressionOptions, checksum), OptionType::kBoolean,
           OptionVerificationType::kNormal, OptionTypeFlags::kMutable}},
+        {"use_shared_dict",
+         {offsetof(struct CompressionOptions, use_shared_dict),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
 };
 
 static std::unordered_map<std::string, OptionTypeInfo>
@@ -203,6 +241,29 @@ static std::unordered_map<std::string, OptionTypeInfo>
           OptionVerificationType::kNormal, OptionTypeFlags::kMutable}},
 };
 
+static std::unordered_map<std::string, OptionTypeInfo>
+    key_prefix_retention_type_info = {
+        {"prefix",
+         {offsetof(struct KeyPrefixRetention, prefix), OptionType::kString,
+          OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
+        {"retention_seconds",
+         {offsetof(struct KeyPrefixRetention, retention_seconds),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+};
+
+static std::unordered_map<std::string, OptionTypeInfo>
+    adaptive_compression_candidate_type_info = {
+        {"type",
+         {offsetof(struct AdaptiveCompressionCandidate, type),
+          OptionType::kCompressionType, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"level",
+         {offsetof(struct AdaptiveCompressionCandidate, level),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+};
+
 static std::unordered_map<std::string, OptionTypeInfo>
     fifo_compaction_options_type_info = {
         {"max_table_files_size",
@@ -264,6 +325,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
         {"allow_trivial_move",
          {offsetof(class CompactionOptionsUniversal, allow_trivial_move),
           OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"fold_non_overlapping_sorted_runs",
+         {offsetof(class CompactionOptionsUniversal,
+                   fold_non_overlapping_sorted_runs),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}}};
 
 static std::unordered_map<std::string, OptionTypeInfo>
@@ -528,6 +594,23 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableCFOptions, bottommost_file_compaction_delay),
           OptionType::kUInt32T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"range_tombstone_compaction_budget",
+         {offsetof(struct MutableCFOptions, range_tombstone_compaction_budget),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"adaptive_compression_candidates",
+         StructVector<struct AdaptiveCompressionCandidate>(
+             offsetof(struct MutableCFOptions,
+                      adaptive_compression_candidates),
+             OptionTypeFlags::kMutable,
+             OptionTypeInfo::Struct("adaptive_compression_candidates",
+                                    &adaptive_compression_candidate_type_info,
+                                    0, OptionVerificationType::kNormal,
+                                    OptionTypeFlags::kMutable))},
+        {"adaptive_compression_write_cost",
+         {offsetof(struct MutableCFOptions, adaptive_compression_write_cost),
+          OptionType::kDouble, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"block_protection_bytes_per_key",
          {offsetof(struct MutableCFOptions, block_protection_bytes_per_key),
           OptionType::kUInt8T, OptionVerificationType::kNormal,
@@ -633,6 +716,14 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableCFOptions, preserve_internal_time_seconds),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"key_prefix_retentions",
+         StructVector<struct KeyPrefixRetention>(
+             offsetof(struct ImmutableCFOptions, key_prefix_retentions),
+             OptionTypeFlags::kNone,
+             OptionTypeInfo::Struct("key_prefix_retentions",
+                                    &key_prefix_retention_type_info, 0,
+                                    OptionVerificationType::kNormal,
+                                    OptionTypeFlags::kNone))},
         // Need to keep this around to be able to read old OPTIONS files.
         {"max_mem_compaction_level",
          {0, OptionType::kInt, OptionVerificationType::kDeprecated,
@@ -982,7 +1073,8 @@ ImmutableCFOptions::ImmutableCFOptions(const ColumnFamilyOptions& cf_options)
       sst_partitioner_factory(cf_options.sst_partitioner_factory),
       blob_cache(cf_options.blob_cache),
       persist_user_defined_timestamps(
-          cf_options.persist_user_defined_timestamps) {}
+          cf_options.persist_user_defined_timestamps),
+      key_prefix_retentions(cf_options.key_prefix_retentions) {}
 
 ImmutableOptions::ImmutableOptions() : ImmutableOptions(Options()) {}
 
@@ -1145,6 +1237,14 @@ void MutableCFOptions::Dump(Logger* log) const {
                  experimental_mempurge_threshold);
   ROCKS_LOG_INFO(log, "         bottommost_file_compaction_delay: %" PRIu32,
                  bottommost_file_compaction_delay);
+  ROCKS_LOG_INFO(log, "        range_tombstone_compaction_budget: %" PRIu64,
+                 range_tombstone_compaction_budget);
+  for (const auto& candidate : adaptive_compression_candidates) {
+    ROCKS_LOG_INFO(log, "          adaptive_compression_candidate: %d:%d",
+                   static_cast<int>(candidate.type), candidate.level);
+  }
+  ROCKS_LOG_INFO(log, "          adaptive_compression_write_cost: %f",
+                 adaptive_compression_write_cost);
 
   // Universal Compaction Options
   ROCKS_LOG_INFO(log, "compaction_options_universal.size_ratio : %d",
@@ -1166,6 +1266,10 @@ void MutableCFOptions::Dump(Logger* log) const {
       static_cast<int>(compaction_options_universal.allow_trivial_move));
   ROCKS_LOG_INFO(log, "compaction_options_universal.incremental        : %d",
                  static_cast<int>(compaction_options_universal.incremental));
+  ROCKS_LOG_INFO(
+      log, "compaction_options_universal.fold_non_overlapping_sorted_runs : %d",
+      static_cast<int>(
+          compaction_options_universal.fold_non_overlapping_sorted_runs));
 
   // FIFO Compaction Options
   ROCKS_LOG_INFO(log, "compaction_options_fifo.max_table_files_size : %" PRIu64,
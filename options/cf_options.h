@@ -104,6 +104,8 @@ struct ImmutableCFOptions {
   std::shared_ptr<Cache> blob_cache;
 
   bool persist_user_defined_timestamps;
+
+  std::vector<KeyPrefixRetention> key_prefix_retentions;
 };
 
 struct ImmutableOptions : public ImmutableDBOptions, public ImmutableCFOptions {
@@ -194,7 +196,13 @@ struct MutableCFOptions {
         compression_per_level(options.compression_per_level),
         memtable_max_range_deletions(options.memtable_max_range_deletions),
         bottommost_file_compaction_delay(
-            options.bottommost_file_compaction_delay) {
+            options.bottommost_file_compaction_delay),
+        range_tombstone_compaction_budget(
+            options.range_tombstone_compaction_budget),
+        adaptive_compression_candidates(
+            options.adaptive_compression_candidates),
+        adaptive_compression_write_cost(
+            options.adaptive_compression_write_cost) {
     RefreshDerivedOptions(options.num_levels, options.compaction_style);
   }
 
@@ -244,7 +252,10 @@ struct MutableCFOptions {
         memtable_protection_bytes_per_key(0),
         block_protection_bytes_per_key(0),
         sample_for_compression(0),
-        memtable_max_range_deletions(0) {}
+        memtable_max_range_deletions(0),
+        bottommost_file_compaction_delay(0),
+        range_tombstone_compaction_budget(0),
+        adaptive_compression_write_cost(4.0) {}
 
   explicit MutableCFOptions(const Options& options);
 
@@ -341,6 +352,9 @@ struct MutableCFOptions {
   std::vector<CompressionType> compression_per_level;
   uint32_t memtable_max_range_deletions;
   uint32_t bottommost_file_compaction_delay;
+  uint64_t range_tombstone_compaction_budget;
+  std::vector<AdaptiveCompressionCandidate> adaptive_compression_candidates;
+  double adaptive_compression_write_cost;
 
   // Derived options
   // Per-level target file size.
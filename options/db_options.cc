@@ -584,6 +584,28 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, use_dynamic_delay),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"hot_blocks_persist_period_sec",
+         {offsetof(struct ImmutableDBOptions, hot_blocks_persist_period_sec),
+          OptionType::kUInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"hot_blocks_warmup_bytes",
+         {offsetof(struct ImmutableDBOptions, hot_blocks_warmup_bytes),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"compaction_decompression_threads",
+         {offsetof(struct ImmutableDBOptions,
+                   compaction_decompression_threads),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"max_compaction_readahead_size",
+         {offsetof(struct ImmutableDBOptions, max_compaction_readahead_size),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"max_non_blocking_compact_range_jobs",
+         {offsetof(struct ImmutableDBOptions,
+                   max_non_blocking_compact_range_jobs),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
 };
 
 const std::string OptionsHelper::kDBOptionsName = "DBOptions";
@@ -785,7 +807,14 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       lowest_used_cache_tier(options.lowest_used_cache_tier),
       compaction_service(options.compaction_service),
       use_dynamic_delay(options.use_dynamic_delay),
-      enforce_single_del_contracts(options.enforce_single_del_contracts) {
+      enforce_single_del_contracts(options.enforce_single_del_contracts),
+      hot_blocks_persist_period_sec(options.hot_blocks_persist_period_sec),
+      hot_blocks_warmup_bytes(options.hot_blocks_warmup_bytes),
+      compaction_decompression_threads(
+          options.compaction_decompression_threads),
+      max_compaction_readahead_size(options.max_compaction_readahead_size),
+      max_non_blocking_compact_range_jobs(
+          options.max_non_blocking_compact_range_jobs) {
   fs = env->GetFileSystem();
   clock = env->GetSystemClock().get();
   logger = info_log.get();
@@ -966,6 +995,19 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    db_host_id.c_str());
   ROCKS_LOG_HEADER(log, "            Options.enforce_single_del_contracts: %s",
                    enforce_single_del_contracts ? "true" : "false");
+  ROCKS_LOG_HEADER(log, "           Options.hot_blocks_persist_period_sec: %u",
+                   hot_blocks_persist_period_sec);
+  ROCKS_LOG_HEADER(log,
+                   "                 Options.hot_blocks_warmup_bytes: %" PRIu64,
+                   hot_blocks_warmup_bytes);
+  ROCKS_LOG_HEADER(
+      log, "        Options.compaction_decompression_threads: %" ROCKSDB_PRIszt,
+      compaction_decompression_threads);
+  ROCKS_LOG_HEADER(
+      log, "           Options.max_compaction_readahead_size: %" PRIu64,
+      max_compaction_readahead_size);
+  ROCKS_LOG_HEADER(log, "     Options.max_non_blocking_compact_range_jobs: %d",
+                   max_non_blocking_compact_range_jobs);
 }
 
 bool ImmutableDBOptions::IsWalDirSameAsDBPath() const {
@@ -122,6 +122,11 @@ struct ImmutableDBOptions {
   std::shared_ptr<CompactionService> compaction_service;
   bool use_dynamic_delay;
   bool enforce_single_del_contracts;
+  unsigned int hot_blocks_persist_period_sec;
+  uint64_t hot_blocks_warmup_bytes;
+  size_t compaction_decompression_threads;
+  uint64_t max_compaction_readahead_size;
+  int max_non_blocking_compact_range_jobs;
 
   bool IsWalDirSameAsDBPath() const;
   bool IsWalDirSameAsDBPath(const std::string& path) const;
@@ -129,7 +129,12 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       blob_file_starting_level(options.blob_file_starting_level),
       blob_cache(options.blob_cache),
       prepopulate_blob_cache(options.prepopulate_blob_cache),
-      persist_user_defined_timestamps(options.persist_user_defined_timestamps) {
+      persist_user_defined_timestamps(options.persist_user_defined_timestamps),
+      range_tombstone_compaction_budget(
+          options.range_tombstone_compaction_budget),
+      key_prefix_retentions(options.key_prefix_retentions),
+      adaptive_compression_candidates(options.adaptive_compression_candidates),
+      adaptive_compression_write_cost(options.adaptive_compression_write_cost) {
   assert(memtable_factory.get() != nullptr);
   if (max_bytes_for_level_multiplier_additional.size() <
       static_cast<unsigned int>(num_levels)) {
@@ -249,6 +254,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
         log,
         "        Options.bottommost_compression_opts.use_zstd_dict_trainer: %s",
         bottommost_compression_opts.use_zstd_dict_trainer ? "true" : "false");
+    ROCKS_LOG_HEADER(
+        log, "        Options.bottommost_compression_opts.use_shared_dict: %s",
+        bottommost_compression_opts.use_shared_dict ? "true" : "false");
     ROCKS_LOG_HEADER(log, "           Options.compression_opts.window_bits: %d",
                      compression_opts.window_bits);
     ROCKS_LOG_HEADER(log, "                 Options.compression_opts.level: %d",
@@ -277,6 +285,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
                      "        Options.compression_opts.max_dict_buffer_bytes: "
                      "%" PRIu64,
                      compression_opts.max_dict_buffer_bytes);
+    ROCKS_LOG_HEADER(log,
+                     "              Options.compression_opts.use_shared_dict: %s",
+                     compression_opts.use_shared_dict ? "true" : "false");
     ROCKS_LOG_HEADER(log, "     Options.level0_file_num_compaction_trigger: %d",
                      level0_file_num_compaction_trigger);
     ROCKS_LOG_HEADER(log, "         Options.level0_slowdown_writes_trigger: %d",
@@ -431,6 +442,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
     ROCKS_LOG_HEADER(log,
                      "         Options.periodic_compaction_seconds: %" PRIu64,
                      periodic_compaction_seconds);
+    ROCKS_LOG_HEADER(
+        log, "   Options.range_tombstone_compaction_budget: %" PRIu64,
+        range_tombstone_compaction_budget);
     const auto& it_temp = temperature_to_string.find(default_temperature);
     std::string str_default_temperature;
     if (it_temp == temperature_to_string.end()) {
@@ -446,6 +460,19 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
                      preclude_last_level_data_seconds);
     ROCKS_LOG_HEADER(log, "   Options.preserve_internal_time_seconds: %" PRIu64,
                      preserve_internal_time_seconds);
+    for (const auto& retention : key_prefix_retentions) {
+      ROCKS_LOG_HEADER(log,
+                       "            Options.key_prefix_retentions: %s=%" PRIu64,
+                       Slice(retention.prefix).ToString(true).c_str(),
+                       retention.retention_seconds);
+    }
+    for (const auto& candidate : adaptive_compression_candidates) {
+      ROCKS_LOG_HEADER(
+          log, "  Options.adaptive_compression_candidates: %s:%d",
+          CompressionTypeToString(candidate.type).c_str(), candidate.level);
+    }
+    ROCKS_LOG_HEADER(log, "  Options.adaptive_compression_write_cost: %f",
+                     adaptive_compression_write_cost);
     ROCKS_LOG_HEADER(log, "                      Options.enable_blob_files: %s",
                      enable_blob_files ? "true" : "false");
     ROCKS_LOG_HEADER(
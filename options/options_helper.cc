@@ -233,6 +233,16 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.lowest_used_cache_tier = immutable_db_options.lowest_used_cache_tier;
   options.enforce_single_del_contracts =
       immutable_db_options.enforce_single_del_contracts;
+  options.hot_blocks_persist_period_sec =
+      immutable_db_options.hot_blocks_persist_period_sec;
+  options.hot_blocks_warmup_bytes =
+      immutable_db_options.hot_blocks_warmup_bytes;
+  options.compaction_decompression_threads =
+      immutable_db_options.compaction_decompression_threads;
+  options.max_compaction_readahead_size =
+      immutable_db_options.max_compaction_readahead_size;
+  options.max_non_blocking_compact_range_jobs =
+      immutable_db_options.max_non_blocking_compact_range_jobs;
   options.refresh_options_sec = mutable_db_options.refresh_options_sec;
   options.refresh_options_file = mutable_db_options.refresh_options_file;
   return options;
@@ -269,6 +279,12 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
       moptions.block_protection_bytes_per_key;
   cf_opts->bottommost_file_compaction_delay =
       moptions.bottommost_file_compaction_delay;
+  cf_opts->range_tombstone_compaction_budget =
+      moptions.range_tombstone_compaction_budget;
+  cf_opts->adaptive_compression_candidates =
+      moptions.adaptive_compression_candidates;
+  cf_opts->adaptive_compression_write_cost =
+      moptions.adaptive_compression_write_cost;
 
   // Compaction related options
   cf_opts->disable_auto_compactions = moptions.disable_auto_compactions;
@@ -374,6 +390,7 @@ void UpdateColumnFamilyOptions(const ImmutableCFOptions& ioptions,
       ioptions.preserve_internal_time_seconds;
   cf_opts->persist_user_defined_timestamps =
       ioptions.persist_user_defined_timestamps;
+  cf_opts->key_prefix_retentions = ioptions.key_prefix_retentions;
   cf_opts->default_temperature = ioptions.default_temperature;
 
   // TODO(yhchiang): find some way to handle the following derived options
@@ -392,7 +409,8 @@ std::map<CompactionPri, std::string> OptionsHelper::compaction_pri_to_string = {
     {kOldestLargestSeqFirst, "kOldestLargestSeqFirst"},
     {kOldestSmallestSeqFirst, "kOldestSmallestSeqFirst"},
     {kMinOverlappingRatio, "kMinOverlappingRatio"},
-    {kRoundRobin, "kRoundRobin"}};
+    {kRoundRobin, "kRoundRobin"},
+    {kHottestRangeFirst, "kHottestRangeFirst"}};
 
 std::map<CompactionStopStyle, std::string>
     OptionsHelper::compaction_stop_style_to_string = {
@@ -805,7 +823,8 @@ std::unordered_map<std::string, CompactionPri>
         {"kOldestLargestSeqFirst", kOldestLargestSeqFirst},
         {"kOldestSmallestSeqFirst", kOldestSmallestSeqFirst},
         {"kMinOverlappingRatio", kMinOverlappingRatio},
-        {"kRoundRobin", kRoundRobin}};
+        {"kRoundRobin", kRoundRobin},
+        {"kHottestRangeFirst", kHottestRangeFirst}};
 
 std::unordered_map<std::string, CompactionStopStyle>
     OptionsHelper::compaction_stop_style_string_map = {
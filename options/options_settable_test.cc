@@ -202,6 +202,8 @@ TEST_F(OptionsSettableTest, BlockBasedTableOptionsAllFieldsSettable) {
       "data_block_index_type=kDataBlockBinaryAndHash;"
       "index_shortening=kNoShortening;"
       "data_block_hash_table_util_ratio=0.75;"
+      "data_block_restart_key_prefixes=true;"
+      "data_block_columnar_entities=true;"
       "checksum=kxxHash;no_block_cache=1;"
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;"
       "block_size_deviation=8;block_restart_interval=4; "
@@ -391,6 +393,11 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "enforce_single_del_contracts=false;"
                              "refresh_options_sec=0;"
                              "refresh_options_file=Options.new;"
+                             "hot_blocks_persist_period_sec=0;"
+                             "hot_blocks_warmup_bytes=0;"
+                             "compaction_decompression_threads=0;"
+                             "max_compaction_readahead_size=0;"
+                             "max_non_blocking_compact_range_jobs=4;"
                              "use_dynamic_delay=true",
                              new_options));
 
@@ -442,6 +449,10 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
        sizeof(uint64_t)},
       {offsetof(struct ColumnFamilyOptions, blob_cache),
        sizeof(std::shared_ptr<Cache>)},
+      {offsetof(struct ColumnFamilyOptions, key_prefix_retentions),
+       sizeof(std::vector<KeyPrefixRetention>)},
+      {offsetof(struct ColumnFamilyOptions, adaptive_compression_candidates),
+       sizeof(std::vector<AdaptiveCompressionCandidate>)},
       {offsetof(struct ColumnFamilyOptions, comparator), sizeof(Comparator*)},
       {offsetof(struct ColumnFamilyOptions, merge_operator),
        sizeof(std::shared_ptr<MergeOperator>)},
@@ -531,11 +542,11 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "compression_opts={max_dict_buffer_bytes=5;use_zstd_dict_trainer=true;"
       "enabled=false;parallel_threads=6;zstd_max_train_bytes=7;strategy=8;max_"
       "dict_bytes=9;level=10;window_bits=11;max_compressed_bytes_per_kb=987;"
-      "checksum=true};"
+      "checksum=true;use_shared_dict=true};"
       "bottommost_compression_opts={max_dict_buffer_bytes=4;use_zstd_dict_"
       "trainer=true;enabled=true;parallel_threads=5;zstd_max_train_bytes=6;"
       "strategy=7;max_dict_bytes=8;level=9;window_bits=10;max_compressed_bytes_"
-      "per_kb=876;checksum=true};"
+      "per_kb=876;checksum=true;use_shared_dict=true};"
       "bottommost_compression=kDisableCompressionOption;"
       "level0_stop_writes_trigger=33;"
       "num_levels=99;"
@@ -589,7 +600,11 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "persist_user_defined_timestamps=true;"
       "block_protection_bytes_per_key=1;"
       "memtable_max_range_deletions=999999;"
-      "bottommost_file_compaction_delay=7200;",
+      "bottommost_file_compaction_delay=7200;"
+      "range_tombstone_compaction_budget=1048576;"
+      "key_prefix_retentions={{prefix=abc;retention_seconds=3600}};"
+      "adaptive_compression_candidates={{type=kZSTD;level=3}};"
+      "adaptive_compression_write_cost=2.5;",
       new_options));
 
   ASSERT_NE(new_options->blob_cache.get(), nullptr);
@@ -613,6 +628,13 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       new_options->compaction_options_fifo.file_temperature_age_thresholds[0]
           .age,
       12345);
+  // key_prefix_retentions was in kColumnFamilyOptionsExcluded as well
+  ASSERT_EQ(new_options->key_prefix_retentions.size(), 1);
+  ASSERT_EQ(new_options->key_prefix_retentions[0].prefix, "abc");
+  ASSERT_EQ(new_options->key_prefix_retentions[0].retention_seconds, 3600);
+  ASSERT_EQ(new_options->adaptive_compression_candidates.size(), 1);
+  ASSERT_EQ(new_options->adaptive_compression_candidates[0].type, kZSTD);
+  ASSERT_EQ(new_options->adaptive_compression_candidates[0].level, 3);
 
   ColumnFamilyOptions rnd_filled_options = *new_options;
 
@@ -634,6 +656,8 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
        sizeof(struct CompactionOptionsFIFO)},
       {offsetof(struct MutableCFOptions, compression_per_level),
        sizeof(std::vector<CompressionType>)},
+      {offsetof(struct MutableCFOptions, adaptive_compression_candidates),
+       sizeof(std::vector<AdaptiveCompressionCandidate>)},
       {offsetof(struct MutableCFOptions, max_file_size),
        sizeof(std::vector<uint64_t>)},
   };
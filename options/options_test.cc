@@ -4115,6 +4115,37 @@ TEST_F(OptionsParserTest, DifferentDefault) {
   ASSERT_EQ(5000, small_opts.max_open_files);
 }
 
+TEST_F(OptionsParserTest, StructVectorsRoundTrip) {
+  const std::string kOptionsFileName = "test-persisted-options.ini";
+
+  ColumnFamilyOptions cf_opts;
+  cf_opts.key_prefix_retentions = {{"a", 3600}, {"b", 7200}};
+  cf_opts.adaptive_compression_candidates = {{kNoCompression, 0},
+                                             {kSnappyCompression, 0}};
+
+  ASSERT_OK(PersistRocksDBOptions(DBOptions(), {"default"}, {cf_opts},
+                                  kOptionsFileName, fs_.get()));
+
+  RocksDBOptionsParser parser;
+  ASSERT_OK(parser.Parse(kOptionsFileName, fs_.get(), false,
+                         4096 /* readahead_size */));
+  const auto* parsed = parser.GetCFOptions("default");
+  ASSERT_NE(parsed, nullptr);
+  ASSERT_EQ(parsed->key_prefix_retentions.size(), 2);
+  ASSERT_EQ(parsed->key_prefix_retentions[0].prefix, "a");
+  ASSERT_EQ(parsed->key_prefix_retentions[0].retention_seconds, 3600);
+  ASSERT_EQ(parsed->key_prefix_retentions[1].prefix, "b");
+  ASSERT_EQ(parsed->key_prefix_retentions[1].retention_seconds, 7200);
+  ASSERT_EQ(parsed->adaptive_compression_candidates.size(), 2);
+  ASSERT_EQ(parsed->adaptive_compression_candidates[1].type,
+            kSnappyCompression);
+
+  ConfigOptions config_options;
+  ASSERT_OK(RocksDBOptionsParser::VerifyRocksDBOptionsFromFile(
+      config_options, DBOptions(), {"default"}, {cf_opts}, kOptionsFileName,
+      fs_.get()));
+}
+
 class OptionsSanityCheckTest : public OptionsParserTest,
                                public ::testing::WithParamInterface<bool> {
  protected:
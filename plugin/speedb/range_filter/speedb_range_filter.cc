@@ -0,0 +1,334 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "plugin/speedb/range_filter/speedb_range_filter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "rocksdb/filter_policy.h"
+#include "table/block_based/filter_policy_internal.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// Filter layout:
+//
+// +------------------------------------------------------------------+
+// | entry 0 | entry 1 | ... | entry N-1                               |
+// +------------------------------------------------------------------+
+// | restart offsets (fixed32 each)                                   |
+// +------------------------------------------------------------------+
+// | num entries (fixed32) | num restarts (fixed32) | format (1 byte) |
+// +------------------------------------------------------------------+
+//
+// Each entry is a distinguishing prefix, front-coded against the previous
+// entry: varint32 shared | varint32 (non_shared << 1 | complete) | bytes.
+// "complete" means the prefix is the whole key, so the entry stands for that
+// single key rather than for every key starting with the prefix. Entries at
+// restart points have shared == 0.
+constexpr uint32_t kRestartInterval = 16;
+constexpr uint8_t kFormatVersion = 1;
+constexpr size_t kTrailerLen = 2 * sizeof(uint32_t) + 1;
+
+size_t CommonPrefixLen(const std::string& a, const std::string& b) {
+  const size_t n = std::min(a.size(), b.size());
+  size_t i = 0;
+  while (i < n && a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
+class SpdbRangeFilterBitsBuilder : public FilterBitsBuilder {
+ public:
+  explicit SpdbRangeFilterBitsBuilder(int suffix_bytes)
+      : suffix_bytes_(suffix_bytes) {}
+
+  // Keys are mostly added in sorted order, but prefixes (prefix_extractor)
+  // are interleaved with whole keys, so they are sorted again in Finish().
+  void AddKey(const Slice& key) override {
+    if (keys_.empty() || Slice(keys_.back()) != key) {
+      keys_.emplace_back(key.data(), key.size());
+    }
+  }
+
+  size_t EstimateEntriesAdded() override { return keys_.size(); }
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override {
+    std::sort(keys_.begin(), keys_.end());
+    keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+
+    std::string out;
+    std::vector<uint32_t> restarts;
+    std::string prev_entry;
+    size_t lcp_prev = 0;
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      const std::string& key = keys_[i];
+      const size_t lcp_next =
+          i + 1 < keys_.size() ? CommonPrefixLen(key, keys_[i + 1]) : 0;
+      const size_t len =
+          std::min(key.size(), std::max(lcp_prev, lcp_next) + 1 +
+                                   static_cast<size_t>(suffix_bytes_));
+      const bool complete = len == key.size();
+
+      size_t shared = 0;
+      if (i % kRestartInterval == 0) {
+        restarts.push_back(static_cast<uint32_t>(out.size()));
+      } else {
+        const size_t max_shared = std::min(len, prev_entry.size());
+        while (shared < max_shared && prev_entry[shared] == key[shared]) {
+          ++shared;
+        }
+      }
+      const size_t non_shared = len - shared;
+      PutVarint32(&out, static_cast<uint32_t>(shared));
+      PutVarint32(&out, static_cast<uint32_t>((non_shared << 1) |
+                                              (complete ? 1 : 0)));
+      out.append(key.data() + shared, non_shared);
+
+      prev_entry.assign(key.data(), len);
+      lcp_prev = lcp_next;
+    }
+    for (uint32_t restart : restarts) {
+      PutFixed32(&out, restart);
+    }
+    PutFixed32(&out, static_cast<uint32_t>(keys_.size()));
+    PutFixed32(&out, static_cast<uint32_t>(restarts.size()));
+    out.push_back(static_cast<char>(kFormatVersion));
+
+    // Partitioned filters reuse the builder for every partition
+    keys_.clear();
+
+    char* data = new char[out.size()];
+    memcpy(data, out.data(), out.size());
+    buf->reset(data);
+    return Slice(data, out.size());
+  }
+  using FilterBitsBuilder::Finish;  // inherit overload
+
+  size_t ApproximateNumEntries(size_t bytes) override {
+    // Two single-byte varints plus the distinguishing byte and suffix bytes
+    // per entry is a reasonable average for keys with a random-ish tail
+    return bytes / (3 + static_cast<size_t>(suffix_bytes_));
+  }
+
+ private:
+  const int suffix_bytes_;
+  std::vector<std::string> keys_;
+};
+
+class SpdbRangeFilterBitsReader : public FilterBitsReader {
+ public:
+  SpdbRangeFilterBitsReader(const char* data, uint32_t data_len,
+                            uint32_t num_entries, const char* restarts,
+                            uint32_t num_restarts)
+      : data_(data),
+        data_len_(data_len),
+        num_entries_(num_entries),
+        restarts_(restarts),
+        num_restarts_(num_restarts) {}
+
+  bool MayMatch(const Slice& key) override {
+    Cursor cursor(this);
+    if (!cursor.SeekToFirstNotBelow(key)) {
+      return cursor.corrupted();
+    }
+    const Slice entry = cursor.entry();
+    return cursor.complete() ? entry == key : key.starts_with(entry);
+  }
+  using FilterBitsReader::MayMatch;  // inherit overload
+
+  bool HashMayMatch(const uint64_t /* h */) override { return true; }
+
+  bool RangeMayMatch(const Slice& lower, const Slice& upper) override {
+    if (lower.compare(upper) >= 0) {
+      return false;
+    }
+    Cursor cursor(this);
+    if (!cursor.SeekToFirstNotBelow(lower)) {
+      return cursor.corrupted();
+    }
+    // The smallest key the entry stands for is the entry itself
+    return cursor.entry().compare(upper) < 0;
+  }
+
+ private:
+  // Decodes entries in order, starting at a restart point
+  class Cursor {
+   public:
+    explicit Cursor(const SpdbRangeFilterBitsReader* reader)
+        : reader_(reader) {}
+
+    // Positions at the first entry that stands for any key >= target.
+    // Returns false if there is no such entry or the filter is corrupted.
+    bool SeekToFirstNotBelow(const Slice& target) {
+      // Binary search for the last restart point whose entry stands only
+      // for keys < target
+      uint32_t left = 0;
+      uint32_t right = reader_->num_restarts_;
+      while (left < right) {
+        const uint32_t mid = left + (right - left) / 2;
+        if (!SeekToRestart(mid)) {
+          return false;
+        }
+        if (IsBelow(target)) {
+          left = mid + 1;
+        } else {
+          right = mid;
+        }
+      }
+      if (!SeekToRestart(left > 0 ? left - 1 : 0)) {
+        return false;
+      }
+      while (IsBelow(target)) {
+        if (!Next()) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    Slice entry() const { return Slice(entry_); }
+    bool complete() const { return complete_; }
+    bool corrupted() const { return corrupted_; }
+
+   private:
+    // Whether every key the current entry stands for is < target
+    bool IsBelow(const Slice& target) const {
+      if (complete_) {
+        return Slice(entry_).compare(target) < 0;
+      }
+      const Slice target_prefix(target.data(),
+                                std::min(target.size(), entry_.size()));
+      return Slice(entry_).compare(target_prefix) < 0;
+    }
+
+    bool SeekToRestart(uint32_t restart_index) {
+      index_ = restart_index * kRestartInterval;
+      pos_ = DecodeFixed32(reader_->restarts_ +
+                           restart_index * sizeof(uint32_t));
+      entry_.clear();
+      return Decode();
+    }
+
+    bool Next() {
+      if (++index_ >= reader_->num_entries_) {
+        return false;
+      }
+      return Decode();
+    }
+
+    bool Decode() {
+      const char* p = reader_->data_ + pos_;
+      const char* limit = reader_->data_ + reader_->data_len_;
+      uint32_t shared = 0;
+      uint32_t non_shared_and_complete = 0;
+      p = GetVarint32Ptr(p, limit, &shared);
+      if (p != nullptr) {
+        p = GetVarint32Ptr(p, limit, &non_shared_and_complete);
+      }
+      const uint32_t non_shared = non_shared_and_complete >> 1;
+      if (p == nullptr || shared > entry_.size() ||
+          static_cast<size_t>(limit - p) < non_shared) {
+        // Treat a broken filter as "may match"
+        corrupted_ = true;
+        return false;
+      }
+      entry_.resize(shared);
+      entry_.append(p, non_shared);
+      complete_ = (non_shared_and_complete & 1) != 0;
+      pos_ = static_cast<uint32_t>(p + non_shared - reader_->data_);
+      return true;
+    }
+
+    const SpdbRangeFilterBitsReader* reader_;
+    uint32_t index_ = 0;
+    uint32_t pos_ = 0;
+    std::string entry_;
+    bool complete_ = false;
+    bool corrupted_ = false;
+  };
+
+  const char* data_;
+  uint32_t data_len_;
+  uint32_t num_entries_;
+  const char* restarts_;
+  uint32_t num_restarts_;
+};
+
+}  // namespace
+
+SpdbRangeFilterPolicy::SpdbRangeFilterPolicy(int suffix_bytes)
+    : suffix_bytes_(std::max(0, std::min(suffix_bytes, kMaxSuffixBytes))) {}
+
+FilterBitsBuilder* SpdbRangeFilterPolicy::GetBuilderWithContext(
+    const FilterBuildingContext& /*context*/) const {
+  return new SpdbRangeFilterBitsBuilder(suffix_bytes_);
+}
+
+FilterBitsReader* SpdbRangeFilterPolicy::GetFilterBitsReader(
+    const Slice& contents) const {
+  if (contents.size() < kTrailerLen ||
+      static_cast<uint8_t>(contents[contents.size() - 1]) != kFormatVersion) {
+    // Broken or from a future version
+    return new AlwaysTrueFilter();
+  }
+  const char* trailer = contents.data() + contents.size() - kTrailerLen;
+  const uint32_t num_entries = DecodeFixed32(trailer);
+  const uint32_t num_restarts = DecodeFixed32(trailer + sizeof(uint32_t));
+  if (num_entries == 0) {
+    return new AlwaysFalseFilter();
+  }
+  const size_t restarts_len = static_cast<size_t>(num_restarts) *
+                              sizeof(uint32_t);
+  if (num_restarts != (num_entries - 1) / kRestartInterval + 1 ||
+      restarts_len > contents.size() - kTrailerLen) {
+    return new AlwaysTrueFilter();
+  }
+  const uint32_t data_len =
+      static_cast<uint32_t>(contents.size() - kTrailerLen - restarts_len);
+  const char* restarts = contents.data() + data_len;
+  for (uint32_t i = 0; i < num_restarts; ++i) {
+    if (DecodeFixed32(restarts + i * sizeof(uint32_t)) >= data_len) {
+      return new AlwaysTrueFilter();
+    }
+  }
+  return new SpdbRangeFilterBitsReader(contents.data(), data_len, num_entries,
+                                       restarts, num_restarts);
+}
+
+std::string SpdbRangeFilterPolicy::GetId() const {
+  return Name() + std::string(":") + std::to_string(suffix_bytes_);
+}
+
+bool SpdbRangeFilterPolicy::IsInstanceOf(const std::string& name) const {
+  if (name == kClassName()) {
+    return true;
+  } else {
+    return FilterPolicy::IsInstanceOf(name);
+  }
+}
+
+const char* SpdbRangeFilterPolicy::kClassName() {
+  return "speedb_range_filter";
+}
+
+const char* SpdbRangeFilterPolicy::kNickName() { return "speedb.RangeFilter"; }
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,75 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include "rocksdb/filter_policy.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A range filter in the spirit of SuRF (Succinct Range Filter). In addition to
+// point (and prefix) queries, it can tell whether any key in a range
+// [lower, upper) may be present in a table. Bounded iterator seeks
+// (ReadOptions::iterate_upper_bound set) consult it before reading any index
+// or data block, so that short scans over empty ranges cost no block reads.
+//
+// For every key, the filter stores the shortest prefix that distinguishes it
+// from its neighbors (the leaves of the trie over all keys), followed by up to
+// `suffix_bytes` real suffix bytes of the key. The prefixes are front-coded in
+// sorted order with restart points, so a query is a binary search over the
+// restart points followed by a short linear scan. More suffix bytes lower the
+// false positive rate of both point and range queries at the cost of space.
+//
+// Range queries require a bytewise comparator, no user-defined timestamps,
+// whole_key_filtering and a full (non-partitioned) filter. In any other
+// configuration the filter still serves point and prefix queries.
+class SpdbRangeFilterPolicy : public FilterPolicy {
+ public:
+  static constexpr int kDefaultSuffixBytes = 1;
+  static constexpr int kMaxSuffixBytes = 8;
+
+ public:
+  explicit SpdbRangeFilterPolicy(int suffix_bytes = kDefaultSuffixBytes);
+
+  FilterBitsBuilder* GetBuilderWithContext(
+      const FilterBuildingContext& context) const override;
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override;
+
+  bool SupportsRangeQueries() const override { return true; }
+
+  int GetSuffixBytes() const { return suffix_bytes_; }
+
+  // Plug-In Support
+ public:
+  static const char* kClassName();
+  const char* Name() const override { return kClassName(); }
+  static const char* kNickName();
+  const char* NickName() const override { return kNickName(); }
+
+  std::string GetId() const override;
+
+  bool IsInstanceOf(const std::string& name) const override;
+
+  // This filter is NOT compatible with RocksDB's built-in filter, only with
+  // itself
+  const char* CompatibilityName() const override {
+    return kCompatibilityName();
+  }
+  static const char* kCompatibilityName() { return kClassName(); }
+
+ private:
+  int suffix_bytes_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -17,6 +17,7 @@ speedb_SOURCES = \
      paired_filter/speedb_paired_bloom.cc          \
      paired_filter/speedb_paired_bloom_internal.cc \
      pinning_policy/scoped_pinning_policy.cc       \
+     range_filter/speedb_range_filter.cc           \
 
 
 speedb_FUNC = register_SpeedbPlugins
@@ -24,6 +25,7 @@ speedb_FUNC = register_SpeedbPlugins
 speedb_HEADERS = \
      paired_filter/speedb_paired_bloom.h           \
      pinning_policy/scoped_pinning_policy.h        \
+     range_filter/speedb_range_filter.h            \
 
 speedb_TESTS =   \
      speedb_customizable_test.cc                   \
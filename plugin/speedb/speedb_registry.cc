@@ -16,6 +16,7 @@
 
 #include "paired_filter/speedb_paired_bloom.h"
 #include "plugin/speedb/pinning_policy/scoped_pinning_policy.h"
+#include "plugin/speedb/range_filter/speedb_range_filter.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "util/string_util.h"
 
@@ -29,6 +30,15 @@ SpdbPairedBloomFilterPolicy* NewSpdbPairedBloomFilterWithBits(
       FilterPolicy::ExtractBitsPerKeyFromUri(uri));
 }
 
+SpdbRangeFilterPolicy* NewSpdbRangeFilterWithSuffixBytes(
+    const std::string& uri) {
+  const std::vector<std::string> vals = StringSplit(uri, ':');
+  if (vals.size() < 2) {
+    return new SpdbRangeFilterPolicy();
+  }
+  return new SpdbRangeFilterPolicy(ParseInt(vals[1]));
+}
+
 int register_SpeedbPlugins(ObjectLibrary& library, const std::string&) {
   library.AddFactory<const FilterPolicy>(
       ObjectLibrary::PatternEntry(SpdbPairedBloomFilterPolicy::kClassName(),
@@ -40,6 +50,15 @@ int register_SpeedbPlugins(ObjectLibrary& library, const std::string&) {
         guard->reset(NewSpdbPairedBloomFilterWithBits(uri));
         return guard->get();
       });
+  library.AddFactory<const FilterPolicy>(
+      ObjectLibrary::PatternEntry(SpdbRangeFilterPolicy::kClassName(), true)
+          .AnotherName(SpdbRangeFilterPolicy::kNickName())
+          .AddNumber(":"),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        guard->reset(NewSpdbRangeFilterWithSuffixBytes(uri));
+        return guard->get();
+      });
   library.AddFactory<TablePinningPolicy>(
       ObjectLibrary::PatternEntry::AsIndividualId(
           ScopedPinningPolicy::kClassName()),
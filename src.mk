@@ -12,6 +12,7 @@ LIB_SOURCES =                                                   \
   cache/secondary_cache.cc                                      \
   cache/secondary_cache_adapter.cc                              \
   cache/sharded_cache.cc                                        \
+  db/adaptive_compression.cc                                    \
   db/arena_wrapped_db_iter.cc                                   \
   db/blob/blob_contents.cc                                      \
   db/blob/blob_fetcher.cc                                       \
@@ -40,8 +41,10 @@ LIB_SOURCES =                                                   \
   db/compaction/compaction_service_job.cc                       \
   db/compaction/compaction_state.cc                             \
   db/compaction/compaction_outputs.cc                           \
+  db/compaction/key_prefix_retention.cc                         \
   db/compaction/sst_partitioner.cc                              \
   db/compaction/subcompaction_state.cc                          \
+  db/compression_dict_service.cc                                \
   db/convenience.cc                                             \
   db/db_filesnapshot.cc                                         \
   db/db_impl/compacted_db_impl.cc                               \
@@ -49,13 +52,14 @@ LIB_SOURCES =                                                   \
   db/db_impl/db_impl_compaction_flush.cc                        \
   db/db_impl/db_impl_debug.cc                                   \
   db/db_impl/db_impl_experimental.cc                            \
+  db/db_impl/db_impl_hot_blocks.cc                              \
   db/db_impl/db_impl_files.cc                                   \
   db/db_impl/db_impl_open.cc                                    \
   db/db_impl/db_impl_readonly.cc                                \
   db/db_impl/db_impl_secondary.cc                               \
   db/db_impl/db_impl_write.cc                                   \
   db/db_impl/db_spdb_impl_write.cc                              \
-  db/db_impl/compact_range_threads_mngr.cc                      \
+  db/db_impl/compact_range_job_queue.cc                         \
   db/db_info_dumper.cc                                          \
   db/db_iter.cc                                                 \
   db/dbformat.cc                                                \
@@ -77,6 +81,8 @@ LIB_SOURCES =                                                   \
   db/memtable_list.cc                                           \
   db/merge_helper.cc                                            \
   db/merge_operator.cc                                          \
+  db/multi_get_async.cc                                         \
+  db/multi_get_io_planner.cc                                    \
   db/output_validator.cc                                        \
   db/periodic_task_scheduler.cc                                 \
   db/range_del_aggregator.cc                                    \
@@ -181,6 +187,7 @@ LIB_SOURCES =                                                   \
   table/block_based/block_cache.cc                              \
   table/block_based/block_prefetcher.cc                         \
   table/block_based/block_prefix_index.cc                       \
+  table/block_based/data_block_columns.cc                       \
   table/block_based/data_block_hash_index.cc                    \
   table/block_based/data_block_footer.cc                        \
   table/block_based/filter_block_reader_common.cc               \
@@ -190,6 +197,9 @@ LIB_SOURCES =                                                   \
   table/block_based/hash_index_reader.cc                        \
   table/block_based/index_builder.cc                            \
   table/block_based/index_reader_common.cc                      \
+  table/block_based/learned_index.cc                            \
+  table/block_based/learned_index_reader.cc                     \
+  table/block_based/parallel_block_decompressor.cc              \
   table/block_based/parsed_full_filter_block.cc                 \
   table/block_based/partitioned_filter_block.cc                 \
   table/block_based/partitioned_index_iterator.cc               \
@@ -243,6 +253,7 @@ LIB_SOURCES =                                                   \
   util/crc32c.cc                                                \
   util/crc32c_arm64.cc                                          \
   util/data_structure.cc                                        \
+  util/deadline_rate_limiter.cc                                 \
   util/dynamic_bloom.cc                                         \
   util/hash.cc                                                  \
   util/murmurhash.cc                                            \
@@ -274,6 +285,7 @@ LIB_SOURCES =                                                   \
   utilities/checkpoint/checkpoint_impl.cc                       \
   utilities/compaction_filters.cc                               \
   utilities/compaction_filters/remove_emptyvalue_compactionfilter.cc    \
+  utilities/compaction_service/local_compaction_service.cc      \
   utilities/convenience/info_log_finder.cc                      \
   utilities/counted_fs.cc                                       \
   utilities/debug.cc                                            \
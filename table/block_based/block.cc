@@ -12,6 +12,7 @@
 #include "table/block_based/block.h"
 
 #include <algorithm>
+#include <limits>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -22,8 +23,14 @@
 #include "rocksdb/comparator.h"
 #include "table/block_based/block_prefix_index.h"
 #include "table/block_based/data_block_footer.h"
+#include "table/block_based/learned_index.h"
 #include "table/format.h"
 #include "util/coding.h"
+#include "util/math.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -269,20 +276,89 @@ void DataBlockIter::PrevImpl() {
     if (raw_key_.IsKeyPinned()) {
       // The key is not delta encoded
       prev_entries_.emplace_back(current_, current_key.data(), 0,
-                                 current_key.size(), value());
+                                 current_key.size(), raw_value());
     } else {
       // The key is delta encoded, cache decoded key in buffer
       size_t new_key_offset = prev_entries_keys_buff_.size();
       prev_entries_keys_buff_.append(current_key.data(), current_key.size());
 
       prev_entries_.emplace_back(current_, nullptr, new_key_offset,
-                                 current_key.size(), value());
+                                 current_key.size(), raw_value());
     }
     // Loop until end of current entry hits the start of original entry
   } while (NextEntryOffset() < original);
   prev_entries_idx_ = static_cast<int32_t>(prev_entries_.size()) - 1;
 }
 
+namespace {
+// Windows of at most this many restart key prefixes are scanned rather than
+// binary searched
+constexpr uint32_t kRestartKeyPrefixScanWindow = 16;
+
+// Returns how many of the sorted restart key prefixes in `prefixes[0, n)`
+// are less than `prefix`.
+uint32_t CountRestartKeyPrefixesLessThan(const char* prefixes, uint32_t n,
+                                         uint64_t prefix) {
+  // Branchless binary search down to a small window. Invariant: the
+  // prefixes before `base` are less than `prefix` and the ones from
+  // `base + len` on are not.
+  uint32_t base = 0;
+  uint32_t len = n;
+  while (len > kRestartKeyPrefixScanWindow) {
+    const uint32_t half = len / 2;
+    base = DecodeFixed64(prefixes + (base + half) * kRestartKeyPrefixSize) <
+                   prefix
+               ? base + half
+               : base;
+    len -= half;
+  }
+
+  const char* window = prefixes + base * kRestartKeyPrefixSize;
+  uint32_t count = 0;
+  uint32_t i = 0;
+#ifdef __AVX2__
+  // Unsigned compares as signed ones with the sign bits flipped
+  const __m256i sign = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+  const __m256i target =
+      _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(prefix)), sign);
+  for (; i + 4 <= len; i += 4) {
+    const __m256i values = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+            window + i * kRestartKeyPrefixSize)),
+        sign);
+    const __m256i less = _mm256_cmpgt_epi64(target, values);
+    count += static_cast<uint32_t>(
+        BitsSetToOne(_mm256_movemask_pd(_mm256_castsi256_pd(less))));
+  }
+#endif  // __AVX2__
+  for (; i < len; ++i) {
+    count += DecodeFixed64(window + i * kRestartKeyPrefixSize) < prefix;
+  }
+  return base + count;
+}
+}  // namespace
+
+bool DataBlockIter::BinarySeekRestarts(const Slice& target, uint32_t* index,
+                                       bool* skip_linear_scan) {
+  if (restart_key_prefixes_ == nullptr) {
+    return BinarySeek<DecodeKey>(target, index, skip_linear_scan);
+  }
+  // Restart keys with a smaller prefix than the target's are smaller than the
+  // target and the ones with a larger prefix are larger, so only the restart
+  // points with an equal prefix need to be binary searched
+  const uint64_t prefix = RestartKeyPrefix(ExtractUserKey(target));
+  const uint32_t lower = CountRestartKeyPrefixesLessThan(
+      restart_key_prefixes_, num_restarts_, prefix);
+  const uint32_t upper =
+      prefix == std::numeric_limits<uint64_t>::max()
+          ? num_restarts_
+          : CountRestartKeyPrefixesLessThan(restart_key_prefixes_,
+                                            num_restarts_, prefix + 1);
+  return BinarySeek<DecodeKey>(target, static_cast<int64_t>(lower) - 1,
+                               static_cast<int64_t>(upper) - 1, index,
+                               skip_linear_scan);
+}
+
 void DataBlockIter::SeekImpl(const Slice& target) {
   Slice seek_key = target;
   PERF_TIMER_GUARD(block_seek_nanos);
@@ -291,7 +367,7 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = BinarySeekRestarts(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -339,6 +415,19 @@ void MetaBlockIter::SeekImpl(const Slice& target) {
 //    than the seek_user_key, or the block ends with a matching user_key but
 //    with a smaller [ type | seqno ] (i.e. a larger seqno, or the same seqno
 //    but larger type).
+Slice DataBlockIter::RebuildEntity() const {
+  if (rebuilt_value_offset_ != current_) {
+    if (!data_block_columns_->Rebuild(value_, column_projection_,
+                                      &rebuilt_value_)) {
+      // An empty value fails to decode as an entity, which surfaces the
+      // corruption to the reader
+      return Slice();
+    }
+    rebuilt_value_offset_ = current_;
+  }
+  return rebuilt_value_;
+}
+
 bool DataBlockIter::SeekForGetImpl(const Slice& target) {
   Slice target_user_key = ExtractUserKey(target);
   uint32_t map_offset = restarts_ + num_restarts_ * sizeof(uint32_t);
@@ -474,10 +563,23 @@ void IndexBlockIter::SeekImpl(const Slice& target) {
     // restart interval must be one when hash search is enabled so the binary
     // search simply lands at the right place.
     skip_linear_scan = true;
-  } else if (value_delta_encoded_) {
-    ok = BinarySeek<DecodeKeyV4>(seek_key, &index, &skip_linear_scan);
   } else {
-    ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+    int64_t left = -1;
+    int64_t right = static_cast<int64_t>(num_restarts_) - 1;
+    if (learned_index_ != nullptr) {
+      uint32_t first = 0;
+      uint32_t limit = 0;
+      learned_index_->GetRestartRange(ExtractUserKey(target), &first, &limit);
+      left = static_cast<int64_t>(first) - 1;
+      right = static_cast<int64_t>(limit) - 1;
+    }
+    if (value_delta_encoded_) {
+      ok = BinarySeek<DecodeKeyV4>(seek_key, left, right, &index,
+                                   &skip_linear_scan);
+    } else {
+      ok = BinarySeek<DecodeKey>(seek_key, left, right, &index,
+                                 &skip_linear_scan);
+    }
   }
 
   if (!ok) {
@@ -494,7 +596,7 @@ void DataBlockIter::SeekForPrevImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = BinarySeekRestarts(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -804,7 +906,8 @@ void BlockIter<TValue>::FindKeyAfterBinarySeek(const Slice& target,
 // compared again later.
 template <class TValue>
 template <typename DecodeKeyFunc>
-bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
+bool BlockIter<TValue>::BinarySeek(const Slice& target, int64_t left,
+                                   int64_t right, uint32_t* index,
                                    bool* skip_linear_scan) {
   if (restarts_ == 0) {
     // SST files dedicated to range tombstones are written with index blocks
@@ -823,7 +926,8 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
   //   keys.
   // - Any restart keys after index `right` are strictly greater than the target
   //   key.
-  int64_t left = -1, right = num_restarts_ - 1;
+  assert(left >= -1 && left <= right);
+  assert(right < static_cast<int64_t>(num_restarts_));
   while (left != right) {
     // The `mid` is computed by rounding up so it lands in (`left`, `right`].
     int64_t mid = left + (right - left + 1) / 2;
@@ -1006,6 +1110,12 @@ uint32_t Block::NumRestarts() const {
     // Such check is for backward compatibility. We can ensure legacy block
     // with a vary large num_restarts i.e. >= 0x80000000 can be interpreted
     // correctly as no HashIndex even if the MSB of num_restarts is set.
+    //
+    // The restart key prefixes and entity columns bits are never set in legacy
+    // blocks, and blocks that have them never set the MSB.
+    if (HasRestartKeyPrefixes() || HasEntityColumns()) {
+      UnPackIndexTypeAndNumRestarts(block_footer, nullptr, &num_restarts);
+    }
     return num_restarts;
   }
   BlockBasedTableOptions::DataBlockIndexType index_type;
@@ -1013,6 +1123,24 @@ uint32_t Block::NumRestarts() const {
   return num_restarts;
 }
 
+bool Block::HasRestartKeyPrefixes() const {
+  assert(size_ >= 2 * sizeof(uint32_t));
+  uint32_t block_footer = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  bool has_restart_key_prefixes = false;
+  UnPackIndexTypeAndNumRestarts(block_footer, nullptr, nullptr,
+                                &has_restart_key_prefixes);
+  return has_restart_key_prefixes;
+}
+
+bool Block::HasEntityColumns() const {
+  assert(size_ >= 2 * sizeof(uint32_t));
+  uint32_t block_footer = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  bool has_entity_columns = false;
+  UnPackIndexTypeAndNumRestarts(block_footer, nullptr, nullptr, nullptr,
+                                &has_entity_columns);
+  return has_entity_columns;
+}
+
 BlockBasedTableOptions::DataBlockIndexType Block::IndexType() const {
   assert(size_ >= 2 * sizeof(uint32_t));
   if (size_ > kMaxBlockSizeSupportedByHashIndex) {
@@ -1046,15 +1174,16 @@ Block::Block(BlockContents&& contents, size_t read_amp_bytes_per_bit,
   } else {
     // Should only decode restart points for uncompressed blocks
     num_restarts_ = NumRestarts();
+    const uint64_t restart_key_prefixes_size =
+        HasRestartKeyPrefixes()
+            ? uint64_t{num_restarts_} * kRestartKeyPrefixSize
+            : 0;
+    // The restart array, followed by the restart key prefixes and the entity
+    // columns if any, ends where the hash index (or the footer) starts
+    uint32_t restarts_end = 0;
     switch (IndexType()) {
       case BlockBasedTableOptions::kDataBlockBinarySearch:
-        restart_offset_ = static_cast<uint32_t>(size_) -
-                          (1 + num_restarts_) * sizeof(uint32_t);
-        if (restart_offset_ > size_ - sizeof(uint32_t)) {
-          // The size is too small for NumRestarts() and therefore
-          // restart_offset_ wrapped around.
-          size_ = 0;
-        }
+        restarts_end = static_cast<uint32_t>(size_ - sizeof(uint32_t));
         break;
       case BlockBasedTableOptions::kDataBlockBinaryAndHash:
         if (size_ < sizeof(uint32_t) /* block footer */ +
@@ -1068,19 +1197,36 @@ Block::Block(BlockContents&& contents, size_t read_amp_bytes_per_bit,
             data_, static_cast<uint16_t>(size_ - sizeof(uint32_t)), /*chop off
                                                                 NUM_RESTARTS*/
             &map_offset);
-
-        restart_offset_ = map_offset - num_restarts_ * sizeof(uint32_t);
-
-        if (restart_offset_ > map_offset) {
-          // map_offset is too small for NumRestarts() and
-          // therefore restart_offset_ wrapped around.
-          size_ = 0;
-          break;
-        }
+        restarts_end = map_offset;
         break;
       default:
         size_ = 0;  // Error marker
     }
+    if (size_ != 0 && HasEntityColumns()) {
+      std::unique_ptr<DataBlockColumns> columns(new DataBlockColumns());
+      uint32_t columns_offset = 0;
+      if (columns->Initialize(data_, restarts_end, &columns_offset)) {
+        data_block_columns_ = std::move(columns);
+        restarts_end = columns_offset;
+      } else {
+        size_ = 0;
+      }
+    }
+    if (size_ != 0) {
+      if (restart_key_prefixes_size +
+              uint64_t{num_restarts_} * sizeof(uint32_t) >
+          restarts_end) {
+        // The size is too small for NumRestarts()
+        size_ = 0;
+      } else {
+        restart_offset_ = restarts_end - num_restarts_ * sizeof(uint32_t) -
+                          static_cast<uint32_t>(restart_key_prefixes_size);
+      }
+    }
+    if (size_ != 0 && restart_key_prefixes_size > 0) {
+      restart_key_prefixes_ =
+          data_ + restart_offset_ + num_restarts_ * sizeof(uint32_t);
+    }
   }
   if (read_amp_bytes_per_bit != 0 && statistics && size_ != 0) {
     read_amp_bitmap_.reset(new BlockReadAmpBitmap(
@@ -1117,7 +1263,7 @@ void Block::InitializeDataBlockProtectionInfo(uint8_t protection_bytes_per_key,
       iter->SeekToFirst();
       while (iter->Valid()) {
         GenerateKVChecksum(kv_checksum_ + i, protection_bytes_per_key,
-                           iter->key(), iter->value());
+                           iter->key(), iter->raw_value());
         iter->Next();
         i += protection_bytes_per_key;
       }
@@ -1255,7 +1401,8 @@ DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
         read_amp_bitmap_.get(), block_contents_pinned,
         user_defined_timestamps_persisted,
         data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr,
-        protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
+        protection_bytes_per_key_, kv_checksum_, block_restart_interval_,
+        restart_key_prefixes_, data_block_columns_.get());
     if (read_amp_bitmap_) {
       if (read_amp_bitmap_->GetStatistics() != stats) {
         // DB changed the Statistics pointer, we need to notify read_amp_bitmap_
@@ -1272,7 +1419,7 @@ IndexBlockIter* Block::NewIndexIterator(
     IndexBlockIter* iter, Statistics* /*stats*/, bool total_order_seek,
     bool have_first_key, bool key_includes_seq, bool value_is_full,
     bool block_contents_pinned, bool user_defined_timestamps_persisted,
-    BlockPrefixIndex* prefix_index) {
+    BlockPrefixIndex* prefix_index, const LearnedIndexModel* learned_index) {
   IndexBlockIter* ret_iter;
   if (iter != nullptr) {
     ret_iter = iter;
@@ -1290,11 +1437,17 @@ IndexBlockIter* Block::NewIndexIterator(
   } else {
     BlockPrefixIndex* prefix_index_ptr =
         total_order_seek ? nullptr : prefix_index;
+    // The model is only valid for the block it was trained on
+    if (learned_index != nullptr &&
+        learned_index->num_restarts() != num_restarts_) {
+      learned_index = nullptr;
+    }
     ret_iter->Initialize(
         raw_ucmp, data_, restart_offset_, num_restarts_, global_seqno,
         prefix_index_ptr, have_first_key, key_includes_seq, value_is_full,
         block_contents_pinned, user_defined_timestamps_persisted,
-        protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
+        protection_bytes_per_key_, kv_checksum_, block_restart_interval_,
+        learned_index);
   }
 
   return ret_iter;
@@ -1311,6 +1464,9 @@ size_t Block::ApproximateMemoryUsage() const {
     usage += read_amp_bitmap_->ApproximateMemoryUsage();
   }
   usage += checksum_size_;
+  if (data_block_columns_) {
+    usage += data_block_columns_->ApproximateMemoryUsage();
+  }
   return usage;
 }
 
@@ -23,6 +23,7 @@
 #include "rocksdb/statistics.h"
 #include "rocksdb/table.h"
 #include "table/block_based/block_prefix_index.h"
+#include "table/block_based/data_block_columns.h"
 #include "table/block_based/data_block_hash_index.h"
 #include "table/format.h"
 #include "table/internal_iterator.h"
@@ -39,6 +40,7 @@ class DataBlockIter;
 class IndexBlockIter;
 class MetaBlockIter;
 class BlockPrefixIndex;
+class LearnedIndexModel;
 
 // BlockReadAmpBitmap is a bitmap that map the ROCKSDB_NAMESPACE::Block data
 // bytes to a bitmap with ratio bytes_per_bit. Whenever we access a range of
@@ -171,6 +173,12 @@ class Block {
   bool own_bytes() const { return contents_.own_bytes(); }
 
   BlockBasedTableOptions::DataBlockIndexType IndexType() const;
+  // Whether the block stores a key prefix per restart point (see
+  // BlockBasedTableOptions::data_block_restart_key_prefixes)
+  bool HasRestartKeyPrefixes() const;
+  // Whether the block stores wide-column entities column-wise (see
+  // BlockBasedTableOptions::data_block_columnar_entities)
+  bool HasEntityColumns() const;
 
   // raw_ucmp is a raw (i.e., not wrapped by `UserComparatorWrapper`) user key
   // comparator.
@@ -239,7 +247,8 @@ class Block {
       bool have_first_key, bool key_includes_seq, bool value_is_full,
       bool block_contents_pinned = false,
       bool user_defined_timestamps_persisted = true,
-      BlockPrefixIndex* prefix_index = nullptr);
+      BlockPrefixIndex* prefix_index = nullptr,
+      const LearnedIndexModel* learned_index = nullptr);
 
   // Report an approximation of how much memory has been used.
   size_t ApproximateMemoryUsage() const;
@@ -281,6 +290,10 @@ class Block {
   size_t size_;              // contents_.data.size()
   uint32_t restart_offset_;  // Offset in data_ of restart array
   uint32_t num_restarts_;
+  // Array of num_restarts_ restart key prefixes, nullptr if the block has none
+  const char* restart_key_prefixes_ = nullptr;
+  // Column streams of the entities, nullptr if the block has none
+  std::unique_ptr<DataBlockColumns> data_block_columns_;
   std::unique_ptr<BlockReadAmpBitmap> read_amp_bitmap_;
   char* kv_checksum_{nullptr};
   uint32_t checksum_size_{0};
@@ -673,7 +686,18 @@ class BlockIter : public InternalIteratorBase<TValue> {
  protected:
   template <typename DecodeKeyFunc>
   inline bool BinarySeek(const Slice& target, uint32_t* index,
-                         bool* is_index_key_result);
+                         bool* is_index_key_result) {
+    return BinarySeek<DecodeKeyFunc>(target, -1,
+                                     static_cast<int64_t>(num_restarts_) - 1,
+                                     index, is_index_key_result);
+  }
+
+  // Same as above, only searches restart points in (`left`, `right`]. The
+  // caller guarantees that the restart key at `left` (if not -1) is less
+  // than `target` and the ones after `right` are greater than `target`.
+  template <typename DecodeKeyFunc>
+  inline bool BinarySeek(const Slice& target, int64_t left, int64_t right,
+                         uint32_t* index, bool* is_index_key_result);
 
   // Find the first key in restart interval `index` that is >= `target`.
   // If there is no such key, iterator is positioned at the first key in
@@ -700,7 +724,9 @@ class DataBlockIter final : public BlockIter<Slice> {
                   bool user_defined_timestamps_persisted,
                   DataBlockHashIndex* data_block_hash_index,
                   uint8_t protection_bytes_per_key, const char* kv_checksum,
-                  uint32_t block_restart_interval) {
+                  uint32_t block_restart_interval,
+                  const char* restart_key_prefixes = nullptr,
+                  const DataBlockColumns* data_block_columns = nullptr) {
     InitializeBase(raw_ucmp, data, restarts, num_restarts, global_seqno,
                    block_contents_pinned, user_defined_timestamps_persisted,
                    protection_bytes_per_key, kv_checksum,
@@ -709,9 +735,31 @@ class DataBlockIter final : public BlockIter<Slice> {
     read_amp_bitmap_ = read_amp_bitmap;
     last_bitmap_offset_ = current_ + 1;
     data_block_hash_index_ = data_block_hash_index;
+    // The prefixes are only written for keys without timestamps
+    restart_key_prefixes_ = ts_sz_ == 0 ? restart_key_prefixes : nullptr;
+    data_block_columns_ = data_block_columns;
+    rebuilt_value_offset_ = restarts_;
+  }
+
+  // Entities stored column-wise are rebuilt with only the columns in
+  // `projection` (unless it is null) when their value is read. The
+  // projection is kept when the iterator is re-initialized.
+  void SetColumnProjection(const std::vector<Slice>* projection) {
+    column_projection_ = projection;
+    rebuilt_value_offset_ = restarts_;
   }
 
   Slice value() const override {
+    Slice raw = raw_value();
+    if (IsColumnarEntity()) {
+      return RebuildEntity();
+    }
+    return raw;
+  }
+
+  // The value as stored in the block, without rebuilding entities stored
+  // column-wise
+  Slice raw_value() const {
     assert(Valid());
     if (read_amp_bitmap_ && current_ < restarts_ &&
         current_ != last_bitmap_offset_) {
@@ -722,6 +770,14 @@ class DataBlockIter final : public BlockIter<Slice> {
     return value_;
   }
 
+  bool IsValuePinned() const override {
+    return IsValueInBlock() && BlockIter::IsValuePinned();
+  }
+
+  // Whether the current value is stored in the block, rather than rebuilt
+  // from the column streams of the block into this iterator
+  bool IsValueInBlock() const { return !IsColumnarEntity(); }
+
   // Returns if `target` may exist.
   inline bool SeekForGet(const Slice& target) {
 #ifndef NDEBUG
@@ -785,8 +841,25 @@ class DataBlockIter final : public BlockIter<Slice> {
   int32_t prev_entries_idx_ = -1;
 
   DataBlockHashIndex* data_block_hash_index_;
+  const char* restart_key_prefixes_ = nullptr;
+  const DataBlockColumns* data_block_columns_ = nullptr;
+  const std::vector<Slice>* column_projection_ = nullptr;
+  // Entity rebuilt for the entry at rebuilt_value_offset_, if any
+  mutable std::string rebuilt_value_;
+  mutable uint32_t rebuilt_value_offset_ = 0;
+
+  bool IsColumnarEntity() const {
+    return data_block_columns_ != nullptr && Valid() &&
+           DataBlockColumns::IsColumnarEntry(value_) &&
+           ExtractValueType(raw_key_.GetInternalKey()) == kTypeWideColumnEntity;
+  }
+  Slice RebuildEntity() const;
 
   bool SeekForGetImpl(const Slice& target);
+  // Binary search for `target` over the restart points, first narrowed down
+  // with restart_key_prefixes_ if the block has them
+  bool BinarySeekRestarts(const Slice& target, uint32_t* index,
+                          bool* skip_linear_scan);
 };
 
 // Iterator over MetaBlocks.  MetaBlocks are similar to Data Blocks and
@@ -831,7 +904,8 @@ class MetaBlockIter final : public BlockIter<Slice> {
 
 class IndexBlockIter final : public BlockIter<IndexValue> {
  public:
-  IndexBlockIter() : BlockIter(), prefix_index_(nullptr) {}
+  IndexBlockIter()
+      : BlockIter(), prefix_index_(nullptr), learned_index_(nullptr) {}
 
   // key_includes_seq, default true, means that the keys are in internal key
   // format.
@@ -844,13 +918,15 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
                   bool value_is_full, bool block_contents_pinned,
                   bool user_defined_timestamps_persisted,
                   uint8_t protection_bytes_per_key, const char* kv_checksum,
-                  uint32_t block_restart_interval) {
+                  uint32_t block_restart_interval,
+                  const LearnedIndexModel* learned_index = nullptr) {
     InitializeBase(raw_ucmp, data, restarts, num_restarts,
                    kDisableGlobalSequenceNumber, block_contents_pinned,
                    user_defined_timestamps_persisted, protection_bytes_per_key,
                    kv_checksum, block_restart_interval);
     raw_key_.SetIsUserKey(!key_includes_seq);
     prefix_index_ = prefix_index;
+    learned_index_ = learned_index;
     value_delta_encoded_ = !value_is_full;
     have_first_key_ = have_first_key;
     if (have_first_key_ && global_seqno != kDisableGlobalSequenceNumber) {
@@ -920,6 +996,8 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
   bool value_delta_encoded_;
   bool have_first_key_;  // value includes first_internal_key
   BlockPrefixIndex* prefix_index_;
+  // Narrows the binary search of total order seeks if not null
+  const LearnedIndexModel* learned_index_;
   // Whether the value is delta encoded. In that case the value is assumed to be
   // BlockHandle. The first value in each restart interval is the full encoded
   // BlockHandle; the restart of encoded size part of the BlockHandle. The
@@ -26,6 +26,8 @@
 #include "cache/cache_helpers.h"
 #include "cache/cache_key.h"
 #include "cache/cache_reservation_manager.h"
+#include "db/adaptive_compression.h"
+#include "db/compression_dict_service.h"
 #include "db/dbformat.h"
 #include "index_builder.h"
 #include "logging/logging.h"
@@ -306,10 +308,20 @@ struct BlockBasedTableBuilder::Rep {
   std::atomic<uint64_t> sampled_output_slow_data_bytes;
   std::atomic<uint64_t> sampled_output_fast_data_bytes;
   CompressionOptions compression_opts;
-  std::unique_ptr<CompressionDict> compression_dict;
+  // Either owned by the file or the column family's shared dictionary, in
+  // which case props.compression_dict_id is set
+  std::shared_ptr<const CompressionDict> compression_dict;
   std::vector<std::unique_ptr<CompressionContext>> compression_ctxs;
   std::vector<std::unique_ptr<UncompressionContext>> verify_ctxs;
-  std::unique_ptr<UncompressionDict> verify_dict;
+  std::shared_ptr<const UncompressionDict> verify_dict;
+  // Set when shared compression dictionaries are enabled, for sampling data
+  // blocks and tracking the compression ratio
+  CompressionDictService* compression_dict_service = nullptr;
+  // Set when the compression was chosen by adaptive compression, which is
+  // reported the time spent compressing data blocks
+  AdaptiveCompressionSelector* adaptive_compression = nullptr;
+  int level_at_creation;
+  std::atomic<uint64_t> data_compression_nanos{0};
 
   size_t data_begin_offset = 0;
 
@@ -460,7 +472,12 @@ struct BlockBasedTableBuilder::Rep {
                        ? BlockBasedTableOptions::kDataBlockBinarySearch
                        : table_options.data_block_index_type,
                    table_options.data_block_hash_table_util_ratio, ts_sz,
-                   persist_user_defined_timestamps),
+                   persist_user_defined_timestamps, false /* is_user_key */,
+                   table_options.data_block_restart_key_prefixes &&
+                       tbo.internal_comparator.user_comparator() ==
+                           BytewiseComparator() &&
+                       ts_sz == 0,
+                   table_options.data_block_columnar_entities),
         range_del_block(
             1 /* block_restart_interval */, true /* use_delta_encoding */,
             false /* use_value_delta_encoding */,
@@ -480,6 +497,8 @@ struct BlockBasedTableBuilder::Rep {
         compression_ctxs(tbo.compression_opts.parallel_threads),
         verify_ctxs(tbo.compression_opts.parallel_threads),
         verify_dict(),
+        adaptive_compression(tbo.adaptive_compression),
+        level_at_creation(tbo.level_at_creation),
         state((tbo.compression_opts.max_dict_bytes > 0) ? State::kBuffered
                                                         : State::kUnbuffered),
         use_delta_encoding_for_index_values(table_opt.format_version >= 4 &&
@@ -525,6 +544,21 @@ struct BlockBasedTableBuilder::Rep {
       compression_dict_buffer_cache_res_mgr = nullptr;
     }
 
+    if (tbo.compression_dict_service != nullptr &&
+        CompressionDictService::IsEnabled(compression_type,
+                                          compression_opts)) {
+      compression_dict_service = tbo.compression_dict_service;
+      uint64_t dict_id = 0;
+      compression_dict = compression_dict_service->GetCurrentCompressionDict(
+          compression_type, compression_opts.level, &dict_id);
+      if (compression_dict != nullptr) {
+        // No need to buffer data blocks for training a dictionary
+        props.compression_dict_id = dict_id;
+        verify_dict = compression_dict_service->GetUncompressionDict(dict_id);
+        state = State::kUnbuffered;
+      }
+    }
+
     assert(compression_ctxs.size() >= compression_opts.parallel_threads);
     for (uint32_t i = 0; i < compression_opts.parallel_threads; i++) {
       compression_ctxs[i].reset(
@@ -1193,6 +1227,10 @@ void BlockBasedTableBuilder::CompressAndVerifyBlock(
     if (is_data_block) {
       r->compressible_input_data_bytes.fetch_add(uncompressed_block_data.size(),
                                                  std::memory_order_relaxed);
+      if (r->compression_dict_service != nullptr) {
+        r->compression_dict_service->AddSample(uncompressed_block_data,
+                                               r->compression_opts);
+      }
     }
     const CompressionDict* compression_dict;
     if (!is_data_block || r->compression_dict == nullptr) {
@@ -1207,10 +1245,19 @@ void BlockBasedTableBuilder::CompressAndVerifyBlock(
 
     std::string sampled_output_fast;
     std::string sampled_output_slow;
+    const bool measure_compression =
+        is_data_block && r->adaptive_compression != nullptr;
+    const uint64_t compression_start_nanos =
+        measure_compression ? r->ioptions.clock->NowNanos() : 0;
     *block_contents = CompressBlock(
         uncompressed_block_data, compression_info, type,
         r->table_options.format_version, is_data_block /* allow_sample */,
         compressed_output, &sampled_output_fast, &sampled_output_slow);
+    if (measure_compression) {
+      r->data_compression_nanos.fetch_add(
+          r->ioptions.clock->NowNanos() - compression_start_nanos,
+          std::memory_order_relaxed);
+    }
 
     if (sampled_output_slow.size() > 0 || sampled_output_fast.size() > 0) {
       // Currently compression sampling is only enabled for data block.
@@ -1744,6 +1791,9 @@ void BlockBasedTableBuilder::WritePropertiesBlock(
 
 void BlockBasedTableBuilder::WriteCompressionDictBlock(
     MetaIndexBuilder* meta_index_builder) {
+  // A shared dictionary is also stored in the file, for readers that have no
+  // access to the column family's dictionaries (e.g. RepairDB or
+  // SstFileReader)
   if (rep_->compression_dict != nullptr &&
       rep_->compression_dict->GetRawDict().size()) {
     BlockHandle compression_dict_block_handle;
@@ -1981,6 +2031,18 @@ Status BlockBasedTableBuilder::Finish() {
   }
 
   r->props.tail_start_offset = r->offset;
+  if (ok() && r->props.compression_dict_id != 0) {
+    r->compression_dict_service->RecordCompression(
+        r->props.compression_dict_id,
+        r->compressible_input_data_bytes + r->uncompressible_input_data_bytes,
+        r->props.data_size, r->compression_opts);
+  }
+  if (ok() && r->adaptive_compression != nullptr) {
+    r->adaptive_compression->Record(
+        r->level_at_creation, r->compression_type, r->compression_opts.level,
+        r->compressible_input_data_bytes + r->uncompressible_input_data_bytes,
+        r->props.data_size, r->data_compression_nanos.load());
+  }
 
   // Write meta blocks, metaindex block and footer in the following order.
   //    1. [meta block: filter]
@@ -27,6 +27,7 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
   is_out_of_bound_ = false;
   is_at_first_key_from_index_ = false;
   seek_stat_state_ = kNone;
+  data_blocks_since_seek_ = 0;
   bool filter_checked = false;
   if (target &&
       !CheckPrefixMayMatch(*target, IterDirection::kForward, &filter_checked)) {
@@ -42,6 +43,17 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
                                             ? LAST_LEVEL_SEEK_FILTER_MATCH
                                             : NON_LAST_LEVEL_SEEK_FILTER_MATCH);
   }
+  if (target && check_range_filter_ &&
+      !table_->KeyRangeMayMatch(*target, read_options_, &lookup_context_)) {
+    // No key in [target, iterate_upper_bound) in this table. We don't set
+    // is_out_of_bound_ since the table may have no keys >= target at all, in
+    // which case the upper level iterator should move to the next file.
+    ResetDataIter();
+    RecordTick(table_->GetStatistics(), is_last_level_
+                                            ? LAST_LEVEL_SEEK_FILTERED
+                                            : NON_LAST_LEVEL_SEEK_FILTERED);
+    return;
+  }
 
   bool need_seek_index = true;
   if (block_iter_points_to_real_block_ && block_iter_.Valid()) {
@@ -154,6 +166,7 @@ void BlockBasedTableIterator::SeekForPrev(const Slice& target) {
   is_out_of_bound_ = false;
   is_at_first_key_from_index_ = false;
   seek_stat_state_ = kNone;
+  data_blocks_since_seek_ = 0;
   bool filter_checked = false;
   // For now totally disable prefix seek in auto prefix mode because we don't
   // have logic
@@ -225,6 +238,7 @@ void BlockBasedTableIterator::SeekToLast() {
   is_out_of_bound_ = false;
   is_at_first_key_from_index_ = false;
   seek_stat_state_ = kNone;
+  data_blocks_since_seek_ = 0;
   SavePrevIndexValue();
   index_iter_->SeekToLast();
   if (!index_iter_->Valid()) {
@@ -287,6 +301,7 @@ void BlockBasedTableIterator::InitDataBlock() {
       ResetDataIter();
     }
     auto* rep = table_->get_rep();
+    ++data_blocks_since_seek_;
 
     bool is_for_compaction =
         lookup_context_.caller == TableReaderCaller::kCompaction;
@@ -299,11 +314,31 @@ void BlockBasedTableIterator::InitDataBlock() {
         rep, data_block_handle, read_options_.readahead_size, is_for_compaction,
         /*no_sequential_checking=*/false, read_options_);
     Status s;
-    table_->NewDataBlockIterator<DataBlockIter>(
-        read_options_, data_block_handle, &block_iter_, BlockType::kData,
-        /*get_context=*/nullptr, &lookup_context_,
-        block_prefetcher_.prefetch_buffer(),
-        /*for_compaction=*/is_for_compaction, /*async_read=*/false, s);
+    std::unique_ptr<Block_kData> block;
+    if (decompressor_ != nullptr &&
+        decompressor_->Take(data_block_handle, &block)) {
+      // The block was read from the readahead buffer ahead of time, so let
+      // the buffer know the scan went past it
+      FilePrefetchBuffer* prefetch_buffer = block_prefetcher_.prefetch_buffer();
+      if (prefetch_buffer != nullptr) {
+        prefetch_buffer->UpdateReadPattern(
+            data_block_handle.offset(),
+            BlockBasedTable::BlockSizeWithTrailer(data_block_handle),
+            /*decrease_readaheadsize=*/false);
+      }
+      TEST_SYNC_POINT(
+          "BlockBasedTableIterator::InitDataBlock:DecompressedAhead");
+      CachableEntry<Block> block_entry;
+      block_entry.As<Block_kData>().SetOwnedValue(std::move(block));
+      table_->NewDataBlockIterator<DataBlockIter>(read_options_, block_entry,
+                                                  &block_iter_, s);
+    } else {
+      table_->NewDataBlockIterator<DataBlockIter>(
+          read_options_, data_block_handle, &block_iter_, BlockType::kData,
+          /*get_context=*/nullptr, DataBlockLookupContext(),
+          block_prefetcher_.prefetch_buffer(),
+          /*for_compaction=*/is_for_compaction, /*async_read=*/false, s);
+    }
     block_iter_points_to_real_block_ = true;
     CheckDataBlockWithinUpperBound();
     if (!is_for_compaction &&
@@ -330,6 +365,7 @@ void BlockBasedTableIterator::AsyncInitDataBlock(bool is_first_pass) {
         ResetDataIter();
       }
       auto* rep = table_->get_rep();
+      ++data_blocks_since_seek_;
       // Prefetch additional data for range scans (iterators).
       // Implicit auto readahead:
       //   Enabled after 2 sequential IOs when ReadOptions.readahead_size == 0.
@@ -347,7 +383,7 @@ void BlockBasedTableIterator::AsyncInitDataBlock(bool is_first_pass) {
       Status s;
       table_->NewDataBlockIterator<DataBlockIter>(
           read_options_, data_block_handle, &block_iter_, BlockType::kData,
-          /*get_context=*/nullptr, &lookup_context_,
+          /*get_context=*/nullptr, DataBlockLookupContext(),
           block_prefetcher_.prefetch_buffer(),
           /*for_compaction=*/is_for_compaction, /*async_read=*/true, s);
 
@@ -362,7 +398,7 @@ void BlockBasedTableIterator::AsyncInitDataBlock(bool is_first_pass) {
     Status s;
     table_->NewDataBlockIterator<DataBlockIter>(
         read_options_, data_block_handle, &block_iter_, BlockType::kData,
-        /*get_context=*/nullptr, &lookup_context_,
+        /*get_context=*/nullptr, DataBlockLookupContext(),
         block_prefetcher_.prefetch_buffer(),
         /*for_compaction=*/is_for_compaction, /*async_read=*/false, s);
   }
@@ -466,10 +502,100 @@ void BlockBasedTableIterator::FindBlockForward() {
     }
 
     InitDataBlock();
+    DecompressAhead();
     block_iter_.SeekToFirst();
   } while (!block_iter_.Valid());
 }
 
+bool BlockBasedTableIterator::MaybeCreateDecompressor() {
+  if (decompressor_ != nullptr) {
+    return true;
+  }
+  if (decompressor_checked_) {
+    return false;
+  }
+  decompressor_checked_ = true;
+  auto* rep = table_->get_rep();
+  // Blocks decompressed ahead of time bypass the block cache, and async reads
+  // may replace the readahead buffer under our feet
+  if (read_options_.decompression_threads == 0 || read_options_.fill_cache ||
+      read_options_.async_io || !rep->blocks_maybe_compressed) {
+    return false;
+  }
+  if (rep->uncompression_dict_reader) {
+    Status s =
+        rep->uncompression_dict_reader->GetOrReadUncompressionDictionary(
+            /*prefetch_buffer=*/nullptr, read_options_,
+            read_options_.read_tier == kBlockCacheTier,
+            read_options_.verify_checksums, /*get_context=*/nullptr,
+            &lookup_context_, &decompression_dict_);
+    if (!s.ok()) {
+      return false;
+    }
+  }
+  decompress_index_iter_.reset(table_->NewIndexIterator(
+      read_options_, need_upper_bound_check_, /*input_iter=*/nullptr,
+      /*get_context=*/nullptr, &lookup_context_));
+  decompressor_.reset(new ParallelBlockDecompressor(
+      table_,
+      decompression_dict_.GetValue() != nullptr
+          ? *decompression_dict_.GetValue()
+          : UncompressionDict::GetEmptyDict(),
+      read_options_.decompression_threads, read_options_.verify_checksums));
+  return true;
+}
+
+void BlockBasedTableIterator::DecompressAhead() {
+  FilePrefetchBuffer* prefetch_buffer = block_prefetcher_.prefetch_buffer();
+  if (prefetch_buffer == nullptr || !block_iter_points_to_real_block_ ||
+      !block_iter_.status().ok() || !MaybeCreateDecompressor()) {
+    return;
+  }
+  InternalIteratorBase<IndexValue>* iter = decompress_index_iter_.get();
+  if (decompressor_->empty()) {
+    // Catch up with the current block. Normally it is right after the last
+    // block handed to the decompressor, otherwise (e.g. after a seek) look
+    // it up.
+    const BlockHandle current = index_iter_->value().handle;
+    if (iter->Valid() && iter->value().handle.offset() +
+                                 BlockBasedTable::BlockSizeWithTrailer(
+                                     iter->value().handle) ==
+                             current.offset()) {
+      iter->Next();
+    }
+    if (!iter->Valid() || iter->value().handle.offset() != current.offset()) {
+      iter->Seek(index_iter_->key());
+      if (!iter->Valid() ||
+          iter->value().handle.offset() != current.offset()) {
+        return;
+      }
+    }
+  }
+  while (decompressor_->HasRoom() && iter->Valid()) {
+    if (read_options_.iterate_upper_bound != nullptr &&
+        user_comparator_.CompareWithoutTimestamp(
+            *read_options_.iterate_upper_bound, /*a_has_ts=*/false,
+            iter->user_key(), /*b_has_ts=*/true) <= 0) {
+      // The following blocks are out of bound
+      break;
+    }
+    iter->Next();
+    if (!iter->Valid()) {
+      break;
+    }
+    const BlockHandle handle = iter->value().handle;
+    Slice serialized_block;
+    if (!prefetch_buffer->TryPeekFromBuffer(
+            handle.offset(), BlockBasedTable::BlockSizeWithTrailer(handle),
+            &serialized_block)) {
+      // Not read ahead yet
+      iter->Prev();
+      break;
+    }
+    decompressor_->Schedule(handle, serialized_block);
+  }
+}
+
 void BlockBasedTableIterator::FindKeyBackward() {
   while (!block_iter_.Valid()) {
     if (!block_iter_.status().ok()) {
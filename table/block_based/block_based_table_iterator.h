@@ -10,6 +10,7 @@
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_based_table_reader_impl.h"
 #include "table/block_based/block_prefetcher.h"
+#include "table/block_based/parallel_block_decompressor.h"
 #include "table/block_based/reader_common.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -25,7 +26,8 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
       std::unique_ptr<InternalIteratorBase<IndexValue>>&& index_iter,
       bool check_filter, bool need_upper_bound_check,
       const SliceTransform* prefix_extractor, TableReaderCaller caller,
-      size_t compaction_readahead_size = 0, bool allow_unprepared_value = false)
+      size_t compaction_readahead_size = 0, bool allow_unprepared_value = false,
+      bool check_range_filter = false)
       : index_iter_(std::move(index_iter)),
         table_(table),
         read_options_(read_options),
@@ -34,15 +36,26 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
         pinned_iters_mgr_(nullptr),
         prefix_extractor_(prefix_extractor),
         lookup_context_(caller),
+        long_scan_lookup_context_(caller == TableReaderCaller::kUserIterator
+                                      ? TableReaderCaller::kUserIteratorLongScan
+                                      : caller),
         block_prefetcher_(
             compaction_readahead_size,
             table_->get_rep()->table_options.initial_auto_readahead_size),
         allow_unprepared_value_(allow_unprepared_value),
         block_iter_points_to_real_block_(false),
         check_filter_(check_filter),
+        check_range_filter_(check_range_filter),
         need_upper_bound_check_(need_upper_bound_check),
         async_read_in_progress_(false),
-        is_last_level_(table->IsLastLevel()) {}
+        is_last_level_(table->IsLastLevel()) {
+    // Merge operands may need the columns outside of the projection, so it is
+    // only applied by the DB iterator then
+    if (read_options_.column_projection != nullptr &&
+        table_->get_rep()->ioptions.merge_operator == nullptr) {
+      block_iter_.SetColumnProjection(read_options_.column_projection);
+    }
+  }
 
   ~BlockBasedTableIterator() {}
 
@@ -142,9 +155,11 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
     assert(!is_at_first_key_from_index_);
     assert(Valid());
 
-    // BlockIter::IsValuePinned() is always true. No need to check
+    // The blocks are pinned through pinned_iters_mgr_, but the entities
+    // rebuilt from the column streams of a block live in the block iterator
+    // and are overwritten by the next one
     return pinned_iters_mgr_ && pinned_iters_mgr_->PinningEnabled() &&
-           block_iter_points_to_real_block_;
+           block_iter_points_to_real_block_ && block_iter_.IsValueInBlock();
   }
 
   void ResetDataIter() {
@@ -244,9 +259,24 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   const SliceTransform* prefix_extractor_;
   uint64_t prev_block_offset_ = std::numeric_limits<uint64_t>::max();
   BlockCacheLookupContext lookup_context_;
+  // Used for data blocks once a scan passes
+  // ReadOptions::scan_probation_threshold, so that they are inserted into the
+  // block cache with bottom priority.
+  BlockCacheLookupContext long_scan_lookup_context_;
+  // Data blocks loaded since the last seek
+  uint64_t data_blocks_since_seek_ = 0;
 
   BlockPrefetcher block_prefetcher_;
 
+  // Decompresses the data blocks following the current one ahead of time
+  // when ReadOptions::decompression_threads is set. Created on the first
+  // block transition of a forward scan that has a readahead buffer.
+  CachableEntry<UncompressionDict> decompression_dict_;
+  std::unique_ptr<ParallelBlockDecompressor> decompressor_;
+  // Positioned at the last block handed to decompressor_
+  std::unique_ptr<InternalIteratorBase<IndexValue>> decompress_index_iter_;
+  bool decompressor_checked_ = false;
+
   const bool allow_unprepared_value_;
   // True if block_iter_ is initialized and points to the same block
   // as index iterator.
@@ -260,6 +290,9 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   // that block yet. A call to PrepareValue() will trigger loading the block.
   bool is_at_first_key_from_index_ = false;
   bool check_filter_;
+  // Whether forward seeks consult the table's range filter (if any) for
+  // [target, iterate_upper_bound) before touching index and data blocks.
+  bool check_range_filter_;
   // TODO(Zhongyi): pick a better name
   bool need_upper_bound_check_;
 
@@ -273,6 +306,15 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
 
   void InitDataBlock();
   void AsyncInitDataBlock(bool is_first_pass);
+  bool MaybeCreateDecompressor();
+  void DecompressAhead();
+  BlockCacheLookupContext* DataBlockLookupContext() {
+    if (read_options_.scan_probation_threshold > 0 &&
+        data_blocks_since_seek_ > read_options_.scan_probation_threshold) {
+      return &long_scan_lookup_context_;
+    }
+    return &lookup_context_;
+  }
   bool MaterializeCurrentBlock();
   void FindKeyForward();
   void FindBlockForward();
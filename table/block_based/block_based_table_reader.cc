@@ -37,6 +37,7 @@
 #include "cache/cache_entry_roles.h"
 #include "cache/cache_key.h"
 #include "db/compaction/compaction_picker.h"
+#include "db/compression_dict_service.h"
 #include "db/dbformat.h"
 #include "db/pinned_iterators_manager.h"
 #include "file/file_prefetch_buffer.h"
@@ -71,6 +72,7 @@
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/full_filter_block.h"
 #include "table/block_based/hash_index_reader.h"
+#include "table/block_based/learned_index_reader.h"
 #include "table/block_based/partitioned_filter_block.h"
 #include "table/block_based/partitioned_index_reader.h"
 #include "table/block_fetcher.h"
@@ -86,6 +88,7 @@
 #include "test_util/sync_point.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/random.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
 
@@ -145,6 +148,7 @@ namespace ROCKSDB_NAMESPACE {
 extern const uint64_t kBlockBasedTableMagicNumber;
 extern const std::string kHashIndexPrefixesBlock;
 extern const std::string kHashIndexPrefixesMetadataBlock;
+extern const std::string kLearnedIndexModelBlock;
 
 BlockBasedTable::~BlockBasedTable() { delete rep_; }
 
@@ -593,7 +597,8 @@ Status BlockBasedTable::Open(
     size_t max_file_size_for_l0_meta_pin, const std::string& cur_db_session_id,
     uint64_t cur_file_num, UniqueId64x2 expected_unique_id,
     const bool user_defined_timestamps_persisted,
-    Cache::ItemOwnerId cache_owner_id) {
+    Cache::ItemOwnerId cache_owner_id,
+    CompressionDictService* compression_dict_service) {
   table_reader->reset();
 
   Status s;
@@ -657,9 +662,10 @@ Status BlockBasedTable::Open(
   Rep* rep = new BlockBasedTable::Rep(
       ioptions, env_options, table_options, internal_comparator, skip_filters,
       file_size, level, immortal_table, user_defined_timestamps_persisted,
-      cache_owner_id);
+      cache_owner_id, compression_dict_service);
   rep->file = std::move(file);
   rep->footer = footer;
+  rep->track_hot_blocks = ioptions.hot_blocks_persist_period_sec > 0;
 
   // For fully portable/stable cache keys, we need to read the properties
   // block before setting up cache keys. TODO: consider setting up a bootstrap
@@ -1172,7 +1178,19 @@ Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
     }
   }
 
-  if (!rep_->compression_dict_handle.IsNull()) {
+  // A file compressed with a shared dictionary of the column family uses the
+  // digested dictionary shared by all readers, and otherwise falls back to
+  // the copy stored in the file
+  std::shared_ptr<UncompressionDict> shared_dict;
+  const uint64_t dict_id =
+      rep_->table_properties ? rep_->table_properties->compression_dict_id : 0;
+  if (dict_id != 0 && rep_->compression_dict_service != nullptr) {
+    shared_dict = rep_->compression_dict_service->GetUncompressionDict(dict_id);
+  }
+  if (shared_dict != nullptr) {
+    UncompressionDictReader::CreateShared(this, std::move(shared_dict),
+                                          &rep_->uncompression_dict_reader);
+  } else if (!rep_->compression_dict_handle.IsNull()) {
     std::unique_ptr<UncompressionDictReader> uncompression_dict_reader;
     const bool pin_dict = table_options.pinning_policy->MayPin(
         pinning_options, TablePinningPolicy::kDictionary,
@@ -1187,6 +1205,9 @@ Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
     }
 
     rep_->uncompression_dict_reader = std::move(uncompression_dict_reader);
+  } else if (dict_id != 0) {
+    return Status::Corruption("Unknown shared compression dictionary " +
+                              std::to_string(dict_id));
   }
 
   assert(s.ok());
@@ -1337,7 +1358,8 @@ WithBlocklikeCheck<Status, TBlocklike> BlockBasedTable::PutDataBlockToCache(
     CachableEntry<TBlocklike>* out_parsed_block, BlockContents&& block_contents,
     CompressionType block_comp_type,
     const UncompressionDict& uncompression_dict,
-    MemoryAllocator* memory_allocator, GetContext* get_context) const {
+    MemoryAllocator* memory_allocator, GetContext* get_context,
+    Cache::Priority priority) const {
   const ImmutableOptions& ioptions = rep_->ioptions;
   const uint32_t format_version = rep_->table_options.format_version;
   assert(out_parsed_block);
@@ -1370,7 +1392,7 @@ WithBlocklikeCheck<Status, TBlocklike> BlockBasedTable::PutDataBlockToCache(
     size_t charge = block_holder->ApproximateMemoryUsage();
     BlockCacheTypedHandle<TBlocklike>* cache_handle = nullptr;
     s = block_cache.InsertFull(cache_key, block_holder.get(), charge,
-                               &cache_handle, GetCachePriority<TBlocklike>(),
+                               &cache_handle, priority,
                                rep_->ioptions.lowest_used_cache_tier,
                                rep_->cache_owner_id);
 
@@ -1501,6 +1523,10 @@ BlockBasedTable::MaybeReadBlockAndLoadToCache(
         // TODO(haoyu): Differentiate cache hit on uncompressed block cache and
         // compressed block cache.
         is_cache_hit = true;
+        if (TBlocklike::kBlockType == BlockType::kData &&
+            rep_->track_hot_blocks) {
+          RecordHotBlockHit(handle);
+        }
         if (prefetch_buffer) {
           // Update the block details so that PrefetchBuffer can use the read
           // pattern to determine if reads are sequential or not for
@@ -1569,12 +1595,20 @@ BlockBasedTable::MaybeReadBlockAndLoadToCache(
       }
 
       if (s.ok()) {
+        // Data blocks of long scans are probationary: they go to the bottom
+        // of the cache and are evicted first unless they are used again.
+        Cache::Priority priority = GetCachePriority<TBlocklike>();
+        if (TBlocklike::kBlockType == BlockType::kData && lookup_context &&
+            lookup_context->caller ==
+                TableReaderCaller::kUserIteratorLongScan) {
+          priority = Cache::Priority::BOTTOM;
+        }
         // If filling cache is allowed and a cache is configured, try to put the
         // block to the cache.
         s = PutDataBlockToCache(
             key, block_cache, out_parsed_block, std::move(*contents),
             contents_comp_type, uncompression_dict,
-            GetMemoryAllocator(rep_->table_options), get_context);
+            GetMemoryAllocator(rep_->table_options), get_context, priority);
       }
     }
   }
@@ -1847,6 +1881,32 @@ bool BlockBasedTable::PrefixRangeMayMatch(
   return may_match;
 }
 
+bool BlockBasedTable::KeyRangeMayMatch(
+    const Slice& internal_key, const ReadOptions& read_options,
+    BlockCacheLookupContext* lookup_context) const {
+  if (read_options.iterate_upper_bound == nullptr ||
+      rep_->filter_type != Rep::FilterType::kFullFilter ||
+      !rep_->whole_key_filtering || rep_->filter_policy == nullptr ||
+      !rep_->filter_policy->SupportsRangeQueries()) {
+    return true;
+  }
+  // The range filter orders keys bytewise and is built on user keys without
+  // timestamps
+  const Comparator* const ucmp = rep_->internal_comparator.user_comparator();
+  if (ucmp->timestamp_size() != 0 || ucmp != BytewiseComparator()) {
+    return true;
+  }
+
+  FilterBlockReader* const filter = rep_->filter.get();
+  if (filter == nullptr) {
+    return true;
+  }
+  const bool no_io = read_options.read_tier == kBlockCacheTier;
+  return filter->KeyRangeMayMatch(ExtractUserKey(internal_key),
+                                  *read_options.iterate_upper_bound, no_io,
+                                  lookup_context, read_options);
+}
+
 bool BlockBasedTable::PrefixExtractorChanged(
     const SliceTransform* prefix_extractor) const {
   if (prefix_extractor == nullptr) {
@@ -1884,7 +1944,8 @@ InternalIterator* BlockBasedTable::NewIterator(
         !skip_filters && !read_options.total_order_seek &&
             prefix_extractor != nullptr,
         need_upper_bound_check, prefix_extractor, caller,
-        compaction_readahead_size, allow_unprepared_value);
+        compaction_readahead_size, allow_unprepared_value,
+        /*check_range_filter=*/!skip_filters);
   } else {
     auto* mem = arena->AllocateAligned(
         sizeof(BlockBasedTableIterator),
@@ -1894,7 +1955,8 @@ InternalIterator* BlockBasedTable::NewIterator(
         !skip_filters && !read_options.total_order_seek &&
             prefix_extractor != nullptr,
         need_upper_bound_check, prefix_extractor, caller,
-        compaction_readahead_size, allow_unprepared_value);
+        compaction_readahead_size, allow_unprepared_value,
+        /*check_range_filter=*/!skip_filters);
   }
 }
 
@@ -2002,6 +2064,101 @@ void BlockBasedTable::FullFilterKeysMayMatch(
   }
 }
 
+namespace {
+// Only one in this many block cache hits is counted, to keep the mutex off
+// the common read path
+constexpr int kHotBlockSampleRate = 8;
+// Bounds the memory used for tracking per table
+constexpr size_t kMaxHotBlocksPerTable = 4096;
+// Hot blocks closer than this are read with a single I/O
+constexpr uint64_t kWarmUpMaxGap = 64 << 10;
+constexpr uint64_t kWarmUpMaxReadSize = 2 << 20;
+}  // namespace
+
+void BlockBasedTable::RecordHotBlockHit(const BlockHandle& handle) const {
+  if (!Random::GetTLSInstance()->OneIn(kHotBlockSampleRate)) {
+    return;
+  }
+  MutexLock l(&rep_->hot_blocks_mutex);
+  auto it = rep_->hot_blocks.find(handle.offset());
+  if (it != rep_->hot_blocks.end()) {
+    ++it->second.hits;
+  } else if (rep_->hot_blocks.size() < kMaxHotBlocksPerTable) {
+    rep_->hot_blocks.emplace(handle.offset(),
+                             HotBlock{handle.offset(), handle.size(), 1});
+  }
+}
+
+void BlockBasedTable::GetHotBlocks(std::vector<HotBlock>* blocks) const {
+  assert(blocks);
+  MutexLock l(&rep_->hot_blocks_mutex);
+  for (auto it = rep_->hot_blocks.begin(); it != rep_->hot_blocks.end();) {
+    blocks->push_back(it->second);
+    // Age the hits, so that blocks that are no longer read drop out
+    it->second.hits /= 2;
+    if (it->second.hits == 0) {
+      it = rep_->hot_blocks.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+Status BlockBasedTable::WarmUpBlocks(const ReadOptions& read_options,
+                                     const std::vector<HotBlock>& blocks) {
+  std::vector<BlockHandle> handles;
+  handles.reserve(blocks.size());
+  for (const auto& block : blocks) {
+    BlockHandle handle(block.offset, block.size);
+    // Skip anything that cannot be a block of this file
+    if (block.offset < rep_->file_size &&
+        BlockSizeWithTrailer(handle) <= rep_->file_size - block.offset) {
+      handles.push_back(handle);
+    }
+  }
+  std::sort(handles.begin(), handles.end(),
+            [](const BlockHandle& a, const BlockHandle& b) {
+              return a.offset() < b.offset();
+            });
+
+  std::unique_ptr<FilePrefetchBuffer> prefetch_buffer;
+  rep_->CreateFilePrefetchBuffer(
+      0 /* readahead_size */, 0 /* max_readahead_size */, &prefetch_buffer,
+      false /* implicit_auto_readahead */, 0 /* num_file_reads */,
+      0 /* num_file_reads_for_auto_readahead */, 0 /* upper_bound_offset */);
+  IOOptions opts;
+  Status s = rep_->file->PrepareIOOptions(read_options, opts);
+  BlockCacheLookupContext lookup_context{TableReaderCaller::kPrefetch};
+  size_t i = 0;
+  while (s.ok() && i < handles.size()) {
+    const uint64_t start = handles[i].offset();
+    uint64_t end = start + BlockSizeWithTrailer(handles[i]);
+    size_t next = i + 1;
+    while (next < handles.size() &&
+           handles[next].offset() <= end + kWarmUpMaxGap) {
+      const uint64_t next_end =
+          handles[next].offset() + BlockSizeWithTrailer(handles[next]);
+      if (next_end - start > kWarmUpMaxReadSize) {
+        break;
+      }
+      end = std::max(end, next_end);
+      ++next;
+    }
+    s = prefetch_buffer->Prefetch(opts, rep_->file.get(), start,
+                                  static_cast<size_t>(end - start));
+    for (; s.ok() && i < next; ++i) {
+      DataBlockIter biter;
+      Status tmp_status;
+      NewDataBlockIterator<DataBlockIter>(
+          read_options, handles[i], &biter, BlockType::kData,
+          /*get_context=*/nullptr, &lookup_context, prefetch_buffer.get(),
+          /*for_compaction=*/false, /*async_read=*/false, tmp_status);
+      s = biter.status();
+    }
+  }
+  return s;
+}
+
 Status BlockBasedTable::ApproximateKeyAnchors(const ReadOptions& read_options,
                                               std::vector<Anchor>& anchors) {
   // We iterator the whole index block here. More efficient implementation
@@ -2243,6 +2400,132 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& key,
   return s;
 }
 
+Status BlockBasedTable::PrepareAsyncGet(const ReadOptions& read_options,
+                                        const Slice& key,
+                                        const SliceTransform* prefix_extractor,
+                                        bool skip_filters,
+                                        AsyncBlockRead* block) {
+  assert(block != nullptr);
+  Cache* const cache = rep_->table_options.block_cache.get();
+  if (cache == nullptr) {
+    return Status::NotSupported("No block cache to load the block into");
+  }
+  if (!TimestampMayMatch(read_options)) {
+    return Status::OK();
+  }
+
+  FilterBlockReader* const filter =
+      !skip_filters ? rep_->filter.get() : nullptr;
+  BlockCacheLookupContext lookup_context{TableReaderCaller::kUserGet};
+  if (!FullFilterKeyMayMatch(filter, key, /*no_io=*/false, prefix_extractor,
+                             /*get_context=*/nullptr, &lookup_context,
+                             read_options)) {
+    return Status::OK();
+  }
+
+  IndexBlockIter iiter_on_stack;
+  bool need_upper_bound_check = false;
+  if (rep_->index_type == BlockBasedTableOptions::kHashSearch) {
+    need_upper_bound_check = PrefixExtractorChanged(prefix_extractor);
+  }
+  auto iiter =
+      NewIndexIterator(read_options, need_upper_bound_check, &iiter_on_stack,
+                       /*get_context=*/nullptr, &lookup_context);
+  std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
+  if (iiter != &iiter_on_stack) {
+    iiter_unique_ptr.reset(iiter);
+  }
+
+  // Same walk as Get(), except that the blocks are only looked up in the
+  // cache. The walk ends at the first block that is not cached, or at the
+  // first block past which Get() would not continue.
+  const UserComparatorWrapper ucmp(
+      rep_->internal_comparator.user_comparator());
+  const Slice user_key = ExtractUserKey(key);
+  for (iiter->Seek(key); iiter->Valid(); iiter->Next()) {
+    IndexValue v = iiter->value();
+    if (!v.first_internal_key.empty() && !skip_filters &&
+        ucmp.CompareWithoutTimestamp(
+            user_key, ExtractUserKey(v.first_internal_key)) < 0) {
+      break;
+    }
+    CacheKey cache_key = GetCacheKey(rep_->base_cache_key, v.handle);
+    Cache::Handle* const cache_handle = cache->Lookup(cache_key.AsSlice());
+    if (cache_handle == nullptr) {
+      block->table = this;
+      block->file = rep_->file.get();
+      block->offset = v.handle.offset();
+      block->len = static_cast<size_t>(BlockSizeWithTrailer(v.handle));
+      break;
+    }
+    cache->Release(cache_handle);
+    const Slice index_user_key = rep_->index_key_includes_seq
+                                     ? ExtractUserKey(iiter->key())
+                                     : iiter->key();
+    if (ucmp.CompareWithoutTimestamp(index_user_key, user_key) > 0) {
+      // The key cannot be in the following blocks
+      break;
+    }
+  }
+  Status s = iiter->status();
+  if (s.IsNotFound()) {
+    s = Status::OK();
+  }
+  return s;
+}
+
+Status BlockBasedTable::CompleteAsyncGet(const ReadOptions& read_options,
+                                         AsyncBlockRead* block) {
+  assert(block != nullptr);
+  assert(block->len > 0);
+  const BlockHandle handle(block->offset, block->len - kBlockTrailerSize);
+  if (block->result.size() != block->len) {
+    return Status::Corruption("Truncated block read from " +
+                              rep_->file->file_name());
+  }
+  if (block->result.data() != block->buf.get()) {
+    memcpy(block->buf.get(), block->result.data(), block->len);
+  }
+  Status s;
+  if (read_options.verify_checksums) {
+    PERF_TIMER_GUARD(block_checksum_time);
+    s = VerifyBlockChecksum(rep_->footer, block->buf.get(), handle.size(),
+                            rep_->file->file_name(), handle.offset());
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  BlockCacheLookupContext lookup_context{TableReaderCaller::kUserGet};
+  CachableEntry<UncompressionDict> uncompression_dict;
+  if (rep_->uncompression_dict_reader) {
+    s = rep_->uncompression_dict_reader->GetOrReadUncompressionDictionary(
+        /*prefetch_buffer=*/nullptr, read_options, /*no_io=*/false,
+        read_options.verify_checksums, /*get_context=*/nullptr,
+        &lookup_context, &uncompression_dict);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  ReadOptions ro = read_options;
+  ro.read_tier = kReadAllTier;
+  ro.fill_cache = true;
+  BlockContents contents(std::move(block->buf), handle.size());
+#ifndef NDEBUG
+  contents.has_trailer = true;
+#endif
+  CachableEntry<Block_kData> block_entry;
+  s = MaybeReadBlockAndLoadToCache(
+      /*prefetch_buffer=*/nullptr, ro, handle,
+      uncompression_dict.GetValue() != nullptr
+          ? *uncompression_dict.GetValue()
+          : UncompressionDict::GetEmptyDict(),
+      /*for_compaction=*/false, &block_entry, /*get_context=*/nullptr,
+      &lookup_context, &contents, /*async_read=*/false);
+  return s;
+}
+
 Status BlockBasedTable::MultiGetFilter(const ReadOptions& read_options,
                                        const SliceTransform* prefix_extractor,
                                        MultiGetRange* mget_range) {
@@ -2441,6 +2724,10 @@ BlockType BlockBasedTable::GetBlockTypeForMetaBlockByName(
     return BlockType::kHashIndexMetadata;
   }
 
+  if (meta_block_name == kLearnedIndexModelBlock) {
+    return BlockType::kLearnedIndexModel;
+  }
+
   if (meta_block_name == kIndexBlockName) {
     return BlockType::kIndex;
   }
@@ -2590,6 +2877,11 @@ Status BlockBasedTable::CreateIndexReader(
                                        lookup_context, index_reader);
       }
     }
+    case BlockBasedTableOptions::kLearnedSearch: {
+      return LearnedIndexReader::Create(this, ro, tpo, prefetch_buffer,
+                                        meta_iter, use_cache, prefetch, pin,
+                                        lookup_context, index_reader);
+    }
     default: {
       std::string error_message =
           "Unrecognized index type: " + std::to_string(rep_->index_type);
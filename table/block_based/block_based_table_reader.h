@@ -25,12 +25,14 @@
 
 #include <cstdint>
 #include <memory>
+#include <unordered_map>
 
 #include "cache/cache_entry_roles.h"
 #include "cache/cache_key.h"
 #include "cache/cache_reservation_manager.h"
 #include "db/range_tombstone_fragmenter.h"
 #include "file/filename.h"
+#include "port/port.h"
 #include "rocksdb/slice_transform.h"
 #include "rocksdb/table_properties.h"
 #include "table/block_based/block.h"
@@ -52,6 +54,7 @@
 namespace ROCKSDB_NAMESPACE {
 
 class Cache;
+class CompressionDictService;
 class FilterBlockReader;
 class FullFilterBlockReader;
 class Footer;
@@ -129,7 +132,8 @@ class BlockBasedTable : public TableReader {
       const std::string& cur_db_session_id = "", uint64_t cur_file_num = 0,
       UniqueId64x2 expected_unique_id = {},
       const bool user_defined_timestamps_persisted = true,
-      Cache::ItemOwnerId cache_owner_id = Cache::kUnknownItemOwnerId);
+      Cache::ItemOwnerId cache_owner_id = Cache::kUnknownItemOwnerId,
+      CompressionDictService* compression_dict_service = nullptr);
 
   bool PrefixRangeMayMatch(const Slice& internal_key,
                            const ReadOptions& read_options,
@@ -138,6 +142,16 @@ class BlockBasedTable : public TableReader {
                            BlockCacheLookupContext* lookup_context,
                            bool* filter_checked) const;
 
+  // Returns false only if the table's range filter (see
+  // FilterPolicy::SupportsRangeQueries()) guarantees that there is no key in
+  // [user key of `internal_key`, read_options.iterate_upper_bound). Returns
+  // true if the range can't be ruled out or no range filter is available.
+  //
+  // REQUIRES: this method shouldn't be called while the DB lock is held.
+  bool KeyRangeMayMatch(const Slice& internal_key,
+                        const ReadOptions& read_options,
+                        BlockCacheLookupContext* lookup_context) const;
+
   // Returns a new iterator over the table contents.
   // The result of NewIterator() is initially invalid (caller must
   // call one of the Seek methods on the iterator before using it).
@@ -170,6 +184,14 @@ class BlockBasedTable : public TableReader {
                                   const SliceTransform* prefix_extractor,
                                   bool skip_filters = false);
 
+  // Requires a block cache to load the block into
+  Status PrepareAsyncGet(const ReadOptions& read_options, const Slice& key,
+                         const SliceTransform* prefix_extractor,
+                         bool skip_filters, AsyncBlockRead* block) override;
+
+  Status CompleteAsyncGet(const ReadOptions& read_options,
+                          AsyncBlockRead* block) override;
+
   // Pre-fetch the disk blocks that correspond to the key range specified by
   // (kbegin, kend). The call will return error status in the event of
   // IO or iteration error.
@@ -196,6 +218,13 @@ class BlockBasedTable : public TableReader {
   Status ApproximateKeyAnchors(const ReadOptions& read_options,
                                std::vector<Anchor>& anchors) override;
 
+  void GetHotBlocks(std::vector<HotBlock>* blocks) const override;
+
+  // Reads the blocks in offset order, coalescing nearby blocks into larger
+  // reads
+  Status WarmUpBlocks(const ReadOptions& read_options,
+                      const std::vector<HotBlock>& blocks) override;
+
   bool TEST_BlockInCache(const BlockHandle& handle) const;
 
   // Returns true if the block for the specified key is in cache.
@@ -338,6 +367,7 @@ class BlockBasedTable : public TableReader {
   void operator=(const TableReader&) = delete;
 
  private:
+  friend class BlockBasedTableIterator;
   friend class MockedBlockBasedTable;
   friend class BlockBasedTableReaderTestVerifyChecksum_ChecksumMismatch_Test;
   BlockCacheTracer* const block_cache_tracer_;
@@ -371,6 +401,10 @@ class BlockBasedTable : public TableReader {
       GetContext* get_context, BlockCacheLookupContext* lookup_context,
       BlockContents* contents, bool async_read) const;
 
+  // Samples a block cache hit on the data block at handle, for the hot block
+  // list returned by GetHotBlocks()
+  void RecordHotBlockHit(const BlockHandle& handle) const;
+
   // Similar to the above, with one crucial difference: it will retrieve the
   // block from the file even if there are no caches configured (assuming the
   // read options allow I/O).
@@ -441,13 +475,15 @@ class BlockBasedTable : public TableReader {
   // PutDataBlockToCache(). After the call, the object will be invalid.
   // @param uncompression_dict Data for presetting the compression library's
   //    dictionary.
+  // @param priority Priority of the block in the block cache
   template <typename TBlocklike>
   WithBlocklikeCheck<Status, TBlocklike> PutDataBlockToCache(
       const Slice& cache_key, BlockCacheInterface<TBlocklike> block_cache,
       CachableEntry<TBlocklike>* cached_block, BlockContents&& block_contents,
       CompressionType block_comp_type,
       const UncompressionDict& uncompression_dict,
-      MemoryAllocator* memory_allocator, GetContext* get_context) const;
+      MemoryAllocator* memory_allocator, GetContext* get_context,
+      Cache::Priority priority) const;
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -574,7 +610,8 @@ struct BlockBasedTable::Rep {
       const InternalKeyComparator& _internal_comparator, bool skip_filters,
       uint64_t _file_size, int _level, const bool _immortal_table,
       const bool _user_defined_timestamps_persisted = true,
-      Cache::ItemOwnerId _cache_owner_id = Cache::kUnknownItemOwnerId)
+      Cache::ItemOwnerId _cache_owner_id = Cache::kUnknownItemOwnerId,
+      CompressionDictService* _compression_dict_service = nullptr)
       : ioptions(_ioptions),
         env_options(_env_options),
         table_options(_table_opt),
@@ -589,7 +626,8 @@ struct BlockBasedTable::Rep {
         level(_level),
         immortal_table(_immortal_table),
         user_defined_timestamps_persisted(_user_defined_timestamps_persisted),
-        cache_owner_id(_cache_owner_id) {}
+        cache_owner_id(_cache_owner_id),
+        compression_dict_service(_compression_dict_service) {}
   ~Rep() { status.PermitUncheckedError(); }
   const ImmutableOptions& ioptions;
   const EnvOptions& env_options;
@@ -681,9 +719,19 @@ struct BlockBasedTable::Rep {
 
   Cache::ItemOwnerId cache_owner_id = Cache::kUnknownItemOwnerId;
 
+  // Provides the shared compression dictionary of files that reference one
+  // (TableProperties::compression_dict_id)
+  CompressionDictService* compression_dict_service = nullptr;
+
   std::unique_ptr<CacheReservationManager::CacheReservationHandle>
       table_reader_cache_res_handle = nullptr;
 
+  // Sampled block cache hits of data blocks, keyed by offset. Only tracked
+  // when the DB persists its hot blocks (hot_blocks_persist_period_sec).
+  bool track_hot_blocks = false;
+  port::Mutex hot_blocks_mutex;
+  std::unordered_map<uint64_t, TableReader::HotBlock> hot_blocks;
+
   SequenceNumber get_global_seqno(BlockType block_type) const {
     return (block_type == BlockType::kFilterPartitionIndex ||
             block_type == BlockType::kCompressionDictionary)
@@ -714,25 +762,28 @@ struct BlockBasedTable::Rep {
                                 bool implicit_auto_readahead,
                                 uint64_t num_file_reads,
                                 uint64_t num_file_reads_for_auto_readahead,
-                                uint64_t upper_bound_offset) const {
+                                uint64_t upper_bound_offset,
+                                FilePrefetchBufferUsage usage =
+                                    FilePrefetchBufferUsage::kUnknown) const {
     fpb->reset(new FilePrefetchBuffer(
         readahead_size, max_readahead_size,
         !ioptions.allow_mmap_reads /* enable */, false /* track_min_offset */,
         implicit_auto_readahead, num_file_reads,
         num_file_reads_for_auto_readahead, upper_bound_offset,
-        ioptions.fs.get(), ioptions.clock, ioptions.stats));
+        ioptions.fs.get(), ioptions.clock, ioptions.stats, usage));
   }
 
   void CreateFilePrefetchBufferIfNotExists(
       size_t readahead_size, size_t max_readahead_size,
       std::unique_ptr<FilePrefetchBuffer>* fpb, bool implicit_auto_readahead,
       uint64_t num_file_reads, uint64_t num_file_reads_for_auto_readahead,
-      uint64_t upper_bound_offset) const {
+      uint64_t upper_bound_offset,
+      FilePrefetchBufferUsage usage = FilePrefetchBufferUsage::kUnknown) const {
     if (!(*fpb)) {
       CreateFilePrefetchBuffer(readahead_size, max_readahead_size, fpb,
                                implicit_auto_readahead, num_file_reads,
                                num_file_reads_for_auto_readahead,
-                               upper_bound_offset);
+                               upper_bound_offset, usage);
     }
   }
 
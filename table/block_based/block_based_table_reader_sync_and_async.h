@@ -497,7 +497,11 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
             continue;
           }
           if (!block_cache) {
-            total_len += BlockSizeWithTrailer(block_handles[i]);
+            if (no_io) {
+              statuses[i] = Status::Incomplete("no blocking io");
+            } else {
+              total_len += BlockSizeWithTrailer(block_handles[i]);
+            }
           } else {
             BCI::TypedHandle* h = async_handles[lookup_idx].Result();
             if (h) {
@@ -510,7 +514,12 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
                                     block_cache.get()->GetUsage(h));
             } else {
               // Cache miss
-              total_len += BlockSizeWithTrailer(block_handles[i]);
+              if (no_io) {
+                // Left unread, the key is reported as incomplete
+                statuses[i] = Status::Incomplete("no blocking io");
+              } else {
+                total_len += BlockSizeWithTrailer(block_handles[i]);
+              }
               UpdateCacheMissMetrics(BlockType::kData, get_context);
             }
             if (!data_lookup_contexts.empty()) {
@@ -640,6 +649,7 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
           // Update Saver.state to Found because we are only looking for
           // whether we can guarantee the key is not there when "no_io" is set
           get_context->MarkKeyMayExist();
+          s = biter->status();
           break;
         }
         if (!biter->status().ok()) {
@@ -706,8 +716,11 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
           if (!pik_status.ok()) {
             s = pik_status;
           }
-          if (!get_context->SaveValue(parsed_key, biter->value(), &matched,
-                                      value_pinner)) {
+          // Entities rebuilt from the column streams of the block are
+          // overwritten by the next one, so they are copied rather than pinned
+          if (!get_context->SaveValue(
+                  parsed_key, biter->value(), &matched,
+                  biter->IsValuePinned() ? value_pinner : nullptr)) {
             if (get_context->State() == GetContext::GetState::kFound) {
               does_referenced_key_exist = true;
               referenced_data_size =
@@ -49,12 +49,16 @@ BlockBuilder::BlockBuilder(
     bool use_value_delta_encoding,
     BlockBasedTableOptions::DataBlockIndexType index_type,
     double data_block_hash_table_util_ratio, size_t ts_sz,
-    bool persist_user_defined_timestamps, bool is_user_key)
+    bool persist_user_defined_timestamps, bool is_user_key,
+    bool store_restart_key_prefixes, bool columnar_entities)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       use_value_delta_encoding_(use_value_delta_encoding),
       strip_ts_sz_(persist_user_defined_timestamps ? 0 : ts_sz),
       is_user_key_(is_user_key),
+      store_restart_key_prefixes_(store_restart_key_prefixes && ts_sz == 0),
+      columnar_entities_(columnar_entities && !is_user_key &&
+                         !use_value_delta_encoding),
       restarts_(1, 0),  // First restart point is at offset 0
       counter_(0),
       finished_(false) {
@@ -70,19 +74,27 @@ BlockBuilder::BlockBuilder(
   }
   assert(block_restart_interval_ >= 1);
   estimate_ = sizeof(uint32_t) + sizeof(uint32_t);
+  if (store_restart_key_prefixes_) {
+    estimate_ += kRestartKeyPrefixSize;
+  }
 }
 
 void BlockBuilder::Reset() {
   buffer_.clear();
   restarts_.resize(1);  // First restart point is at offset 0
   assert(restarts_[0] == 0);
+  restart_key_prefixes_.clear();
   estimate_ = sizeof(uint32_t) + sizeof(uint32_t);
+  if (store_restart_key_prefixes_) {
+    estimate_ += kRestartKeyPrefixSize;
+  }
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
   if (data_block_hash_index_builder_.Valid()) {
     data_block_hash_index_builder_.Reset();
   }
+  data_block_columns_builder_.Reset();
 #ifndef NDEBUG
   add_with_last_key_called_ = false;
 #endif
@@ -111,6 +123,9 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key,
 
   if (counter_ >= block_restart_interval_) {
     estimate += sizeof(uint32_t);  // a new restart entry.
+    if (store_restart_key_prefixes_) {
+      estimate += kRestartKeyPrefixSize;
+    }
   }
 
   estimate += sizeof(int32_t);  // varint for shared prefix length.
@@ -130,6 +145,22 @@ Slice BlockBuilder::Finish() {
     PutFixed32(&buffer_, restarts_[i]);
   }
 
+  // Append restart key prefixes, unless the block is empty
+  const bool has_restart_key_prefixes =
+      store_restart_key_prefixes_ &&
+      restart_key_prefixes_.size() == restarts_.size();
+  if (has_restart_key_prefixes) {
+    for (uint64_t prefix : restart_key_prefixes_) {
+      PutFixed64(&buffer_, prefix);
+    }
+  }
+
+  // Append the column streams of the entities, if any
+  const bool has_entity_columns = data_block_columns_builder_.Valid();
+  if (has_entity_columns) {
+    data_block_columns_builder_.Finish(buffer_);
+  }
+
   uint32_t num_restarts = static_cast<uint32_t>(restarts_.size());
   BlockBasedTableOptions::DataBlockIndexType index_type =
       BlockBasedTableOptions::kDataBlockBinarySearch;
@@ -140,7 +171,9 @@ Slice BlockBuilder::Finish() {
   }
 
   // footer is a packed format of data_block_index_type and num_restarts
-  uint32_t block_footer = PackIndexTypeAndNumRestarts(index_type, num_restarts);
+  uint32_t block_footer =
+      PackIndexTypeAndNumRestarts(index_type, num_restarts,
+                                  has_restart_key_prefixes, has_entity_columns);
 
   PutFixed32(&buffer_, block_footer);
   finished_ = true;
@@ -207,23 +240,41 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
     // Restart compression
     restarts_.push_back(static_cast<uint32_t>(buffer_size));
     estimate_ += sizeof(uint32_t);
+    if (store_restart_key_prefixes_) {
+      estimate_ += kRestartKeyPrefixSize;
+    }
     counter_ = 0;
   } else if (use_delta_encoding_) {
     // See how much sharing to do with previous string
     shared = key_to_persist.difference_offset(last_key_persisted);
   }
+  if (store_restart_key_prefixes_ &&
+      restart_key_prefixes_.size() < restarts_.size()) {
+    // First key of a restart interval
+    restart_key_prefixes_.push_back(RestartKeyPrefix(
+        is_user_key_ ? key_to_persist : ExtractUserKey(key_to_persist)));
+  }
 
   const size_t non_shared = key_to_persist.size() - shared;
 
+  // Entities are replaced by references to the column streams of the block
+  Slice value_to_persist = value;
+  if (columnar_entities_ &&
+      ExtractValueType(key) == ValueType::kTypeWideColumnEntity &&
+      data_block_columns_builder_.Add(value, &columnar_entry_)) {
+    value_to_persist = columnar_entry_;
+  }
+
   if (use_value_delta_encoding_) {
     // Add "<shared><non_shared>" to buffer_
     PutVarint32Varint32(&buffer_, static_cast<uint32_t>(shared),
                         static_cast<uint32_t>(non_shared));
   } else {
     // Add "<shared><non_shared><value_size>" to buffer_
-    PutVarint32Varint32Varint32(&buffer_, static_cast<uint32_t>(shared),
-                                static_cast<uint32_t>(non_shared),
-                                static_cast<uint32_t>(value.size()));
+    PutVarint32Varint32Varint32(
+        &buffer_, static_cast<uint32_t>(shared),
+        static_cast<uint32_t>(non_shared),
+        static_cast<uint32_t>(value_to_persist.size()));
   }
 
   // Add string delta to buffer_ followed by value
@@ -234,7 +285,7 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
   if (shared != 0 && use_value_delta_encoding_) {
     buffer_.append(delta_value->data(), delta_value->size());
   } else {
-    buffer_.append(value.data(), value.size());
+    buffer_.append(value_to_persist.data(), value_to_persist.size());
   }
 
   // TODO(yuzhangyu): make user defined timestamp work with block hash index.
@@ -14,6 +14,7 @@
 
 #include "rocksdb/slice.h"
 #include "rocksdb/table.h"
+#include "table/block_based/data_block_columns.h"
 #include "table/block_based/data_block_hash_index.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -31,7 +32,9 @@ class BlockBuilder {
                         double data_block_hash_table_util_ratio = 0.75,
                         size_t ts_sz = 0,
                         bool persist_user_defined_timestamps = true,
-                        bool is_user_key = false);
+                        bool is_user_key = false,
+                        bool store_restart_key_prefixes = false,
+                        bool columnar_entities = false);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -69,9 +72,11 @@ class BlockBuilder {
   // Returns an estimate of the current (uncompressed) size of the block
   // we are building.
   inline size_t CurrentSizeEstimate() const {
-    return estimate_ + (data_block_hash_index_builder_.Valid()
-                            ? data_block_hash_index_builder_.EstimateSize()
-                            : 0);
+    return estimate_ +
+           (data_block_hash_index_builder_.Valid()
+                ? data_block_hash_index_builder_.EstimateSize()
+                : 0) +
+           data_block_columns_builder_.EstimateSize();
   }
 
   // Returns an estimated block size after appending key and value.
@@ -112,14 +117,27 @@ class BlockBuilder {
   // index block for partitioned index blocks. In summary, this only applies to
   // block whose key are real user keys or internal keys created from user keys.
   const bool is_user_key_;
+  // Whether to store a fixed-width key prefix per restart point, see
+  // BlockBasedTableOptions::data_block_restart_key_prefixes. Only valid for
+  // keys ordered by BytewiseComparator without timestamps.
+  const bool store_restart_key_prefixes_;
+  // Whether to store wide-column entities column-wise, see
+  // BlockBasedTableOptions::data_block_columnar_entities. Only valid for data
+  // blocks.
+  const bool columnar_entities_;
 
   std::string buffer_;              // Destination buffer
   std::vector<uint32_t> restarts_;  // Restart points
+  // Key prefix of each restart point if store_restart_key_prefixes_
+  std::vector<uint64_t> restart_key_prefixes_;
   size_t estimate_;
   int counter_;    // Number of entries emitted since restart
   bool finished_;  // Has Finish() been called?
   std::string last_key_;
   DataBlockHashIndexBuilder data_block_hash_index_builder_;
+  DataBlockColumnsBuilder data_block_columns_builder_;
+  // Value stored in the block for the last entity added column-wise
+  std::string columnar_entry_;
 #ifndef NDEBUG
   bool add_with_last_key_called_ = false;
 #endif
@@ -71,6 +71,7 @@ const std::array<const Cache::CacheItemHelper*,
         BlockCacheInterface<Block_kRangeDeletion>::GetFullHelper(),
         nullptr,  // kHashIndexPrefixes
         nullptr,  // kHashIndexMetadata
+        nullptr,  // kLearnedIndexModel
         nullptr,  // kMetaIndex (not yet stored in block cache)
         BlockCacheInterface<Block_kIndex>::GetFullHelper(),
         nullptr,  // kInvalid
@@ -88,6 +89,7 @@ const std::array<const Cache::CacheItemHelper*,
         BlockCacheInterface<Block_kRangeDeletion>::GetBasicHelper(),
         nullptr,  // kHashIndexPrefixes
         nullptr,  // kHashIndexMetadata
+        nullptr,  // kLearnedIndexModel
         nullptr,  // kMetaIndex (not yet stored in block cache)
         BlockCacheInterface<Block_kIndex>::GetBasicHelper(),
         nullptr,  // kInvalid
@@ -21,8 +21,36 @@ void BlockPrefetcher::PrefetchIfNeeded(const BlockBasedTable::Rep* rep,
   const size_t len = BlockBasedTable::BlockSizeWithTrailer(handle);
   const size_t offset = handle.offset();
 
+  // Blocks can only be decompressed ahead of time if they were read ahead
+  // into the internal prefetch buffer rather than the OS page cache
+  const bool needs_prefetch_buffer = read_options.decompression_threads > 0;
+
   if (is_for_compaction) {
-    if (!rep->file->use_direct_io() && compaction_readahead_size_ > 0) {
+    const size_t max_adaptive_readahead_size =
+        static_cast<size_t>(rep->ioptions.max_compaction_readahead_size);
+    if (max_adaptive_readahead_size > 0) {
+      // Read ahead asynchronously into the internal prefetch buffer, which
+      // adapts the readahead size of this file to how its reads keep up
+      constexpr size_t kDefaultInitialReadaheadSize = 64 * 1024;
+      const size_t max_readahead_size =
+          std::max(max_adaptive_readahead_size,
+                   FilePrefetchBuffer::kMinAdaptiveReadaheadSize);
+      size_t initial_readahead_size = compaction_readahead_size_ > 0
+                                          ? compaction_readahead_size_
+                                          : kDefaultInitialReadaheadSize;
+      initial_readahead_size = std::min(
+          max_readahead_size,
+          std::max(initial_readahead_size,
+                   FilePrefetchBuffer::kMinAdaptiveReadaheadSize));
+      rep->CreateFilePrefetchBufferIfNotExists(
+          initial_readahead_size, max_readahead_size, &prefetch_buffer_,
+          /*implicit_auto_readahead=*/false, /*num_file_reads=*/0,
+          /*num_file_reads_for_auto_readahead=*/0, /*upper_bound_offset=*/0,
+          FilePrefetchBufferUsage::kCompactionAdaptiveReadahead);
+      return;
+    }
+    if (!rep->file->use_direct_io() && compaction_readahead_size_ > 0 &&
+        !needs_prefetch_buffer) {
       // If FS supports prefetching (readahead_limit_ will be non zero in that
       // case) and current block exists in prefetch buffer then return.
       if (offset + len <= readahead_limit_) {
@@ -110,7 +138,7 @@ void BlockPrefetcher::PrefetchIfNeeded(const BlockBasedTable::Rep* rep,
     return;
   }
 
-  if (rep->file->use_direct_io()) {
+  if (rep->file->use_direct_io() || needs_prefetch_buffer) {
     rep->CreateFilePrefetchBufferIfNotExists(
         initial_auto_readahead_size_, max_auto_readahead_size,
         &prefetch_buffer_, /*implicit_auto_readahead=*/true, num_file_reads_,
@@ -26,6 +26,7 @@
 #include "rocksdb/table.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/data_block_footer.h"
 #include "table/format.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
@@ -302,6 +303,108 @@ INSTANTIATE_TEST_CASE_P(
             BlockBasedTableOptions::DataBlockIndexType::
                 kDataBlockBinaryAndHash)));
 
+TEST_F(BlockTest, RestartKeyPrefixes) {
+  Random rnd(301);
+  const Comparator *ucmp = BytewiseComparator();
+
+  // Mix of short keys, keys that differ within the first 8 bytes and keys
+  // that share long prefixes, so prefixes both narrow and don't narrow
+  std::set<std::string> user_keys;
+  for (int i = 0; i < 2000; ++i) {
+    std::string k;
+    switch (rnd.Uniform(3)) {
+      case 0:
+        k = rnd.RandomString(1 + rnd.Uniform(7));
+        break;
+      case 1:
+        k = rnd.RandomString(8 + rnd.Uniform(16));
+        break;
+      default:
+        k = "commonpref" + rnd.RandomString(1 + rnd.Uniform(8));
+        break;
+    }
+    user_keys.insert(k);
+  }
+  user_keys.insert(std::string(8, '\xff') + "x");
+  user_keys.insert(std::string(3, '\0'));
+
+  std::vector<std::string> keys;
+  for (const auto &user_key : user_keys) {
+    keys.emplace_back(user_key);
+    AppendInternalKeyFooter(&keys.back(), 0 /* seqno */, kTypeValue);
+  }
+
+  for (auto index_type : {BlockBasedTableOptions::kDataBlockBinarySearch,
+                          BlockBasedTableOptions::kDataBlockBinaryAndHash}) {
+    BlockBuilder plain_builder(4, true /* use_delta_encoding */,
+                               false /* use_value_delta_encoding */,
+                               index_type, 0.75, 0 /* ts_sz */);
+    BlockBuilder prefix_builder(
+        4, true /* use_delta_encoding */, false /* use_value_delta_encoding */,
+        index_type, 0.75, 0 /* ts_sz */,
+        true /* persist_user_defined_timestamps */, false /* is_user_key */,
+        true /* store_restart_key_prefixes */);
+    for (const auto &key : keys) {
+      plain_builder.Add(key, key);
+      prefix_builder.Add(key, key);
+    }
+    ASSERT_EQ(plain_builder.CurrentSizeEstimate() +
+                  (keys.size() + 3) / 4 * kRestartKeyPrefixSize,
+              prefix_builder.CurrentSizeEstimate());
+
+    BlockContents plain_contents;
+    plain_contents.data = plain_builder.Finish();
+    Block plain_block(std::move(plain_contents));
+    BlockContents prefix_contents;
+    prefix_contents.data = prefix_builder.Finish();
+    Block prefix_block(std::move(prefix_contents));
+    ASSERT_FALSE(plain_block.HasRestartKeyPrefixes());
+    ASSERT_TRUE(prefix_block.HasRestartKeyPrefixes());
+    ASSERT_EQ(plain_block.NumRestarts(), prefix_block.NumRestarts());
+    ASSERT_EQ(plain_block.IndexType(), prefix_block.IndexType());
+
+    std::unique_ptr<DataBlockIter> plain_iter(plain_block.NewDataIterator(
+        ucmp, kDisableGlobalSequenceNumber));
+    std::unique_ptr<DataBlockIter> prefix_iter(prefix_block.NewDataIterator(
+        ucmp, kDisableGlobalSequenceNumber));
+
+    // Existing keys and random targets, including ones past both ends
+    std::vector<std::string> targets(user_keys.begin(), user_keys.end());
+    for (int i = 0; i < 2000; ++i) {
+      targets.emplace_back(rnd.RandomString(rnd.Uniform(20)));
+      targets.emplace_back("commonpref" + rnd.RandomString(rnd.Uniform(8)));
+    }
+    targets.emplace_back("");
+    targets.emplace_back(std::string(16, '\xff'));
+    for (const auto &user_key : targets) {
+      std::string target = user_key;
+      AppendInternalKeyFooter(&target, kMaxSequenceNumber, kValueTypeForSeek);
+
+      plain_iter->Seek(target);
+      prefix_iter->Seek(target);
+      ASSERT_EQ(plain_iter->Valid(), prefix_iter->Valid());
+      if (plain_iter->Valid()) {
+        ASSERT_EQ(plain_iter->key(), prefix_iter->key());
+      }
+
+      plain_iter->SeekForPrev(target);
+      prefix_iter->SeekForPrev(target);
+      ASSERT_EQ(plain_iter->Valid(), prefix_iter->Valid());
+      if (plain_iter->Valid()) {
+        ASSERT_EQ(plain_iter->key(), prefix_iter->key());
+      }
+
+      ASSERT_EQ(plain_iter->SeekForGet(target), prefix_iter->SeekForGet(target));
+      ASSERT_EQ(plain_iter->Valid(), prefix_iter->Valid());
+      if (plain_iter->Valid()) {
+        ASSERT_EQ(plain_iter->key(), prefix_iter->key());
+      }
+    }
+    ASSERT_OK(plain_iter->status());
+    ASSERT_OK(prefix_iter->status());
+  }
+}
+
 // A slow and accurate version of BlockReadAmpBitmap that simply store
 // all the marked ranges in a set.
 class BlockReadAmpBitmapSlowAndAccurate {
@@ -25,6 +25,7 @@ enum class BlockType : uint8_t {
   kRangeDeletion,
   kHashIndexPrefixes,
   kHashIndexMetadata,
+  kLearnedIndexModel,
   kMetaIndex,
   kIndex,
   // Note: keep kInvalid the last value when adding new enum values.
@@ -0,0 +1,173 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "table/block_based/data_block_columns.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "db/wide/wide_column_serialization.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+constexpr uint32_t kTrailerSize = 3 * sizeof(uint32_t);
+}  // namespace
+
+bool DataBlockColumnsBuilder::Add(const Slice& entity, std::string* entry) {
+  Slice input = entity;
+  WideColumns columns;
+  if (!WideColumnSerialization::Deserialize(input, columns).ok()) {
+    return false;
+  }
+
+  entry->clear();
+  entry->push_back(DataBlockColumns::kColumnarEntryMarker);
+  PutVarint32(entry, static_cast<uint32_t>(columns.size()));
+  for (const auto& column : columns) {
+    const std::string name = column.name().ToString();
+    auto it = column_ids_.find(name);
+    if (it == column_ids_.end()) {
+      it = column_ids_
+               .emplace(name, static_cast<uint32_t>(column_names_.size()))
+               .first;
+      column_names_.push_back(name);
+      streams_.emplace_back();
+      names_size_ += name.size();
+    }
+    std::string& stream = streams_[it->second];
+    PutVarint32Varint32Varint32(entry, it->second,
+                                static_cast<uint32_t>(stream.size()),
+                                static_cast<uint32_t>(column.value().size()));
+    stream.append(column.value().data(), column.value().size());
+    streams_size_ += column.value().size();
+  }
+  return true;
+}
+
+size_t DataBlockColumnsBuilder::EstimateSize() const {
+  if (!Valid()) {
+    return 0;
+  }
+  // Two varints per dictionary entry, usually of one or two bytes each
+  return streams_size_ + names_size_ + column_names_.size() * 4 + kTrailerSize;
+}
+
+void DataBlockColumnsBuilder::Finish(std::string& buffer) {
+  assert(Valid());
+  const size_t section_start = buffer.size();
+  std::vector<uint32_t> stream_offsets;
+  stream_offsets.reserve(streams_.size());
+  for (const auto& stream : streams_) {
+    stream_offsets.push_back(
+        static_cast<uint32_t>(buffer.size() - section_start));
+    buffer.append(stream);
+  }
+  const uint32_t dict_offset =
+      static_cast<uint32_t>(buffer.size() - section_start);
+  for (size_t i = 0; i < column_names_.size(); ++i) {
+    PutLengthPrefixedSlice(&buffer, column_names_[i]);
+    PutVarint32(&buffer, stream_offsets[i]);
+  }
+  PutFixed32(&buffer, dict_offset);
+  PutFixed32(&buffer, static_cast<uint32_t>(column_names_.size()));
+  PutFixed32(&buffer, static_cast<uint32_t>(buffer.size() + sizeof(uint32_t) -
+                                            section_start));
+}
+
+void DataBlockColumnsBuilder::Reset() {
+  column_ids_.clear();
+  column_names_.clear();
+  streams_.clear();
+  streams_size_ = 0;
+  names_size_ = 0;
+}
+
+bool DataBlockColumns::Initialize(const char* data, uint32_t section_end,
+                                  uint32_t* section_start) {
+  columns_.clear();
+  if (section_end < kTrailerSize) {
+    return false;
+  }
+  const char* trailer = data + section_end - kTrailerSize;
+  const uint32_t dict_offset = DecodeFixed32(trailer);
+  const uint32_t num_columns = DecodeFixed32(trailer + sizeof(uint32_t));
+  const uint32_t section_size = DecodeFixed32(trailer + 2 * sizeof(uint32_t));
+  if (section_size < kTrailerSize || section_size > section_end ||
+      dict_offset > section_size - kTrailerSize) {
+    return false;
+  }
+  const char* section = data + section_end - section_size;
+
+  Slice dict(section + dict_offset, section_size - kTrailerSize - dict_offset);
+  std::vector<uint32_t> stream_offsets;
+  columns_.resize(num_columns);
+  stream_offsets.resize(num_columns);
+  for (uint32_t i = 0; i < num_columns; ++i) {
+    if (!GetLengthPrefixedSlice(&dict, &columns_[i].name) ||
+        !GetVarint32(&dict, &stream_offsets[i]) ||
+        stream_offsets[i] > dict_offset ||
+        (i > 0 && stream_offsets[i] < stream_offsets[i - 1])) {
+      columns_.clear();
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < num_columns; ++i) {
+    const uint32_t end =
+        i + 1 < num_columns ? stream_offsets[i + 1] : dict_offset;
+    columns_[i].stream =
+        Slice(section + stream_offsets[i], end - stream_offsets[i]);
+  }
+  *section_start = section_end - section_size;
+  return true;
+}
+
+bool DataBlockColumns::Rebuild(const Slice& entry,
+                               const std::vector<Slice>* projection,
+                               std::string* entity) const {
+  assert(IsColumnarEntry(entry));
+  Slice input(entry.data() + 1, entry.size() - 1);
+  uint32_t num_columns = 0;
+  if (!GetVarint32(&input, &num_columns)) {
+    return false;
+  }
+  WideColumns columns;
+  columns.reserve(projection != nullptr
+                      ? std::min<size_t>(num_columns, projection->size())
+                      : num_columns);
+  for (uint32_t i = 0; i < num_columns; ++i) {
+    uint32_t id = 0;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    if (!GetVarint32(&input, &id) || !GetVarint32(&input, &offset) ||
+        !GetVarint32(&input, &size) || id >= columns_.size() ||
+        offset > columns_[id].stream.size() ||
+        size > columns_[id].stream.size() - offset) {
+      return false;
+    }
+    const Column& column = columns_[id];
+    if (projection != nullptr &&
+        std::find(projection->begin(), projection->end(), column.name) ==
+            projection->end()) {
+      continue;
+    }
+    columns.emplace_back(column.name,
+                         Slice(column.stream.data() + offset, size));
+  }
+  entity->clear();
+  return WideColumnSerialization::Serialize(columns, *entity).ok();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
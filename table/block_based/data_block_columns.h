@@ -0,0 +1,113 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+// Column-wise (PAX) layout of the wide-column entities of a data block, see
+// BlockBasedTableOptions::data_block_columnar_entities.
+//
+// The values of every column are stored contiguously in a per-column stream,
+// and the entry of an entity in the block only refers to them, so reading a
+// few columns of many entities touches only the streams of those columns. The
+// column names are stored once per block rather than once per entity.
+//
+// DATA_BLOCK: [RI RI ... RI RI_IDX PREFIXES? COLUMNS HASH_IDX? FOOTER]
+//
+// COLUMNS:    [STREAM STREAM ... STREAM DICT DICT_OFFSET NUM_COLS SIZE]
+//
+// STREAM:      The values of one column, in the order they were added.
+// DICT:        For every column: varint32 name length, name, and varint32
+//              offset of its stream from the start of COLUMNS.
+// DICT_OFFSET: fixed32 offset of DICT from the start of COLUMNS.
+// NUM_COLS:    fixed32 number of columns.
+// SIZE:        fixed32 size of COLUMNS, including this field.
+//
+// The value of an entity entry is:
+//
+// ENTITY:     [0x00 NUM_ENTITY_COLS (COLUMN_ID OFFSET SIZE)...]
+//
+// with varint32 fields. OFFSET is the position of the column value in the
+// stream of COLUMN_ID. Columns are listed in the order of the entity. The
+// leading 0x00 tells these entries apart from serialized entities, which
+// start with a non-zero version.
+class DataBlockColumnsBuilder {
+ public:
+  // Stores the columns of the serialized entity `entity` in the column
+  // streams, and sets `*entry` to the value to store in the block instead.
+  // Returns false, leaving everything untouched, if `entity` cannot be
+  // deserialized.
+  bool Add(const Slice& entity, std::string* entry);
+
+  bool Valid() const { return !column_names_.empty(); }
+
+  // Estimated size of the column section, or 0 if there are no entities
+  size_t EstimateSize() const;
+
+  // Appends the column section to `buffer`
+  void Finish(std::string& buffer);
+
+  void Reset();
+
+ private:
+  std::unordered_map<std::string, uint32_t> column_ids_;
+  std::vector<std::string> column_names_;
+  std::vector<std::string> streams_;
+  size_t streams_size_ = 0;
+  size_t names_size_ = 0;
+};
+
+// Reads the column section of a data block and rebuilds entities from it
+class DataBlockColumns {
+ public:
+  // `data` points to the block and [0, `section_end`) is the part of it before
+  // the hash index or the footer. Returns false if the section is corrupted,
+  // otherwise sets `*section_start` to the offset of the section.
+  bool Initialize(const char* data, uint32_t section_end,
+                  uint32_t* section_start);
+
+  // Sets `*entity` to the serialized entity of the block entry value `entry`,
+  // with only the columns in `projection` unless it is null. Returns false if
+  // `entry` or the column section is corrupted.
+  bool Rebuild(const Slice& entry, const std::vector<Slice>* projection,
+               std::string* entity) const;
+
+  // Whether the value of an entity entry refers to the column streams
+  static bool IsColumnarEntry(const Slice& entry) {
+    return !entry.empty() && entry[0] == kColumnarEntryMarker;
+  }
+
+  size_t ApproximateMemoryUsage() const {
+    return sizeof(*this) + columns_.capacity() * sizeof(Column);
+  }
+
+ private:
+  friend class DataBlockColumnsBuilder;
+  static constexpr char kColumnarEntryMarker = 0;
+
+  struct Column {
+    Slice name;
+    Slice stream;
+  };
+  std::vector<Column> columns_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
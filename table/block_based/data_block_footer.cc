@@ -15,15 +15,21 @@ namespace ROCKSDB_NAMESPACE {
 
 const int kDataBlockIndexTypeBitShift = 31;
 
-// 0x7FFFFFFF
-const uint32_t kMaxNumRestarts = (1u << kDataBlockIndexTypeBitShift) - 1u;
+// No real block has 2^29 restarts (the restart array alone would take 2GiB),
+// so legacy blocks never have these bits set
+const int kRestartKeyPrefixesBitShift = 30;
+const int kEntityColumnsBitShift = 29;
 
-// 0x7FFFFFFF
-const uint32_t kNumRestartsMask = (1u << kDataBlockIndexTypeBitShift) - 1u;
+// 0x1FFFFFFF
+const uint32_t kMaxNumRestarts = (1u << kEntityColumnsBitShift) - 1u;
+
+// 0x1FFFFFFF
+const uint32_t kNumRestartsMask = (1u << kEntityColumnsBitShift) - 1u;
 
 uint32_t PackIndexTypeAndNumRestarts(
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    uint32_t num_restarts) {
+    uint32_t num_restarts, bool has_restart_key_prefixes,
+    bool has_entity_columns) {
   if (num_restarts > kMaxNumRestarts) {
     assert(0);  // mute travis "unused" warning
   }
@@ -34,6 +40,12 @@ uint32_t PackIndexTypeAndNumRestarts(
   } else if (index_type != BlockBasedTableOptions::kDataBlockBinarySearch) {
     assert(0);
   }
+  if (has_restart_key_prefixes) {
+    block_footer |= 1u << kRestartKeyPrefixesBitShift;
+  }
+  if (has_entity_columns) {
+    block_footer |= 1u << kEntityColumnsBitShift;
+  }
 
   return block_footer;
 }
@@ -41,7 +53,8 @@ uint32_t PackIndexTypeAndNumRestarts(
 void UnPackIndexTypeAndNumRestarts(
     uint32_t block_footer,
     BlockBasedTableOptions::DataBlockIndexType* index_type,
-    uint32_t* num_restarts) {
+    uint32_t* num_restarts, bool* has_restart_key_prefixes,
+    bool* has_entity_columns) {
   if (index_type) {
     if (block_footer & 1u << kDataBlockIndexTypeBitShift) {
       *index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
@@ -54,6 +67,15 @@ void UnPackIndexTypeAndNumRestarts(
     *num_restarts = block_footer & kNumRestartsMask;
     assert(*num_restarts <= kMaxNumRestarts);
   }
+
+  if (has_restart_key_prefixes) {
+    *has_restart_key_prefixes =
+        (block_footer & 1u << kRestartKeyPrefixesBitShift) != 0;
+  }
+
+  if (has_entity_columns) {
+    *has_entity_columns = (block_footer & 1u << kEntityColumnsBitShift) != 0;
+  }
 }
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -9,17 +9,46 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+
+#include "port/port.h"
+#include "rocksdb/slice.h"
 #include "rocksdb/table.h"
+#include "util/math.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+// The block footer packs the data block index type (MSB), whether the block
+// has a restart key prefix array (next bit, see
+// BlockBasedTableOptions::data_block_restart_key_prefixes), whether it stores
+// wide-column entities column-wise (next bit, see
+// BlockBasedTableOptions::data_block_columnar_entities) and the number of
+// restarts (remaining bits).
 uint32_t PackIndexTypeAndNumRestarts(
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    uint32_t num_restarts);
+    uint32_t num_restarts, bool has_restart_key_prefixes = false,
+    bool has_entity_columns = false);
 
 void UnPackIndexTypeAndNumRestarts(
     uint32_t block_footer,
     BlockBasedTableOptions::DataBlockIndexType* index_type,
-    uint32_t* num_restarts);
+    uint32_t* num_restarts, bool* has_restart_key_prefixes = nullptr,
+    bool* has_entity_columns = nullptr);
+
+// Size of a restart key prefix. The prefixes are stored as fixed64 values,
+// one per restart point, right after the restart array.
+constexpr size_t kRestartKeyPrefixSize = sizeof(uint64_t);
+
+// Returns the restart key prefix of `user_key`: its first 8 bytes, zero
+// padded, read as a big-endian integer. For BytewiseComparator keys,
+// RestartKeyPrefix(a) < RestartKeyPrefix(b) implies a < b.
+inline uint64_t RestartKeyPrefix(const Slice& user_key) {
+  char buf[kRestartKeyPrefixSize] = {0};
+  memcpy(buf, user_key.data(), std::min(user_key.size(), sizeof(buf)));
+  uint64_t prefix;
+  memcpy(&prefix, buf, sizeof(prefix));
+  return port::kLittleEndian ? EndianSwapValue(prefix) : prefix;
+}
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -155,6 +155,18 @@ class FilterBlockReader {
     }
   }
 
+  /**
+   * Returns false only if the filter guarantees that no user key (without
+   * timestamp) in [lower, upper) was added to it. Filters that can't answer
+   * range queries return true. no_io means the same as in KeyMayMatch.
+   */
+  virtual bool KeyRangeMayMatch(const Slice& /*lower*/,
+                                const Slice& /*upper*/, const bool /*no_io*/,
+                                BlockCacheLookupContext* /*lookup_context*/,
+                                const ReadOptions& /*read_options*/) {
+    return true;
+  }
+
   virtual size_t ApproximateMemoryUsage() const = 0;
 
   // convert this object to a human readable form
@@ -113,6 +113,14 @@ class FilterBitsReader {
   }
 
   virtual bool HashMayMatch(const uint64_t /* h */) = 0;
+
+  // Check if any entry in the range [lower, upper) may have been added to the
+  // filter. Only filters of policies that SupportsRangeQueries() can rule out
+  // a range; all others conservatively return true.
+  virtual bool RangeMayMatch(const Slice& /* lower */,
+                             const Slice& /* upper */) {
+    return true;
+  }
 };
 
 // Exposes any extra information needed for testing built-in
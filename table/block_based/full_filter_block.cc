@@ -300,6 +300,35 @@ void FullFilterBlockReader::MayMatch(MultiGetRange* range, bool no_io,
   }
 }
 
+bool FullFilterBlockReader::KeyRangeMayMatch(
+    const Slice& lower, const Slice& upper, const bool no_io,
+    BlockCacheLookupContext* lookup_context, const ReadOptions& read_options) {
+  if (!whole_key_filtering()) {
+    return true;
+  }
+
+  CachableEntry<ParsedFullFilterBlock> filter_block;
+
+  const Status s = GetOrReadFilterBlock(no_io, nullptr /* get_context */,
+                                        lookup_context, &filter_block,
+                                        read_options);
+  if (!s.ok()) {
+    IGNORE_STATUS_IF_ERROR(s);
+    return true;
+  }
+
+  assert(filter_block.GetValue());
+
+  FilterBitsReader* const filter_bits_reader =
+      filter_block.GetValue()->filter_bits_reader();
+
+  if (filter_bits_reader && !filter_bits_reader->RangeMayMatch(lower, upper)) {
+    PERF_COUNTER_ADD(bloom_sst_miss_count, 1);
+    return false;
+  }
+  return true;
+}
+
 size_t FullFilterBlockReader::ApproximateMemoryUsage() const {
   size_t usage = ApproximateFilterBlockMemoryUsage();
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
@@ -152,6 +152,12 @@ class FullFilterBlockReader
                         const bool no_io,
                         BlockCacheLookupContext* lookup_context,
                         const ReadOptions& read_options) override;
+
+  bool KeyRangeMayMatch(const Slice& lower, const Slice& upper,
+                        const bool no_io,
+                        BlockCacheLookupContext* lookup_context,
+                        const ReadOptions& read_options) override;
+
   size_t ApproximateMemoryUsage() const override;
 
  private:
@@ -18,6 +18,7 @@
 #include "rocksdb/comparator.h"
 #include "table/block_based/block_based_table_factory.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/learned_index.h"
 #include "table/format.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -401,6 +402,73 @@ class HashIndexBuilder : public IndexBuilder {
   uint64_t current_restart_index_ = 0;
 };
 
+// LearnedIndexBuilder contains a binary-searchable primary index and, in a
+// metablock, a LearnedIndexModel of its restart keys that lets readers
+// narrow the binary search down to a small window. The model is only built
+// for keys ordered by BytewiseComparator without timestamps, and only if
+// their first 8 bytes are suitable for it. Otherwise the index is read as a
+// plain binary search index.
+class LearnedIndexBuilder : public IndexBuilder {
+ public:
+  LearnedIndexBuilder(
+      const InternalKeyComparator* comparator,
+      int index_block_restart_interval, int format_version,
+      bool use_value_delta_encoding,
+      BlockBasedTableOptions::IndexShorteningMode shortening_mode,
+      size_t ts_sz, const bool persist_user_defined_timestamps)
+      : IndexBuilder(comparator, ts_sz, persist_user_defined_timestamps),
+        primary_index_builder_(comparator, index_block_restart_interval,
+                               format_version, use_value_delta_encoding,
+                               shortening_mode, /* include_first_key */ false,
+                               ts_sz, persist_user_defined_timestamps),
+        index_block_restart_interval_(index_block_restart_interval),
+        build_model_(comparator->user_comparator() == BytewiseComparator() &&
+                     ts_sz == 0) {}
+
+  void AddIndexEntry(std::string* last_key_in_current_block,
+                     const Slice* first_key_in_next_block,
+                     const BlockHandle& block_handle) override {
+    primary_index_builder_.AddIndexEntry(last_key_in_current_block,
+                                         first_key_in_next_block, block_handle);
+    // The separator has now been shortened in place
+    if (build_model_ && num_entries_ % index_block_restart_interval_ == 0) {
+      model_builder_.AddRestartKey(ExtractUserKey(*last_key_in_current_block));
+    }
+    ++num_entries_;
+  }
+
+  void OnKeyAdded(const Slice& key) override {
+    primary_index_builder_.OnKeyAdded(key);
+  }
+
+  Status Finish(IndexBlocks* index_blocks,
+                const BlockHandle& last_partition_block_handle) override {
+    Status s = primary_index_builder_.Finish(index_blocks,
+                                             last_partition_block_handle);
+    if (s.ok() && build_model_ && model_builder_.Finish(&model_block_)) {
+      index_blocks->meta_blocks.insert(
+          {kLearnedIndexModelBlock.c_str(), model_block_});
+    }
+    return s;
+  }
+
+  size_t IndexSize() const override {
+    return primary_index_builder_.IndexSize() + model_block_.size();
+  }
+
+  bool seperator_is_key_plus_seq() override {
+    return primary_index_builder_.seperator_is_key_plus_seq();
+  }
+
+ private:
+  ShortenedIndexBuilder primary_index_builder_;
+  const uint64_t index_block_restart_interval_;
+  const bool build_model_;
+  LearnedIndexModel::Builder model_builder_;
+  std::string model_block_;
+  uint64_t num_entries_ = 0;
+};
+
 /**
  * IndexBuilder for two-level indexing. Internally it creates a new index for
  * each partition and Finish then in order when Finish is called on it
@@ -0,0 +1,252 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "table/block_based/learned_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "table/block_based/data_block_footer.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// Model layout:
+//
+// +-----------------------------------------------------------------------+
+// | num restarts (fixed32) | max error (fixed32) | num segments (fixed32) |
+// +-----------------------------------------------------------------------+
+// | segment first prefixes (fixed64 each)                                 |
+// +-----------------------------------------------------------------------+
+// | segment first ranks (fixed32 each)                                    |
+// +-----------------------------------------------------------------------+
+// | segment slopes (IEEE 754 double as fixed64 each)                      |
+// +-----------------------------------------------------------------------+
+// | format (1 byte)                                                       |
+// +-----------------------------------------------------------------------+
+constexpr uint8_t kFormatVersion = 1;
+constexpr size_t kHeaderLen = 3 * sizeof(uint32_t);
+constexpr size_t kSegmentLen =
+    sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
+// The first 8 bytes only tell the keys apart if most restart keys have a
+// distinct prefix
+constexpr size_t kMinDistinctPrefixRatio = 2;
+// Don't bother when the model is not much smaller than the keys it replaces
+constexpr size_t kMinRestartsPerSegment = 4;
+
+uint64_t EncodeDouble(double d) {
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  return bits;
+}
+
+double DecodeDouble(uint64_t bits) {
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+}  // namespace
+
+void LearnedIndexModel::Builder::AddRestartKey(const Slice& user_key) {
+  prefixes_.push_back(RestartKeyPrefix(user_key));
+  assert(prefixes_.size() == 1 ||
+         prefixes_[prefixes_.size() - 2] <= prefixes_.back());
+}
+
+bool LearnedIndexModel::Builder::Finish(std::string* contents) {
+  const size_t num_restarts = prefixes_.size();
+  if (num_restarts == 0 ||
+      num_restarts > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  // The model approximates the position of the first restart key whose
+  // prefix is >= x, for any x. That is a step function, so train on both
+  // ends of every step: the first position of each distinct prefix p, and
+  // the position after its last one at p + 1.
+  std::vector<std::pair<uint64_t, uint32_t>> points;
+  size_t num_distinct = 0;
+  for (size_t i = 0; i < num_restarts;) {
+    const uint64_t prefix = prefixes_[i];
+    const uint32_t first = static_cast<uint32_t>(i);
+    while (i < num_restarts && prefixes_[i] == prefix) {
+      ++i;
+    }
+    ++num_distinct;
+    points.emplace_back(prefix, first);
+    if (prefix != std::numeric_limits<uint64_t>::max() &&
+        (i == num_restarts || prefixes_[i] != prefix + 1)) {
+      points.emplace_back(prefix + 1, static_cast<uint32_t>(i));
+    }
+  }
+  if (num_distinct * kMinDistinctPrefixRatio < num_restarts) {
+    return false;
+  }
+
+  // Greedy shrinking-cone segmentation: extend a segment anchored at its
+  // first point as long as some slope keeps every point within the error
+  std::unique_ptr<LearnedIndexModel> model(new LearnedIndexModel());
+  model->num_restarts_ = static_cast<uint32_t>(num_restarts);
+  const double max_error = static_cast<double>(kTargetMaxError);
+  size_t start = 0;
+  double slope_lo = 0;
+  double slope_hi = std::numeric_limits<double>::infinity();
+  auto close_segment = [&]() {
+    model->segment_keys_.push_back(points[start].first);
+    model->segment_ranks_.push_back(points[start].second);
+    model->segment_slopes_.push_back(
+        std::isinf(slope_hi) ? 0 : (slope_lo + slope_hi) / 2);
+  };
+  for (size_t i = 1; i < points.size(); ++i) {
+    const double dx =
+        static_cast<double>(points[i].first - points[start].first);
+    const double dy = static_cast<double>(points[i].second) -
+                      static_cast<double>(points[start].second);
+    const double lo = std::max(slope_lo, (dy - max_error) / dx);
+    const double hi = std::min(slope_hi, (dy + max_error) / dx);
+    if (lo > hi) {
+      close_segment();
+      start = i;
+      slope_lo = 0;
+      slope_hi = std::numeric_limits<double>::infinity();
+    } else {
+      slope_lo = lo;
+      slope_hi = hi;
+    }
+  }
+  close_segment();
+  const size_t num_segments = model->segment_keys_.size();
+  if (num_segments * kMinRestartsPerSegment > num_restarts) {
+    return false;
+  }
+
+  // Floating point rounding may slightly exceed the target, so record the
+  // actual error. As predictions are monotonic, the error bound on the
+  // training points also holds between them.
+  uint32_t actual_error = 0;
+  for (const auto& point : points) {
+    const uint32_t predicted = model->Predict(point.first);
+    actual_error = std::max(actual_error, predicted > point.second
+                                              ? predicted - point.second
+                                              : point.second - predicted);
+  }
+
+  PutFixed32(contents, static_cast<uint32_t>(num_restarts));
+  PutFixed32(contents, actual_error);
+  PutFixed32(contents, static_cast<uint32_t>(num_segments));
+  for (uint64_t key : model->segment_keys_) {
+    PutFixed64(contents, key);
+  }
+  for (uint32_t rank : model->segment_ranks_) {
+    PutFixed32(contents, rank);
+  }
+  for (double slope : model->segment_slopes_) {
+    PutFixed64(contents, EncodeDouble(slope));
+  }
+  contents->push_back(static_cast<char>(kFormatVersion));
+
+  prefixes_.clear();
+  return true;
+}
+
+Status LearnedIndexModel::Create(const Slice& contents,
+                                 std::unique_ptr<LearnedIndexModel>* model) {
+  if (contents.size() < kHeaderLen + 1 ||
+      static_cast<uint8_t>(contents[contents.size() - 1]) != kFormatVersion) {
+    return Status::Corruption("Unsupported learned index model");
+  }
+  const char* p = contents.data();
+  const uint32_t num_restarts = DecodeFixed32(p);
+  const uint32_t max_error = DecodeFixed32(p + sizeof(uint32_t));
+  const uint32_t num_segments = DecodeFixed32(p + 2 * sizeof(uint32_t));
+  if (num_segments == 0 ||
+      (contents.size() - kHeaderLen - 1) / kSegmentLen != num_segments ||
+      (contents.size() - kHeaderLen - 1) % kSegmentLen != 0) {
+    return Status::Corruption("Bad learned index model size");
+  }
+
+  std::unique_ptr<LearnedIndexModel> result(new LearnedIndexModel());
+  result->num_restarts_ = num_restarts;
+  result->max_error_ = max_error;
+  result->segment_keys_.resize(num_segments);
+  result->segment_ranks_.resize(num_segments);
+  result->segment_slopes_.resize(num_segments);
+  const char* keys = p + kHeaderLen;
+  const char* ranks = keys + num_segments * sizeof(uint64_t);
+  const char* slopes = ranks + num_segments * sizeof(uint32_t);
+  for (uint32_t i = 0; i < num_segments; ++i) {
+    result->segment_keys_[i] = DecodeFixed64(keys + i * sizeof(uint64_t));
+    result->segment_ranks_[i] = DecodeFixed32(ranks + i * sizeof(uint32_t));
+    result->segment_slopes_[i] =
+        DecodeDouble(DecodeFixed64(slopes + i * sizeof(uint64_t)));
+    // Predictions must be monotonic for the error bound to hold
+    if (result->segment_ranks_[i] > num_restarts ||
+        !(result->segment_slopes_[i] >= 0) ||
+        std::isinf(result->segment_slopes_[i]) ||
+        (i > 0 &&
+         (result->segment_keys_[i] <= result->segment_keys_[i - 1] ||
+          result->segment_ranks_[i] < result->segment_ranks_[i - 1]))) {
+      return Status::Corruption("Bad learned index model segment");
+    }
+  }
+  *model = std::move(result);
+  return Status::OK();
+}
+
+uint32_t LearnedIndexModel::Predict(uint64_t prefix) const {
+  auto it =
+      std::upper_bound(segment_keys_.begin(), segment_keys_.end(), prefix);
+  if (it == segment_keys_.begin()) {
+    return 0;
+  }
+  const size_t segment = static_cast<size_t>(it - segment_keys_.begin()) - 1;
+  const uint32_t segment_end = segment + 1 < segment_ranks_.size()
+                                   ? segment_ranks_[segment + 1]
+                                   : num_restarts_;
+  const double predicted =
+      static_cast<double>(segment_ranks_[segment]) +
+      segment_slopes_[segment] *
+          static_cast<double>(prefix - segment_keys_[segment]);
+  if (predicted >= static_cast<double>(segment_end)) {
+    return segment_end;
+  }
+  return static_cast<uint32_t>(predicted);
+}
+
+void LearnedIndexModel::GetRestartRange(const Slice& user_key, uint32_t* left,
+                                        uint32_t* right) const {
+  const uint64_t prefix = RestartKeyPrefix(user_key);
+  const uint32_t first = Predict(prefix);
+  *left = first > max_error_ ? first - max_error_ : 0;
+  if (prefix == std::numeric_limits<uint64_t>::max()) {
+    *right = num_restarts_;
+  } else {
+    const uint64_t last = uint64_t{Predict(prefix + 1)} + max_error_;
+    *right = static_cast<uint32_t>(std::min<uint64_t>(last, num_restarts_));
+  }
+  if (*left > *right) {
+    // Only possible with a corrupted model
+    assert(false);
+    *left = 0;
+    *right = num_restarts_;
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
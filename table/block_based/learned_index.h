@@ -0,0 +1,93 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A learned model of an index block (see
+// BlockBasedTableOptions::kLearnedSearch) in the spirit of the PGM-index.
+// Restart keys are mapped to integers by their first 8 bytes (see
+// RestartKeyPrefix()), and a piecewise-linear function of that integer
+// predicts the position of the first restart key with that prefix within a
+// known error bound. A seek then binary searches only the restart points
+// inside the error window instead of the whole block.
+//
+// The model is only accurate for keys whose first 8 bytes are spread out,
+// like fixed-width big-endian numeric IDs. The builder refuses to build a
+// model when that is not the case, and the index is then read with a plain
+// binary search.
+class LearnedIndexModel {
+ public:
+  // Maximal distance between the predicted and the actual position of a key
+  // that the builder aims for
+  static constexpr uint32_t kTargetMaxError = 8;
+
+  class Builder {
+   public:
+    // Adds the user key of the next restart point of the index block. Keys
+    // must be added in BytewiseComparator order.
+    void AddRestartKey(const Slice& user_key);
+
+    // Trains the model over the restart keys added so far and appends it to
+    // `*contents`. Returns false without touching `*contents` if the keys are
+    // not suitable for a learned model.
+    bool Finish(std::string* contents);
+
+   private:
+    std::vector<uint64_t> prefixes_;
+  };
+
+  // Parses a model serialized by Builder::Finish()
+  static Status Create(const Slice& contents,
+                       std::unique_ptr<LearnedIndexModel>* model);
+
+  // Number of restart points of the index block the model was trained on
+  uint32_t num_restarts() const { return num_restarts_; }
+
+  // Narrows the restart points to search for `user_key` to the range
+  // [*left, *right): the restart key at `*left - 1` (if any) is smaller than
+  // `user_key`, and restart keys at `*right` or after are larger.
+  void GetRestartRange(const Slice& user_key, uint32_t* left,
+                       uint32_t* right) const;
+
+  size_t ApproximateMemoryUsage() const {
+    return sizeof(*this) + segment_keys_.capacity() * sizeof(uint64_t) +
+           segment_ranks_.capacity() * sizeof(uint32_t) +
+           segment_slopes_.capacity() * sizeof(double);
+  }
+
+ private:
+  LearnedIndexModel() = default;
+
+  // Predicted position of the first restart key whose prefix is >= `prefix`
+  uint32_t Predict(uint64_t prefix) const;
+
+  uint32_t num_restarts_ = 0;
+  uint32_t max_error_ = 0;
+  // Segment i covers prefixes in [segment_keys_[i], segment_keys_[i + 1])
+  std::vector<uint64_t> segment_keys_;
+  std::vector<uint32_t> segment_ranks_;
+  std::vector<double> segment_slopes_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
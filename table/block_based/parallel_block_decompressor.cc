@@ -0,0 +1,157 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "table/block_based/parallel_block_decompressor.h"
+
+#include "table/block_based/block_based_table_reader.h"
+#include "table/block_based/reader_common.h"
+#include "util/compression.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+ParallelBlockDecompressor::ParallelBlockDecompressor(
+    const BlockBasedTable* table, const UncompressionDict& dict,
+    size_t num_threads, bool verify_checksums)
+    : table_(table),
+      dict_(dict),
+      allocator_(GetMemoryAllocator(table->get_rep()->table_options)),
+      create_context_(table->get_rep()->create_context),
+      env_(table->get_rep()->ioptions.env),
+      verify_checksums_(verify_checksums),
+      max_tasks_(num_threads * kBlocksPerThread),
+      shared_(std::make_shared<Shared>(this)) {
+  assert(num_threads > 0);
+  env_->IncBackgroundThreadsIfNeeded(static_cast<int>(num_threads),
+                                     Env::Priority::USER);
+}
+
+ParallelBlockDecompressor::~ParallelBlockDecompressor() { Clear(); }
+
+void ParallelBlockDecompressor::Schedule(const BlockHandle& handle,
+                                         const Slice& serialized_block) {
+  assert(HasRoom());
+  assert(serialized_block.size() ==
+         BlockBasedTable::BlockSizeWithTrailer(handle));
+  std::unique_ptr<Task> task(new Task);
+  task->handle = handle;
+  task->serialized = AllocateAndCopyBlock(serialized_block, allocator_);
+  {
+    MutexLock l(&shared_->mutex);
+    shared_->queue.push_back(task.get());
+  }
+  tasks_.push_back(std::move(task));
+  // Each job processes whichever block is first in the queue when it runs
+  env_->Schedule(&ParallelBlockDecompressor::BGWorkDecompression,
+                 new std::shared_ptr<Shared>(shared_), Env::Priority::USER,
+                 nullptr /* tag */,
+                 &ParallelBlockDecompressor::UnscheduleDecompression);
+}
+
+bool ParallelBlockDecompressor::Take(const BlockHandle& handle,
+                                     std::unique_ptr<Block_kData>* block) {
+  if (tasks_.empty()) {
+    return false;
+  }
+  if (tasks_.front()->handle.offset() != handle.offset()) {
+    Clear();
+    return false;
+  }
+  std::unique_ptr<Task> task = std::move(tasks_.front());
+  tasks_.pop_front();
+  {
+    MutexLock l(&shared_->mutex);
+    if (!shared_->queue.empty() && shared_->queue.front() == task.get()) {
+      // No job got to it yet, so do it here rather than wait
+      shared_->queue.pop_front();
+    } else {
+      while (!task->done) {
+        shared_->cv.Wait();
+      }
+    }
+  }
+  if (!task->done) {
+    Process(task.get());
+  }
+  if (!task->status.ok()) {
+    return false;
+  }
+  *block = std::move(task->block);
+  return true;
+}
+
+void ParallelBlockDecompressor::Clear() {
+  MutexLock l(&shared_->mutex);
+  shared_->queue.clear();
+  while (shared_->in_progress > 0) {
+    shared_->cv.Wait();
+  }
+  tasks_.clear();
+}
+
+void ParallelBlockDecompressor::BGWorkDecompression(void* arg) {
+  std::unique_ptr<std::shared_ptr<Shared>> shared_ptr(
+      static_cast<std::shared_ptr<Shared>*>(arg));
+  Shared* shared = shared_ptr->get();
+  MutexLock l(&shared->mutex);
+  if (shared->queue.empty()) {
+    // Taken by the owner, or dropped
+    return;
+  }
+  Task* task = shared->queue.front();
+  shared->queue.pop_front();
+  ++shared->in_progress;
+  shared->mutex.Unlock();
+  shared->owner->Process(task);
+  shared->mutex.Lock();
+  task->done = true;
+  --shared->in_progress;
+  shared->cv.SignalAll();
+}
+
+void ParallelBlockDecompressor::UnscheduleDecompression(void* arg) {
+  delete static_cast<std::shared_ptr<Shared>*>(arg);
+}
+
+void ParallelBlockDecompressor::Process(Task* task) {
+  const BlockBasedTable::Rep* rep = table_->get_rep();
+  const BlockHandle& handle = task->handle;
+  const char* data = task->serialized.get();
+  if (verify_checksums_) {
+    task->status = VerifyBlockChecksum(rep->footer, data, handle.size(),
+                                       rep->file->file_name(), handle.offset());
+    if (!task->status.ok()) {
+      return;
+    }
+  }
+  CompressionType compression_type =
+      BlockBasedTable::GetBlockCompressionType(data, handle.size());
+  BlockContents contents;
+  if (compression_type == kNoCompression) {
+    contents = BlockContents(std::move(task->serialized), handle.size());
+  } else {
+    UncompressionContext context(compression_type);
+    UncompressionInfo info(context, dict_, compression_type);
+    task->status = UncompressSerializedBlock(
+        info, data, handle.size(), &contents, rep->footer.format_version(),
+        rep->ioptions, allocator_);
+    task->serialized.reset();
+    if (!task->status.ok()) {
+      return;
+    }
+  }
+  create_context_.Create(&task->block, std::move(contents));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,118 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+
+#include "memory/memory_allocator_impl.h"
+#include "port/port.h"
+#include "rocksdb/env.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "table/block_based/block_cache.h"
+#include "table/format.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class BlockBasedTable;
+struct UncompressionDict;
+
+// Verifies and decompresses the data blocks of a table on the
+// Env::Priority::USER thread pool of the Env, ahead of the iterator that is
+// going to read them (see ReadOptions::decompression_threads). The pool is
+// shared by all decompressors, and is only grown to the largest number of
+// threads any of them asked for.
+//
+// The iterator schedules the serialized blocks that follow the current one and
+// are already in its readahead buffer, in file order, and takes them back
+// decompressed when it gets to them. Taking a block that is not the next
+// scheduled one (e.g. after a seek) drops all scheduled blocks.
+//
+// Must be used from a single thread and destroyed before the table and the
+// dictionary passed to the constructor.
+class ParallelBlockDecompressor {
+ public:
+  // Number of blocks that may be scheduled per thread
+  static constexpr size_t kBlocksPerThread = 4;
+
+  ParallelBlockDecompressor(const BlockBasedTable* table,
+                            const UncompressionDict& dict, size_t num_threads,
+                            bool verify_checksums);
+  ~ParallelBlockDecompressor();
+
+  // No copying allowed
+  ParallelBlockDecompressor(const ParallelBlockDecompressor&) = delete;
+  ParallelBlockDecompressor& operator=(const ParallelBlockDecompressor&) =
+      delete;
+
+  bool empty() const { return tasks_.empty(); }
+  bool HasRoom() const { return tasks_.size() < max_tasks_; }
+
+  // Schedules the block at `handle`, whose serialized contents including the
+  // trailer are `serialized_block`. The contents are copied.
+  void Schedule(const BlockHandle& handle, const Slice& serialized_block);
+
+  // If the block at `handle` is the next scheduled one, waits for it and
+  // returns true with the parsed block in `*block`. Returns false if it could
+  // not be processed, in which case it should be read as usual.
+  bool Take(const BlockHandle& handle, std::unique_ptr<Block_kData>* block);
+
+  // Drops all scheduled blocks
+  void Clear();
+
+ private:
+  struct Task {
+    BlockHandle handle;
+    CacheAllocationPtr serialized;
+    std::unique_ptr<Block_kData> block;
+    Status status;
+    bool done = false;
+  };
+
+  // The state shared with the pool jobs, which may run after the decompressor
+  // is gone and then find nothing to do
+  struct Shared {
+    explicit Shared(ParallelBlockDecompressor* _owner)
+        : owner(_owner), cv(&mutex) {}
+    // Only used while a job is in progress
+    ParallelBlockDecompressor* const owner;
+    port::Mutex mutex;
+    port::CondVar cv;
+    // Scheduled blocks that no job picked up yet
+    std::deque<Task*> queue;
+    size_t in_progress = 0;
+  };
+
+  static void BGWorkDecompression(void* arg);
+  static void UnscheduleDecompression(void* arg);
+  void Process(Task* task);
+
+  const BlockBasedTable* const table_;
+  const UncompressionDict& dict_;
+  MemoryAllocator* const allocator_;
+  BlockCreateContext create_context_;
+  Env* const env_;
+  const bool verify_checksums_;
+  const size_t max_tasks_;
+
+  // Scheduled blocks in file order. Only accessed by the owning thread.
+  std::deque<std::unique_ptr<Task>> tasks_;
+
+  const std::shared_ptr<Shared> shared_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
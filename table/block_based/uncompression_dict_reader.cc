@@ -66,6 +66,14 @@ Status UncompressionDictReader::Create(
   return Status::OK();
 }
 
+void UncompressionDictReader::CreateShared(
+    const BlockBasedTable* table, std::shared_ptr<UncompressionDict> dict,
+    std::unique_ptr<UncompressionDictReader>* uncompression_dict_reader) {
+  assert(uncompression_dict_reader);
+  uncompression_dict_reader->reset(
+      new UncompressionDictReader(table, std::move(dict)));
+}
+
 UncompressionDictReader::~UncompressionDictReader() {
   table_->UnPinData(std::move(pinned_));
 }
@@ -110,6 +118,11 @@ Status UncompressionDictReader::GetOrReadUncompressionDictionary(
     CachableEntry<UncompressionDict>* uncompression_dict) const {
   assert(uncompression_dict);
 
+  if (shared_dict_) {
+    uncompression_dict->SetUnownedValue(shared_dict_.get());
+    return Status::OK();
+  }
+
   if (!uncompression_dict_.IsEmpty()) {
     uncompression_dict->SetUnownedValue(uncompression_dict_.GetValue());
     return Status::OK();
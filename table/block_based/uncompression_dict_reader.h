@@ -21,6 +21,7 @@
 #pragma once
 
 #include <cassert>
+#include <memory>
 
 #include "rocksdb/table_pinning_policy.h"
 #include "table/block_based/cachable_entry.h"
@@ -46,6 +47,11 @@ class UncompressionDictReader {
       bool use_cache, bool prefetch, bool pin,
       BlockCacheLookupContext* lookup_context,
       std::unique_ptr<UncompressionDictReader>* uncompression_dict_reader);
+  // For files compressed with a shared dictionary of the column family (see
+  // CompressionOptions::use_shared_dict), which is not stored in the file
+  static void CreateShared(
+      const BlockBasedTable* table, std::shared_ptr<UncompressionDict> dict,
+      std::unique_ptr<UncompressionDictReader>* uncompression_dict_reader);
   ~UncompressionDictReader();
   Status GetOrReadUncompressionDictionary(
       FilePrefetchBuffer* prefetch_buffer, const ReadOptions& ro, bool no_io,
@@ -64,6 +70,12 @@ class UncompressionDictReader {
         pinned_(std::move(pinned)) {
     assert(table_);
   }
+  UncompressionDictReader(const BlockBasedTable* t,
+                          std::shared_ptr<UncompressionDict>&& shared_dict)
+      : table_(t), shared_dict_(std::move(shared_dict)) {
+    assert(table_);
+    assert(shared_dict_);
+  }
 
   bool cache_dictionary_blocks() const;
 
@@ -76,6 +88,7 @@ class UncompressionDictReader {
   const BlockBasedTable* table_;
   CachableEntry<UncompressionDict> uncompression_dict_;
   std::unique_ptr<PinnedEntry> pinned_;
+  std::shared_ptr<UncompressionDict> shared_dict_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
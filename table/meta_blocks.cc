@@ -122,6 +122,9 @@ void PropertyBlockBuilder::AddTableProperty(const TableProperties& props) {
     Add(TablePropertiesNames::kUserDefinedTimestampsPersisted,
         props.user_defined_timestamps_persisted);
   }
+  if (props.compression_dict_id > 0) {
+    Add(TablePropertiesNames::kCompressionDictId, props.compression_dict_id);
+  }
   if (!props.db_id.empty()) {
     Add(TablePropertiesNames::kDbId, props.db_id);
   }
@@ -316,6 +319,8 @@ Status ReadTablePropertiesHelper(
        &new_table_properties->fast_compression_estimated_data_size},
       {TablePropertiesNames::kTailStartOffset,
        &new_table_properties->tail_start_offset},
+      {TablePropertiesNames::kCompressionDictId,
+       &new_table_properties->compression_dict_id},
       {TablePropertiesNames::kUserDefinedTimestampsPersisted,
        &new_table_properties->user_defined_timestamps_persisted},
   };
@@ -42,6 +42,8 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+class AdaptiveCompressionSelector;
+class CompressionDictService;
 class Slice;
 class Status;
 
@@ -122,6 +124,9 @@ struct TableReaderOptions {
   bool user_defined_timestamps_persisted;
 
   Cache::ItemOwnerId cache_owner_id = Cache::kUnknownItemOwnerId;
+
+  // Shared compression dictionaries of the column family, if any
+  CompressionDictService* compression_dict_service = nullptr;
 };
 
 struct TableBuilderOptions {
@@ -187,6 +192,12 @@ struct TableBuilderOptions {
   // in the table options of the ioptions.table_factory
   bool skip_filters = false;
   const uint64_t cur_file_num;
+  // Shared compression dictionaries of the column family, if any. Only set
+  // for flushes and compactions.
+  CompressionDictService* compression_dict_service = nullptr;
+  // Receives the compression measurements of the data blocks when the
+  // compression was chosen by adaptive compression. Only set for compactions.
+  AdaptiveCompressionSelector* adaptive_compression = nullptr;
 };
 
 // TableBuilder provides the interface used to build a Table
@@ -15,6 +15,7 @@
 #include "folly/experimental/coro/Coroutine.h"
 #include "folly/experimental/coro/Task.h"
 #endif
+#include "rocksdb/cleanable.h"
 #include "rocksdb/slice_transform.h"
 #include "rocksdb/table_reader_caller.h"
 #include "table/get_context.h"
@@ -31,6 +32,7 @@ struct ReadOptions;
 struct TableProperties;
 class GetContext;
 class MultiGetContext;
+class RandomAccessFileReader;
 
 // A Table (also referred to as SST) is a sorted map from strings to strings.
 // Tables are immutable and persistent.  A Table may be safely accessed from
@@ -172,6 +174,59 @@ class TableReader {
     return Status::OK();
   }
 
+  // A data block that a lookup has to read from storage before it can
+  // complete from the block cache (see PrepareAsyncGet()). Cleanups registered
+  // on it keep the table reader alive until the read is completed.
+  struct AsyncBlockRead : public Cleanable {
+    TableReader* table = nullptr;
+    RandomAccessFileReader* file = nullptr;
+    uint64_t offset = 0;
+    // Size of the block including its trailer; 0 when there is nothing to read
+    size_t len = 0;
+    // Where the block was read to by the caller
+    std::unique_ptr<char[]> buf;
+    Slice result;
+  };
+
+  // Finds the first data block a Get() of `key` would miss in the block
+  // cache, and sets `*block` to it. Filter and index blocks needed to locate
+  // it are read synchronously. Leaves `block->len` at 0 if the lookup does
+  // not need to read any data block from storage.
+  virtual Status PrepareAsyncGet(const ReadOptions& /*read_options*/,
+                                 const Slice& /*key*/,
+                                 const SliceTransform* /*prefix_extractor*/,
+                                 bool /*skip_filters*/,
+                                 AsyncBlockRead* /*block*/) {
+    return Status::NotSupported("PrepareAsyncGet() not supported");
+  }
+
+  // Verifies a block returned by PrepareAsyncGet() once the caller has read
+  // it into `block->buf`, and inserts it into the block cache
+  virtual Status CompleteAsyncGet(const ReadOptions& /*read_options*/,
+                                  AsyncBlockRead* /*block*/) {
+    return Status::NotSupported("CompleteAsyncGet() not supported");
+  }
+
+  // A data block and how often it was found in the block cache
+  struct HotBlock {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t hits;
+  };
+
+  // Appends the data blocks this table has seen block cache hits on, in no
+  // particular order. Hits may be sampled, so they are only comparable
+  // relative to each other. Each call halves the hits counted so far, so
+  // that blocks that were hot long ago age out.
+  virtual void GetHotBlocks(std::vector<HotBlock>* /*blocks*/) const {}
+
+  // Reads the given data blocks (as returned by GetHotBlocks(), possibly by
+  // an earlier instance of the same file) into the block cache
+  virtual Status WarmUpBlocks(const ReadOptions& /*read_options*/,
+                              const std::vector<HotBlock>& /*blocks*/) {
+    return Status::NotSupported("WarmUpBlocks() not supported");
+  }
+
   // convert db file to a human readable form
   virtual Status DumpTable(WritableFile* /*out_file*/) {
     return Status::NotSupported("DumpTable() not supported");
@@ -1707,7 +1707,8 @@ TEST_F(TablePropertyTest, UniqueIdsFailure) {
 // This test include all the basic checks except those for index size and block
 // size, which will be conducted in separated unit tests.
 TEST_P(BlockBasedTableTest, BasicBlockBasedTableProperties) {
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
 
   c.Add("a1", "val1");
   c.Add("b2", "val2");
@@ -1762,7 +1763,8 @@ TEST_P(BlockBasedTableTest, BasicBlockBasedTableProperties) {
 
 #ifdef SNAPPY
 uint64_t BlockBasedTableTest::IndexUncompressedHelper(bool compressed) {
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   constexpr size_t kNumKeys = 10000;
 
   for (size_t k = 0; k < kNumKeys; ++k) {
@@ -1919,7 +1921,8 @@ TEST_P(BlockBasedTableTest, RangeDelBlock) {
 }
 
 TEST_P(BlockBasedTableTest, FilterPolicyNameProperties) {
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   c.Add("a1", "val1");
   std::vector<std::string> keys;
   stl_wrappers::KVMap kvmap;
@@ -2021,7 +2024,8 @@ TEST_P(BlockBasedTableTest, PrefetchTest) {
   table_options.block_cache = NewLRUCache(16 * 1024 * 1024, 4);
   opt.table_factory.reset(NewBlockBasedTableFactory(table_options));
 
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   c.Add("k01", "hello");
   c.Add("k02", "hello2");
   c.Add("k03", std::string(10000, 'x'));
@@ -2666,6 +2670,95 @@ TEST_P(BlockBasedTableTest, HashIndexTest) {
   IndexTest(table_options);
 }
 
+TEST_P(BlockBasedTableTest, LearnedIndexTest) {
+  BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+  table_options.index_type = BlockBasedTableOptions::kLearnedSearch;
+  IndexTest(table_options);
+}
+
+TEST_P(BlockBasedTableTest, LearnedIndexKeys) {
+  Random rnd(301);
+  auto big_endian_key = [](uint64_t id) {
+    std::string key(sizeof(id), '\0');
+    for (size_t i = key.size(); i > 0; --i) {
+      key[i - 1] = static_cast<char>(id & 0xff);
+      id >>= 8;
+    }
+    return key;
+  };
+
+  // Fixed-width numeric keys get a model, keys that share their first 8 bytes
+  // don't, and both must be searched correctly
+  for (bool numeric : {true, false}) {
+    std::vector<std::string> user_keys;
+    for (uint64_t i = 0; i < 20000; ++i) {
+      // Mostly linear, with some denser and sparser ranges
+      uint64_t id = i * 1000 + (i % 7 == 0 ? rnd.Uniform(1000) : 0) +
+                    (i > 10000 ? (i - 10000) * 3000 : 0);
+      user_keys.push_back(numeric ? big_endian_key(id)
+                                  : "user0000" + big_endian_key(id));
+    }
+
+    uint64_t index_size[2] = {0, 0};
+    for (auto index_type : {BlockBasedTableOptions::kBinarySearch,
+                            BlockBasedTableOptions::kLearnedSearch}) {
+      TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
+      for (const auto& user_key : user_keys) {
+        c.Add(user_key, "v");
+      }
+      std::vector<std::string> keys;
+      stl_wrappers::KVMap kvmap;
+      Options options;
+      BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+      table_options.index_type = index_type;
+      table_options.block_size = 64;
+      options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+      const ImmutableOptions ioptions(options);
+      const MutableCFOptions moptions(options);
+      c.Finish(options, ioptions, moptions, table_options,
+               GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+      auto reader = c.GetTableReader();
+      index_size[index_type == BlockBasedTableOptions::kLearnedSearch] =
+          reader->GetTableProperties()->index_size;
+
+      ReadOptions read_options;
+      std::unique_ptr<InternalIterator> iter(reader->NewIterator(
+          read_options, moptions.prefix_extractor.get(), /*arena=*/nullptr,
+          /*skip_filters=*/false, TableReaderCaller::kUncategorized));
+      for (int i = 0; i < 20000; ++i) {
+        std::string target;
+        if (i % 2 == 0) {
+          target = user_keys[rnd.Uniform(20000)];
+        } else {
+          target = big_endian_key(rnd.Uniform(60000000));
+          if (!numeric) {
+            target = "user0000" + target;
+          }
+        }
+        auto expected =
+            std::lower_bound(user_keys.begin(), user_keys.end(), target);
+        InternalKey ikey(target, kMaxSequenceNumber, kTypeValue);
+        iter->Seek(ikey.Encode());
+        ASSERT_OK(iter->status());
+        if (expected == user_keys.end()) {
+          ASSERT_FALSE(iter->Valid());
+        } else {
+          ASSERT_TRUE(iter->Valid());
+          ASSERT_EQ(*expected, ExtractUserKey(iter->key()).ToString());
+        }
+      }
+      iter.reset();
+      c.ResetTableReader();
+    }
+    if (numeric) {
+      ASSERT_GT(index_size[1], index_size[0]);
+    } else {
+      ASSERT_EQ(index_size[1], index_size[0]);
+    }
+  }
+}
+
 TEST_P(BlockBasedTableTest, PartitionIndexTest) {
   const int max_index_keys = 5;
   const int est_max_index_key_value_size = 32;
@@ -3057,7 +3150,8 @@ TEST_P(BlockBasedTableTest, IndexSizeStat) {
 
 TEST_P(BlockBasedTableTest, NumBlockStat) {
   Random rnd(test::RandomSeed());
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   Options options;
   options.compression = kNoCompression;
   BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
@@ -3522,7 +3616,8 @@ TEST_P(BlockBasedTableTest, BlockCacheDisabledTest) {
   std::vector<std::string> keys;
   stl_wrappers::KVMap kvmap;
 
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   c.Add("key", "value");
   const ImmutableOptions ioptions(options);
   const MutableCFOptions moptions(options);
@@ -3574,7 +3669,8 @@ TEST_P(BlockBasedTableTest, FilterBlockInBlockCache) {
   std::vector<std::string> keys;
   stl_wrappers::KVMap kvmap;
 
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   c.Add("key", "value");
   const ImmutableOptions ioptions(options);
   const MutableCFOptions moptions(options);
@@ -3877,7 +3973,8 @@ TEST_P(BlockBasedTableTest, BlockCacheLeak) {
   table_options.block_cache = NewLRUCache(16 * 1024 * 1024, 4);
   opt.table_factory.reset(NewBlockBasedTableFactory(table_options));
 
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   c.Add("k01", "hello");
   c.Add("k02", "hello2");
   c.Add("k03", std::string(10000, 'x'));
@@ -4191,7 +4288,8 @@ TEST_F(PlainTableTest, Crc32cFileChecksum) {
 
 
 TEST_F(GeneralTableTest, ApproximateOffsetOfPlain) {
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   c.Add("k01", "hello");
   c.Add("k02", "hello2");
   c.Add("k03", std::string(10000, 'x'));
@@ -4231,7 +4329,8 @@ TEST_F(GeneralTableTest, ApproximateOffsetOfPlain) {
 static void DoCompressionTest(CompressionType comp) {
   SCOPED_TRACE("CompressionType = " + CompressionTypeToString(comp));
   Random rnd(301);
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   std::string tmp;
   c.Add("k01", "hello");
   c.Add("k02", test::CompressibleString(&rnd, 0.25, 10000, &tmp));
@@ -4300,7 +4399,8 @@ TEST_F(GeneralTableTest, ApproximateOffsetOfCompressed) {
 
 TEST_F(GeneralTableTest, ApproximateKeyAnchors) {
   Random rnd(301);
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   std::string tmp;
   for (int i = 1000; i < 9000; i++) {
     c.Add(std::to_string(i), rnd.RandomString(2000));
@@ -5186,7 +5286,8 @@ TEST_P(BlockBasedTableTest, PropertiesMetaBlockLast) {
   // are sometimes read depending on the user's configuration. This ordering
   // allows us to do a small readahead on the end of the file to read properties
   // and meta-index blocks with one I/O.
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   c.Add("a1", "val1");
   c.Add("b2", "val2");
   c.Add("c3", "val3");
@@ -5266,7 +5367,8 @@ TEST_P(BlockBasedTableTest, PropertiesMetaBlockLast) {
 }
 
 TEST_P(BlockBasedTableTest, SeekMetaBlocks) {
-  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  TableConstructor c(BytewiseComparator(),
+                         true /* convert_to_internal_key */);
   c.Add("foo_a1", "val1");
   c.Add("foo_b2", "val2");
   c.Add("foo_c3", "val3");
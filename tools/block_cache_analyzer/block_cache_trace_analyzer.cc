@@ -51,7 +51,8 @@ DEFINE_string(
     "cache_name,num_shard_bits,ghost_capacity,cache_capacity_1,...,cache_"
     "capacity_N. Supported cache names are lru, lru_priority, lru_hybrid, and "
     "lru_hybrid_no_insert_on_row_miss. User may also add a prefix 'ghost_' to "
-    "a cache_name to add a ghost cache in front of the real cache. "
+    "a cache_name to add a ghost cache in front of the real cache, and/or a "
+    "prefix 'tinylfu_' to admit blocks using TinyLFU, e.g. tinylfu_ghost_lru. "
     "ghost_capacity and cache_capacity can be xK, xM or xG where x is a "
     "positive number.");
 DEFINE_int32(block_cache_trace_downsample_ratio, 1,
@@ -183,7 +184,8 @@ const std::set<std::string> kGroupbyLabels{
 const std::string kSupportedCacheNames =
     " lru ghost_lru lru_priority ghost_lru_priority lru_hybrid "
     "ghost_lru_hybrid lru_hybrid_no_insert_on_row_miss "
-    "ghost_lru_hybrid_no_insert_on_row_miss ";
+    "ghost_lru_hybrid_no_insert_on_row_miss tinylfu_lru tinylfu_ghost_lru "
+    "tinylfu_lru_priority tinylfu_ghost_lru_priority ";
 
 // The suffix for the generated csv files.
 const std::string kFileNameSuffixMissRatioTimeline = "miss_ratio_timeline";
@@ -234,6 +236,8 @@ std::string caller_to_string(TableReaderCaller caller) {
       return "MultiGet";
     case kUserIterator:
       return "Iterator";
+    case kUserIteratorLongScan:
+      return "IteratorLongScan";
     case kUserApproximateSize:
       return "ApproximateSize";
     case kUserVerifyChecksum:
@@ -270,6 +274,8 @@ TableReaderCaller string_to_caller(std::string caller_str) {
     return kUserMultiGet;
   } else if (caller_str == "Iterator") {
     return kUserIterator;
+  } else if (caller_str == "IteratorLongScan") {
+    return kUserIteratorLongScan;
   } else if (caller_str == "ApproximateSize") {
     return kUserApproximateSize;
   } else if (caller_str == "VerifyChecksum") {
@@ -301,6 +307,7 @@ bool is_user_access(TableReaderCaller caller) {
     case kUserGet:
     case kUserMultiGet:
     case kUserIterator:
+    case kUserIteratorLongScan:
     case kUserApproximateSize:
     case kUserVerifyChecksum:
       return true;
@@ -72,6 +72,7 @@
 #include "rocksdb/filter_policy.h"
 #include "rocksdb/memtablerep.h"
 #include "rocksdb/options.h"
+#include "rocksdb/iostats_context.h"
 #include "rocksdb/perf_context.h"
 #include "rocksdb/persistent_cache.h"
 #include "rocksdb/rate_limiter.h"
@@ -83,6 +84,7 @@
 #include "rocksdb/table_pinning_policy.h"
 #include "rocksdb/utilities/backup_engine.h"
 #include "rocksdb/utilities/db_ttl.h"
+#include "rocksdb/utilities/local_compaction_service.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "rocksdb/utilities/optimistic_transaction_db.h"
 #include "rocksdb/utilities/options_type.h"
@@ -707,6 +709,10 @@ DEFINE_bool(universal_allow_trivial_move, false,
 DEFINE_bool(universal_incremental, false,
             "Enable incremental compactions in universal compaction.");
 
+DEFINE_bool(universal_fold_non_overlapping_sorted_runs, false,
+            "Fold non-overlapping sorted runs by trivial moves in universal "
+            "compaction.");
+
 DEFINE_int64(cache_size, 32 << 20,  // 32MB
              "Number of bytes to use as a cache of uncompressed data");
 
@@ -786,6 +792,11 @@ DEFINE_bool(partition_index, false, "Partition index blocks");
 
 DEFINE_bool(index_with_first_key, false, "Include first key in the index");
 
+DEFINE_bool(use_learned_index, false,
+            "Use kLearnedSearch instead of kBinarySearch. The generated keys "
+            "start with a big-endian number, which suits the learned model "
+            "unless --keys_per_prefix is set.");
+
 DEFINE_bool(
     optimize_filters_for_memory,
     ROCKSDB_NAMESPACE::BlockBasedTableOptions().optimize_filters_for_memory,
@@ -902,6 +913,14 @@ DEFINE_double(data_block_hash_table_util_ratio, 0.75,
               "This is only valid if use_data_block_hash_index is "
               "set to true");
 
+DEFINE_bool(data_block_restart_key_prefixes, false,
+            "Store fixed-width key prefixes of restart points in data "
+            "blocks to speed up seeks within a block");
+
+DEFINE_bool(data_block_columnar_entities, false,
+            "Store the columns of wide-column entities column-wise in data "
+            "blocks");
+
 DEFINE_int64(compressed_cache_size, -1,
              "Number of bytes to use as a cache of compressed data.");
 
@@ -923,6 +942,30 @@ DEFINE_int32(compaction_readahead_size,
                  ROCKSDB_NAMESPACE::Options().compaction_readahead_size),
              "Compaction readahead size");
 
+DEFINE_uint64(compaction_decompression_threads,
+              ROCKSDB_NAMESPACE::Options().compaction_decompression_threads,
+              "Number of threads per compaction input file that decompress "
+              "data blocks ahead of the compaction.");
+
+DEFINE_uint64(max_compaction_readahead_size,
+              ROCKSDB_NAMESPACE::Options().max_compaction_readahead_size,
+              "If non-zero, compaction inputs are read ahead asynchronously "
+              "with a readahead size that adapts to the storage, up to this "
+              "size.");
+
+DEFINE_int32(max_non_blocking_compact_range_jobs,
+             ROCKSDB_NAMESPACE::Options().max_non_blocking_compact_range_jobs,
+             "Maximum number of non-blocking manual compactions that run at "
+             "the same time.");
+
+DEFINE_int32(local_compaction_workers, 0,
+             "If positive, compactions run in this many worker processes of "
+             "a local compaction service, which execute this binary.");
+
+DEFINE_int32(local_compaction_worker_fd, -1,
+             "Internal: runs a local compaction service worker on this "
+             "socket instead of a benchmark.");
+
 DEFINE_int32(
     log_readahead_size,
     static_cast<int32_t>(ROCKSDB_NAMESPACE::Options().log_readahead_size),
@@ -1089,6 +1132,11 @@ DEFINE_uint64(periodic_compaction_seconds,
               "Files older than this will be picked up for compaction and"
               " rewritten to the same level");
 
+DEFINE_uint64(range_tombstone_compaction_budget,
+              ROCKSDB_NAMESPACE::Options().range_tombstone_compaction_budget,
+              "If positive, files whose range tombstones cover data in lower "
+              "levels are compacted, within this budget of covered bytes");
+
 DEFINE_uint64(ttl_seconds, ROCKSDB_NAMESPACE::Options().ttl, "Set options.ttl");
 
 static bool ValidateInt32Percent(const char* flagname, int32_t value) {
@@ -1393,11 +1441,21 @@ DEFINE_bool(async_io, ROCKSDB_NAMESPACE::ReadOptions().async_io,
             "When set true, asynchronous reads are used for internal auto "
             "readahead prefetching.");
 
+DEFINE_uint64(decompression_threads,
+              ROCKSDB_NAMESPACE::ReadOptions().decompression_threads,
+              "Number of threads per table file that decompress data blocks "
+              "ahead of long scans with fill_cache=false.");
+
 DEFINE_bool(optimize_multiget_for_io,
             ROCKSDB_NAMESPACE::ReadOptions().optimize_multiget_for_io,
             "When set true, asynchronous reads are done for SST files in "
             "multiple levels for MultiGet.");
 
+DEFINE_bool(multiget_single_round_io,
+            ROCKSDB_NAMESPACE::ReadOptions().multiget_single_round_io,
+            "When set true, MultiGet reads the data blocks it needs from all "
+            "levels in a single round of I/O before resolving the keys.");
+
 DEFINE_bool(charge_compression_dictionary_building_buffer, false,
             "Setting for "
             "CacheEntryRoleOptions::charged of "
@@ -1536,6 +1594,12 @@ DEFINE_bool(compression_use_zstd_dict_trainer,
             "If true, use ZSTD_TrainDictionary() to create dictionary, else"
             "use ZSTD_FinalizeDictionary() to create dictionary");
 
+DEFINE_bool(compression_use_shared_dict,
+            ROCKSDB_NAMESPACE::CompressionOptions().use_shared_dict,
+            "If true, train one dictionary per column family during "
+            "compactions and share it between SST files, instead of storing "
+            "a dictionary in every file");
+
 static bool ValidateTableCacheNumshardbits(const char* flagname,
                                            int32_t value) {
   if (0 >= value || value >= 20) {
@@ -1561,6 +1625,14 @@ DEFINE_string(fs_uri, "",
               "URI for registry Filesystem lookup. Mutually exclusive"
               " with --env_uri."
               " Creates a default environment with the specified filesystem.");
+DEFINE_bool(io_uring_sqpoll, false,
+            "Use the posix filesystem with io_uring_sqpoll=true, so MultiRead "
+            "submits to a kernel-polled queue and busy-polls completions. "
+            "Mutually exclusive with --env_uri and --fs_uri.");
+DEFINE_bool(io_uring_iopoll, false,
+            "Use the posix filesystem with io_uring_iopoll=true, so MultiRead "
+            "polls the device for completions. Requires --use_direct_reads. "
+            "Mutually exclusive with --env_uri and --fs_uri.");
 DEFINE_string(simulate_hybrid_fs_file, "",
               "File for Store Metadata for Simulate hybrid FS. Empty means "
               "disable the feature. Now, if it is set, last_level_temperature "
@@ -1678,6 +1750,10 @@ DEFINE_bool(rate_limiter_auto_tuned, false,
             "Enable dynamic adjustment of rate limit according to demand for "
             "background I/O");
 
+DEFINE_bool(rate_limiter_deadline, false,
+            "Use the deadline rate limiter (NewDeadlineRateLimiter()) instead "
+            "of the generic one");
+
 DEFINE_bool(sine_write_rate, false, "Use a sine wave write_rate_limit");
 
 DEFINE_uint64(
@@ -3787,7 +3863,10 @@ class Benchmark {
       read_options_.readahead_size = FLAGS_readahead_size;
       read_options_.adaptive_readahead = FLAGS_adaptive_readahead;
       read_options_.async_io = FLAGS_async_io;
+      read_options_.decompression_threads =
+          static_cast<size_t>(FLAGS_decompression_threads);
       read_options_.optimize_multiget_for_io = FLAGS_optimize_multiget_for_io;
+      read_options_.multiget_single_round_io = FLAGS_multiget_single_round_io;
       read_options_.skip_expired_data = FLAGS_skip_expired_data;
 
       void (Benchmark::*method)(ThreadState*) = nullptr;
@@ -4297,6 +4376,8 @@ class Benchmark {
     if (FLAGS_perf_level > ROCKSDB_NAMESPACE::PerfLevel::kDisable) {
       thread->stats.AddMessage(std::string("PERF_CONTEXT:\n") +
                                get_perf_context()->ToString());
+      thread->stats.AddMessage(std::string("IOSTATS_CONTEXT:\n") +
+                               get_iostats_context()->ToString(true));
     }
     thread->stats.Stop();
 
@@ -4568,6 +4649,8 @@ class Benchmark {
         FLAGS_compression_max_dict_buffer_bytes;
     options.compression_opts.use_zstd_dict_trainer =
         FLAGS_compression_use_zstd_dict_trainer;
+    options.compression_opts.use_shared_dict =
+        FLAGS_compression_use_shared_dict;
 
     options.max_open_files = FLAGS_open_files;
     options.arena_block_size = FLAGS_arena_block_size;
@@ -4620,6 +4703,27 @@ class Benchmark {
     options.bloom_locality = FLAGS_bloom_locality;
     options.max_file_opening_threads = FLAGS_file_opening_threads;
     options.compaction_readahead_size = FLAGS_compaction_readahead_size;
+    options.compaction_decompression_threads =
+        static_cast<size_t>(FLAGS_compaction_decompression_threads);
+    options.max_compaction_readahead_size = FLAGS_max_compaction_readahead_size;
+    options.max_non_blocking_compact_range_jobs =
+        FLAGS_max_non_blocking_compact_range_jobs;
+    if (FLAGS_local_compaction_workers > 0) {
+      static std::shared_ptr<CompactionService> local_compaction_service;
+      if (!local_compaction_service) {
+        LocalCompactionServiceOptions service_options;
+        service_options.num_workers = FLAGS_local_compaction_workers;
+        service_options.worker_command = {"/proc/self/exe"};
+        Status s = NewLocalCompactionService(service_options,
+                                             &local_compaction_service);
+        if (!s.ok()) {
+          fprintf(stderr, "Cannot start the local compaction service: %s\n",
+                  s.ToString().c_str());
+          exit(1);
+        }
+      }
+      options.compaction_service = local_compaction_service;
+    }
     options.log_readahead_size = FLAGS_log_readahead_size;
     options.random_access_max_buffer_size = FLAGS_random_access_max_buffer_size;
     options.writable_file_max_buffer_size = FLAGS_writable_file_max_buffer_size;
@@ -4684,6 +4788,8 @@ class Benchmark {
           ErrorExit("prefix_size not assigned when enable use_hash_search");
         }
         block_based_options.index_type = BlockBasedTableOptions::kHashSearch;
+      } else if (FLAGS_use_learned_index) {
+        block_based_options.index_type = BlockBasedTableOptions::kLearnedSearch;
       } else {
         block_based_options.index_type = BlockBasedTableOptions::kBinarySearch;
       }
@@ -4826,6 +4932,10 @@ class Benchmark {
       }
       block_based_options.data_block_hash_table_util_ratio =
           FLAGS_data_block_hash_table_util_ratio;
+      block_based_options.data_block_restart_key_prefixes =
+          FLAGS_data_block_restart_key_prefixes;
+      block_based_options.data_block_columnar_entities =
+          FLAGS_data_block_columnar_entities;
       if (FLAGS_read_cache_path != "") {
         Status rc_status;
 
@@ -4996,6 +5106,8 @@ class Benchmark {
     options.check_flush_compaction_key_order =
         FLAGS_check_flush_compaction_key_order;
     options.periodic_compaction_seconds = FLAGS_periodic_compaction_seconds;
+    options.range_tombstone_compaction_budget =
+        FLAGS_range_tombstone_compaction_budget;
     options.ttl = FLAGS_ttl_seconds;
     // fill storage options
     options.advise_random_on_open = FLAGS_advise_random_on_open;
@@ -5041,6 +5153,8 @@ class Benchmark {
         FLAGS_universal_allow_trivial_move;
     options.compaction_options_universal.incremental =
         FLAGS_universal_incremental;
+    options.compaction_options_universal.fold_non_overlapping_sorted_runs =
+        FLAGS_universal_fold_non_overlapping_sorted_runs;
     if (FLAGS_thread_status_per_interval > 0) {
       options.enable_thread_tracking = true;
     }
@@ -5201,7 +5315,14 @@ class Benchmark {
     }
 
     if (options.rate_limiter == nullptr) {
-      if (FLAGS_rate_limiter_bytes_per_sec > 0) {
+      if (FLAGS_rate_limiter_bytes_per_sec > 0 && FLAGS_rate_limiter_deadline) {
+        options.rate_limiter.reset(NewDeadlineRateLimiter(
+            FLAGS_rate_limiter_bytes_per_sec,
+            FLAGS_rate_limiter_refill_period_us, 20 /* urgent_reserve_pct */,
+            25 /* low_pri_pct_during_reads */,
+            FLAGS_rate_limit_bg_reads ? RateLimiter::Mode::kReadsOnly
+                                      : RateLimiter::Mode::kWritesOnly));
+      } else if (FLAGS_rate_limiter_bytes_per_sec > 0) {
         options.rate_limiter.reset(NewGenericRateLimiter(
             FLAGS_rate_limiter_bytes_per_sec,
             FLAGS_rate_limiter_refill_period_us, 10 /* fairness */,
@@ -9528,9 +9649,31 @@ void ValidateAndProcessEnvFlags(bool first_group,
     return;
   }
 
-  int env_opts = !FLAGS_env_uri.empty() + !FLAGS_fs_uri.empty();
+  int env_opts = !FLAGS_env_uri.empty() + !FLAGS_fs_uri.empty() +
+                 (FLAGS_io_uring_sqpoll || FLAGS_io_uring_iopoll);
   if (env_opts > 1) {
-    ErrorExit("--env_uri and --fs_uri are mutually exclusive");
+    ErrorExit(
+        "--env_uri, --fs_uri and --io_uring_sqpoll/iopoll are mutually "
+        "exclusive");
+  }
+  if (FLAGS_io_uring_iopoll && !FLAGS_use_direct_reads) {
+    ErrorExit("--io_uring_iopoll requires --use_direct_reads");
+  }
+
+  if (FLAGS_io_uring_sqpoll || FLAGS_io_uring_iopoll) {
+    std::shared_ptr<FileSystem> fs;
+    Status s = FileSystem::CreateFromString(
+        config_options,
+        std::string("id=posix;io_uring_sqpoll=") +
+            (FLAGS_io_uring_sqpoll ? "true" : "false") +
+            ";io_uring_iopoll=" + (FLAGS_io_uring_iopoll ? "true" : "false"),
+        &fs);
+    if (!s.ok()) {
+      ErrorExit("Failed creating filesystem: %s", s.ToString().c_str());
+    }
+    env_guard = NewCompositeEnv(fs);
+    FLAGS_env = env_guard.get();
+    return;
   }
 
   if (env_opts == 1) {
@@ -9663,6 +9806,13 @@ int db_bench_tool_run_group(int group_num, int num_groups, int argc,
   ParseCommandLineFlags(&argc, &argv, true);
   parsing_cmd_line_args = false;
 
+  if (FLAGS_local_compaction_worker_fd >= 0) {
+    // Started by the local compaction service of another db_bench
+    Status s = RunLocalCompactionServiceWorker(
+        FLAGS_local_compaction_worker_fd, CompactionServiceOptionsOverride());
+    return s.ok() ? 0 : 1;
+  }
+
   ValidateAndProcessStatisticsFlags(first_group, config_options);
   ValidateEnableSpeedbFlags();
 
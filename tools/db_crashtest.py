@@ -94,7 +94,7 @@ default_params = {
     "clear_column_family_one_in": 0,
     "compact_files_one_in": 1000000,
     "compact_range_one_in": 1000000,
-    "compaction_pri": random.randint(0, 4),
+    "compaction_pri": random.randint(0, 5),
     "data_block_index_type": lambda: random.choice([0, 1]),
     "destroy_db_initially": 0,
     "enable_pipelined_write": lambda: random.choice([0, 0, 0, 0, 1]),
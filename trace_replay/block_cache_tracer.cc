@@ -56,6 +56,7 @@ bool BlockCacheTraceHelper::IsUserAccess(TableReaderCaller caller) {
   return caller == TableReaderCaller::kUserGet ||
          caller == TableReaderCaller::kUserMultiGet ||
          caller == TableReaderCaller::kUserIterator ||
+         caller == TableReaderCaller::kUserIteratorLongScan ||
          caller == TableReaderCaller::kUserApproximateSize ||
          caller == TableReaderCaller::kUserVerifyChecksum;
 }
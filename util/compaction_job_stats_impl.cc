@@ -45,6 +45,10 @@ void CompactionJobStats::Reset() {
   file_fsync_nanos = 0;
   file_prepare_write_nanos = 0;
 
+  readahead_bytes = 0;
+  readahead_useful_bytes = 0;
+  readahead_stalls = 0;
+
   smallest_output_key_prefix.clear();
   largest_output_key_prefix.clear();
 
@@ -86,6 +90,10 @@ void CompactionJobStats::Add(const CompactionJobStats& stats) {
   file_fsync_nanos += stats.file_fsync_nanos;
   file_prepare_write_nanos += stats.file_prepare_write_nanos;
 
+  readahead_bytes += stats.readahead_bytes;
+  readahead_useful_bytes += stats.readahead_useful_bytes;
+  readahead_stalls += stats.readahead_stalls;
+
   num_single_del_fallthru += stats.num_single_del_fallthru;
   num_single_del_mismatch += stats.num_single_del_mismatch;
 }
@@ -0,0 +1,304 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/deadline_rate_limiter.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "monitoring/statistics_impl.h"
+#include "test_util/sync_point.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Pending request
+struct DeadlineRateLimiter::Req {
+  Req(int64_t _bytes, Env::IOPriority _pri, int64_t _deadline_us,
+      port::Mutex* _mu)
+      : request_bytes(_bytes), pri(_pri), deadline_us(_deadline_us), cv(_mu) {}
+  int64_t request_bytes;
+  const Env::IOPriority pri;
+  const int64_t deadline_us;
+  port::CondVar cv;
+};
+
+DeadlineRateLimiter::DeadlineRateLimiter(
+    int64_t rate_bytes_per_sec, int64_t refill_period_us,
+    int32_t urgent_reserve_pct, int32_t low_pri_pct_during_reads,
+    RateLimiter::Mode mode, const std::shared_ptr<SystemClock>& clock)
+    : RateLimiter(mode),
+      refill_period_us_(refill_period_us),
+      urgent_reserve_pct_(std::min(std::max(urgent_reserve_pct, 0), 99)),
+      low_pri_pct_during_reads_(
+          std::min(std::max(low_pri_pct_during_reads, 1), 100)),
+      clock_(clock),
+      rate_bytes_per_sec_(rate_bytes_per_sec),
+      refill_bytes_per_period_(
+          CalculateRefillBytesPerPeriod(rate_bytes_per_sec)),
+      last_foreground_read_us_(std::numeric_limits<int64_t>::min() / 2),
+      exit_cv_(&request_mutex_),
+      last_urgent_request_us_(std::numeric_limits<int64_t>::min() / 2),
+      next_refill_us_(NowMicrosMonotonic()) {
+  for (int i = Env::IO_LOW; i < Env::IO_TOTAL; ++i) {
+    total_requests_[i] = 0;
+    total_bytes_through_[i] = 0;
+  }
+}
+
+DeadlineRateLimiter::~DeadlineRateLimiter() {
+  MutexLock g(&request_mutex_);
+  stop_ = true;
+  for (auto* req : queue_) {
+    req->cv.Signal();
+  }
+  while (num_waiters_ > 0) {
+    exit_cv_.Wait();
+  }
+}
+
+void DeadlineRateLimiter::SetBytesPerSecond(int64_t bytes_per_second) {
+  assert(bytes_per_second > 0);
+  MutexLock g(&request_mutex_);
+  rate_bytes_per_sec_.store(bytes_per_second, std::memory_order_relaxed);
+  refill_bytes_per_period_.store(
+      CalculateRefillBytesPerPeriod(bytes_per_second),
+      std::memory_order_relaxed);
+}
+
+void DeadlineRateLimiter::Request(const int64_t bytes,
+                                  const Env::IOPriority pri, Statistics* stats,
+                                  OpType op_type) {
+  NoteForegroundRead(pri, op_type);
+  if (IsRateLimited(op_type)) {
+    Request(bytes, pri, stats);
+  }
+}
+
+size_t DeadlineRateLimiter::RequestToken(size_t bytes, size_t alignment,
+                                         Env::IOPriority io_priority,
+                                         Statistics* stats,
+                                         RateLimiter::OpType op_type) {
+  // The foreground reads are seen even when reads are not rate limited
+  NoteForegroundRead(io_priority, op_type);
+  return RateLimiter::RequestToken(bytes, alignment, io_priority, stats,
+                                   op_type);
+}
+
+void DeadlineRateLimiter::Request(int64_t bytes, const Env::IOPriority pri,
+                                  Statistics* stats) {
+  assert(bytes <= refill_bytes_per_period_.load(std::memory_order_relaxed));
+  assert(pri < Env::IO_TOTAL);
+  bytes = std::max(static_cast<int64_t>(0), bytes);
+  TEST_SYNC_POINT("DeadlineRateLimiter::Request");
+  MutexLock g(&request_mutex_);
+
+  if (stop_) {
+    return;
+  }
+
+  ++total_requests_[pri];
+
+  int64_t now_us = NowMicrosMonotonic();
+  if (IsUrgent(pri)) {
+    last_urgent_request_us_ = now_us;
+  }
+  if (queue_.empty() && now_us >= next_refill_us_) {
+    RefillBytesAndGrantRequestsLocked(now_us);
+  }
+  const int64_t deadline_us =
+      now_us + kDeadlinePeriods[pri] * refill_period_us_;
+  // Only the requests due earlier than the pending ones may bypass them
+  if (queue_.empty() || deadline_us < queue_.front()->deadline_us) {
+    const int64_t granted =
+        std::min(bytes, GrantableBytesLocked(pri, now_us));
+    ConsumeLocked(pri, granted);
+    bytes -= granted;
+  }
+  if (bytes == 0) {
+    return;
+  }
+
+  // Request cannot be satisfied at this moment, enqueue it after the requests
+  // due earlier or at the same time
+  Req r(bytes, pri, deadline_us, &request_mutex_);
+  queue_.insert(std::upper_bound(queue_.begin(), queue_.end(), deadline_us,
+                                 [](int64_t deadline, const Req* req) {
+                                   return deadline < req->deadline_us;
+                                 }),
+                &r);
+  ++num_waiters_;
+  RecordTick(stats, NUMBER_RATE_LIMITER_DRAINS);
+  TEST_SYNC_POINT_CALLBACK("DeadlineRateLimiter::Request:PostEnqueueRequest",
+                           &request_mutex_);
+
+  // Every waiter sleeps until the next refill, and the first one to wake up
+  // refills and grants the queue
+  while (!stop_ && r.request_bytes > 0) {
+    now_us = NowMicrosMonotonic();
+    if (now_us < next_refill_us_) {
+      r.cv.TimedWait(clock_->NowMicros() + (next_refill_us_ - now_us));
+    } else {
+      RefillBytesAndGrantRequestsLocked(now_us);
+    }
+  }
+
+  --num_waiters_;
+  if (stop_) {
+    // It is now in the clean-up of ~DeadlineRateLimiter(), the request may or
+    // may not have been satisfied
+    auto it = std::find(queue_.begin(), queue_.end(), &r);
+    if (it != queue_.end()) {
+      queue_.erase(it);
+    }
+    exit_cv_.Signal();
+  }
+}
+
+int64_t DeadlineRateLimiter::GetTotalBytesThrough(
+    const Env::IOPriority pri) const {
+  MutexLock g(&request_mutex_);
+  if (pri == Env::IO_TOTAL) {
+    int64_t total_bytes_through_sum = 0;
+    for (int i = Env::IO_LOW; i < Env::IO_TOTAL; ++i) {
+      total_bytes_through_sum += total_bytes_through_[i];
+    }
+    return total_bytes_through_sum;
+  }
+  return total_bytes_through_[pri];
+}
+
+int64_t DeadlineRateLimiter::GetTotalRequests(const Env::IOPriority pri) const {
+  MutexLock g(&request_mutex_);
+  if (pri == Env::IO_TOTAL) {
+    int64_t total_requests_sum = 0;
+    for (int i = Env::IO_LOW; i < Env::IO_TOTAL; ++i) {
+      total_requests_sum += total_requests_[i];
+    }
+    return total_requests_sum;
+  }
+  return total_requests_[pri];
+}
+
+Status DeadlineRateLimiter::GetTotalPendingRequests(
+    int64_t* total_pending_requests, const Env::IOPriority pri) const {
+  assert(total_pending_requests != nullptr);
+  MutexLock g(&request_mutex_);
+  *total_pending_requests = static_cast<int64_t>(
+      pri == Env::IO_TOTAL
+          ? queue_.size()
+          : std::count_if(queue_.begin(), queue_.end(),
+                          [pri](const Req* req) { return req->pri == pri; }));
+  return Status::OK();
+}
+
+int64_t DeadlineRateLimiter::CalculateRefillBytesPerPeriod(
+    int64_t rate_bytes_per_sec) const {
+  if (std::numeric_limits<int64_t>::max() / rate_bytes_per_sec <
+      refill_period_us_) {
+    // Avoid the overflow, the result is still large enough
+    return std::numeric_limits<int64_t>::max() / 1000000;
+  }
+  return std::max(static_cast<int64_t>(1),
+                  rate_bytes_per_sec * refill_period_us_ / 1000000);
+}
+
+void DeadlineRateLimiter::NoteForegroundRead(Env::IOPriority pri,
+                                             OpType op_type) {
+  if (pri == Env::IO_USER && op_type == OpType::kRead) {
+    last_foreground_read_us_.store(NowMicrosMonotonic(),
+                                   std::memory_order_relaxed);
+  }
+}
+
+int64_t DeadlineRateLimiter::GrantableBytesLocked(Env::IOPriority pri,
+                                                  int64_t now_us) const {
+  int64_t grantable = available_bytes_;
+  if (!IsUrgent(pri)) {
+    const int64_t refill_bytes =
+        refill_bytes_per_period_.load(std::memory_order_relaxed);
+    // The reserve is only held while there are urgent requests, and is
+    // otherwise granted to the lower priorities
+    if (now_us - last_urgent_request_us_ < refill_period_us_) {
+      grantable -= refill_bytes / 100 * urgent_reserve_pct_ +
+                   refill_bytes % 100 * urgent_reserve_pct_ / 100;
+    }
+    if (pri == Env::IO_LOW &&
+        now_us - last_foreground_read_us_.load(std::memory_order_relaxed) <
+            refill_period_us_) {
+      const int64_t low_pri_bytes =
+          std::max(static_cast<int64_t>(1),
+                   refill_bytes / 100 * low_pri_pct_during_reads_ +
+                       refill_bytes % 100 * low_pri_pct_during_reads_ / 100);
+      grantable = std::min(grantable, low_pri_bytes - low_pri_bytes_in_period_);
+    }
+  }
+  return std::max(static_cast<int64_t>(0), grantable);
+}
+
+void DeadlineRateLimiter::ConsumeLocked(Env::IOPriority pri, int64_t bytes) {
+  assert(bytes <= available_bytes_);
+  available_bytes_ -= bytes;
+  total_bytes_through_[pri] += bytes;
+  if (pri == Env::IO_LOW) {
+    low_pri_bytes_in_period_ += bytes;
+  }
+}
+
+void DeadlineRateLimiter::RefillBytesAndGrantRequestsLocked(int64_t now_us) {
+  TEST_SYNC_POINT_CALLBACK(
+      "DeadlineRateLimiter::RefillBytesAndGrantRequestsLocked",
+      &request_mutex_);
+  next_refill_us_ = now_us + refill_period_us_;
+  // The leftover of the last period is not carried over
+  available_bytes_ = refill_bytes_per_period_.load(std::memory_order_relaxed);
+  low_pri_bytes_in_period_ = 0;
+  // Pending urgent requests hold the reserve for this period as well
+  if (std::any_of(queue_.begin(), queue_.end(),
+                  [](const Req* req) { return IsUrgent(req->pri); })) {
+    last_urgent_request_us_ = now_us;
+  }
+
+  // Grant in deadline order, as much as each priority may get. The requests
+  // of the priorities that ran out of bytes for this period do not block the
+  // others.
+  for (auto it = queue_.begin();
+       it != queue_.end() && available_bytes_ > 0;) {
+    Req* req = *it;
+    const int64_t granted =
+        std::min(req->request_bytes, GrantableBytesLocked(req->pri, now_us));
+    ConsumeLocked(req->pri, granted);
+    req->request_bytes -= granted;
+    if (req->request_bytes == 0) {
+      it = queue_.erase(it);
+      // Quota granted, signal the thread to exit
+      req->cv.Signal();
+    } else {
+      ++it;
+    }
+  }
+}
+
+RateLimiter* NewDeadlineRateLimiter(
+    int64_t rate_bytes_per_sec, int64_t refill_period_us /* = 100 * 1000 */,
+    int32_t urgent_reserve_pct /* = 20 */,
+    int32_t low_pri_pct_during_reads /* = 25 */,
+    RateLimiter::Mode mode /* = RateLimiter::Mode::kWritesOnly */) {
+  assert(rate_bytes_per_sec > 0);
+  assert(refill_period_us > 0);
+  return new DeadlineRateLimiter(rate_bytes_per_sec, refill_period_us,
+                                 urgent_reserve_pct, low_pri_pct_during_reads,
+                                 mode, SystemClock::Default());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
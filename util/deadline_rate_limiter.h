@@ -0,0 +1,135 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+
+#include "port/port.h"
+#include "rocksdb/env.h"
+#include "rocksdb/rate_limiter.h"
+#include "rocksdb/status.h"
+#include "rocksdb/system_clock.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A rate limiter that grants pending requests by deadline, reserves a part of
+// the bandwidth for urgent requests while there are any and throttles low
+// priority requests further while there are foreground reads (see
+// NewDeadlineRateLimiter()).
+//
+// Like GenericRateLimiter, the bytes are refilled once per refill period, and
+// the leftover of a period is not carried over. Requests that cannot be
+// granted right away are queued, and the first waiter that reaches the
+// refill time refills and grants the queue in deadline order. A request
+// larger than what its priority may use in a period is granted partially in
+// consecutive periods.
+class DeadlineRateLimiter : public RateLimiter {
+ public:
+  DeadlineRateLimiter(int64_t rate_bytes_per_sec, int64_t refill_period_us,
+                      int32_t urgent_reserve_pct,
+                      int32_t low_pri_pct_during_reads, RateLimiter::Mode mode,
+                      const std::shared_ptr<SystemClock>& clock);
+
+  ~DeadlineRateLimiter() override;
+
+  void SetBytesPerSecond(int64_t bytes_per_second) override;
+
+  using RateLimiter::Request;
+  void Request(const int64_t bytes, const Env::IOPriority pri,
+               Statistics* stats) override;
+  void Request(const int64_t bytes, const Env::IOPriority pri,
+               Statistics* stats, OpType op_type) override;
+
+  size_t RequestToken(size_t bytes, size_t alignment,
+                      Env::IOPriority io_priority, Statistics* stats,
+                      RateLimiter::OpType op_type) override;
+
+  int64_t GetSingleBurstBytes() const override {
+    return refill_bytes_per_period_.load(std::memory_order_relaxed);
+  }
+
+  int64_t GetTotalBytesThrough(
+      const Env::IOPriority pri = Env::IO_TOTAL) const override;
+
+  int64_t GetTotalRequests(
+      const Env::IOPriority pri = Env::IO_TOTAL) const override;
+
+  Status GetTotalPendingRequests(
+      int64_t* total_pending_requests,
+      const Env::IOPriority pri = Env::IO_TOTAL) const override;
+
+  int64_t GetBytesPerSecond() const override {
+    return rate_bytes_per_sec_.load(std::memory_order_relaxed);
+  }
+
+  bool SchedulesByDeadline() const override { return true; }
+
+ private:
+  struct Req;
+
+  // The deadline of the requests of each priority, in refill periods
+  static constexpr int64_t kDeadlinePeriods[Env::IO_TOTAL] = {16, 4, 1, 0};
+
+  static bool IsUrgent(Env::IOPriority pri) {
+    return pri == Env::IO_HIGH || pri == Env::IO_USER;
+  }
+
+  int64_t CalculateRefillBytesPerPeriod(int64_t rate_bytes_per_sec) const;
+  void NoteForegroundRead(Env::IOPriority pri, OpType op_type);
+  // Returns how many of the available bytes a request of `pri` may get
+  int64_t GrantableBytesLocked(Env::IOPriority pri, int64_t now_us) const;
+  void ConsumeLocked(Env::IOPriority pri, int64_t bytes);
+  void RefillBytesAndGrantRequestsLocked(int64_t now_us);
+
+  int64_t NowMicrosMonotonic() const {
+    return static_cast<int64_t>(clock_->NowNanos() / std::milli::den);
+  }
+
+  const int64_t refill_period_us_;
+  const int32_t urgent_reserve_pct_;
+  const int32_t low_pri_pct_during_reads_;
+  const std::shared_ptr<SystemClock> clock_;
+
+  std::atomic<int64_t> rate_bytes_per_sec_;
+  std::atomic<int64_t> refill_bytes_per_period_;
+  // The time of the last foreground read, or a time long enough ago
+  std::atomic<int64_t> last_foreground_read_us_;
+
+  // This mutex guards all the state below
+  mutable port::Mutex request_mutex_;
+  bool stop_ = false;
+  port::CondVar exit_cv_;
+  // The number of threads waiting in Request()
+  int32_t num_waiters_ = 0;
+
+  int64_t total_requests_[Env::IO_TOTAL];
+  int64_t total_bytes_through_[Env::IO_TOTAL];
+  // The last time an Env::IO_USER or Env::IO_HIGH request was made or
+  // pending at a refill, or a time long enough ago
+  int64_t last_urgent_request_us_;
+  int64_t available_bytes_ = 0;
+  // The bytes granted to Env::IO_LOW requests in the current period
+  int64_t low_pri_bytes_in_period_ = 0;
+  int64_t next_refill_us_;
+
+  // Pending requests, ordered by deadline
+  std::deque<Req*> queue_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -13,7 +13,9 @@ int main() {
 
 #include "file/writable_file_writer.h"
 #include "monitoring/histogram.h"
+#include "rocksdb/convenience.h"
 #include "rocksdb/env.h"
+#include "rocksdb/file_system.h"
 #include "rocksdb/system_clock.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
@@ -29,17 +31,30 @@ DEFINE_int32(record_size, 249, "Size of each record.");
 DEFINE_int32(record_interval, 10000, "Interval between records (microSec)");
 DEFINE_int32(bytes_per_sync, 0, "bytes_per_sync parameter in EnvOptions");
 DEFINE_bool(enable_sync, false, "sync after each write.");
+DEFINE_bool(use_io_uring, false,
+            "write the log through io_uring, if it is available.");
+DEFINE_bool(compare_io_uring, false,
+            "run the benchmark with both blocking writes and io_uring.");
 
 namespace ROCKSDB_NAMESPACE {
-void RunBenchmark() {
+void RunBenchmark(const char* label, bool use_io_uring) {
   std::string file_name = test::PerThreadDBPath("log_write_benchmark.log");
   DBOptions options;
   Env* env = Env::Default();
   const auto& clock = env->GetSystemClock();
   EnvOptions env_options = env->OptimizeForLogWrite(EnvOptions(), options);
   env_options.bytes_per_sync = FLAGS_bytes_per_sync;
-  std::unique_ptr<WritableFile> file;
-  env->NewWritableFile(file_name, &file, env_options);
+  std::shared_ptr<FileSystem> fs;
+  Status s = FileSystem::CreateFromString(
+      ConfigOptions(),
+      use_io_uring ? "id=posix; io_uring_write=true" : "id=posix", &fs);
+  if (!s.ok()) {
+    fprintf(stderr, "Failed to create the file system: %s\n",
+            s.ToString().c_str());
+    return;
+  }
+  std::unique_ptr<FSWritableFile> file;
+  fs->NewWritableFile(file_name, FileOptions(env_options), &file, nullptr);
   std::unique_ptr<WritableFileWriter> writer;
   writer.reset(new WritableFileWriter(std::move(file), file_name, env_options,
                                       clock, nullptr /* stats */,
@@ -71,7 +86,8 @@ void RunBenchmark() {
     }
   }
 
-  fprintf(stderr, "Distribution of latency of append+flush: \n%s",
+  writer->Close();
+  fprintf(stderr, "Distribution of latency of append+flush (%s): \n%s", label,
           hist.ToString().c_str());
 }
 }  // namespace ROCKSDB_NAMESPACE
@@ -81,7 +97,12 @@ int main(int argc, char** argv) {
                   " [OPTIONS]...");
   ParseCommandLineFlags(&argc, &argv, true);
 
-  ROCKSDB_NAMESPACE::RunBenchmark();
+  if (FLAGS_compare_io_uring || !FLAGS_use_io_uring) {
+    ROCKSDB_NAMESPACE::RunBenchmark("blocking writes", false);
+  }
+  if (FLAGS_compare_io_uring || FLAGS_use_io_uring) {
+    ROCKSDB_NAMESPACE::RunBenchmark("io_uring", true);
+  }
   return 0;
 }
 
@@ -17,6 +17,7 @@
 #include "rocksdb/system_clock.h"
 #include "test_util/sync_point.h"
 #include "test_util/testharness.h"
+#include "util/deadline_rate_limiter.h"
 #include "util/random.h"
 #include "util/rate_limiter_impl.h"
 
@@ -511,6 +512,109 @@ TEST_F(RateLimiterTest, AutoTuneIncreaseWhenFull) {
   ASSERT_LT(new_bytes_per_sec, orig_bytes_per_sec);
 }
 
+class DeadlineRateLimiterTest : public RateLimiterTest {
+ protected:
+  // 1000 bytes per refill period of 1 second
+  static constexpr int64_t kRefillPeriodUs = 1000 * 1000;
+
+  DeadlineRateLimiterTest()
+      : special_env_(Env::Default(), /*time_elapse_only_sleep*/ true),
+        limiter_(1000 /* rate_bytes_per_sec */, kRefillPeriodUs,
+                 20 /* urgent_reserve_pct */,
+                 25 /* low_pri_pct_during_reads */,
+                 RateLimiter::Mode::kWritesOnly,
+                 special_env_.GetSystemClock()) {}
+
+  void WaitForPendingRequests(int64_t expected) {
+    int64_t pending = -1;
+    while (pending != expected) {
+      ASSERT_OK(limiter_.GetTotalPendingRequests(&pending));
+      std::this_thread::yield();
+    }
+  }
+
+  SpecialEnv special_env_;
+  DeadlineRateLimiter limiter_;
+};
+
+TEST_F(DeadlineRateLimiterTest, ReserveAndDeadlines) {
+  // The urgent requests get the reserved 20%
+  limiter_.Request(800, Env::IO_LOW, nullptr /* stats */,
+                   RateLimiter::OpType::kWrite);
+  limiter_.Request(200, Env::IO_USER, nullptr /* stats */,
+                   RateLimiter::OpType::kWrite);
+  ASSERT_EQ(800, limiter_.GetTotalBytesThrough(Env::IO_LOW));
+  ASSERT_EQ(200, limiter_.GetTotalBytesThrough(Env::IO_USER));
+
+  // A flush queued after a compaction is due earlier, and is granted first
+  port::Thread low_pri([&]() {
+    limiter_.Request(500, Env::IO_LOW, nullptr /* stats */,
+                     RateLimiter::OpType::kWrite);
+  });
+  WaitForPendingRequests(1);
+  port::Thread high_pri([&]() {
+    limiter_.Request(500, Env::IO_HIGH, nullptr /* stats */,
+                     RateLimiter::OpType::kWrite);
+  });
+  WaitForPendingRequests(2);
+  special_env_.SleepForMicroseconds(kRefillPeriodUs);
+  high_pri.join();
+  // The compaction got the unreserved part of the rest of the period
+  WaitForPendingRequests(1);
+  ASSERT_EQ(500, limiter_.GetTotalBytesThrough(Env::IO_HIGH));
+  ASSERT_EQ(1100, limiter_.GetTotalBytesThrough(Env::IO_LOW));
+
+  special_env_.SleepForMicroseconds(kRefillPeriodUs);
+  low_pri.join();
+  ASSERT_EQ(1300, limiter_.GetTotalBytesThrough(Env::IO_LOW));
+}
+
+TEST_F(DeadlineRateLimiterTest, SoftReserve) {
+  // Without urgent requests, the reserve is granted to compactions
+  limiter_.Request(1000, Env::IO_LOW, nullptr /* stats */,
+                   RateLimiter::OpType::kWrite);
+  ASSERT_EQ(1000, limiter_.GetTotalBytesThrough(Env::IO_LOW));
+
+  // And held for a refill period after an urgent request
+  special_env_.SleepForMicroseconds(kRefillPeriodUs);
+  limiter_.Request(100, Env::IO_HIGH, nullptr /* stats */,
+                   RateLimiter::OpType::kWrite);
+  port::Thread low_pri([&]() {
+    limiter_.Request(900, Env::IO_LOW, nullptr /* stats */,
+                     RateLimiter::OpType::kWrite);
+  });
+  WaitForPendingRequests(1);
+  ASSERT_EQ(1700, limiter_.GetTotalBytesThrough(Env::IO_LOW));
+
+  special_env_.SleepForMicroseconds(kRefillPeriodUs);
+  low_pri.join();
+  ASSERT_EQ(1900, limiter_.GetTotalBytesThrough(Env::IO_LOW));
+}
+
+TEST_F(DeadlineRateLimiterTest, ThrottleDuringForegroundReads) {
+  // Reads are not rate limited, but are still seen
+  ASSERT_EQ(100, limiter_.RequestToken(100, 0 /* alignment */, Env::IO_USER,
+                                       nullptr /* stats */,
+                                       RateLimiter::OpType::kRead));
+  ASSERT_EQ(0, limiter_.GetTotalRequests());
+
+  // Low priority requests get 25% of the period while there are reads
+  port::Thread low_pri([&]() {
+    limiter_.Request(400, Env::IO_LOW, nullptr /* stats */,
+                     RateLimiter::OpType::kWrite);
+  });
+  WaitForPendingRequests(1);
+  ASSERT_EQ(250, limiter_.GetTotalBytesThrough(Env::IO_LOW));
+  limiter_.Request(300, Env::IO_MID, nullptr /* stats */,
+                   RateLimiter::OpType::kWrite);
+  ASSERT_EQ(300, limiter_.GetTotalBytesThrough(Env::IO_MID));
+
+  // And the unreserved bytes again after the reads
+  special_env_.SleepForMicroseconds(kRefillPeriodUs);
+  low_pri.join();
+  ASSERT_EQ(400, limiter_.GetTotalBytesThrough(Env::IO_LOW));
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -0,0 +1,460 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rocksdb/utilities/local_compaction_service.h"
+
+#ifndef OS_WIN
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif  // OS_WIN
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+
+#include "db/compaction/compaction_job.h"
+#include "port/port.h"
+#include "rocksdb/db.h"
+#include "rocksdb/env.h"
+#include "test_util/sync_point.h"
+#include "util/coding.h"
+#include "util/mutexlock.h"
+
+#ifndef OS_WIN
+extern "C" char** environ;
+#endif  // OS_WIN
+
+namespace ROCKSDB_NAMESPACE {
+
+const char* kLocalCompactionWorkerFdArg = "--local_compaction_worker_fd=";
+
+#ifndef OS_WIN
+namespace {
+
+// Requests and replies are sent as a fixed32 length followed by the payload.
+// A request holds the DB name, the output directory and the compaction input;
+// a reply holds whether the compaction succeeded and the compaction result.
+Status WriteFrame(int fd, const std::string& payload) {
+  std::string buf;
+  PutFixed32(&buf, static_cast<uint32_t>(payload.size()));
+  buf.append(payload);
+  size_t done = 0;
+  while (done < buf.size()) {
+    ssize_t n = send(fd, buf.data() + done, buf.size() - done, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status::IOError("Local compaction send failed", strerror(errno));
+    }
+    done += static_cast<size_t>(n);
+  }
+  return Status::OK();
+}
+
+// Returns Status::Incomplete() once the other side closed the socket
+Status ReadFully(int fd, char* buf, size_t len) {
+  size_t done = 0;
+  while (done < len) {
+    ssize_t n = recv(fd, buf + done, len - done, 0);
+    if (n == 0) {
+      return Status::Incomplete("Local compaction socket closed");
+    }
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status::IOError("Local compaction recv failed", strerror(errno));
+    }
+    done += static_cast<size_t>(n);
+  }
+  return Status::OK();
+}
+
+Status ReadFrame(int fd, std::string* payload) {
+  char header[sizeof(uint32_t)];
+  Status s = ReadFully(fd, header, sizeof(header));
+  if (!s.ok()) {
+    return s;
+  }
+  payload->resize(DecodeFixed32(header));
+  if (payload->empty()) {
+    return Status::OK();
+  }
+  return ReadFully(fd, &(*payload)[0], payload->size());
+}
+
+// Takes the options that are not overridden from the compaction input
+void FillOptionsOverride(const std::string& input,
+                         CompactionServiceOptionsOverride* options_override) {
+  if (options_override->env == nullptr) {
+    options_override->env = Env::Default();
+  }
+  CompactionServiceInput compaction_input;
+  if (!CompactionServiceInput::Read(input, &compaction_input).ok()) {
+    // OpenAndCompact() reports the error
+    return;
+  }
+  const ColumnFamilyOptions& cf_options =
+      compaction_input.column_family.options;
+  if (options_override->comparator == nullptr) {
+    options_override->comparator = cf_options.comparator;
+  }
+  if (options_override->merge_operator == nullptr) {
+    options_override->merge_operator = cf_options.merge_operator;
+  }
+  if (options_override->compaction_filter_factory == nullptr) {
+    options_override->compaction_filter_factory =
+        cf_options.compaction_filter_factory;
+  }
+  if (options_override->prefix_extractor == nullptr) {
+    options_override->prefix_extractor = cf_options.prefix_extractor;
+  }
+  if (options_override->table_factory == nullptr) {
+    options_override->table_factory = cf_options.table_factory;
+  }
+  if (options_override->sst_partitioner_factory == nullptr) {
+    options_override->sst_partitioner_factory =
+        cf_options.sst_partitioner_factory;
+  }
+  if (options_override->table_properties_collector_factories.empty()) {
+    options_override->table_properties_collector_factories =
+        cf_options.table_properties_collector_factories;
+  }
+}
+
+class LocalCompactionService : public CompactionService {
+ public:
+  explicit LocalCompactionService(const LocalCompactionServiceOptions& options)
+      : options_(options),
+        env_(Env::Default()),
+        cv_(&mutex_),
+        workers_(static_cast<size_t>(std::max(options.num_workers, 1))) {}
+
+  ~LocalCompactionService() override {
+    MutexLock l(&mutex_);
+    for (auto& worker : workers_) {
+      StopWorker(&worker);
+    }
+    DeleteFinishedOutputs();
+  }
+
+  static const char* kClassName() { return "LocalCompactionService"; }
+
+  const char* Name() const override { return kClassName(); }
+
+  Status StartWorkers() {
+    MutexLock l(&mutex_);
+    for (auto& worker : workers_) {
+      Status s = StartWorker(&worker);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    return Status::OK();
+  }
+
+  CompactionServiceJobStatus StartV2(
+      const CompactionServiceJobInfo& info,
+      const std::string& compaction_service_input) override {
+    MutexLock l(&mutex_);
+    jobs_[JobKey(info)] = compaction_service_input;
+    return CompactionServiceJobStatus::kSuccess;
+  }
+
+  CompactionServiceJobStatus WaitForCompleteV2(
+      const CompactionServiceJobInfo& info,
+      std::string* compaction_service_result) override {
+    std::string input;
+    Worker* worker = nullptr;
+    {
+      MutexLock l(&mutex_);
+      auto it = jobs_.find(JobKey(info));
+      if (it == jobs_.end()) {
+        return CompactionServiceJobStatus::kFailure;
+      }
+      input = std::move(it->second);
+      jobs_.erase(it);
+      DeleteFinishedOutputs();
+      worker = AcquireWorker();
+    }
+    if (worker == nullptr) {
+      return CompactionServiceJobStatus::kUseLocal;
+    }
+
+    const std::string output_root = options_.output_root.empty()
+                                        ? info.db_name + "/local_compaction"
+                                        : options_.output_root;
+    const std::string output_dir =
+        output_root + "/" + info.db_session_id + "-" +
+        std::to_string(info.job_id);
+    std::string request;
+    PutLengthPrefixedSlice(&request, info.db_name);
+    PutLengthPrefixedSlice(&request, output_dir);
+    PutLengthPrefixedSlice(&request, input);
+    std::string reply;
+    Status s = env_->CreateDirIfMissing(output_root);
+    if (s.ok()) {
+      s = WriteFrame(worker->fd, request);
+    }
+    if (s.ok()) {
+      s = ReadFrame(worker->fd, &reply);
+    }
+    Slice result;
+    bool compacted = false;
+    if (s.ok()) {
+      Slice in(reply);
+      if (in.empty()) {
+        s = Status::Corruption("Invalid local compaction reply");
+      } else {
+        compacted = in[0] != 0;
+        in.remove_prefix(1);
+        if (!GetLengthPrefixedSlice(&in, &result)) {
+          s = Status::Corruption("Invalid local compaction reply");
+        }
+      }
+    }
+
+    MutexLock l(&mutex_);
+    if (!s.ok()) {
+      // The worker died, or cannot be trusted anymore. The compaction runs
+      // in the DB process instead.
+      StopWorker(worker);
+      StartWorker(worker).PermitUncheckedError();
+      ReleaseWorker(worker);
+      DeleteOutput(output_dir);
+      return CompactionServiceJobStatus::kUseLocal;
+    }
+    ReleaseWorker(worker);
+    compaction_service_result->assign(result.data(), result.size());
+    if (!compacted) {
+      DeleteOutput(output_dir);
+      return CompactionServiceJobStatus::kFailure;
+    }
+    // The DB moves the output files in once this returns
+    finished_outputs_.push_back(output_dir);
+    return CompactionServiceJobStatus::kSuccess;
+  }
+
+ private:
+  struct Worker {
+    pid_t pid = -1;
+    int fd = -1;
+    bool busy = false;
+  };
+
+  static std::string JobKey(const CompactionServiceJobInfo& info) {
+    return info.db_session_id + "/" + std::to_string(info.job_id);
+  }
+
+  // Spawns the worker command, which inherits only its end of the socket.
+  // REQUIRES: mutex_ held
+  Status StartWorker(Worker* worker) {
+    mutex_.AssertHeld();
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+      return Status::IOError("Local compaction socketpair failed",
+                             strerror(errno));
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+
+    std::vector<std::string> args = options_.worker_command;
+    args.push_back(kLocalCompactionWorkerFdArg + std::to_string(fds[1]));
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+      argv.push_back(&arg[0]);
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid;
+    int err = posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(),
+                           environ);
+    close(fds[1]);
+    if (err != 0) {
+      close(fds[0]);
+      return Status::IOError("Local compaction worker spawn failed",
+                             args[0] + ": " + strerror(err));
+    }
+    worker->pid = pid;
+    worker->fd = fds[0];
+    return Status::OK();
+  }
+
+  // REQUIRES: mutex_ held
+  void StopWorker(Worker* worker) {
+    mutex_.AssertHeld();
+    if (worker->pid < 0) {
+      return;
+    }
+    // Closing the socket ends the worker loop
+    close(worker->fd);
+    if (worker->busy) {
+      kill(worker->pid, SIGKILL);
+    }
+    while (waitpid(worker->pid, nullptr, 0) < 0 && errno == EINTR) {
+    }
+    worker->pid = -1;
+    worker->fd = -1;
+  }
+
+  // Returns an idle worker, or nullptr if no worker is left.
+  // REQUIRES: mutex_ held
+  Worker* AcquireWorker() {
+    mutex_.AssertHeld();
+    while (true) {
+      bool any_alive = false;
+      for (auto& worker : workers_) {
+        if (worker.pid < 0) {
+          continue;
+        }
+        any_alive = true;
+        if (!worker.busy) {
+          worker.busy = true;
+          return &worker;
+        }
+      }
+      if (!any_alive) {
+        return nullptr;
+      }
+      cv_.Wait();
+    }
+  }
+
+  // REQUIRES: mutex_ held
+  void ReleaseWorker(Worker* worker) {
+    mutex_.AssertHeld();
+    worker->busy = false;
+    // Waiters also need to know when no worker is left
+    cv_.SignalAll();
+  }
+
+  void DeleteOutput(const std::string& dir) {
+    std::vector<std::string> children;
+    if (env_->GetChildren(dir, &children).ok()) {
+      for (const auto& child : children) {
+        env_->DeleteFile(dir + "/" + child).PermitUncheckedError();
+      }
+    }
+    env_->DeleteDir(dir).PermitUncheckedError();
+  }
+
+  // Deletes the output directories of the jobs whose table files were moved
+  // into their DB. REQUIRES: mutex_ held
+  void DeleteFinishedOutputs() {
+    mutex_.AssertHeld();
+    for (auto it = finished_outputs_.begin(); it != finished_outputs_.end();) {
+      std::vector<std::string> children;
+      bool installed = true;
+      if (env_->GetChildren(*it, &children).ok()) {
+        for (const auto& child : children) {
+          if (Slice(child).ends_with(".sst") ||
+              Slice(child).ends_with(".blob")) {
+            installed = false;
+            break;
+          }
+        }
+      }
+      if (installed) {
+        DeleteOutput(*it);
+        it = finished_outputs_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  const LocalCompactionServiceOptions options_;
+  Env* const env_;
+
+  port::Mutex mutex_;
+  port::CondVar cv_;
+  std::vector<Worker> workers_;
+  std::map<std::string, std::string> jobs_;
+  std::vector<std::string> finished_outputs_;
+};
+
+}  // namespace
+
+Status NewLocalCompactionService(const LocalCompactionServiceOptions& options,
+                                 std::shared_ptr<CompactionService>* service) {
+  if (options.worker_command.empty()) {
+    return Status::InvalidArgument(
+        "Local compaction service requires a worker_command");
+  }
+  auto local_service = std::make_shared<LocalCompactionService>(options);
+  Status s = local_service->StartWorkers();
+  if (s.ok()) {
+    *service = std::move(local_service);
+  }
+  return s;
+}
+
+Status RunLocalCompactionServiceWorker(
+    int fd, const CompactionServiceOptionsOverride& options_override) {
+  while (true) {
+    std::string request;
+    Status s = ReadFrame(fd, &request);
+    if (s.IsIncomplete()) {
+      // The service is gone
+      return Status::OK();
+    }
+    if (!s.ok()) {
+      return s;
+    }
+    Slice in(request);
+    Slice name;
+    Slice output_dir;
+    Slice input;
+    if (!GetLengthPrefixedSlice(&in, &name) ||
+        !GetLengthPrefixedSlice(&in, &output_dir) ||
+        !GetLengthPrefixedSlice(&in, &input)) {
+      return Status::Corruption("Invalid local compaction request");
+    }
+    CompactionServiceOptionsOverride job_options_override = options_override;
+    FillOptionsOverride(input.ToString(), &job_options_override);
+    TEST_SYNC_POINT("RunLocalCompactionServiceWorker:BeforeCompaction");
+
+    std::string result;
+    s = DB::OpenAndCompact(name.ToString(), output_dir.ToString(),
+                           input.ToString(), &result, job_options_override);
+    std::string reply(1, s.ok() ? 1 : 0);
+    PutLengthPrefixedSlice(&reply, result);
+    s = WriteFrame(fd, reply);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+}
+
+#else  // OS_WIN
+
+Status NewLocalCompactionService(
+    const LocalCompactionServiceOptions& /*options*/,
+    std::shared_ptr<CompactionService>* /*service*/) {
+  return Status::NotSupported("Local compaction service is not supported");
+}
+
+Status RunLocalCompactionServiceWorker(
+    int /*fd*/, const CompactionServiceOptionsOverride& /*options_override*/) {
+  return Status::NotSupported("Local compaction service is not supported");
+}
+
+#endif  // OS_WIN
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -9,11 +9,16 @@
 
 #include "db/dbformat.h"
 #include "rocksdb/trace_record.h"
+#include "util/cast_util.h"
+#include "util/hash.h"
 
 namespace ROCKSDB_NAMESPACE {
 
 namespace {
 const std::string kGhostCachePrefix = "ghost_";
+const std::string kTinyLfuPrefix = "tinylfu_";
+// Used to size the TinyLFU frequency sketch
+const uint64_t kTinyLfuEstimatedEntryCharge = 4096;
 }  // namespace
 
 GhostCache::GhostCache(std::shared_ptr<Cache> sim_cache)
@@ -36,13 +41,31 @@ CacheSimulator::CacheSimulator(std::unique_ptr<GhostCache>&& ghost_cache,
                                std::shared_ptr<Cache> sim_cache)
     : ghost_cache_(std::move(ghost_cache)), sim_cache_(sim_cache) {}
 
+bool CacheSimulator::Admit(const Slice& key, uint64_t charge) {
+  bool admit = true;
+  if (ghost_cache_) {
+    admit = ghost_cache_->Admit(key);
+  }
+  if (sketch_) {
+    const uint64_t hash = GetSliceNPHash64(key);
+    sketch_->Increment(hash);
+    std::string victim_key;
+    if (admit && static_cast_with_check<LRUCache>(sim_cache_.get())
+                     ->GetEvictionCandidate(key, charge, &victim_key)) {
+      admit = sketch_->Estimate(hash) >
+              sketch_->Estimate(GetSliceNPHash64(victim_key));
+    }
+  }
+  return admit;
+}
+
 void CacheSimulator::Access(const BlockCacheTraceRecord& access) {
   bool admit = true;
   const bool is_user_access =
       BlockCacheTraceHelper::IsUserAccess(access.caller);
   bool is_cache_miss = true;
-  if (ghost_cache_ && !access.no_insert) {
-    admit = ghost_cache_->Admit(access.block_key);
+  if (!access.no_insert) {
+    admit = Admit(access.block_key, access.block_size);
   }
   auto handle = sim_cache_->Lookup(access.block_key);
   if (handle != nullptr) {
@@ -88,6 +111,9 @@ Cache::Priority PrioritizedCacheSimulator::ComputeBlockPriority(
       access.block_type == TraceType::kBlockTraceUncompressionDictBlock) {
     return Cache::Priority::HIGH;
   }
+  if (access.caller == TableReaderCaller::kUserIteratorLongScan) {
+    return Cache::Priority::BOTTOM;
+  }
   return Cache::Priority::LOW;
 }
 
@@ -99,8 +125,8 @@ void PrioritizedCacheSimulator::AccessKVPair(
   assert(admitted);
   *is_cache_miss = true;
   *admitted = true;
-  if (ghost_cache_ && !no_insert) {
-    *admitted = ghost_cache_->Admit(key);
+  if (!no_insert) {
+    *admitted = Admit(key, value_size);
   }
   auto handle = sim_cache_->Lookup(key);
   if (handle != nullptr) {
@@ -218,6 +244,11 @@ Status BlockCacheTraceSimulator::InitializeCaches() {
       std::shared_ptr<CacheSimulator> sim_cache;
       std::unique_ptr<GhostCache> ghost_cache;
       std::string cache_name = config.cache_name;
+      bool tinylfu = false;
+      if (cache_name.find(kTinyLfuPrefix) == 0) {
+        tinylfu = true;
+        cache_name = cache_name.substr(kTinyLfuPrefix.size());
+      }
       if (cache_name.find(kGhostCachePrefix) != std::string::npos) {
         ghost_cache.reset(new GhostCache(
             NewLRUCache(config.ghost_cache_capacity, /*num_shard_bits=*/1,
@@ -256,6 +287,10 @@ Status BlockCacheTraceSimulator::InitializeCaches() {
         return Status::InvalidArgument("Unknown cache name " +
                                        config.cache_name);
       }
+      if (tinylfu) {
+        sim_cache->EnableTinyLfuAdmission(static_cast<size_t>(
+            simulate_cache_capacity / kTinyLfuEstimatedEntryCharge));
+      }
       sim_caches_[config].push_back(sim_cache);
     }
   }
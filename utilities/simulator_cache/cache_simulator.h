@@ -7,6 +7,7 @@
 
 #include <unordered_map>
 
+#include "cache/frequency_sketch.h"
 #include "cache/lru_cache.h"
 #include "trace_replay/block_cache_tracer.h"
 
@@ -112,19 +113,31 @@ class CacheSimulator {
 
   virtual void Access(const BlockCacheTraceRecord& access);
 
+  // Admit a missing entry only if it fits without eviction or it was accessed
+  // more often recently than the LRU entry it would evict (TinyLFU). Requires
+  // sim_cache to be an LRUCache.
+  void EnableTinyLfuAdmission(size_t expected_entries) {
+    sketch_.reset(new FrequencySketch(expected_entries));
+  }
+
   void reset_counter() { miss_ratio_stats_.reset_counter(); }
 
   const MissRatioStats& miss_ratio_stats() const { return miss_ratio_stats_; }
 
  protected:
+  // Records an access to the key and returns whether the key should be
+  // inserted with the given charge upon a miss.
+  bool Admit(const Slice& key, uint64_t charge);
+
   MissRatioStats miss_ratio_stats_;
   std::unique_ptr<GhostCache> ghost_cache_;
   std::shared_ptr<Cache> sim_cache_;
+  std::unique_ptr<FrequencySketch> sketch_;
 };
 
 // A prioritized cache simulator that runs against a block cache trace.
 // It inserts missing index/filter/uncompression-dictionary blocks with high
-// priority in the cache.
+// priority in the cache, and data blocks of long scans with bottom priority.
 class PrioritizedCacheSimulator : public CacheSimulator {
  public:
   PrioritizedCacheSimulator(std::unique_ptr<GhostCache>&& ghost_cache,
@@ -160,6 +160,40 @@ TEST_F(CacheSimulatorTest, GhostCacheSimulator) {
   ASSERT_EQ(100, cache_simulator->miss_ratio_stats().miss_ratio());
 }
 
+TEST_F(CacheSimulatorTest, TinyLfuCacheSimulator) {
+  const BlockCacheTraceRecord& hot_access = GenerateGetRecord(kGetId);
+  BlockCacheTraceRecord scan_access = GenerateGetRecord(kGetId + 1);
+  scan_access.block_key = kBlockKeyPrefix + std::to_string(kGetBlockId + 1);
+  // Room for only one block
+  std::shared_ptr<Cache> sim_cache =
+      NewLRUCache(/*capacity=*/6000, /*num_shard_bits=*/0,
+                  /*strict_capacity_limit=*/false,
+                  /*high_pri_pool_ratio=*/0);
+  std::unique_ptr<CacheSimulator> cache_simulator(
+      new CacheSimulator(nullptr, sim_cache));
+  cache_simulator->EnableTinyLfuAdmission(/*expected_entries=*/16);
+  cache_simulator->Access(hot_access);
+  cache_simulator->Access(hot_access);
+  cache_simulator->Access(hot_access);
+  // A block accessed once does not replace the hot block.
+  cache_simulator->Access(scan_access);
+  cache_simulator->Access(hot_access);
+  ASSERT_EQ(5, cache_simulator->miss_ratio_stats().total_accesses());
+  ASSERT_EQ(2, cache_simulator->miss_ratio_stats().total_misses());
+  auto handle = sim_cache->Lookup(scan_access.block_key);
+  ASSERT_EQ(nullptr, handle);
+
+  // Once it is accessed more often than the hot block, it is admitted.
+  for (int i = 0; i < 4; i++) {
+    cache_simulator->Access(scan_access);
+  }
+  handle = sim_cache->Lookup(scan_access.block_key);
+  ASSERT_NE(nullptr, handle);
+  sim_cache->Release(handle);
+  handle = sim_cache->Lookup(hot_access.block_key);
+  ASSERT_EQ(nullptr, handle);
+}
+
 TEST_F(CacheSimulatorTest, PrioritizedCacheSimulator) {
   const BlockCacheTraceRecord& access = GenerateGetRecord(kGetId);
   std::shared_ptr<Cache> sim_cache =